@@ -0,0 +1,280 @@
+/*!
+ * @file DdpReceiverTests.cpp
+ *
+ * Host tests of streaming pixels to the LEDs with
+ * the Distributed Display Protocol (DDP): a local
+ * sender streams frames to the receiver over the
+ * loopback network.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include <vector>
+#include "HostTest.h"
+#include "LoopbackUdpService.h"
+#include "SimulatedBoard.h"
+#include "../../src/Networking/DdpReceiver.h"
+
+using namespace LS;
+
+#define		DDP_TEST_PORT				4048
+#define		DDP_TEST_LEDS				150
+#define		DDP_TEST_PIXELS_PER_PACKET	75			// pixels sent in each packet of a frame
+
+/*!
+	@brief	Sends DDP packets over the loopback network, as a PC that streams
+			pixels to the LEDs would.
+*/
+struct DdpSender {
+	LoopbackUdpService* udp;
+	uint8_t sequence = 0;
+	uint8_t flags = DDP_VERSION << 6;
+	uint8_t destination = DDP_ID_DISPLAY;
+	bool sendTimecode = false;
+
+	/*!
+		@brief		Sends a packet of RGB data.
+		@param		offset		The byte offset of the data into the frame.
+		@param		data		The RGB data.
+		@param		push		True if the LEDs are shown once the data has been written.
+	*/
+	void Send(uint32_t offset, const std::vector<uint8_t>& data, bool push) {
+		sequence = (sequence % 15) + 1;
+
+		uint8_t header[DDP_HEADER_SIZE + DDP_TIMECODE_SIZE] = {
+			(uint8_t)(flags | (push ? DDP_FLAG_PUSH : 0) | (sendTimecode ? DDP_FLAG_TIMECODE : 0)),
+			sequence,
+			0x0B,
+			destination,
+			(uint8_t)(offset >> 24), (uint8_t)(offset >> 16), (uint8_t)(offset >> 8), (uint8_t)offset,
+			(uint8_t)(data.size() >> 8), (uint8_t)data.size(),
+			0x12, 0x34, 0x56, 0x78
+		};
+
+		udp->beginPacket({ 192, 168, 1, 50 }, DDP_TEST_PORT);
+		udp->write(header, sendTimecode ? DDP_HEADER_SIZE + DDP_TIMECODE_SIZE : DDP_HEADER_SIZE);
+		if (data.size() > 0) {
+			udp->write(data.data(), data.size());
+		}
+		udp->endPacket();
+	}
+
+	/*!
+		@brief		Sends a whole frame of pixels, split over several packets, and
+					sets the push flag of the last packet.
+		@param		frame		The colours of the pixels (0xRRGGBB).
+	*/
+	void SendFrame(const std::vector<uint32_t>& frame) {
+		for (size_t firstPixel = 0; firstPixel < frame.size(); firstPixel += DDP_TEST_PIXELS_PER_PACKET) {
+			size_t endPixel = firstPixel + DDP_TEST_PIXELS_PER_PACKET < frame.size()
+				? firstPixel + DDP_TEST_PIXELS_PER_PACKET
+				: frame.size();
+
+			std::vector<uint8_t> data;
+			for (size_t n = firstPixel; n < endPixel; n++) {
+				data.push_back((uint8_t)(frame[n] >> 16));
+				data.push_back((uint8_t)(frame[n] >> 8));
+				data.push_back((uint8_t)frame[n]);
+			}
+
+			Send((uint32_t)(firstPixel * 3), data, endPixel == frame.size());
+		}
+	}
+};
+
+/*!
+	@brief	A receiver and the local sender that streams to it.
+*/
+struct DdpTestBoards {
+	double simulatedTime = 0;
+	LoopbackNetwork network;
+	LoopbackUdpService receiverUdp = LoopbackUdpService(&network, { 192, 168, 1, 50 });
+	LoopbackUdpService senderUdp = LoopbackUdpService(&network, { 192, 168, 1, 10 });
+	SimulatedTimer timer = SimulatedTimer(&simulatedTime, 25, 1.0, 5000);
+	SimulatedOrchastor orchastor;
+	SimulatedPixels pixels = SimulatedPixels(DDP_TEST_LEDS);
+	DdpReceiver receiver = DdpReceiver(DDP_TEST_PORT, &receiverUdp, &pixels, &orchastor, &timer);
+	DdpSender sender;
+
+	DdpTestBoards() {
+		sender.udp = &senderUdp;
+		receiver.Start();
+	}
+
+	/*!
+		@brief		Runs the receiver for a number of ms of simulated time.
+	*/
+	void Run(uint32_t milliseconds) {
+		for (uint32_t ms = 0; ms < milliseconds; ms++) {
+			simulatedTime += 1;
+			receiver.Execute();
+		}
+	}
+};
+
+/*!
+	@brief		Makes a frame with a different colour for each pixel.
+*/
+static std::vector<uint32_t> MakeFrame(uint16_t numberOfPixels, uint8_t seed) {
+	std::vector<uint32_t> frame;
+	for (uint16_t n = 0; n < numberOfPixels; n++) {
+		frame.push_back(((uint32_t)(uint8_t)(n + seed) << 16) | ((uint32_t)(uint8_t)(n * 3) << 8) | (uint8_t)(n * 7 + seed));
+	}
+
+	return frame;
+}
+
+/*!
+	@brief		A frame split over several packets is shown once, when the packet
+				with the push flag has been written.
+*/
+static void FrameIsShownOnPush() {
+	DdpTestBoards boards;
+	std::vector<uint32_t> frame = MakeFrame(DDP_TEST_LEDS, 1);
+
+	boards.sender.SendFrame(frame);
+	boards.Run(1);
+
+	CHECK(boards.pixels.shows == 1);
+	CHECK(boards.pixels.shown == frame);
+	CHECK(boards.receiver.GetStatistics()->packetsReceived == DDP_TEST_LEDS / DDP_TEST_PIXELS_PER_PACKET);
+	CHECK(boards.receiver.GetStatistics()->framesShown == 1);
+	CHECK(boards.receiver.GetStatistics()->outOfSequence == 0);
+
+	// a packet without the push flag is written but not shown
+	boards.sender.Send(0, { 1, 2, 3 }, false);
+	boards.Run(1);
+	CHECK(boards.pixels.shows == 1);
+	CHECK(boards.pixels.pixels[0] == 0x010203);
+}
+
+/*!
+	@brief		Packets whose header has a timecode are written in the same way as
+				packets without one.
+*/
+static void TimecodeIsSkipped() {
+	DdpTestBoards boards;
+	std::vector<uint32_t> frame = MakeFrame(DDP_TEST_LEDS, 2);
+
+	boards.sender.sendTimecode = true;
+	boards.sender.SendFrame(frame);
+	boards.Run(1);
+
+	CHECK(boards.pixels.shown == frame);
+	CHECK(boards.receiver.GetStatistics()->packetsIgnored == 0);
+}
+
+/*!
+	@brief		Data that starts or ends part way through a pixel keeps the other
+				channels of that pixel, and pixels beyond the LEDs are ignored.
+*/
+static void PartialPixelsKeepTheirOtherChannels() {
+	DdpTestBoards boards;
+	boards.sender.SendFrame(std::vector<uint32_t>(DDP_TEST_LEDS, 0x102030));
+	boards.Run(1);
+
+	// the green and blue of pixel 1 and the red of pixel 2
+	boards.sender.Send(4, { 0xAA, 0xBB, 0xCC }, true);
+	boards.Run(1);
+	CHECK(boards.pixels.shown[0] == 0x102030);
+	CHECK(boards.pixels.shown[1] == 0x10AABB);
+	CHECK(boards.pixels.shown[2] == 0xCC2030);
+	CHECK(boards.pixels.shown[3] == 0x102030);
+
+	std::vector<uint8_t> pastTheEnd(30, 0xFF);
+	boards.sender.Send((DDP_TEST_LEDS - 2) * 3, pastTheEnd, true);
+	boards.Run(1);
+	CHECK(boards.pixels.shown[DDP_TEST_LEDS - 1] == 0xFFFFFF);
+	CHECK(boards.pixels.outOfRange == 0);
+}
+
+/*!
+	@brief		Packets that are not pixels for display are ignored and do not take
+				the LEDs from the program.
+*/
+static void OtherPacketsAreIgnored() {
+	DdpTestBoards boards;
+	std::vector<uint8_t> data = { 1, 2, 3 };
+
+	boards.sender.flags = (DDP_VERSION << 6) | DDP_FLAG_QUERY;
+	boards.sender.Send(0, data, true);
+	boards.sender.flags = (DDP_VERSION << 6) | DDP_FLAG_STORAGE;
+	boards.sender.Send(0, data, true);
+	boards.sender.flags = 2 << 6;
+	boards.sender.Send(0, data, true);
+	boards.sender.flags = DDP_VERSION << 6;
+	boards.sender.destination = 2;
+	boards.sender.Send(0, data, true);
+
+	boards.senderUdp.beginPacket({ 192, 168, 1, 50 }, DDP_TEST_PORT);
+	boards.senderUdp.write("DDP");
+	boards.senderUdp.endPacket();
+
+	boards.Run(1);
+	CHECK(boards.receiver.GetStatistics()->packetsReceived == 5);
+	CHECK(boards.receiver.GetStatistics()->packetsIgnored == 5);
+	CHECK(boards.pixels.shows == 0);
+	CHECK(!boards.receiver.IsStreaming());
+	CHECK(boards.orchastor.preempts == 0);
+}
+
+/*!
+	@brief		The first packet preempts the program, which takes back the LEDs
+				once no packet has been received for the timeout.
+*/
+static void StreamPreemptsAndResumesTheProgram() {
+	DdpTestBoards boards;
+	std::vector<uint32_t> frame = MakeFrame(DDP_TEST_LEDS, 3);
+
+	boards.sender.SendFrame(frame);
+	boards.Run(1);
+	CHECK(boards.receiver.IsStreaming());
+	CHECK(boards.orchastor.isPreempted);
+
+	// frames that keep coming keep the LEDs
+	for (int i = 0; i < 10; i++) {
+		boards.Run(DDP_TIMEOUT / 2);
+		boards.sender.SendFrame(frame);
+	}
+	boards.Run(1);
+	CHECK(boards.orchastor.preempts == 1);
+	CHECK(boards.orchastor.resumes == 0);
+
+	boards.Run(DDP_TIMEOUT - 2);
+	CHECK(boards.receiver.IsStreaming());
+	boards.Run(2);
+	CHECK(!boards.receiver.IsStreaming());
+	CHECK(!boards.orchastor.isPreempted);
+	CHECK(boards.orchastor.resumes == 1);
+}
+
+/*!
+	@brief		A lost packet is counted as a packet out of sequence.
+*/
+static void LostPacketsAreCounted() {
+	DdpTestBoards boards;
+	std::vector<uint32_t> frame = MakeFrame(DDP_TEST_LEDS, 4);
+
+	boards.sender.SendFrame(frame);
+	boards.senderUdp.packetsToDrop = 1;
+	boards.sender.SendFrame(frame);
+	boards.Run(1);
+
+	CHECK(boards.receiver.GetStatistics()->outOfSequence == 1);
+	CHECK(boards.receiver.GetStatistics()->framesShown == 2);
+}
+
+int main() {
+	FrameIsShownOnPush();
+	TimecodeIsSkipped();
+	PartialPixelsKeepTheirOtherChannels();
+	OtherPacketsAreIgnored();
+	StreamPreemptsAndResumesTheProgram();
+	LostPacketsAreCounted();
+
+	return HostTestResult("DdpReceiverTests");
+}
\ No newline at end of file
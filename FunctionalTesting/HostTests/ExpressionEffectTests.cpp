@@ -0,0 +1,136 @@
+/*!
+ * @file ExpressionEffectTests.cpp
+ *
+ * Host tests of compiling and evaluating the
+ * expressions of expression LPIs.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include "HostTest.h"
+#include "../../src/LPE/EffectHelpers/ExpressionEffect.h"
+#include "../../src/LPE/Validation/LpJsonValidator.h"
+#include "../../src/LPE/Validation/JsonInstructionValidatorFactory.h"
+
+using namespace LS;
+
+// the validator is large so it is kept off the stack
+static LEDConfig ledConfig;
+static StringProcessor stringProcessor;
+static LpiExecutorFactory lpiExecutorFactory;
+static JsonInstructionValidatorFactory validatorFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonValidator validator(&validatorFactory);
+static FixedSizeCharBuffer lpBuffer(BUFFER_LP);
+static LPValidateResult validateResult;
+
+/*!
+	@brief		Checks whether an expression compiles.
+*/
+static bool Compiles(const char* expression) {
+	ExpressionEffect expressionEffect;
+	return expressionEffect.Compile(expression, &stringProcessor);
+}
+
+/*!
+	@brief		Checks whether a program with a single expression LPI is valid.
+*/
+static bool IsValidExpressionLpi(const char* expression) {
+	char program[200];
+	snprintf(program, sizeof(program), "{\"name\":\"expression\",\"instructions\":[\"0901000040020000FFFF0000%s\"]}", expression);
+	lpBuffer.ClearBuffer();
+	lpBuffer.LoadFromBuffer(program);
+	validator.ValidateLp(&lpBuffer, &validateResult);
+
+	return validateResult.GetCode() == LPValidateCode::Valid;
+}
+
+/*!
+	@brief		Each operation needs the values that it takes to be on the stack.
+*/
+static void OperationsNeedTheirOperands() {
+	CHECK(!Compiles("d"));
+	CHECK(!Compiles("~"));
+	CHECK(!Compiles("i~"));
+	CHECK(!Compiles("s"));
+	CHECK(!Compiles("+"));
+	CHECK(!Compiles("i+"));
+	CHECK(!Compiles("dd+"));
+
+	CHECK(Compiles("id+"));
+	CHECK(Compiles("it~-"));
+	CHECK(Compiles("is"));
+	CHECK(Compiles("it+"));
+}
+
+/*!
+	@brief		Expressions that do not leave a single value, overflow the stack,
+				have an invalid literal, an unknown operation or are too long are
+				not compiled.
+*/
+static void InvalidExpressionsAreRejected() {
+	CHECK(!Compiles(""));
+	CHECK(!Compiles("it"));
+	CHECK(!Compiles("iiiiiiiii++++++++"));
+	CHECK(Compiles("iiiiiiii+++++++"));
+	CHECK(!Compiles("#G0"));
+	CHECK(!Compiles("#0"));
+	CHECK(!Compiles("iz"));
+
+	char tooLong[EXPRESSION_MAX_LENGTH + 2];
+	tooLong[0] = 'i';
+	for (int n = 1; n < EXPRESSION_MAX_LENGTH + 1; n += 2) {
+		tooLong[n] = 'i';
+		tooLong[n + 1] = '+';
+	}
+	tooLong[EXPRESSION_MAX_LENGTH + 1] = '\0';
+	CHECK(!Compiles(tooLong));
+}
+
+/*!
+	@brief		Compiled expressions evaluate as documented, and an expression that
+				fails to compile leaves nothing to evaluate.
+*/
+static void ExpressionsEvaluate() {
+	ExpressionEffect expressionEffect;
+
+	CHECK(expressionEffect.Compile("id+", &stringProcessor));
+	CHECK(expressionEffect.Evaluate(21, 0, 60) == 42);
+
+	CHECK(expressionEffect.Compile("it~-", &stringProcessor));
+	CHECK(expressionEffect.Evaluate(3, 10, 60) == 7);
+
+	CHECK(expressionEffect.Compile("i#08xt#04x+s", &stringProcessor));
+	CHECK(expressionEffect.GetNumberOfOperations() == 8);
+	CHECK(expressionEffect.Evaluate(0, 0, 60) == 128);
+	CHECK(expressionEffect.Evaluate(8, 0, 60) == 255);
+
+	CHECK(!expressionEffect.Compile("d", &stringProcessor));
+	CHECK(!expressionEffect.IsCompiledFrom("d"));
+	CHECK(expressionEffect.GetNumberOfOperations() == 0);
+	CHECK(expressionEffect.Evaluate(8, 0, 60) == 0);
+}
+
+/*!
+	@brief		A program with an expression LPI whose expression does not compile
+				is not valid.
+*/
+static void InvalidExpressionLpisAreRejected() {
+	CHECK(IsValidExpressionLpi("i#08xt#04x+s"));
+	CHECK(!IsValidExpressionLpi("d"));
+	CHECK(!IsValidExpressionLpi("i~"));
+}
+
+int main() {
+	ledConfig.numberOfLEDs = 60;
+
+	OperationsNeedTheirOperands();
+	InvalidExpressionsAreRejected();
+	ExpressionsEvaluate();
+	InvalidExpressionLpisAreRejected();
+
+	return HostTestResult("ExpressionEffectTests");
+}
\ No newline at end of file
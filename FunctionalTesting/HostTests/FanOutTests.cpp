@@ -0,0 +1,245 @@
+/*!
+ * @file FanOutTests.cpp
+ *
+ * Host tests of spreading a logical strip of LEDs
+ * over several servers: a fan-out master sends two
+ * followers their segments of each frame over the
+ * loopback network.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include <vector>
+#include "HostTest.h"
+#include "LoopbackUdpService.h"
+#include "SimulatedBoard.h"
+#include "../../src/Renderer/FanOutPixelRenderer.h"
+#include "../../src/Networking/FanOutReceiver.h"
+
+using namespace LS;
+
+#define		FAN_OUT_TEST_PORT			8890
+#define		FAN_OUT_TEST_LOGICAL_LEDS	330			// LEDs of the whole logical strip
+#define		FAN_OUT_TEST_MASTER_LEDS	100			// LEDs attached to the master
+#define		FAN_OUT_TEST_FIRST_LEDS		120			// LEDs attached to the first follower
+#define		FAN_OUT_TEST_SECOND_LEDS	110			// LEDs attached to the second follower
+
+/*!
+	@brief	A master and two followers on the loopback network that between
+			them render a logical strip of LEDs.  A renderer of the whole strip
+			on a single server gives the frames that are expected.
+*/
+struct FanOutTestBoards {
+	LoopbackNetwork network;
+	LoopbackUdpService masterUdp = LoopbackUdpService(&network, { 192, 168, 1, 50 });
+	LoopbackUdpService firstUdp = LoopbackUdpService(&network, { 192, 168, 1, 51 });
+	LoopbackUdpService secondUdp = LoopbackUdpService(&network, { 192, 168, 1, 52 });
+	LEDConfig masterConfig;
+	LEDConfig firstConfig;
+	LEDConfig secondConfig;
+	LEDConfig expectedConfig;
+	SimulatedPixels masterPixels = SimulatedPixels(FAN_OUT_TEST_MASTER_LEDS);
+	SimulatedPixels firstPixels = SimulatedPixels(FAN_OUT_TEST_FIRST_LEDS);
+	SimulatedPixels secondPixels = SimulatedPixels(FAN_OUT_TEST_SECOND_LEDS);
+	SimulatedPixels expectedPixels = SimulatedPixels(FAN_OUT_TEST_LOGICAL_LEDS);
+	FanOutPixelRenderer master = FanOutPixelRenderer(&masterPixels, &masterConfig, FAN_OUT_TEST_MASTER_LEDS, &masterUdp, FAN_OUT_TEST_PORT);
+	PixelRenderer firstRenderer = PixelRenderer(&firstPixels, &firstConfig);
+	PixelRenderer secondRenderer = PixelRenderer(&secondPixels, &secondConfig);
+	PixelRenderer expectedRenderer = PixelRenderer(&expectedPixels, &expectedConfig);
+	FanOutReceiver first = FanOutReceiver(FAN_OUT_TEST_PORT, &firstUdp, &firstRenderer);
+	FanOutReceiver second = FanOutReceiver(FAN_OUT_TEST_PORT, &secondUdp, &secondRenderer);
+
+	FanOutTestBoards() {
+		masterConfig.numberOfLEDs = FAN_OUT_TEST_LOGICAL_LEDS;
+		firstConfig.numberOfLEDs = FAN_OUT_TEST_FIRST_LEDS;
+		secondConfig.numberOfLEDs = FAN_OUT_TEST_SECOND_LEDS;
+		expectedConfig.numberOfLEDs = FAN_OUT_TEST_LOGICAL_LEDS;
+
+		master.AddFollower({ 192, 168, 1, 51 }, FAN_OUT_TEST_MASTER_LEDS, FAN_OUT_TEST_FIRST_LEDS);
+		master.AddFollower({ 192, 168, 1, 52 }, FAN_OUT_TEST_MASTER_LEDS + FAN_OUT_TEST_FIRST_LEDS, FAN_OUT_TEST_SECOND_LEDS);
+		master.Start();
+		first.Start();
+		second.Start();
+	}
+
+	/*!
+		@brief		Renders a frame on the master and lets the followers render the
+					packets that they have been sent.
+	*/
+	void ShowFrame(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat) {
+		master.SetPixels(renderingInstructions, numberOfInstructions, repeat);
+		master.ShowPixels();
+		ReceiveFrames();
+
+		expectedRenderer.SetPixels(renderingInstructions, numberOfInstructions, repeat);
+		expectedRenderer.ShowPixels();
+	}
+
+	/*!
+		@brief		Lets the followers render all of the packets that they have been sent.
+	*/
+	void ReceiveFrames() {
+		for (int i = 0; i < 8; i++) {
+			first.Execute();
+			second.Execute();
+		}
+	}
+
+	/*!
+		@brief		Checks whether the LEDs shown by a server are its part of the expected frame.
+	*/
+	bool IsShowing(SimulatedPixels* pixels, uint16_t firstLed) {
+		for (size_t n = 0; n < pixels->shown.size(); n++) {
+			if (pixels->shown[n] != expectedPixels.shown[firstLed + n]) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool MasterIsShowingFrame() { return IsShowing(&masterPixels, 0); }
+	bool FirstIsShowingFrame() { return IsShowing(&firstPixels, FAN_OUT_TEST_MASTER_LEDS); }
+	bool SecondIsShowingFrame() { return IsShowing(&secondPixels, FAN_OUT_TEST_MASTER_LEDS + FAN_OUT_TEST_FIRST_LEDS); }
+};
+
+/*!
+	@brief		Fills a frame with a different colour for each LED so that the
+				segments need several packets.
+*/
+static std::vector<RI> SingleLedFrame(uint8_t seed) {
+	std::vector<RI> frame;
+	for (int n = 0; n < FAN_OUT_TEST_LOGICAL_LEDS; n++) {
+		frame.push_back(RI(Colour((uint8_t)(n + seed), (uint8_t)(n * 3), (uint8_t)(n * 7)), 1));
+	}
+
+	return frame;
+}
+
+/*!
+	@brief		Each server shows its part of the frame rendered by the master:
+				a repeated pattern, a frame of many packets, runs longer than a
+				packet run can hold and a frame shorter than the strip.
+*/
+static void SegmentsMatchTheLogicalStrip() {
+	FanOutTestBoards boards;
+
+	RI pattern[3] = { RI(Colour(255, 0, 0), 3), RI(Colour(0, 255, 0), 2), RI(Colour(0, 0, 255), 1) };
+	boards.ShowFrame(pattern, 3, true);
+	CHECK(boards.MasterIsShowingFrame());
+	CHECK(boards.FirstIsShowingFrame());
+	CHECK(boards.SecondIsShowingFrame());
+
+	std::vector<RI> singleLeds = SingleLedFrame(0);
+	boards.ShowFrame(singleLeds.data(), (uint16_t)singleLeds.size(), false);
+	CHECK(boards.MasterIsShowingFrame());
+	CHECK(boards.FirstIsShowingFrame());
+	CHECK(boards.SecondIsShowingFrame());
+
+	RI longRuns[2] = { RI(Colour(9, 9, 9), 300), RI(Colour(1, 2, 3), 30) };
+	boards.ShowFrame(longRuns, 2, false);
+	CHECK(boards.MasterIsShowingFrame());
+	CHECK(boards.FirstIsShowingFrame());
+	CHECK(boards.SecondIsShowingFrame());
+
+	RI shortFrame[1] = { RI(Colour(7, 7, 7), 150) };
+	boards.ShowFrame(shortFrame, 1, false);
+	CHECK(boards.MasterIsShowingFrame());
+	CHECK(boards.FirstIsShowingFrame());
+
+	CHECK(boards.first.GetStatistics()->framesShown == 4);
+	CHECK(boards.second.GetStatistics()->framesShown == 4);
+	CHECK(boards.first.GetStatistics()->framesDropped == 0);
+	CHECK(boards.masterPixels.outOfRange == 0);
+	CHECK(boards.firstPixels.outOfRange == 0);
+	CHECK(boards.secondPixels.outOfRange == 0);
+}
+
+/*!
+	@brief		A follower that loses a packet of a frame holds the last frame it
+				showed rather than show part of the frame, and shows the next frame.
+*/
+static void LostPacketHoldsTheLastFrame() {
+	FanOutTestBoards boards;
+
+	std::vector<RI> frame = SingleLedFrame(0);
+	boards.ShowFrame(frame.data(), (uint16_t)frame.size(), false);
+	std::vector<uint32_t> heldFrame = boards.firstPixels.shown;
+
+	// the first packet sent is the first packet of the first follower's segment
+	boards.masterUdp.packetsToDrop = 1;
+	frame = SingleLedFrame(0x55);
+	boards.ShowFrame(frame.data(), (uint16_t)frame.size(), false);
+	CHECK(boards.firstPixels.shown == heldFrame);
+	CHECK(boards.first.GetStatistics()->framesDropped == 1);
+	CHECK(boards.first.GetStatistics()->framesShown == 1);
+	CHECK(boards.SecondIsShowingFrame());
+
+	frame = SingleLedFrame(0xAA);
+	boards.ShowFrame(frame.data(), (uint16_t)frame.size(), false);
+	CHECK(boards.FirstIsShowingFrame());
+	CHECK(boards.first.GetStatistics()->framesShown == 2);
+}
+
+/*!
+	@brief		The last frame is sent again when no new frame has been rendered
+				for a while, so followers that lost it catch up.  Followers that
+				already showed the frame ignore it.
+*/
+static void RefreshSendsTheLastFrameAgain() {
+	FanOutTestBoards boards;
+
+	// a frame that each follower is sent in a single packet
+	RI pattern[2] = { RI(Colour(255, 0, 0), 50), RI(Colour(0, 0, 255), 50) };
+	boards.masterUdp.packetsToDrop = 2;
+	boards.ShowFrame(pattern, 2, true);
+	CHECK(boards.MasterIsShowingFrame());
+	CHECK(boards.first.GetStatistics()->framesShown == 0);
+	CHECK(boards.second.GetStatistics()->framesShown == 0);
+
+	// the frame was sent during the first refresh interval so is not sent again until the second
+	boards.master.Refresh(FAN_OUT_REFRESH_INTERVAL);
+	boards.ReceiveFrames();
+	CHECK(boards.first.GetStatistics()->framesShown == 0);
+
+	boards.master.Refresh(FAN_OUT_REFRESH_INTERVAL * 2);
+	boards.ReceiveFrames();
+	CHECK(boards.FirstIsShowingFrame());
+	CHECK(boards.SecondIsShowingFrame());
+	CHECK(boards.first.GetStatistics()->framesShown == 1);
+
+	uint32_t ignored = boards.first.GetStatistics()->packetsIgnored;
+	boards.master.Refresh(FAN_OUT_REFRESH_INTERVAL * 3);
+	boards.ReceiveFrames();
+	CHECK(boards.first.GetStatistics()->framesShown == 1);
+	CHECK(boards.first.GetStatistics()->packetsIgnored == ignored + 1);
+}
+
+/*!
+	@brief		Packets that are not fan-out packets are ignored.
+*/
+static void OtherPacketsAreIgnored() {
+	FanOutTestBoards boards;
+
+	boards.masterUdp.beginPacket({ 192, 168, 1, 51 }, FAN_OUT_TEST_PORT);
+	boards.masterUdp.write("not a frame");
+	boards.masterUdp.endPacket();
+	boards.ReceiveFrames();
+
+	CHECK(boards.first.GetStatistics()->packetsReceived == 1);
+	CHECK(boards.first.GetStatistics()->packetsIgnored == 1);
+	CHECK(boards.firstPixels.shows == 0);
+}
+
+int main() {
+	SegmentsMatchTheLogicalStrip();
+	LostPacketHoldsTheLastFrame();
+	RefreshSendsTheLastFrameAgain();
+	OtherPacketsAreIgnored();
+
+	return HostTestResult("FanOutTests");
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+/*!
+ * @file FrameClockSyncTests.cpp
+ *
+ * Host tests of keeping the frame clocks of two
+ * servers in step: a master and a follower whose
+ * clocks run 600ppm apart exchange beacons over
+ * the loopback network.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include "HostTest.h"
+#include "LoopbackUdpService.h"
+#include "SimulatedBoard.h"
+#include "../../src/Networking/FrameClockSync.h"
+
+using namespace LS;
+
+#define		SYNC_TEST_PORT			8889
+#define		SYNC_TEST_INTERVAL		40			// ms between rendering frames
+#define		SYNC_TEST_PROGRAM_ID	42
+
+/*!
+	@brief	A master and a follower on the loopback network.  Each has a clock
+			of its own, started at a different time, and a program that counts
+			the frames shown.
+*/
+struct SyncTestBoards {
+	double simulatedTime = 0;
+	LoopbackNetwork network;
+	LoopbackUdpService masterUdp = LoopbackUdpService(&network, { 192, 168, 1, 50 });
+	LoopbackUdpService followerUdp = LoopbackUdpService(&network, { 192, 168, 1, 51 });
+	SimulatedTimer masterTimer = SimulatedTimer(&simulatedTime, SYNC_TEST_INTERVAL, 1.0003, 5000);
+	SimulatedTimer followerTimer = SimulatedTimer(&simulatedTime, SYNC_TEST_INTERVAL, 0.9997, 123457);
+	SimulatedOrchastor masterOrchastor;
+	SimulatedOrchastor followerOrchastor;
+	LpState masterState;
+	LpState followerState;
+	FrameClockSync master = FrameClockSync(SYNC_TEST_PORT, &masterUdp, &masterTimer, &masterOrchastor, &masterState);
+	FrameClockSync follower = FrameClockSync(SYNC_TEST_PORT, &followerUdp, &followerTimer, &followerOrchastor, &followerState);
+
+	SyncTestBoards() {
+		masterState.SetProgramId(SYNC_TEST_PROGRAM_ID);
+		followerState.SetProgramId(SYNC_TEST_PROGRAM_ID);
+		master.Start();
+		follower.Start();
+		master.SetRole(FrameSyncRole::SyncMaster);
+		follower.SetRole(FrameSyncRole::SyncFollower);
+	}
+
+	/*!
+		@brief		Runs both servers for a number of ms of simulated time.
+		@param		milliseconds	The time to run for.
+		@param		worstError		Set to the largest difference (ms) between the frame
+									clocks seen whilst running (if not nullptr).
+	*/
+	void Run(uint32_t milliseconds, double* worstError = nullptr) {
+		for (uint32_t ms = 0; ms < milliseconds; ms++) {
+			simulatedTime += 1;
+			if (masterTimer.IsTime()) {
+				masterOrchastor.frame++;
+			}
+			if (followerTimer.IsTime()) {
+				followerOrchastor.frame++;
+			}
+			master.Execute();
+			follower.Execute();
+
+			if (worstError != nullptr) {
+				double masterPosition = masterOrchastor.frame * (double)SYNC_TEST_INTERVAL - masterTimer.GetTimeUntilNext();
+				double followerPosition = followerOrchastor.frame * (double)SYNC_TEST_INTERVAL - followerTimer.GetTimeUntilNext();
+				double error = masterPosition > followerPosition ? masterPosition - followerPosition : followerPosition - masterPosition;
+				if (error > *worstError) {
+					*worstError = error;
+				}
+			}
+		}
+	}
+};
+
+/*!
+	@brief		A follower that starts many frames behind the master seeks to the
+				master's frame once and then stays within a few ms of the master.
+*/
+static void FollowerLocksToMaster() {
+	SyncTestBoards boards;
+	boards.masterOrchastor.frame = 1000;
+	boards.followerOrchastor.frame = 963;
+
+	boards.Run(20000);
+	double worstError = 0;
+	boards.Run(100000, &worstError);
+
+	FrameSyncQuality* quality = boards.follower.GetQuality();
+	printf("FollowerLocksToMaster: beacons %u, seeks %u, worst error %.1fms\n",
+		(unsigned)quality->beaconsReceived, (unsigned)quality->seeks, worstError);
+	CHECK(quality->seeks == 1);
+	CHECK(quality->beaconsReceived >= 100000 / FRAME_SYNC_BEACON_INTERVAL);
+	CHECK(worstError <= FRAME_SYNC_LOCKED_ERROR);
+	CHECK(boards.follower.IsLocked());
+	CHECK(boards.master.GetQuality()->beaconsSent >= quality->beaconsReceived);
+}
+
+/*!
+	@brief		Beacons are 16 bytes in the documented format and their sequence
+				number goes up by one with each beacon.
+*/
+static void BeaconsHaveTheDocumentedFormat() {
+	SyncTestBoards boards;
+	boards.masterOrchastor.frame = 0x01020304;
+	boards.follower.SetRole(FrameSyncRole::SyncOff);
+
+	boards.Run(FRAME_SYNC_BEACON_INTERVAL * 3);
+
+	uint8_t beacon[FRAME_SYNC_PACKET_SIZE + 1];
+	uint16_t lastSequence = 0;
+	int numberOfBeacons = 0;
+	int packetSize = 0;
+	while ((packetSize = boards.followerUdp.parsePacket()) > 0) {
+		CHECK(packetSize == FRAME_SYNC_PACKET_SIZE);
+		CHECK(boards.followerUdp.read((char*)beacon, sizeof(beacon)) == FRAME_SYNC_PACKET_SIZE);
+		CHECK(beacon[0] == 'L' && beacon[1] == 'S' && beacon[2] == 'F' && beacon[3] == FRAME_SYNC_VERSION);
+		CHECK(beacon[4] == SYNC_TEST_PROGRAM_ID && beacon[5] == 0 && beacon[6] == 0 && beacon[7] == 0);
+		CHECK(beacon[11] == 0x01 && beacon[10] == 0x02);
+		CHECK(beacon[15] == SYNC_TEST_INTERVAL);
+		CHECK(beacon[14] <= SYNC_TEST_INTERVAL);
+
+		uint16_t sequence = (uint16_t)(beacon[12] | (beacon[13] << 8));
+		CHECK(numberOfBeacons == 0 || sequence == lastSequence + 1);
+		lastSequence = sequence;
+		numberOfBeacons++;
+	}
+
+	CHECK(numberOfBeacons >= 2);
+}
+
+/*!
+	@brief		Beacons for a different program are ignored by the follower.
+*/
+static void BeaconsOfAnotherProgramAreIgnored() {
+	SyncTestBoards boards;
+	boards.followerState.SetProgramId(SYNC_TEST_PROGRAM_ID + 1);
+	boards.followerOrchastor.frame = 500;
+
+	boards.Run(5000);
+
+	FrameSyncQuality* quality = boards.follower.GetQuality();
+	CHECK(quality->beaconsReceived == 0);
+	CHECK(quality->beaconsIgnored >= 5000 / FRAME_SYNC_BEACON_INTERVAL - 1);
+	CHECK(quality->seeks == 0);
+	CHECK(boards.followerOrchastor.frame < 1000);
+	CHECK(!boards.follower.IsLocked());
+}
+
+/*!
+	@brief		A beacon that arrives after a later one is ignored.
+*/
+static void LateBeaconsAreIgnored() {
+	SyncTestBoards boards;
+	LoopbackUdpService replayUdp(&boards.network, { 192, 168, 1, 60 });
+	replayUdp.begin(SYNC_TEST_PORT);
+
+	boards.Run(FRAME_SYNC_BEACON_INTERVAL + 10);
+	uint8_t firstBeacon[FRAME_SYNC_PACKET_SIZE];
+	CHECK(replayUdp.parsePacket() == FRAME_SYNC_PACKET_SIZE);
+	replayUdp.read((char*)firstBeacon, FRAME_SYNC_PACKET_SIZE);
+
+	boards.Run(FRAME_SYNC_BEACON_INTERVAL * 2);
+	FrameSyncQuality* quality = boards.follower.GetQuality();
+	uint32_t ignored = quality->beaconsIgnored;
+	uint32_t received = quality->beaconsReceived;
+
+	replayUdp.beginPacket({ 255, 255, 255, 255 }, SYNC_TEST_PORT);
+	replayUdp.write(firstBeacon, FRAME_SYNC_PACKET_SIZE);
+	replayUdp.endPacket();
+	boards.follower.Execute();
+
+	CHECK(quality->beaconsIgnored == ignored + 1);
+	CHECK(quality->beaconsReceived == received);
+}
+
+int main() {
+	FollowerLocksToMaster();
+	BeaconsHaveTheDocumentedFormat();
+	BeaconsOfAnotherProgramAreIgnored();
+	LateBeaconsAreIgnored();
+
+	return HostTestResult("FrameClockSyncTests");
+}
\ No newline at end of file
@@ -0,0 +1,146 @@
+/*!
+ * @file FrameGovernorTests.cpp
+ *
+ * Host tests of how the frame governor stretches and
+ * recovers the rendering frame interval.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include "HostTest.h"
+#include "../../src/Orchastrator/FrameGovernor.h"
+
+using namespace LS;
+
+/*!
+	@brief		Records the same cycle time a number of times.
+	@param		governor	The governor that records the cycles.
+	@param		frameTime	The time, in milliseconds, taken by each cycle.
+	@param		cycles		The number of cycles to record.
+	@author		Kevin White
+	@date		19 Oct 2026
+*/
+static void RecordFrames(FrameGovernor* governor, uint32_t frameTime, int cycles) {
+	for (int i = 0; i < cycles; i++) {
+		governor->RecordFrame(frameTime);
+	}
+}
+
+/*!
+	@brief		Cycles that are slightly over budget stretch the interval only
+				as far as is needed for them to fit and not to the maximum.
+*/
+static void SlightOverrunStretchesByOneStep() {
+	FrameGovernor governor(25);
+
+	RecordFrames(&governor, 27, 200);
+
+	CHECK(governor.GetInterval() == 30);
+	CHECK(governor.GetOverruns() == 1);
+}
+
+/*!
+	@brief		Cycles that fit the stretched interval but would not fit one step
+				shorter hold the interval rather than letting it flip back and forth.
+*/
+static void IntervalHoldsUnderSteadyLoad() {
+	FrameGovernor governor(25);
+
+	RecordFrames(&governor, 43, 200);
+	CHECK(governor.GetInterval() == 45);
+
+	uint32_t overruns = governor.GetOverruns();
+	RecordFrames(&governor, 43, 1000);
+	CHECK(governor.GetInterval() == 45);
+	CHECK(governor.GetOverruns() == overruns);
+}
+
+/*!
+	@brief		The interval recovers to the base interval once the load goes away.
+*/
+static void IntervalRecoversWhenLoadGoesAway() {
+	FrameGovernor governor(25);
+
+	RecordFrames(&governor, 250, 50);
+	CHECK(governor.GetInterval() == GOVERNOR_DEFAULT_MAX_INTERVAL);
+
+	RecordFrames(&governor, 10, GOVERNOR_DEFAULT_RECOVERY_FRAMES - 1);
+	CHECK(governor.GetInterval() == GOVERNOR_DEFAULT_MAX_INTERVAL);
+
+	RecordFrames(&governor, 10, 1);
+	CHECK(governor.GetInterval() == GOVERNOR_DEFAULT_MAX_INTERVAL - GOVERNOR_DEFAULT_INTERVAL_STEP);
+
+	RecordFrames(&governor, 10, 20 * GOVERNOR_DEFAULT_RECOVERY_FRAMES);
+	CHECK(governor.GetInterval() == 25);
+	CHECK(!governor.IsSheddingNetwork());
+}
+
+/*!
+	@brief		A cycle that would not fit the shorter interval restarts the count
+				of cycles needed before the interval is shortened.
+*/
+static void RecoveryNeedsConsecutiveCycles() {
+	FrameGovernor governor(25);
+
+	RecordFrames(&governor, 28, 1);
+	CHECK(governor.GetInterval() == 30);
+
+	for (int i = 0; i < 10; i++) {
+		RecordFrames(&governor, 10, GOVERNOR_DEFAULT_RECOVERY_FRAMES - 1);
+		RecordFrames(&governor, 28, 1);
+	}
+	CHECK(governor.GetInterval() == 30);
+
+	RecordFrames(&governor, 10, GOVERNOR_DEFAULT_RECOVERY_FRAMES);
+	CHECK(governor.GetInterval() == 25);
+}
+
+/*!
+	@brief		Network work is shed for no more than the maximum number of
+				consecutive cycles.
+*/
+static void SheddingIsLimited() {
+	FrameGovernor governor(25);
+	int consecutiveShedCycles = 0;
+	int mostConsecutiveShedCycles = 0;
+
+	for (int i = 0; i < 100; i++) {
+		governor.RecordFrame(250);
+		consecutiveShedCycles = governor.IsSheddingNetwork() ? consecutiveShedCycles + 1 : 0;
+		if (consecutiveShedCycles > mostConsecutiveShedCycles) {
+			mostConsecutiveShedCycles = consecutiveShedCycles;
+		}
+	}
+
+	CHECK(mostConsecutiveShedCycles == GOVERNOR_DEFAULT_MAX_SHED_FRAMES);
+}
+
+/*!
+	@brief		A disabled governor always returns the base interval.
+*/
+static void DisabledGovernorKeepsBaseInterval() {
+	FrameGovernor governor(25);
+	FrameGovernorPolicy policy;
+	policy.enabled = false;
+	governor.SetPolicy(&policy);
+
+	RecordFrames(&governor, 250, 100);
+
+	CHECK(governor.GetInterval() == 25);
+	CHECK(!governor.IsSheddingNetwork());
+}
+
+int main() {
+	SlightOverrunStretchesByOneStep();
+	IntervalHoldsUnderSteadyLoad();
+	IntervalRecoversWhenLoadGoesAway();
+	RecoveryNeedsConsecutiveCycles();
+	SheddingIsLimited();
+	DisabledGovernorKeepsBaseInterval();
+
+	return HostTestResult("FrameGovernorTests");
+}
\ No newline at end of file
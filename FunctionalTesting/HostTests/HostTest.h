@@ -0,0 +1,51 @@
+/*!
+ * @file HostTest.h
+ *
+ * Minimal support for tests of the LS library that are
+ * built and run on a development machine rather than on
+ * the board.  Each test file is a program in its own right
+ * that returns zero when all of its checks pass.  See
+ * Run-HostTests.ps1 for how the tests are built.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _HostTest_h
+#define _HostTest_h
+
+#include <stdio.h>
+
+static int hostTestChecks = 0;
+static int hostTestFailures = 0;
+
+/*!
+	@brief	Checks that a condition holds and reports the
+			condition, file and line when it does not.
+*/
+#define CHECK(condition)																	\
+	do {																					\
+		hostTestChecks++;																	\
+		if (!(condition)) {																	\
+			hostTestFailures++;																\
+			printf("FAILED: %s (%s:%d)\n", #condition, __FILE__, __LINE__);				\
+		}																					\
+	} while (0)
+
+/*!
+	@brief		Reports the outcome of the checks made by a test.
+	@param		testName	The name of the test that is reported.
+	@returns	Zero if all of the checks passed, one otherwise.
+	@author		Kevin White
+	@date		19 Oct 2026
+*/
+static int HostTestResult(const char* testName) {
+	printf("%s: %d checks, %d failed\n", testName, hostTestChecks, hostTestFailures);
+
+	return hostTestFailures == 0 ? 0 : 1;
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+/*!
+ * @file LoopbackUdpService.h
+ *
+ * An in-memory UDP service for host tests of
+ * the networking classes, which stands in for
+ * the UDP service of several boards that share
+ * the one network.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _LoopbackUdpService_h
+#define _LoopbackUdpService_h
+
+#include <stdint.h>
+#include <string.h>
+#include <deque>
+#include <vector>
+#include "../../src/Networking/IUdpService.h"
+
+#define		LOOPBACK_MAX_PACKET_SIZE		1500		// largest packet that can be sent
+#define		LOOPBACK_MAX_QUEUED				32			// packets queued for a service before more are dropped
+
+namespace LS {
+	class LoopbackUdpService;
+
+	/*!
+		@brief	A packet sent over the loopback network.
+	*/
+	struct LoopbackPacket {
+		IP from;
+		uint16_t fromPort = 0;
+		std::vector<uint8_t> data;
+	};
+
+	/*!
+		@brief	The network that the loopback UDP services are attached to.
+				A packet is delivered to each of the other services that listen
+				on the port it was sent to and that have the IP address it was
+				sent to (or to all of them if it was broadcast).
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LoopbackNetwork {
+	private:
+		std::vector<LoopbackUdpService*> services;
+
+	public:
+		void Attach(LoopbackUdpService* service) {
+			services.push_back(service);
+		}
+
+		void Send(LoopbackUdpService* sender, IP to, uint16_t port, const std::vector<uint8_t>& data);
+	};
+
+	/*!
+		@brief	UDP service of a single board on the loopback network.  Packets
+				are queued until they are parsed.  The packets sent can be dropped,
+				e.g. to test how a lost packet is handled.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LoopbackUdpService : public IUdpService {
+	private:
+		LoopbackNetwork* network;
+		IP ip;
+		uint16_t listenPort = 0;
+
+		std::deque<LoopbackPacket> received;
+		LoopbackPacket current;
+		size_t readPosition = 0;
+
+		IP sendIp = { 0, 0, 0, 0 };
+		uint16_t sendPort = 0;
+		std::vector<uint8_t> sendData;
+
+	public:
+		uint32_t packetsSent = 0;
+		uint32_t packetsToDrop = 0;			// the next packets sent that are lost rather than delivered
+
+		LoopbackUdpService(LoopbackNetwork* network, IP ip) {
+			this->network = network;
+			this->ip = ip;
+			network->Attach(this);
+		}
+
+		IP GetIp() { return ip; }
+		uint16_t GetListenPort() { return listenPort; }
+
+		void Deliver(const LoopbackPacket& packet) {
+			if (listenPort != 0
+				&& received.size() < LOOPBACK_MAX_QUEUED) {
+				received.push_back(packet);
+			}
+		}
+
+		uint8_t begin(uint16_t port) {
+			listenPort = port;
+			return 1;
+		}
+
+		int parsePacket() {
+			if (received.empty()) {
+				return 0;
+			}
+
+			current = received.front();
+			received.pop_front();
+			readPosition = 0;
+
+			return (int)current.data.size();
+		}
+
+		int read(char* buffer, size_t len) {
+			size_t remaining = current.data.size() - readPosition;
+			size_t numberRead = len < remaining ? len : remaining;
+			if (numberRead > 0) {
+				memcpy(buffer, &current.data[readPosition], numberRead);
+				readPosition += numberRead;
+			}
+
+			return (int)numberRead;
+		}
+
+		int beginPacket(IP ip, uint16_t port) {
+			sendIp = ip;
+			sendPort = port;
+			sendData.clear();
+			return 1;
+		}
+
+		IP remoteIP() { return current.from; }
+		uint16_t remotePort() { return current.fromPort; }
+
+		size_t write(const char* str) {
+			return write((const uint8_t*)str, strlen(str));
+		}
+
+		size_t write(const uint8_t* buffer, size_t size) {
+			if (sendData.size() + size > LOOPBACK_MAX_PACKET_SIZE) {
+				return 0;
+			}
+
+			sendData.insert(sendData.end(), buffer, buffer + size);
+			return size;
+		}
+
+		int endPacket() {
+			packetsSent++;
+			if (packetsToDrop > 0) {
+				packetsToDrop--;
+				return 1;
+			}
+
+			network->Send(this, sendIp, sendPort, sendData);
+			return 1;
+		}
+	};
+
+	/*!
+		@brief		Delivers a packet to the services it was sent to.
+		@param		sender		The service that sent the packet (which does not receive it).
+		@param		to			The IP address the packet was sent to (255.255.255.255 = all).
+		@param		port		The port the packet was sent to.
+		@param		data		The content of the packet.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	inline void LoopbackNetwork::Send(LoopbackUdpService* sender, IP to, uint16_t port, const std::vector<uint8_t>& data) {
+		bool isBroadcast = to.firstOctet == 255 && to.secondOctet == 255
+			&& to.thirdOctet == 255 && to.fourthOctet == 255;
+
+		LoopbackPacket packet;
+		packet.from = sender->GetIp();
+		packet.fromPort = sender->GetListenPort();
+		packet.data = data;
+
+		for (LoopbackUdpService* service : services) {
+			IP ip = service->GetIp();
+			if (service == sender
+				|| service->GetListenPort() != port
+				|| (!isBroadcast && memcmp(&ip, &to, sizeof(IP)) != 0)) {
+				continue;
+			}
+
+			service->Deliver(packet);
+		}
+	}
+}
+
+#endif
\ No newline at end of file
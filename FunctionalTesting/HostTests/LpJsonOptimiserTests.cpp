@@ -0,0 +1,241 @@
+/*!
+ * @file LpJsonOptimiserTests.cpp
+ *
+ * Host tests that the optimiser of the instruction
+ * tree folds the instructions that it should and
+ * does not change the frames rendered by any of
+ * the programs in FunctionalTesting/Programs.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include <stdlib.h>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "HostTest.h"
+#include "../../src/LPE/Executor/LpExecutor.h"
+#include "../../src/LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "../../src/LPE/StateBuilder/LpJsonOptimiser.h"
+#include "../../src/LPE/StateBuilder/JsonInstructionBuilderFactory.h"
+
+using namespace LS;
+
+#define		OPTIMISER_TEST_LEDS			60
+#define		OPTIMISER_TEST_FRAMES		3000
+
+// the LP engine is large so it is kept off the stack
+static LEDConfig ledConfig;
+static StringProcessor stringProcessor;
+static LpiExecutorFactory lpiExecutorFactory;
+static JsonInstructionBuilderFactory instructionBuilderFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonOptimiser optimiser(&stringProcessor);
+static LpJsonStateBuilder stateBuilder(&instructionBuilderFactory);
+static LpJsonState state;
+static LpiExecutorOutput lpiExecutorOutput;
+static FixedSizeCharBuffer lpBuffer(BUFFER_LP);
+
+/*!
+	@brief	The frames rendered by a program and the shape of its instruction tree.
+*/
+struct RenderedProgram {
+	bool isBuilt = false;
+	int numberOfInstructions = 0;
+	uint32_t frameLength = 0;
+	std::vector<std::string> frames;
+};
+
+/*!
+	@brief		Counts the instructions of a tree, i.e. the slots that it uses.
+*/
+static int CountInstructions(Instruction* instruction) {
+	int numberOfInstructions = 0;
+	for (; instruction != nullptr; instruction = instruction->getNext()) {
+		numberOfInstructions++;
+		if (instruction->getInstructionType() == InstructionType::Repeat) {
+			numberOfInstructions += CountInstructions(((InstructionWithChild*)instruction)->getFirstChild());
+		}
+	}
+
+	return numberOfInstructions;
+}
+
+/*!
+	@brief		Writes the rendering instructions of a frame onto the LEDs.
+*/
+static void RenderFrame(LpiExecutorOutput* output, uint8_t* pixels) {
+	if (!output->RenderingInstructionsSet()) {
+		return;
+	}
+
+	RI* renderingInstructions = output->GetRenderingInstructions();
+	uint16_t numberOfInstructions = output->GetNumberOfRenderingInstructions();
+	int ledIndex = 0;
+	do {
+		for (uint16_t riIndex = 0; riIndex < numberOfInstructions && ledIndex < OPTIMISER_TEST_LEDS; riIndex++) {
+			for (uint16_t n = 0; n < renderingInstructions[riIndex].number && ledIndex < OPTIMISER_TEST_LEDS; n++) {
+				pixels[ledIndex * 3] = renderingInstructions[riIndex].colour.red;
+				pixels[ledIndex * 3 + 1] = renderingInstructions[riIndex].colour.green;
+				pixels[ledIndex * 3 + 2] = renderingInstructions[riIndex].colour.blue;
+				ledIndex++;
+			}
+		}
+	} while (output->GetRepeatRenderingInstructions() && numberOfInstructions > 0 && ledIndex < OPTIMISER_TEST_LEDS);
+}
+
+/*!
+	@brief		Builds and runs a program, with or without the optimiser, and
+				keeps the LEDs shown on each frame.
+*/
+static RenderedProgram RenderProgram(const std::string& program, bool optimise) {
+	RenderedProgram rendered;
+	stateBuilder.SetOptimiser(optimise ? &optimiser : nullptr);
+	lpBuffer.ClearBuffer();
+	lpBuffer.LoadFromBuffer(program.c_str());
+	rendered.isBuilt = stateBuilder.BuildState(&lpBuffer, &state);
+	if (!rendered.isBuilt) {
+		return rendered;
+	}
+
+	rendered.numberOfInstructions = CountInstructions(state.getFirstInstruction());
+	for (Instruction* instruction = state.getFirstInstruction(); instruction != nullptr; instruction = instruction->getNext()) {
+		rendered.frameLength = LpJsonStateBuilder::AddFrameLength(rendered.frameLength, instruction->GetFrameLength());
+	}
+
+	// the same random colours are chosen on both runs
+	srand(7);
+	LpExecutor executor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+	uint8_t pixels[OPTIMISER_TEST_LEDS * 3] = {};
+	for (int frame = 0; frame < OPTIMISER_TEST_FRAMES; frame++) {
+		executor.Execute(&state, &lpiExecutorOutput);
+		RenderFrame(&lpiExecutorOutput, pixels);
+		rendered.frames.push_back(std::string((char*)pixels, sizeof(pixels)));
+	}
+
+	return rendered;
+}
+
+/*!
+	@brief		Checks that a program renders the same frames, and has the same
+				length, with and without the optimiser.
+	@returns	The number of instructions that the optimiser folded away.
+*/
+static int CheckFramesAreIdentical(const std::string& name, const std::string& program) {
+	RenderedProgram original = RenderProgram(program, false);
+	RenderedProgram optimised = RenderProgram(program, true);
+
+	size_t differentFrame = 0;
+	while (differentFrame < original.frames.size()
+		&& differentFrame < optimised.frames.size()
+		&& original.frames[differentFrame] == optimised.frames[differentFrame]) {
+		differentFrame++;
+	}
+
+	printf("%-40s instructions %3d -> %3d, frames %s\n",
+		name.c_str(), original.numberOfInstructions, optimised.numberOfInstructions,
+		differentFrame == original.frames.size() ? "identical" : "DIFFERENT");
+	CHECK(original.isBuilt && optimised.isBuilt);
+	CHECK(optimised.numberOfInstructions <= original.numberOfInstructions);
+	CHECK(optimised.frameLength == original.frameLength);
+	CHECK(original.frames.size() == OPTIMISER_TEST_FRAMES);
+	CHECK(differentFrame == original.frames.size());
+
+	return original.numberOfInstructions - optimised.numberOfInstructions;
+}
+
+/*!
+	@brief		Every program of the corpus renders the same frames once optimised.
+				The traffic lights program is written as an editor writes programs
+				so it is folded by each of the optimisations.
+*/
+static void CorpusFramesAreIdentical() {
+	std::filesystem::path programsFolder = std::filesystem::path(__FILE__).parent_path() / ".." / "Programs";
+	int numberOfPrograms = 0;
+	int foldedInstructions = -1;
+
+	for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(programsFolder)) {
+		if (entry.path().extension() != ".ldl") {
+			continue;
+		}
+
+		std::ifstream programFile(entry.path());
+		std::stringstream program;
+		program << programFile.rdbuf();
+		int folded = CheckFramesAreIdentical(entry.path().filename().string(), program.str());
+		if (entry.path().filename() == "Editor - Traffic Lights.ldl") {
+			foldedInstructions = folded;
+		}
+		numberOfPrograms++;
+	}
+
+	CHECK(numberOfPrograms > 0);
+	// a single iteration repeat, a merged LPI and a held repeat: 8 -> 5 instructions
+	CHECK(foldedInstructions == 3);
+}
+
+/*!
+	@brief		A repeat with a single iteration is replaced by its instructions and
+				a repeat with several iterations is not.
+*/
+static void SingleIterationRepeatsAreFlattened() {
+	CHECK(CheckFramesAreIdentical("single iteration",
+		"{\"name\":\"s\",\"instructions\":[\"01050000FF0000\",{\"repeat\":{\"times\":1,\"instructions\":[\"0105000000FF00\",\"010500000000FF\"]}}]}") == 1);
+	CHECK(CheckFramesAreIdentical("two iterations",
+		"{\"name\":\"s\",\"instructions\":[\"01050000FF0000\",{\"repeat\":{\"times\":2,\"instructions\":[\"0105000000FF00\",\"010500000000FF\"]}}]}") == 0);
+}
+
+/*!
+	@brief		A finite repeat of a single static LPI becomes the LPI held for all of
+				the iterations, unless that is longer than the longest duration of an
+				LPI, the LPI is animated or the repeat is infinite.
+*/
+static void RepeatsOfAStaticLpiAreHeld() {
+	CHECK(CheckFramesAreIdentical("held",
+		"{\"name\":\"s\",\"instructions\":[{\"repeat\":{\"times\":20,\"instructions\":[\"010A00000000FF\"]}},\"00050000\"]}") == 1);
+	CHECK(CheckFramesAreIdentical("too long to hold",
+		"{\"name\":\"s\",\"instructions\":[{\"repeat\":{\"times\":30,\"instructions\":[\"010A00000000FF\"]}},\"00050000\"]}") == 0);
+	CHECK(CheckFramesAreIdentical("animated LPI not held",
+		"{\"name\":\"s\",\"instructions\":[{\"repeat\":{\"times\":3,\"instructions\":[\"03010000050100000FF0000009900\"]}}]}") == 0);
+	CHECK(CheckFramesAreIdentical("infinite repeat not held",
+		"{\"name\":\"s\",\"instructions\":[{\"repeat\":{\"times\":0,\"instructions\":[\"01030000FF0000\"]}}]}") == 0);
+}
+
+/*!
+	@brief		A static LPI that follows the same static LPI is merged in to the earlier
+				LPI, up to the longest duration of an LPI.
+*/
+static void SameStaticLpisAreMerged() {
+	CHECK(CheckFramesAreIdentical("merged",
+		"{\"name\":\"s\",\"instructions\":[\"01050000FF0000\",\"010A0000FF0000\",\"01F50000FF0000\"]}") == 1);
+	CHECK(CheckFramesAreIdentical("different colours not merged",
+		"{\"name\":\"s\",\"instructions\":[\"01050000FF0000\",\"0105000000FF00\"]}") == 0);
+}
+
+/*!
+	@brief		Programs that use the optimisations together, nested in repeats, render
+				the same frames once optimised.
+*/
+static void NestedOptimisationsKeepTheFrames() {
+	CHECK(CheckFramesAreIdentical("single iterations and holds",
+		"{\"name\":\"s\",\"instructions\":[\"01020000FF0000\",\"01030000FF0000\",{\"repeat\":{\"times\":1,\"instructions\":[\"01010000FF0000\",{\"repeat\":{\"times\":4,\"instructions\":[\"01050000020000300FF0000\"]}},\"0402000001000000000FF\"]}},{\"repeat\":{\"times\":3,\"instructions\":[{\"repeat\":{\"times\":1,\"instructions\":[\"01010000FFFFFF\",\"01010000FFFFFF\"]}}]}},{\"repeat\":{\"times\":200,\"instructions\":[\"01020000123456\"]}},\"05020000020000FF00FF00\",\"05020000020000FF00FF00\"]}") == 6);
+	CHECK(CheckFramesAreIdentical("infinite repeat",
+		"{\"name\":\"s\",\"instructions\":[{\"repeat\":{\"times\":0,\"instructions\":[{\"repeat\":{\"times\":1,\"instructions\":[\"01030000FF0000\"]}},{\"repeat\":{\"times\":5,\"instructions\":[\"01030000FF0000\"]}},\"00010000\",\"00020000\",{\"repeat\":{\"times\":2,\"instructions\":[\"03010000050100000FF0000009900\"]}}]}}]}") == 4);
+}
+
+int main() {
+	ledConfig.numberOfLEDs = OPTIMISER_TEST_LEDS;
+
+	CorpusFramesAreIdentical();
+	SingleIterationRepeatsAreFlattened();
+	RepeatsOfAStaticLpiAreHeld();
+	SameStaticLpisAreMerged();
+	NestedOptimisationsKeepTheFrames();
+
+	return HostTestResult("LpJsonOptimiserTests");
+}
\ No newline at end of file
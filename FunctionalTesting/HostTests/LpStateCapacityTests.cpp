@@ -0,0 +1,131 @@
+/*!
+ * @file LpStateCapacityTests.cpp
+ *
+ * Host tests that programs are validated against,
+ * and built into, LP states that are smaller than
+ * the LP state of the program (e.g. those of layers).
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include "HostTest.h"
+#include "../../src/LPE/Validation/LpJsonValidator.h"
+#include "../../src/LPE/Validation/JsonInstructionValidatorFactory.h"
+#include "../../src/LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "../../src/LPE/StateBuilder/JsonInstructionBuilderFactory.h"
+
+using namespace LS;
+
+#define		CAPACITY_TEST_DOCUMENT		1000		// JSON document of the small state
+#define		CAPACITY_TEST_LPIS			16			// most LPIs of the small state
+#define		CAPACITY_TEST_REPEATS		4			// most repeats of the small state
+#define		CAPACITY_TEST_CALLS			4			// most calls of the small state
+
+// the LP engine is large so it is kept off the stack
+static LEDConfig ledConfig;
+static StringProcessor stringProcessor;
+static LpiExecutorFactory lpiExecutorFactory;
+static JsonInstructionValidatorFactory validatorFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonValidator validator(&validatorFactory);
+static JsonInstructionBuilderFactory instructionBuilderFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonStateBuilder stateBuilder(&instructionBuilderFactory);
+static LpJsonState smallState(CAPACITY_TEST_DOCUMENT, CAPACITY_TEST_LPIS, CAPACITY_TEST_REPEATS, CAPACITY_TEST_CALLS);
+static FixedSizeCharBuffer lpBuffer(BUFFER_LP);
+static LPValidateResult validateResult;
+
+/*!
+	@brief		Loads a program of distinct solid LPIs (none of which can be shared).
+*/
+static void LoadSolidsProgram(uint8_t numberOfLpis) {
+	char program[BUFFER_LP];
+	int length = snprintf(program, sizeof(program), "{\"name\":\"solids\",\"instructions\":[");
+	for (uint8_t lpiIndex = 0; lpiIndex < numberOfLpis; lpiIndex++) {
+		length += snprintf(program + length, sizeof(program) - length, "%s\"0101000000%04X\"", lpiIndex == 0 ? "" : ",", lpiIndex);
+	}
+	snprintf(program + length, sizeof(program) - length, "]}");
+
+	lpBuffer.ClearBuffer();
+	lpBuffer.LoadFromBuffer(program);
+}
+
+/*!
+	@brief		The capacities given to a state are those it reports.
+*/
+static void StatesHaveTheirCapacities() {
+	LpJsonState defaultState;
+
+	CHECK(defaultState.GetMaxLpInstructions() == MAX_LPINSTRUCTIONS);
+	CHECK(defaultState.GetMaxRepeatInstructions() == MAX_REPEATINSTRUCTIONS);
+	CHECK(defaultState.GetMaxCallInstructions() == MAX_CALLINSTRUCTIONS);
+	CHECK(defaultState.getLpJsonDoc()->capacity() >= BUFFER_LP);
+	CHECK(smallState.GetMaxLpInstructions() == CAPACITY_TEST_LPIS);
+	CHECK(smallState.GetMaxRepeatInstructions() == CAPACITY_TEST_REPEATS);
+	CHECK(smallState.GetMaxCallInstructions() == CAPACITY_TEST_CALLS);
+	CHECK(smallState.getLpJsonDoc()->capacity() >= CAPACITY_TEST_DOCUMENT);
+}
+
+/*!
+	@brief		A program is too big for a state that cannot hold its LPIs, even though
+				it fits in the state of the program.
+*/
+static void TooManyLpisForTheState() {
+	LoadSolidsProgram(CAPACITY_TEST_LPIS + 1);
+
+	validator.ValidateLp(&lpBuffer, &validateResult);
+	CHECK(validateResult.GetCode() == LPValidateCode::Valid);
+
+	validator.ValidateLp(&lpBuffer, &validateResult, &smallState);
+	CHECK(validateResult.GetCode() == LPValidateCode::ProgramTooBig);
+}
+
+/*!
+	@brief		A program is too big for a state whose JSON document cannot hold it.
+*/
+static void TooBigForTheDocumentOfTheState() {
+	char program[BUFFER_LP];
+	int length = snprintf(program, sizeof(program), "{\"name\":\"long name ");
+	for (int nameIndex = 0; nameIndex < CAPACITY_TEST_DOCUMENT; nameIndex++) {
+		program[length++] = 'x';
+	}
+	snprintf(program + length, sizeof(program) - length, "\",\"instructions\":[\"01010000FF0000\"]}");
+	lpBuffer.ClearBuffer();
+	lpBuffer.LoadFromBuffer(program);
+
+	validator.ValidateLp(&lpBuffer, &validateResult);
+	CHECK(validateResult.GetCode() == LPValidateCode::Valid);
+
+	validator.ValidateLp(&lpBuffer, &validateResult, &smallState);
+	CHECK(validateResult.GetCode() == LPValidateCode::ProgramTooBig);
+}
+
+/*!
+	@brief		A program that fits in the state is valid and is built into it.
+*/
+static void ProgramThatFitsIsBuilt() {
+	LoadSolidsProgram(CAPACITY_TEST_LPIS);
+
+	validator.ValidateLp(&lpBuffer, &validateResult, &smallState);
+	CHECK(validateResult.GetCode() == LPValidateCode::Valid);
+	CHECK(stateBuilder.BuildState(&lpBuffer, &smallState));
+
+	int numberOfLpis = 0;
+	for (Instruction* instruction = smallState.getFirstInstruction(); instruction != nullptr; instruction = instruction->getNext()) {
+		numberOfLpis++;
+	}
+	CHECK(numberOfLpis == CAPACITY_TEST_LPIS);
+}
+
+int main() {
+	ledConfig.numberOfLEDs = 60;
+
+	StatesHaveTheirCapacities();
+	TooManyLpisForTheState();
+	TooBigForTheDocumentOfTheState();
+	ProgramThatFitsIsBuilt();
+
+	return HostTestResult("LpStateCapacityTests");
+}
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*!
+ * @file LpStatePatcherTests.cpp
+ *
+ * Host tests of changing the LPIs of the loaded
+ * program in place, in particular LPIs that refer
+ * to the colours of the palette of the program.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#include <string.h>
+#include "HostTest.h"
+#include "../../src/LPE/Executor/LpExecutor.h"
+#include "../../src/LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "../../src/LPE/StateBuilder/LpStatePatcher.h"
+#include "../../src/LPE/StateBuilder/JsonInstructionBuilderFactory.h"
+
+using namespace LS;
+
+#define		PATCH_TEST_PROGRAM		"{\"name\":\"patch test\",\"palette\":[\"FF0000\",\"33CC00\"],\"instructions\":["	\
+									"\"01020000*1\",\"0103000000FF00\",{\"repeat\":{\"times\":2,\"instructions\":["	\
+									"\"01010000*0\",\"01010000FFFFFF\"]}}]}"
+
+// the LP engine is large so it is kept off the stack
+static LEDConfig ledConfig;
+static StringProcessor stringProcessor;
+static LpiExecutorFactory lpiExecutorFactory;
+static JsonInstructionBuilderFactory instructionBuilderFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonStateBuilder stateBuilder(&instructionBuilderFactory);
+static LpStatePatcher statePatcher(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+static LpJsonState state;
+static LpiExecutorOutput lpiExecutorOutput;
+static FixedSizeCharBuffer lpBuffer(BUFFER_LP);
+
+/*!
+	@brief		Loads the program that the patches are made to.
+*/
+static bool LoadProgram() {
+	lpBuffer.ClearBuffer();
+	lpBuffer.LoadFromBuffer(PATCH_TEST_PROGRAM);
+
+	return stateBuilder.BuildState(&lpBuffer, &state)
+		&& !state.IsOptimised();
+}
+
+/*!
+	@brief		Gets the colour of the first frame of the program as it is now.
+*/
+static uint32_t GetFirstColour() {
+	state.SetFrame(0);
+	LpExecutor executor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+	executor.Execute(&state, &lpiExecutorOutput);
+	if (!lpiExecutorOutput.RenderingInstructionsSet()) {
+		return 0xFFFFFFFF;
+	}
+
+	Colour colour = lpiExecutorOutput.GetRenderingInstructions()[0].colour;
+	return ((uint32_t)colour.red << 16) | ((uint32_t)colour.green << 8) | colour.blue;
+}
+
+/*!
+	@brief		An LPI that refers to colours of the palette can replace an LPI and
+				is executed with the colours of the palette.
+*/
+static void LpiWithColourReferencesReplacesLpi() {
+	CHECK(LoadProgram());
+	CHECK(GetFirstColour() == 0x33CC00);
+
+	LpPatch patch;
+	patch.path = "0";
+	patch.lpi = "01050000*0";
+	CHECK(statePatcher.Patch(&state, &patch));
+	CHECK(strcmp(((LpInstruction*)state.getFirstInstruction())->getLpi(), "01050000*0") == 0);
+	CHECK(((LpInstruction*)state.getFirstInstruction())->GetFrameLength() == 5);
+	CHECK(GetFirstColour() == 0xFF0000);
+
+	// an LPI without colour references can still replace one with them
+	patch.lpi = "0101000000FF00";
+	CHECK(statePatcher.Patch(&state, &patch));
+	CHECK(GetFirstColour() == 0x00FF00);
+}
+
+/*!
+	@brief		The duration of an LPI that refers to colours of the palette can be
+				changed, as can the characters of the LPI e.g. the colour reference.
+*/
+static void LpiWithColourReferencesIsChanged() {
+	CHECK(LoadProgram());
+
+	LpPatch durationPatch;
+	durationPatch.path = "2.0";
+	durationPatch.duration = 4;
+	CHECK(statePatcher.Patch(&state, &durationPatch));
+	Instruction* repeat = state.getFirstInstruction()->getNext()->getNext();
+	LpInstruction* lpInstruction = (LpInstruction*)((InstructionWithChild*)repeat)->getFirstChild();
+	CHECK(strcmp(lpInstruction->getLpi(), "01040000*0") == 0);
+	CHECK(repeat->GetFrameLength() == 2 * (4 + 1));
+
+	LpPatch hexPatch;
+	hexPatch.path = "0";
+	hexPatch.at = 8;
+	hexPatch.hex = "*0";
+	CHECK(statePatcher.Patch(&state, &hexPatch));
+	CHECK(GetFirstColour() == 0xFF0000);
+}
+
+/*!
+	@brief		A colour reference that is not valid is refused and nothing is
+				changed; a reference to a colour the palette does not have is black.
+*/
+static void InvalidColourReferencesAreRefused() {
+	CHECK(LoadProgram());
+
+	LpPatch patch;
+	patch.path = "0";
+	patch.lpi = "01050000*G";
+	CHECK(!statePatcher.Patch(&state, &patch));
+	patch.lpi = "01050000*";
+	CHECK(!statePatcher.Patch(&state, &patch));
+	CHECK(strcmp(((LpInstruction*)state.getFirstInstruction())->getLpi(), "01020000*1") == 0);
+	CHECK(GetFirstColour() == 0x33CC00);
+
+	patch.lpi = "01050000*5";
+	CHECK(statePatcher.Patch(&state, &patch));
+	CHECK(GetFirstColour() == 0x000000);
+}
+
+int main() {
+	ledConfig.numberOfLEDs = 60;
+
+	LpiWithColourReferencesReplacesLpi();
+	LpiWithColourReferencesIsChanged();
+	InvalidColourReferencesAreRefused();
+
+	return HostTestResult("LpStatePatcherTests");
+}
\ No newline at end of file
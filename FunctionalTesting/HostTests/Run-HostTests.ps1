@@ -0,0 +1,70 @@
+<#
+    .Description
+    Builds and runs the host tests of the LS library.  Each *Tests.cpp
+    file in this folder is compiled together with the library sources
+    that do not depend on the board (the LPE, the string and buffer
+    helpers, the timer and frame governor, the pixel renderers and the
+    networking classes that only use IUdpService) and then run.  The
+    tests are built with the Visual Studio compiler so this script must
+    be run from a Developer PowerShell (where cl.exe is on the path).
+    Kevin White
+    19 Oct 2026
+
+    .Example
+    # build and run all of the host tests
+    & "$PSScriptRoot\Run-HostTests.ps1"
+
+    # build and run a single host test
+    & "$PSScriptRoot\Run-HostTests.ps1" -Filter "FrameClockSyncTests.cpp"
+#>
+param(
+    [string]$Filter = "*Tests.cpp"
+)
+
+$srcFolder = Resolve-Path "$PSScriptRoot\..\..\src"
+$outFolder = "$PSScriptRoot\bin"
+
+$librarySources = @(Get-ChildItem -Path "$srcFolder\LPE" -Filter "*.cpp" -Recurse | ForEach-Object { $_.FullName })
+$librarySources += "$srcFolder\StringProcessor.cpp"
+$librarySources += "$srcFolder\FixedSizeCharBuffer.cpp"
+$librarySources += "$srcFolder\Orchastrator\FrameGovernor.cpp"
+$librarySources += "$srcFolder\Orchastrator\Timer.cpp"
+$librarySources += "$srcFolder\Networking\FrameClockSync.cpp"
+$librarySources += "$srcFolder\Networking\FanOutPacket.cpp"
+$librarySources += "$srcFolder\Networking\FanOutReceiver.cpp"
+$librarySources += "$srcFolder\Networking\DdpReceiver.cpp"
+$librarySources += "$srcFolder\Renderer\PixelRenderer.cpp"
+$librarySources += "$srcFolder\Renderer\FanOutPixelRenderer.cpp"
+
+New-Item -ItemType Directory -Force -Path $outFolder | Out-Null
+
+$failedTests = 0
+Get-ChildItem -Path $PSScriptRoot -Filter $Filter | ForEach-Object {
+    $testName = $_.BaseName
+    $testExe = "$outFolder\$testName.exe"
+
+    Write-Host "Building $testName..." -ForegroundColor Green
+    Push-Location $outFolder
+    & cl.exe /nologo /EHsc /std:c++17 /W3 "/Fe$testExe" $_.FullName $librarySources | Out-Null
+    $buildResult = $LASTEXITCODE
+    Pop-Location
+    if($buildResult -ne 0) {
+        Write-Host "...$testName did not build" -ForegroundColor Red
+        $failedTests++
+        return
+    }
+
+    & $testExe
+    if($LASTEXITCODE -ne 0) {
+        Write-Host "...$testName failed" -ForegroundColor Red
+        $failedTests++
+    }
+}
+
+if($failedTests -eq 0) {
+    Write-Host "All host tests passed" -ForegroundColor Green
+} else {
+    Write-Host "$failedTests host test(s) failed" -ForegroundColor Red
+}
+
+exit $failedTests
@@ -0,0 +1,138 @@
+/*!
+ * @file SimulatedBoard.h
+ *
+ * Stand-ins for the parts of a board that host
+ * tests of the networking classes need: a timer
+ * driven by a simulated clock, an orchastrator
+ * that only keeps count of the frames shown and
+ * LEDs that are held in memory.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _SimulatedBoard_h
+#define _SimulatedBoard_h
+
+#include <stdint.h>
+#include <vector>
+#include "../../src/DomainInterfaces.h"
+#include "../../src/Orchastrator/Timer.h"
+#include "../../src/Orchastrator/IOrchastor.h"
+
+namespace LS {
+	/*!
+		@brief	Timer whose clock is the simulated time of the test (in ms)
+				scaled by the rate of the board's clock and offset by the time
+				at which the board was started, so that the clocks of several
+				boards can drift apart as real clocks do.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class SimulatedTimer : public Timer {
+	private:
+		double* simulatedTime;
+		double rate;
+		double offset;
+
+	protected:
+		uint32_t GetCurrent() {
+			return (uint32_t)(*simulatedTime * rate + offset);
+		}
+
+	public:
+		SimulatedTimer(double* simulatedTime, uint8_t interval, double rate, double offset)
+			: Timer(interval) {
+			this->simulatedTime = simulatedTime;
+			this->rate = rate;
+			this->offset = offset;
+			nextTime = GetCurrent() + interval;
+		}
+	};
+
+	/*!
+		@brief	Orchastrator that plays no program: it counts the frames
+				shown and records the requests made of it.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class SimulatedOrchastor : public IOrchastor {
+	public:
+		uint32_t frame = 0;
+		uint32_t seeks = 0;
+		uint32_t preempts = 0;
+		uint32_t resumes = 0;
+		bool isPreempted = false;
+
+		void StopPrograms() {}
+		bool SeekProgram(uint32_t frame) {
+			this->frame = frame;
+			seeks++;
+			return true;
+		}
+		uint32_t GetProgramFrame() { return frame; }
+		void PreemptPrograms() {
+			isPreempted = true;
+			preempts++;
+		}
+		void ResumePrograms() {
+			isPreempted = false;
+			resumes++;
+		}
+		bool SetLayerBlend(uint8_t /*layer*/, BlendMode /*blendMode*/, uint8_t /*alpha*/) { return false; }
+		bool StopLayer(uint8_t /*layer*/) { return false; }
+		bool StopSegment(uint8_t /*segment*/) { return false; }
+		void StopSegments() {}
+
+		void Start() {}
+		void Stop() {}
+		bool Execute(bool /*isInSetupMode*/) { return false; }
+	};
+
+	/*!
+		@brief	LEDs held in memory.  The colours that have been set are
+				copied to the colours shown each time the LEDs are shown.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class SimulatedPixels : public IPixelController {
+	public:
+		std::vector<uint32_t> pixels;
+		std::vector<uint32_t> shown;
+		uint32_t shows = 0;
+		uint32_t outOfRange = 0;			// colours set for LEDs that are not attached
+
+		SimulatedPixels(uint16_t numberOfPixels)
+			: pixels(numberOfPixels, 0), shown(numberOfPixels, 0) {
+		}
+
+		void setPixelColor(uint16_t n, uint8_t r, uint8_t g, uint8_t b) {
+			if (n >= pixels.size()) {
+				outOfRange++;
+				return;
+			}
+
+			pixels[n] = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b;
+		}
+		void show() {
+			shown = pixels;
+			shows++;
+		}
+		void fill(uint32_t c = 0, uint16_t first = 0, uint16_t count = 0) {
+			for (size_t n = first; n < pixels.size() && (count == 0 || n < (size_t)first + count); n++) {
+				pixels[n] = c;
+			}
+		}
+		uint16_t numPixels(void) const { return (uint16_t)pixels.size(); }
+		uint32_t getPixelColor(uint16_t n) const { return n < pixels.size() ? pixels[n] : 0; }
+		void updateLength(uint16_t n) {
+			pixels.assign(n, 0);
+			shown.assign(n, 0);
+		}
+	};
+}
+
+#endif
\ No newline at end of file
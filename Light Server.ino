@@ -11,29 +11,68 @@
 
 
  Buffer Allocations (*** BUFFER ALLOCATION ***)
+	RAM (bytes) taken by the objects of the Light Server, both static and on the heap.  These are the
+	sizes of the objects on a 32-bit build (as the SAMD21) of the same sources; they are not from a link
+	map, as no ARM toolchain was available when they were taken, so check the "Global variables use"
+	figure of the Arduino build (which does not include the heap).  The WiFiNINA, web server and WiFi
+	manager libraries, the Arduino core and the stack are not included and need the rest of the 32768.
+
 	--- WEB BUFFERS ---
-	4000: *** BUFFER ALLOCATION *** - Web receiving buffer
-	200:  *** BUFFER ALLOCATION *** - Web response buffer
-	200:  *** BUFFER ALLOCATION *** - Web response JSON document buffer
-	100:  *** BUFFER ALLOCATION *** - Web response info buffer
+	3500: *** BUFFER ALLOCATION *** - Web receiving buffer
+	150:  *** BUFFER ALLOCATION *** - Web response buffer
+	184:  *** BUFFER ALLOCATION *** - Web response JSON document buffer
+	150:  *** BUFFER ALLOCATION *** - UDP discovery response
+	----
+	3984
+
+	--- LP ENGINE ---
+	6196: *** BUFFER ALLOCATION *** - Store an entire LP state (3500 JSON document and the tree structure)
+	4236: LP validator (3500 JSON document of an entire LP program requiring validation)
+	2292: Orchastrator (2116 of the frame rendered)
+	2070: LED configuration (including the stored program)
+	672:  LP state builder
+	488:  LP executor (400 individual LPI loading buffer)
+	972:  Instruction builders and validators (2 x 400 individual LPI buffers)
+	860:  LP state patcher (2 x 400 individual LPI buffers)
+	108:  Factories, optimiser and frame governor
 	----
-	4500
+	17894
+
+	--- COMMANDS & NETWORKING ---
+	452:  Commands, command factory and web server
+	572:  UDP command channel (256 command body)
+	128:  DDP receiver
+	72:   Frame clock sync
+	16:   Pixel renderer
+	----
+	1240
 
-	--- INDIVIDUAL LPIs ---
-	500:  *** BUFFER ALLOCATION *** - Individual LPI loading buffer
-	500:  *** BUFFER ALLOCATION *** - Individual LPI for validation
-	500:  *** BUFFER ALLOCATION *** - Individual LPI building
+	--- PIXELS ---
+	1050: NeoPixel pixels (3 x 350 LEDs)
+	----
+	1050
+
+	--- FEATURES (defined by default) ---
+	680:  FEATURE_LOOKAHEAD - Frames rendered ahead of the display clock
+	1408: FEATURE_TRANSITIONS - The frame that LPIs with a transition fade in from (350 LEDs)
+	2248: FEATURE_SEGMENTS - Store the LP states of the 2 segment programs (600 JSON document, 8 LPIs, 2 repeats and 2 calls each)
+	976:  FEATURE_SEGMENTS - Executors of the 2 segment programs
+	104:  FEATURE_SEGMENTS - Segment commands
 	----
-	1500
+	5416
 
-	--- ENTIRE LPs ---
-	4000: *** BUFFER ALLOCATION *** - An entire LP program requiring validation
-	4000: *** BUFFER ALLOCATION *** - Store an entire LP state
-	xxxx: *** BUFFER ALLOCATION *** - Store a tree structure of a entire LP state
+ TOTAL: 29584
+
+	--- FEATURES (not defined by default) ---
+	1556: FEATURE_FRAME_CACHE - Frames of infinite repeats
+	1076: FEATURE_PROFILER - Time spent on each LPI
+	1080: FEATURE_QUEUE - LPIs queued to play after the program
+	1812: FEATURE_LAYERS - Store the LP state of the layer (1000 JSON document, 16 LPIs, 4 repeats and 4 calls)
+	5492: FEATURE_LAYERS - Executor and last frame of the layer and compositing of the pixels (2 x 350 LEDs)
 	----
-	8000+
+	11016
 
- TOTAL: 14000
+ TOTAL (all features): 40600 - more than the MKR1010 has, so choose the features that are needed
 
 
  IMPORTANT INFORMATION:-
@@ -78,6 +117,29 @@ UPDATE 17/08/2021: Simply define DEBUG_MODE to enable serial output or commect o
 // #define		NUMLEDS							50			// default number of connected LEDs if no configurtion values
 #define		NUMLEDS							350			// default number of connected LEDs if no configurtion values
 #define		RENDERING_FRAME					25			// rendering frame duration in milliseconds
+#define		FRAME_BUDGET					25			// cycles taking longer (ms) cause the frame governor to slow rendering
+#define		MAX_RENDERING_FRAME				100			// slowest rendering frame duration (ms) the frame governor will use
+
+/* Optional features: each takes RAM (see the Buffer Allocations above) so only define those that are used */
+#define		FEATURE_LOOKAHEAD							// render frames ahead of the display clock
+// #define		FEATURE_FRAME_CACHE							// replay the frames of infinite repeats from a cache
+#define		FEATURE_TRANSITIONS							// crossfade from one LPI to the next
+// #define		FEATURE_PROFILER							// attribute the time spent to each LPI (profile API)
+// #define		FEATURE_QUEUE								// queue LPIs to play after the program (queue API)
+// #define		FEATURE_LAYERS								// composite a program over the program (layer API)
+#define		FEATURE_SEGMENTS							// play programs on segments of the LEDs (segment API)
+
+/* The program of the layer is smaller than the program so that the layer takes less RAM */
+#define		LAYER_LP_SIZE					1000		// JSON document of the program of the layer (bytes)
+#define		LAYER_LPIS						16			// most LPIs of the program of the layer
+#define		LAYER_REPEATS					4			// most repeats of the program of the layer
+#define		LAYER_CALLS						4			// most calls of the program of the layer
+
+/* The programs of the segments are smaller still so that two segments can play programs by default */
+#define		SEGMENT_LP_SIZE					600			// JSON document of the program of a segment (bytes)
+#define		SEGMENT_LPIS					8			// most LPIs of the program of a segment
+#define		SEGMENT_REPEATS					2			// most repeats of the program of a segment
+#define		SEGMENT_CALLS					2			// most calls of the program of a segment
 
 #define		LS_VERSION						"1.0.1"		// Light-server version
 #define		LDL_VERSION						"1.0.0"		// Light-definition language version
@@ -87,6 +149,13 @@ UPDATE 17/08/2021: Simply define DEBUG_MODE to enable serial output or commect o
 
 #define		DISCOVERY_HANDSHAKE_MSG			"LDL-HOLA?"
 #define		DISCOVERY_PORT					8888
+#define		SYNC_PORT						8889		// port on which frame clock beacons are broadcast
+#define		COMMAND_PORT					8891		// port on which authenticated commands are received over UDP
+#define		DDP_PORT						4048		// port on which pixels are streamed to the server using DDP
+#define		FAN_OUT_PORT					8890		// port on which a fan-out master sends followers their segments
+// #define		FAN_OUT_MASTER							// define to run the program for a strip spread over several servers
+// #define		FAN_OUT_FOLLOWER						// define to render the segments sent by a fan-out master
+#define		FAN_OUT_LOCAL_LEDS				100			// LEDs attached to a fan-out master (the start of the logical strip)
 // The following is the response that is sent to a UDP discovery request.  The "name"
 // value is the device name.  It is intented that this be a user-friendly set of 2-3 words proceeded by LDL-
 // e.g. LDL-BlueMelon, LDL-RedApple, LDL-GreenPear.  An enhancement here would be to allow
@@ -94,6 +163,7 @@ UPDATE 17/08/2021: Simply define DEBUG_MODE to enable serial output or commect o
 const char DISCOVERY_FOUND_MSG[] PROGMEM = "{ \"server\" : \"1.0.1\", \"name\" : \"LDL-Window\" }";
 char discoveryResponse[BUFFER_JSON_RESPONSE_SIZE];
 // #define		WEBDUINO_SERIAL_DEBUGGING	2		// define this to see web server debugging output
+#define		WEBDUINO_COMMANDS_COUNT		18		// number of routes that can be registered with the web server
 
 // MKR-Wifi
 #define		MKR1010
@@ -108,15 +178,21 @@ char discoveryResponse[BUFFER_JSON_RESPONSE_SIZE];
 
 // 1. Timer
 #include "src/Orchastrator/ArduinoTimer.h"
+#include "src/Orchastrator/FrameGovernor.h"
 // 2. LpExecutor
 #include "src/LPE/LpiExecutors/LpiExecutorFactory.h"
 #include "src/LPE/Executor/LpExecutor.h"
+#include "src/LPE/Executor/LookaheadFrameBuffer.h"
+#include "src/LPE/Executor/LpFrameCache.h"
+#include "src/LPE/Executor/LpTransitionFrame.h"
+#include "src/LPE/Executor/LpProfiler.h"
 // 3. LpState
 #include "src/LPE/StateBuilder/LpJsonState.h"
 // 4. PixelRenderer
 #include "src/Adafruit_NeoPixel.h"
 #include "src/Adafruit_NeoPixel.h"
 #include "src/Renderer/PixelRenderer.h"
+#include "src/Renderer/LayerCompositor.h"
 // 5. LightWebServer
 #include "src/FixedSizeCharBuffer.h"
 #include "src/LightWebServer.h"
@@ -126,6 +202,9 @@ char discoveryResponse[BUFFER_JSON_RESPONSE_SIZE];
 #include "src/LPE/Validation/LpJsonValidator.h"
 #include "src/LPE/StateBuilder/JsonInstructionBuilderFactory.h"
 #include "src/LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "src/LPE/StateBuilder/LpJsonOptimiser.h"
+#include "src/LPE/StateBuilder/LpStatePatcher.h"
+#include "src/LPE/StateBuilder/LpiQueue.h"
 #include "src/Commands/CommandFactory.h"
 #include "src/AppLogger.h"
 #include "src/Orchastrator/LightServerOrchastrator.h"
@@ -134,10 +213,21 @@ char discoveryResponse[BUFFER_JSON_RESPONSE_SIZE];
 #include "src/Commands/InvalidCommand.h"
 #include "src/Commands/LoadProgramCommand.h"
 #include "src/Commands/LoadProgramAndStoreCommand.h"
+#include "src/Commands/LoadLayerCommand.h"
+#include "src/Commands/LoadSegmentCommand.h"
+#include "src/Commands/SetSegmentsCommand.h"
 #include "src/Commands/PowerOffCommand.h"
 #include "src/Commands/PowerOnCommand.h"
 #include "src/Commands/CheckPowerCommand.h"
 #include "src/Commands/GetAboutCommand.h"
+#include "src/Commands/GetStatusCommand.h"
+#include "src/Commands/ProfileCommand.h"
+#include "src/Commands/SeekCommand.h"
+#include "src/Commands/PatchProgramCommand.h"
+#include "src/Commands/QueueProgramCommand.h"
+#include "src/Commands/SyncCommand.h"
+#include "src/Commands/BatchCommand.h"
+#include "src/Commands/BatchResponseCollector.h"
 #include "src/ConfigPersistance/IConfigPersistance.h"
 #include "src/ConfigPersistance/FlashConfigPersistance.h"
 #include "src/Commands/SetLedsCommand.h"
@@ -145,6 +235,11 @@ char discoveryResponse[BUFFER_JSON_RESPONSE_SIZE];
 // 8. Networking
 #include "src/Networking/EthernetUdpService.h"
 #include "src/Networking/EthernetUdpDiscoveryService.h"
+#include "src/Networking/FrameClockSync.h"
+#include "src/Networking/FanOutReceiver.h"
+#include "src/Networking/DdpReceiver.h"
+#include "src/Networking/UdpCommandChannel.h"
+#include "src/Renderer/FanOutPixelRenderer.h"
 
 // Utiltiy functions
 #include "UtilityFunctions.h"
@@ -155,23 +250,71 @@ WiFiNINA_Configuration myConfig;
 // Instantiate dependencies required by LightServerOrchastrator
 // 1. Timer: for determining when the next instruction should be rendered
 LS::ArduinoTimer timer(RENDERING_FRAME);
+LS::FrameGovernor frameGovernor(RENDERING_FRAME);
 // 2. LpExecutor: executes Light Program to determine next rendering instruction
 LS::LpiExecutorFactory lpiExecutorFactory = LS::LpiExecutorFactory();
 LS::StringProcessor stringProcessor;
 LS::FlashConfigPersistance configPersistance = LS::FlashConfigPersistance();
 LS::LEDConfig ledConfig = LS::LEDConfig();
 LS::LpExecutor executor = LS::LpExecutor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+#if defined(FEATURE_LOOKAHEAD)
+// *** BUFFER ALLOCATION *** - Frames rendered ahead of the display clock
+LS::LookaheadFrameBuffer lookaheadBuffer;
+#endif
+#if defined(FEATURE_FRAME_CACHE)
+// *** BUFFER ALLOCATION *** - Frames of infinite repeats
+LS::LpFrameCache frameCache;
+#endif
+#if defined(FEATURE_TRANSITIONS)
+// *** BUFFER ALLOCATION *** - The frame that LPIs with a transition fade in from
+LS::LpTransitionFrame transitionFrame;
+#endif
+#if defined(FEATURE_PROFILER)
+LS::LpProfiler profiler(micros);
+#endif
 // 3. LpState: stores the tree representation of a parsed Light Program
 LS::LpJsonState primaryState;
+#if defined(FEATURE_LAYERS)
+// 3a. Layer: a program of its own (e.g. a notification) that is composited over the primary program, with its own
+// LP state, executor and last frame.  There is room for one layer (MAX_LAYERS).
+// *** BUFFER ALLOCATION *** - Store the LP state of the layer
+LS::LpJsonState layerState(LAYER_LP_SIZE, LAYER_LPIS, LAYER_REPEATS, LAYER_CALLS);
+LS::LpExecutor layerExecutor = LS::LpExecutor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+LS::LpiExecutorOutput layerOutput;
+// *** BUFFER ALLOCATION *** - Composite the pixels of the layer over those of the program
+LS::LayerCompositor layerCompositor(&ledConfig);
+#endif
+#if defined(FEATURE_SEGMENTS)
+// 3b. Segments: programs of their own that play on the first two named ranges of the LEDs instead of the primary
+// program, each with its own LP state and executor
+// *** BUFFER ALLOCATION *** - Store the LP states of the segments
+LS::LpJsonState segmentState1(SEGMENT_LP_SIZE, SEGMENT_LPIS, SEGMENT_REPEATS, SEGMENT_CALLS);
+LS::LpExecutor segmentExecutor1 = LS::LpExecutor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+LS::LpJsonState segmentState2(SEGMENT_LP_SIZE, SEGMENT_LPIS, SEGMENT_REPEATS, SEGMENT_CALLS);
+LS::LpExecutor segmentExecutor2 = LS::LpExecutor(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+#endif
 // 4. PixelRenderer: interacts with and activates individual LEDs on the connected hardware
 Adafruit_NeoPixel pixels(NUMLEDS, PIN, NEO_GRB + NEO_KHZ800);
+#if defined(FAN_OUT_MASTER)
+// renders the start of the logical strip and sends the rest to the followers
+LS::EthernetUdpService fanOutUdpService;
+LS::FanOutPixelRenderer renderer = LS::FanOutPixelRenderer(&pixels, &ledConfig, FAN_OUT_LOCAL_LEDS, &fanOutUdpService, FAN_OUT_PORT);
+#else
 LS::PixelRenderer renderer = LS::PixelRenderer(&pixels, &ledConfig);
+#endif
 // 5. ILightServer: receives and executes HTTP commands
 WebServer webserv("", 80);
 LS::IWebServer* webserver = &webserv;
 // *** BUFFER ALLOCATION *** - Web receiving buffer
 LS::FixedSizeCharBuffer webLoadingBuffer = LS::FixedSizeCharBuffer(BUFFER_SIZE);
 LS::LightWebServer lightWebServ(webserver, &webLoadingBuffer, BASIC_AUTH_SUPER);
+// 5a. UdpCommandChannel: receives authenticated commands over UDP as well as the HTTP requests of lightWebServ.
+// Commands respond through the channel so the response goes back to wherever the command came from.
+// NOTE: the key is set in Credentials.h
+LS::EthernetUdpService commandUdpService;
+LS::UdpCommandChannel commandChannel(COMMAND_PORT, &commandUdpService, &lightWebServ, udpCommandKey);
+// 5b. BatchResponseCollector: collects the responses of the commands in a batch into one combined response.
+LS::BatchResponseCollector batchResponses(&commandChannel);
 // 6. CommandFactory: returns command instances for received HTTP commands.  These are then executed.
 LS::CommandFactory commandFactory;
 // ** Orchastrator **
@@ -180,32 +323,70 @@ LS::LightServerOrchastrator orchastrator = LS::LightServerOrchastrator(
 	&executor,
 	&primaryState,
 	&renderer,
-	&lightWebServ,
+	&batchResponses,
 	&commandFactory
 );
 // 7. Individual commands that are added to the command factory
-LS::NoAuthCommand noAuthCommand = LS::NoAuthCommand(&lightWebServ);
-LS::InvalidCommand invalidCommand = LS::InvalidCommand(&lightWebServ);
+LS::NoAuthCommand noAuthCommand = LS::NoAuthCommand(&batchResponses);
+LS::InvalidCommand invalidCommand = LS::InvalidCommand(&batchResponses);
 LS::JsonInstructionValidatorFactory instructionValidatorFactory = LS::JsonInstructionValidatorFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
 LS::LpJsonValidator validator = LS::LpJsonValidator(&instructionValidatorFactory);
 LS::JsonInstructionBuilderFactory instructionBuilderFactory = LS::JsonInstructionBuilderFactory(&lpiExecutorFactory, &stringProcessor, &ledConfig);
 LS::LpJsonStateBuilder stateBuilder = LS::LpJsonStateBuilder(&instructionBuilderFactory);
-LS::LoadProgramCommand loadProgramCommand = LS::LoadProgramCommand(&lightWebServ, &validator, &stateBuilder, &primaryState);
-LS::LoadProgramAndStoreCommand loadProgramAndStoreCommand = LS::LoadProgramAndStoreCommand(&lightWebServ, &validator, &stateBuilder, &primaryState, &ledConfig, &configPersistance);
-LS::PowerOffCommand powerOffCommand = LS::PowerOffCommand(&lightWebServ, &pixels, &orchastrator);
-LS::PowerOnCommand powerOnCommand = LS::PowerOnCommand(&lightWebServ, &pixels, &orchastrator, &stringProcessor);
+LS::LpJsonOptimiser optimiser = LS::LpJsonOptimiser(&stringProcessor);
 // *** BUFFER ALLOCATION *** - Web response JSON document buffer
 StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE> webDoc;
 // ***BUFFER ALLOCATION*** - Web response buffer
 LS::FixedSizeCharBuffer webReponse = LS::FixedSizeCharBuffer(BUFFER_WEB_RESPONSE_SIZE);
-LS::CheckPowerCommand checkPowerCommand = LS::CheckPowerCommand(&lightWebServ, &pixels, &webDoc, &webReponse);
-LS::GetAboutCommand getAboutCommand = LS::GetAboutCommand(&lightWebServ, &webDoc, &webReponse, &ledConfig);
-LS::SetLedsCommand setLedsCommand = LS::SetLedsCommand(&lightWebServ, &stringProcessor, &ledConfig, &configPersistance, &pixels, &primaryState);
+LS::LoadProgramCommand loadProgramCommand = LS::LoadProgramCommand(&batchResponses, &validator, &stateBuilder, &primaryState, &webDoc, &webReponse);
+LS::LoadProgramAndStoreCommand loadProgramAndStoreCommand = LS::LoadProgramAndStoreCommand(&batchResponses, &validator, &stateBuilder, &primaryState, &webDoc, &webReponse, &ledConfig, &configPersistance);
+LS::PowerOffCommand powerOffCommand = LS::PowerOffCommand(&batchResponses, &pixels, &orchastrator);
+LS::PowerOnCommand powerOnCommand = LS::PowerOnCommand(&batchResponses, &pixels, &orchastrator, &stringProcessor);
+LS::CheckPowerCommand checkPowerCommand = LS::CheckPowerCommand(&batchResponses, &pixels, &webDoc, &webReponse);
+LS::GetAboutCommand getAboutCommand = LS::GetAboutCommand(&batchResponses, &webDoc, &webReponse, &ledConfig);
+#if defined(FEATURE_FRAME_CACHE)
+LS::GetStatusCommand getStatusCommand = LS::GetStatusCommand(&batchResponses, &webDoc, &webReponse, &frameGovernor, &frameCache);
+#else
+LS::GetStatusCommand getStatusCommand = LS::GetStatusCommand(&batchResponses, &webDoc, &webReponse, &frameGovernor);
+#endif
+#if defined(FEATURE_PROFILER)
+LS::ProfileCommand profileCommand = LS::ProfileCommand(&batchResponses, &webDoc, &webReponse, &profiler, &primaryState);
+#endif
+LS::SeekCommand seekCommand = LS::SeekCommand(&batchResponses, &webDoc, &orchastrator);
+LS::LpStatePatcher statePatcher = LS::LpStatePatcher(&lpiExecutorFactory, &stringProcessor, &ledConfig);
+LS::PatchProgramCommand patchProgramCommand = LS::PatchProgramCommand(&batchResponses, &webDoc, &statePatcher, &primaryState, &orchastrator);
+#if defined(FEATURE_QUEUE)
+// *** BUFFER ALLOCATION *** - LPIs queued to play after the program
+LS::LpiQueue lpiQueue;
+LS::QueueProgramCommand queueProgramCommand = LS::QueueProgramCommand(&batchResponses, &webDoc, &webReponse, &instructionValidatorFactory, &lpiQueue, &primaryState, &orchastrator);
+#endif
+#if defined(FEATURE_LAYERS)
+LS::LoadLayerCommand loadLayerCommand = LS::LoadLayerCommand(&batchResponses, &validator, &stateBuilder, &webDoc, &webReponse, &orchastrator);
+#endif
+#if defined(FEATURE_SEGMENTS)
+LS::LoadSegmentCommand loadSegmentCommand = LS::LoadSegmentCommand(&batchResponses, &validator, &stateBuilder, &webDoc, &webReponse, &ledConfig, &orchastrator);
+LS::SetSegmentsCommand setSegmentsCommand = LS::SetSegmentsCommand(&batchResponses, &ledConfig, &configPersistance, &orchastrator);
+#endif
+#if defined(FAN_OUT_MASTER)
+LS::SetLedsCommand setLedsCommand = LS::SetLedsCommand(&batchResponses, &stringProcessor, &ledConfig, &configPersistance, &pixels, &primaryState, FAN_OUT_LOCAL_LEDS);
+#else
+LS::SetLedsCommand setLedsCommand = LS::SetLedsCommand(&batchResponses, &stringProcessor, &ledConfig, &configPersistance, &pixels, &primaryState);
+#endif
 
 LS::AppLogger appLogger;
 // 8: Networking: e.g. UDP discovery service
 LS::EthernetUdpService ethernetUdpService;
 LS::EthernetUdpDiscoveryService discoveryService = LS::EthernetUdpDiscoveryService(DISCOVERY_PORT, DISCOVERY_FOUND_MSG, DISCOVERY_HANDSHAKE_MSG, &ethernetUdpService);
+LS::EthernetUdpService syncUdpService;
+LS::FrameClockSync frameSync = LS::FrameClockSync(SYNC_PORT, &syncUdpService, &timer, &orchastrator, &primaryState);
+LS::SyncCommand syncCommand = LS::SyncCommand(&batchResponses, &webDoc, &webReponse, &frameSync);
+LS::BatchCommand batchCommand = LS::BatchCommand(&batchResponses, &commandFactory);
+LS::EthernetUdpService ddpUdpService;
+LS::DdpReceiver ddpReceiver = LS::DdpReceiver(DDP_PORT, &ddpUdpService, &pixels, &orchastrator, &timer);
+#if defined(FAN_OUT_FOLLOWER)
+LS::EthernetUdpService fanOutUdpService;
+LS::FanOutReceiver fanOutReceiver = LS::FanOutReceiver(FAN_OUT_PORT, &fanOutUdpService, &renderer);
+#endif
 
 // WiFiManager_NINA_Lite* WiFiManager_NINA;
 
@@ -218,7 +399,7 @@ button{background-color:blue;color:white;line-height:2.4rem;font-size:1.2rem;wid
 // char udpReply[200];
 
 // Complex XMAS program - this is the default program is no other program has been permanently stored to flash memory
-const char defaultLdlProgram[] PROGMEM = "{\"name\":\"Complexxmastree\",\"instructions\":[{\"repeat\":{\"times\":0,\"instructions\":[{\"repeat\":{\"times\":2,\"instructions\":[\"07010000193C002FF000033CC00\"]}},{\"repeat\":{\"times\":4,\"instructions\":[\"040100000A0000000FF0000\",\"040100000A1FF0000000000\",\"040100000A000000033CC00\",\"040100000A133CC00000000\"]}},{\"repeat\":{\"times\":6,\"instructions\":[\"030100000100F0F33CC00FF0000\",\"030100000110F0F33CC00FF0000\"]}},{\"repeat\":{\"times\":30,\"instructions\":[\"0528000002FF000033CC00\"]}},{\"repeat\":{\"times\":8,\"instructions\":[\"07010000193C003FF000033CC003366FF\"]}},{\"repeat\":{\"times\":10,\"instructions\":[\"030100000100F0FFF000033CC00\",\"030100000110F0FFF000033CC00\"]}},{\"repeat\":{\"times\":10,\"instructions\":[\"030100000100F0FFFFFFF000000\",\"030100000110F0FFFFFFF000000\"]}}]}}]}";
+const char defaultLdlProgram[] PROGMEM = "{\"name\":\"Complexxmastree\",\"palette\":[\"FF0000\",\"33CC00\",\"000000\",\"3366FF\",\"FFFFFF\"],\"instructions\":[{\"repeat\":{\"times\":0,\"instructions\":[{\"repeat\":{\"times\":2,\"instructions\":[\"07010000193C002*0*1\"]}},{\"repeat\":{\"times\":4,\"instructions\":[\"040100000A0*2*0\",\"040100000A1*0*2\",\"040100000A0*2*1\",\"040100000A1*1*2\"]}},{\"repeat\":{\"times\":6,\"instructions\":[\"030100000100F0F*1*0\",\"030100000110F0F*1*0\"]}},{\"repeat\":{\"times\":30,\"instructions\":[\"0528000002*0*1\"]}},{\"repeat\":{\"times\":8,\"instructions\":[\"07010000193C003*0*1*3\"]}},{\"repeat\":{\"times\":10,\"instructions\":[\"030100000100F0F*0*1\",\"030100000110F0F*0*1\"]}},{\"repeat\":{\"times\":10,\"instructions\":[\"030100000100F0F*4*2\",\"030100000110F0F*4*2\"]}}]}}]}";
 
 
 
@@ -260,11 +441,94 @@ void setup() {
 	commandFactory.SetCommand(LS::CommandType::CHECKPOWER, &checkPowerCommand);
 	commandFactory.SetCommand(LS::CommandType::GETABOUT, &getAboutCommand);
 	commandFactory.SetCommand(LS::CommandType::SETLEDS, &setLedsCommand);
+	commandFactory.SetCommand(LS::CommandType::GETSTATUS, &getStatusCommand);
+	commandFactory.SetCommand(LS::CommandType::SEEKPROGRAM, &seekCommand);
+	commandFactory.SetCommand(LS::CommandType::PATCHPROGRAM, &patchProgramCommand);
+	// the commands of features that are not defined are invalid
+#if defined(FEATURE_PROFILER)
+	commandFactory.SetCommand(LS::CommandType::PROFILE, &profileCommand);
+#else
+	commandFactory.SetCommand(LS::CommandType::PROFILE, &invalidCommand);
+#endif
+#if defined(FEATURE_QUEUE)
+	commandFactory.SetCommand(LS::CommandType::QUEUEPROGRAM, &queueProgramCommand);
+#else
+	commandFactory.SetCommand(LS::CommandType::QUEUEPROGRAM, &invalidCommand);
+#endif
+#if defined(FEATURE_LAYERS)
+	commandFactory.SetCommand(LS::CommandType::LOADLAYER, &loadLayerCommand);
+#else
+	commandFactory.SetCommand(LS::CommandType::LOADLAYER, &invalidCommand);
+#endif
+#if defined(FEATURE_SEGMENTS)
+	commandFactory.SetCommand(LS::CommandType::SETSEGMENTS, &setSegmentsCommand);
+	commandFactory.SetCommand(LS::CommandType::LOADSEGMENT, &loadSegmentCommand);
+#else
+	commandFactory.SetCommand(LS::CommandType::SETSEGMENTS, &invalidCommand);
+	commandFactory.SetCommand(LS::CommandType::LOADSEGMENT, &invalidCommand);
+#endif
+	commandFactory.SetCommand(LS::CommandType::SYNC, &syncCommand);
+	commandFactory.SetCommand(LS::CommandType::BATCH, &batchCommand);
 
 
 	// add the app logger class so the orchastrator can log events for debugging purposes
 	orchastrator.SetAppLogger(appLog);
 
+	// slow rendering down when cycles take longer than the frame budget, holding commands
+	// over to a later cycle, rather than letting the frame rate drift uncontrolled
+	LS::FrameGovernorPolicy governorPolicy;
+	governorPolicy.frameBudget = FRAME_BUDGET;
+	governorPolicy.maxInterval = MAX_RENDERING_FRAME;
+	governorPolicy.shedMode = LS::GovernorShedMode::ShedDeferCommands;
+	frameGovernor.SetPolicy(&governorPolicy);
+	orchastrator.SetFrameGovernor(&frameGovernor);
+
+#if defined(FEATURE_LOOKAHEAD)
+	// render frames ahead of the display clock whilst waiting for the next rendering frame
+	// so that expensive frames do not delay the frames that are shown
+	orchastrator.SetLookaheadBuffer(&lookaheadBuffer);
+#endif
+
+#if defined(FEATURE_LAYERS)
+	// composite a layer over the program whilst a program is loaded into the layer (via the layer API)
+	orchastrator.SetLayerCompositor(&layerCompositor);
+	orchastrator.AddLayer(&layerState, &layerExecutor, &layerOutput);
+	loadLayerCommand.AddLayer(&layerState);
+#endif
+
+#if defined(FEATURE_SEGMENTS)
+	// play a program of its own on each of the first two segments of the LEDs whilst a program is loaded
+	// into the segment (via the segment API)
+	orchastrator.AddSegment(&segmentState1, &segmentExecutor1);
+	loadSegmentCommand.AddSegment(&segmentState1);
+	orchastrator.AddSegment(&segmentState2, &segmentExecutor2);
+	loadSegmentCommand.AddSegment(&segmentState2);
+#endif
+
+	// stop rendering, and just poll for commands, whilst nothing can change on the LEDs
+	orchastrator.SetIdleEnabled(true);
+
+#if defined(FEATURE_FRAME_CACHE)
+	// replay the frames of infinite repeats from a cache after their first iteration
+	executor.SetFrameCache(&frameCache);
+#endif
+
+#if defined(FEATURE_TRANSITIONS)
+	// crossfade from one LPI to the next when an LPI has a transition
+	executor.SetTransitionFrame(&transitionFrame);
+#endif
+
+#if defined(FEATURE_PROFILER)
+	// attribute the time spent on each LPI to it (off until enabled via the profile API)
+	executor.SetProfiler(&profiler);
+#endif
+
+	// build programs into fewer instructions (e.g. without repeats of a single iteration)
+	stateBuilder.SetOptimiser(&optimiser);
+
+	// estimate the cost of programs as they are loaded against the time available to render a frame
+	validator.SetFrameBudget((uint32_t)RENDERING_FRAME * 1000);
+
 	// start the pixel renderer
 	pixels.begin();
 
@@ -277,8 +541,31 @@ void setup() {
 	// start listening for incoming UDP packets so the IP address of this server can be discovered
 	discoveryService.StartDiscoveryService();
 
+	// listen for the frame clock beacons of other servers (off until a role is set via the sync API)
+	frameSync.Start();
+
+	// listen for commands sent over UDP; the session id is random so that packets of a previous session cannot be replayed
+	commandChannel.Start(getSessionId());
+
+	// listen for pixels streamed to the server, which take over the LEDs from the program whilst they arrive
+	ddpReceiver.Start();
+
+#if defined(FAN_OUT_MASTER)
+	// send each follower its segment of the logical strip, e.g. LEDs 100-199 and 200-299
+	renderer.Start();
+	renderer.AddFollower({ 192, 168, 1, 51 }, FAN_OUT_LOCAL_LEDS, 100);
+	renderer.AddFollower({ 192, 168, 1, 52 }, FAN_OUT_LOCAL_LEDS + 100, 100);
+#elif defined(FAN_OUT_FOLLOWER)
+	// render the segments sent by the master rather than running a program
+	fanOutReceiver.Start();
+#endif
+
 	// attempt to read the LED configuration from flash - use defaults if no config values or invalid
 	ledConfig = configPersistance.ReadConfig();
+	if (!ledConfig.AreSegmentsValid()) {
+		// segments saved by an earlier version (or for a different number of LEDs) are discarded
+		ledConfig.numberOfSegments = 0;
+	}
 	bool updateLedLength = false;
 	if (ledConfig.numberOfLEDs == 0) {
 		// no # of LEDs saved to config, so this is probably the first time
@@ -305,7 +592,12 @@ void setup() {
 	if (updateLedLength) {
 		pixels.fill(0, 0, 0);
 		pixels.show();
+#if defined(FAN_OUT_MASTER)
+		// the number of LEDs configured is the length of the logical strip
+		pixels.updateLength(ledConfig.numberOfLEDs < FAN_OUT_LOCAL_LEDS ? ledConfig.numberOfLEDs : FAN_OUT_LOCAL_LEDS);
+#else
 		pixels.updateLength(ledConfig.numberOfLEDs);
+#endif
 	}
 
 	// Re-load the last loaded program or otherwise use a default program if nothing has yet been persisted to flash
@@ -313,8 +605,10 @@ void setup() {
 	if (ledConfig.storedProgram != nullptr && strlen(ledConfig.storedProgram) > 0) {
 		defaultProgram = ledConfig.storedProgram;
 	}
+#if !defined(FAN_OUT_FOLLOWER)
 	webLoadingBuffer.LoadFromBuffer(defaultProgram);
 	stateBuilder.BuildState(&webLoadingBuffer, &primaryState);
+#endif
 
 	// Set the name of the server to be the name supplied during configuration
 	// This is in response to a GET \about request
@@ -345,6 +639,20 @@ void loop() {
 	// a VirtualBox adapter is enabled it will prevent the UDP service from functioning.In this case
 	// disable the VirtualBox adapter.
 
+	// send or follow frame clock beacons so that servers running the same program stay in step
+	frameSync.Execute();
+
+	// write pixels streamed to the server straight to the LEDs
+	ddpReceiver.Execute();
+
+#if defined(FAN_OUT_MASTER)
+	// send the last frame to the followers again if nothing has changed for a while
+	renderer.Refresh(timer.GetTime());
+#elif defined(FAN_OUT_FOLLOWER)
+	// render the frames sent by the fan-out master
+	fanOutReceiver.Execute();
+#endif
+
 	// execute the orchastrator on each loop - this will just return if not yet time to execute
 	orchastrator.Execute(!wifiIsConnected);
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 
 #include "src/Networking/WifiConnectManager/defines.h"
 
+#ifdef MKR1010
+#include <ArduinoECCX08.h>
+#endif
+
 /*
 // original PIN assignments: makes an active connection red!  Pins must have changed
 // as some point to the ones below.
@@ -61,5 +65,29 @@ bool checkWifistatus(WiFiManager_NINA_Lite* wifiManager)
 }
 
 
+/*!
+	@brief	Gets an id for the session of the UDP command channel that is
+			unpredictable and differs each time the server starts.  The
+			random number generator of the crypto chip of the MKR1010 is
+			used; otherwise the noise of the WiFi signal strength is mixed
+			with the time taken to start.
+*/
+uint32_t getSessionId() {
+#ifdef MKR1010
+	byte random[4];
+	if (ECCX08.begin() && ECCX08.random(random, sizeof(random))) {
+		return ((uint32_t)random[0] << 24) | ((uint32_t)random[1] << 16) | ((uint32_t)random[2] << 8) | random[3];
+	}
+#endif
+
+	uint32_t sessionId = micros();
+	for (int i = 0; i < 8; i++) {
+		delayMicroseconds(WiFi.RSSI() & 0x0F);
+		sessionId = (sessionId * 2654435761UL) ^ (uint32_t)WiFi.RSSI() ^ micros();
+	}
+
+	return sessionId;
+}
+
 
 #endif
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include "BatchCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   The routes that can be used in a batch.
+	*/
+	const BatchRoute BatchCommand::routes[] = {
+		{ "program/stored", CommandType::LOADPROGRAMANDSTORE, true, true },
+		{ "program/seek", CommandType::SEEKPROGRAM, false, true },
+		{ "program/patch", CommandType::PATCHPROGRAM, false, true },
+		{ "program/queue", CommandType::QUEUEPROGRAM, true, true },
+		{ "program/layer", CommandType::LOADLAYER, false, true },
+		{ "program/segment", CommandType::LOADSEGMENT, false, true },
+		{ "program", CommandType::LOADPROGRAM, true, true },
+		{ "power/off", CommandType::POWEROFF, true, true },
+		{ "power/on", CommandType::POWERON, true, true },
+		{ "power", CommandType::CHECKPOWER, true, false },
+		{ "about", CommandType::GETABOUT, true, false },
+		{ "config/leds", CommandType::SETLEDS, false, true },
+		{ "config/segments", CommandType::SETSEGMENTS, false, true },
+		{ "status", CommandType::GETSTATUS, true, false },
+		{ "profile", CommandType::PROFILE, true, true },
+		{ "sync", CommandType::SYNC, true, true },
+		{ nullptr, CommandType::NONE, false, false }
+	};
+
+	/*!
+	  @brief   Finds the route of a command in the batch.
+	  @param   route		A pointer to the route (not terminated).
+	  @param   routeLength	The number of characters in the route.
+	  @returns A pointer to the route or nullptr if it cannot be used in a batch.
+	*/
+	const BatchRoute* BatchCommand::FindRoute(const char* route, uint16_t routeLength) {
+		for (const BatchRoute* batchRoute = routes; batchRoute->route != nullptr; batchRoute++) {
+			if (strlen(batchRoute->route) == routeLength
+				&& strncmp(batchRoute->route, route, routeLength) == 0) {
+				return batchRoute;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/*!
+	  @brief   Executes the commands in the batch.
+	  @returns True if the batch was executed or false if
+			   the body is not a batch.
+	*/
+	bool BatchCommand::ExecuteCommand() {
+		loadingBuffer = responseCollector->GetLoadingFixedSizeBuffer();
+		char* buf = loadingBuffer->GetBuffer();
+		uint16_t bufferSize = loadingBuffer->GetBufferSize();
+
+		uint16_t batchLength = 0;
+		while (batchLength < bufferSize - 1
+			&& buf[batchLength] != '\0') {
+			batchLength++;
+		}
+
+		activeCommand = nullptr;
+		numberOfCommands = 0;
+		if (batchLength == 0) {
+			responseCollector->RespondError();
+
+			return false;
+		}
+
+		// move the batch to the end of the buffer so that the body of each
+		// command can be moved to the start of the buffer without overwriting
+		// the commands that follow it
+		nextLine = bufferSize - 1 - batchLength;
+		memmove(&buf[nextLine], buf, batchLength);
+		buf[bufferSize - 1] = '\0';
+
+		responseCollector->BeginBatch();
+
+		return ExecuteNextCommands();
+	}
+
+	/*!
+	  @brief   Executes the commands in the batch, in order, until a command
+			   has pending work or all of the commands have been executed, in
+			   which case the combined response is sent.
+	  @returns True.
+	*/
+	bool BatchCommand::ExecuteNextCommands() {
+		char* buf = loadingBuffer->GetBuffer();
+
+		while (buf[nextLine] != '\0') {
+			uint16_t lineStart = nextLine;
+			uint16_t lineEnd = lineStart;
+			while (buf[lineEnd] != '\0'
+				&& buf[lineEnd] != '\n') {
+				lineEnd++;
+			}
+
+			nextLine = buf[lineEnd] == '\0' ? lineEnd : lineEnd + 1;
+			if (lineEnd > lineStart
+				&& buf[lineEnd - 1] == '\r') {
+				lineEnd--;
+			}
+
+			if (lineEnd == lineStart) {
+				continue;
+			}
+
+			uint16_t routeEnd = lineStart;
+			while (routeEnd < lineEnd
+				&& buf[routeEnd] != ' ') {
+				routeEnd++;
+			}
+
+			const BatchRoute* batchRoute = FindRoute(&buf[lineStart], routeEnd - lineStart);
+			bool hasBody = routeEnd < lineEnd;
+			if (numberOfCommands++ >= BATCH_MAX_COMMANDS) {
+				break;
+			}
+
+			ICommand* command = batchRoute != nullptr
+				? commandFactory->GetCommand(batchRoute->commandType)
+				: nullptr;
+			if (command == nullptr
+				|| (hasBody && !batchRoute->allowPost)
+				|| (!hasBody && !batchRoute->allowGet)) {
+				responseCollector->RespondError();
+				continue;
+			}
+
+			// the command expects its body at the start of the loading buffer;
+			// the body always ends before the next line so that is never overwritten
+			uint16_t bodyLength = hasBody ? lineEnd - routeEnd - 1 : 0;
+			if (hasBody) {
+				memmove(buf, &buf[routeEnd + 1], bodyLength);
+			}
+			buf[bodyLength] = '\0';
+
+			responseCollector->SetCommandType(batchRoute->commandType);
+			command->ExecuteCommand();
+			if (command->HasPendingWork()) {
+				activeCommand = command;
+				return true;
+			}
+		}
+
+		responseCollector->EndBatch();
+
+		return true;
+	}
+
+	/*!
+	  @brief   Gets whether a command in the batch, and so the batch
+			   itself, has still to complete.
+	  @returns True if the batch has not completed, false otherwise.
+	*/
+	bool BatchCommand::HasPendingWork() {
+		return activeCommand != nullptr;
+	}
+
+	/*!
+	  @brief   Carries out the next part of the work of the command with
+			   pending work and, once it completes, executes the commands
+			   that follow it.
+	  @returns True.
+	*/
+	bool BatchCommand::ContinueCommand() {
+		if (activeCommand == nullptr) {
+			return true;
+		}
+
+		activeCommand->ContinueCommand();
+		if (activeCommand->HasPendingWork()) {
+			return true;
+		}
+
+		activeCommand = nullptr;
+
+		return ExecuteNextCommands();
+	}
+}
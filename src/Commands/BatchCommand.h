@@ -0,0 +1,103 @@
+/*!
+ * @file BatchCommand.h
+ *
+ * Handles a command that carries an ordered
+ * list of commands that are all executed for
+ * the one request.
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _BATCHCOMMAND_H
+#define _BATCHCOMMAND_H
+
+#include "ICommand.h"
+#include "CommandFactory.h"
+#include "BatchResponseCollector.h"
+#include "../DomainInterfaces.h"
+#include "../FixedSizeCharBuffer.h"
+
+#define		BATCH_MAX_COMMANDS			16		// most commands in a batch (the rest are not executed)
+
+namespace LS {
+	/*!
+	@brief  A route that can be used in a batch and how it may be used.
+	*/
+	struct BatchRoute {
+		const char* route;				// as the route of the HTTP request, e.g. "power/off"
+		CommandType commandType;
+		bool allowGet;					// may be given without a body
+		bool allowPost;					// may be given with a body
+	};
+
+	/*!
+	@brief  BatchCommand handles a command that carries an ordered list
+			of commands in its body so that, for example, the number of
+			LEDs can be set, a program loaded and the power checked with
+			one round-trip.  Each line of the body is a command of the form:
+
+			<route>[ <body>]
+
+			where the route is that of the equivalent HTTP request and the
+			body, if any, is the body of that request (a line with a body
+			is the equivalent of a POST and one without of a GET), e.g.
+
+			config/leds 120
+			program/stored {"name":"red","instructions":["01200000FF0000"]}
+			power
+
+			The commands are executed in order, through the CommandFactory,
+			and the response is a JSON array with one entry per command (see
+			BatchResponseCollector).  A command that does not complete in one
+			execution cycle (e.g. loading a large program) holds back the commands
+			that follow it until it completes.  The batch text is kept at the end
+			of the loading buffer whilst each body is moved to the start, where
+			the commands expect it, so batches are limited by the loading buffer.
+	*/
+	class BatchCommand : public ICommand
+	{
+	private:
+		BatchResponseCollector* responseCollector;
+		CommandFactory* commandFactory;
+		FixedSizeCharBuffer* loadingBuffer;
+		ICommand* activeCommand = nullptr;
+		uint16_t nextLine = 0;						// index, in the loading buffer, of the next line to execute
+		uint8_t numberOfCommands = 0;
+
+		static const BatchRoute routes[];
+
+	protected:
+		const BatchRoute* FindRoute(const char* route, uint16_t routeLength);
+		bool ExecuteNextCommands();
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   responseCollector	Pointer to the class that handles web requests and collects the batch response.
+		  @param   commandFactory		Pointer to the factory that gets the commands in the batch.
+		*/
+		BatchCommand(
+			BatchResponseCollector* responseCollector,
+			CommandFactory* commandFactory
+		) {
+			this->responseCollector = responseCollector;
+			this->commandFactory = commandFactory;
+			this->loadingBuffer = nullptr;
+		}
+
+		/*!
+		  @brief   Executes the commands in the batch.
+		  @returns True if the batch was executed or false if
+				   the body is not a batch.
+		*/
+		bool ExecuteCommand();
+
+		bool HasPendingWork();
+
+		bool ContinueCommand();
+	};
+}
+#endif
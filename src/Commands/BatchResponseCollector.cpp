@@ -0,0 +1,161 @@
+#include "BatchResponseCollector.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects the dependencies.
+		@param		webServer	A pointer to the interface that the combined response is written to.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	BatchResponseCollector::BatchResponseCollector(ILightWebServer* webServer) {
+		this->webServer = webServer;
+	}
+
+	/*!
+		@brief		Starts the combined response of a batch.  Responses are collected
+					until EndBatch is called.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void BatchResponseCollector::BeginBatch() {
+		isCollecting = true;
+		numberOfResponses = 0;
+
+		webServer->StartResponseOK();
+		webServer->WriteResponse("[");
+	}
+
+	/*!
+		@brief		Completes, and sends, the combined response of a batch.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void BatchResponseCollector::EndBatch() {
+		if (!isCollecting) {
+			return;
+		}
+
+		isCollecting = false;
+
+		webServer->WriteResponse("]");
+		webServer->EndResponse();
+	}
+
+	/*!
+		@brief		Gets the number of responses collected since the batch began.
+		@returns	The number of responses.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t BatchResponseCollector::GetNumberOfResponses() {
+		return numberOfResponses;
+	}
+
+	/*!
+		@brief		Writes the start of the entry of the next response.
+		@param		status		The HTTP status of the response.
+		@param		hasBody		True if the body of the response follows, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void BatchResponseCollector::WriteStatus(uint16_t status, bool hasBody) {
+		char entry[24];
+		snprintf(entry, sizeof(entry), "%s{\"status\":%u%s",
+			numberOfResponses > 0 ? "," : "",
+			status,
+			hasBody ? ",\"body\":" : "}");
+
+		webServer->WriteResponse(entry);
+		numberOfResponses++;
+	}
+
+	void BatchResponseCollector::SetCommandType(CommandType commandType) {
+		webServer->SetCommandType(commandType);
+	}
+
+	char* BatchResponseCollector::GetLoadingBuffer(bool clearBuffer) {
+		return webServer->GetLoadingBuffer(clearBuffer);
+	}
+
+	FixedSizeCharBuffer* BatchResponseCollector::GetLoadingFixedSizeBuffer() {
+		return webServer->GetLoadingFixedSizeBuffer();
+	}
+
+	const char* BatchResponseCollector::GetAuthCredentials() {
+		return webServer->GetAuthCredentials();
+	}
+
+	void BatchResponseCollector::RespondError() {
+		if (!isCollecting) {
+			webServer->RespondError();
+			return;
+		}
+
+		WriteStatus(400, false);
+	}
+
+	void BatchResponseCollector::RespondNotAuthorised() {
+		if (!isCollecting) {
+			webServer->RespondNotAuthorised();
+			return;
+		}
+
+		WriteStatus(401, false);
+	}
+
+	void BatchResponseCollector::RespondNoContent() {
+		if (!isCollecting) {
+			webServer->RespondNoContent();
+			return;
+		}
+
+		WriteStatus(204, false);
+	}
+
+	void BatchResponseCollector::RespondOK(const char* str) {
+		if (!isCollecting) {
+			webServer->RespondOK(str);
+			return;
+		}
+
+		if (str == nullptr
+			|| str[0] == '\0') {
+			WriteStatus(200, false);
+			return;
+		}
+
+		WriteStatus(200, true);
+		webServer->WriteResponse(str);
+		webServer->WriteResponse("}");
+	}
+
+	void BatchResponseCollector::StartResponseOK() {
+		if (!isCollecting) {
+			webServer->StartResponseOK();
+			return;
+		}
+
+		WriteStatus(200, true);
+	}
+
+	void BatchResponseCollector::WriteResponse(const char* str) {
+		webServer->WriteResponse(str);
+	}
+
+	void BatchResponseCollector::EndResponse() {
+		if (!isCollecting) {
+			webServer->EndResponse();
+			return;
+		}
+
+		webServer->WriteResponse("}");
+	}
+
+	CommandType BatchResponseCollector::HandleNextCommand() {
+		return webServer->HandleNextCommand();
+	}
+
+	CommandType BatchResponseCollector::HandleNextQuickCommand() {
+		return webServer->HandleNextQuickCommand();
+	}
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file BatchResponseCollector.h
+ *
+ * Collects the responses of the commands in a
+ * batch into one combined response.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _BatchResponseCollector_h
+#define _BatchResponseCollector_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include "../DomainInterfaces.h"
+#include "../FixedSizeCharBuffer.h"
+
+namespace LS {
+	/*!
+		@brief	Wraps the Restful interface (or the UDP command channel) so that,
+				whilst a batch of commands is executed, the response of each command
+				is written as one entry of a single combined response rather than
+				closing the connection.  The combined response is a JSON array with
+				one entry per command, in order, of the form {"status":204} or
+				{"status":200,"body":<body of the response>}.  Outside of a batch
+				every call is simply passed on.  It is the collector that is given
+				to the commands and the orchastrator.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class BatchResponseCollector : public ILightWebServer {
+	private:
+		ILightWebServer* webServer;
+		bool isCollecting = false;
+		uint8_t numberOfResponses = 0;
+
+		void WriteStatus(uint16_t status, bool hasBody);
+
+	public:
+		BatchResponseCollector(ILightWebServer* webServer);
+
+		void BeginBatch();
+		void EndBatch();
+		uint8_t GetNumberOfResponses();
+
+		void SetCommandType(CommandType commandType);
+		char* GetLoadingBuffer(bool clearBuffer = true);
+		FixedSizeCharBuffer* GetLoadingFixedSizeBuffer();
+		const char* GetAuthCredentials();
+		void RespondError();
+		void RespondNotAuthorised();
+		void RespondNoContent();
+		void RespondOK(const char* str = nullptr);
+		void StartResponseOK();
+		void WriteResponse(const char* str);
+		void EndResponse();
+		CommandType HandleNextCommand();
+		CommandType HandleNextQuickCommand();
+	};
+}
+
+#endif
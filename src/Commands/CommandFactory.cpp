@@ -43,6 +43,38 @@ namespace LS {
 			case CommandType::SETLEDS:
 				commands[8] = command;
 				break;
+			case CommandType::GETSTATUS:
+				commands[9] = command;
+				break;
+			case CommandType::PROFILE:
+				commands[10] = command;
+				break;
+			case CommandType::SEEKPROGRAM:
+				commands[11] = command;
+				break;
+			case CommandType::SYNC:
+				commands[12] = command;
+				break;
+			case CommandType::BATCH:
+				commands[13] = command;
+				break;
+			case CommandType::PATCHPROGRAM:
+				commands[14] = command;
+				break;
+			case CommandType::QUEUEPROGRAM:
+				commands[15] = command;
+				break;
+			case CommandType::LOADLAYER:
+				commands[16] = command;
+				break;
+			case CommandType::SETSEGMENTS:
+				commands[17] = command;
+				break;
+			case CommandType::LOADSEGMENT:
+				commands[18] = command;
+				break;
+			default:
+				break;
 		}
 	}
 
@@ -83,6 +115,38 @@ namespace LS {
 			case CommandType::SETLEDS:
 				return commands[8];
 				break;
+			case CommandType::GETSTATUS:
+				return commands[9];
+				break;
+			case CommandType::PROFILE:
+				return commands[10];
+				break;
+			case CommandType::SEEKPROGRAM:
+				return commands[11];
+				break;
+			case CommandType::SYNC:
+				return commands[12];
+				break;
+			case CommandType::BATCH:
+				return commands[13];
+				break;
+			case CommandType::PATCHPROGRAM:
+				return commands[14];
+				break;
+			case CommandType::QUEUEPROGRAM:
+				return commands[15];
+				break;
+			case CommandType::LOADLAYER:
+				return commands[16];
+				break;
+			case CommandType::SETSEGMENTS:
+				return commands[17];
+				break;
+			case CommandType::LOADSEGMENT:
+				return commands[18];
+				break;
+			default:
+				break;
 		}
 
 		return nullptr;
@@ -4,18 +4,26 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\WProgram.h"
+#include "../WProgram.h"
 #endif
 
 #include "ICommand.h"
 #include "CheckPowerCommand.h"
 #include "GetAboutCommand.h"
+#include "GetStatusCommand.h"
+#include "ProfileCommand.h"
 #include "InvalidCommand.h"
 #include "LoadProgramCommand.h"
 #include "NoAuthCommand.h"
 #include "PowerOffCommand.h"
 #include "PowerOnCommand.h"
 #include "SetLedsCommand.h"
+#include "SeekCommand.h"
+#include "SyncCommand.h"
+#include "PatchProgramCommand.h"
+#include "LoadLayerCommand.h"
+#include "SetSegmentsCommand.h"
+#include "LoadSegmentCommand.h"
 
 namespace LS {
 	/*!
@@ -25,7 +33,7 @@ namespace LS {
 	*/
 	class CommandFactory {
 	private:
-		ICommand* commands[9];
+		ICommand* commands[19];
 
 	public:
 		virtual void SetCommand(CommandType commandType, ICommand* command);
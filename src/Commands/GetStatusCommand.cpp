@@ -0,0 +1,40 @@
+#include "GetStatusCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Executes the command that gets the
+			   run-time status of the server.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool GetStatusCommand::ExecuteCommand() {
+		webDoc->clear();
+
+		if (frameGovernor == nullptr
+			|| !frameGovernor->GetPolicy()->enabled) {
+			(*webDoc)["governor"] = false;
+		}
+		else {
+			(*webDoc)["interval"] = frameGovernor->GetInterval();
+			(*webDoc)["budget"] = frameGovernor->GetFrameBudget();
+			(*webDoc)["lastFrame"] = frameGovernor->GetLastFrameTime();
+			(*webDoc)["peakFrame"] = frameGovernor->GetPeakFrameTime();
+			(*webDoc)["overruns"] = frameGovernor->GetOverruns();
+			(*webDoc)["shed"] = frameGovernor->GetShedFrames();
+			(*webDoc)["deferred"] = frameGovernor->GetDeferredCommands();
+		}
+
+		if (frameCache != nullptr) {
+			(*webDoc)["hits"] = frameCache->GetHits();
+			(*webDoc)["misses"] = frameCache->GetMisses();
+		}
+
+		// not pretty printed as the response would not fit in the response buffer
+		serializeJson(*webDoc, webResponse->GetBuffer(), BUFFER_JSON_RESPONSE_SIZE);
+		// only requires about 144 bytes in the JSON document
+
+		lightWebServer->RespondOK(webResponse->GetBuffer());
+
+		return true;
+	}
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file GetStatusCommand.h
+ *
+ * Handles a command to retrieve the
+ * run-time status of the server, such
+ * as the decisions taken by the frame
+ * governor and the use of the frame cache.
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _GETSTATUSCOMMAND_H
+#define _GETSTATUSCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../FixedSizeCharBuffer.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/FrameGovernor.h"
+#include "../LPE/Executor/LpFrameCache.h"
+
+namespace LS {
+	/*!
+	@brief  GetStatusCommand handles a command that has been
+			received in order to get the run-time status
+			of the server.
+	*/
+	class GetStatusCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		FixedSizeCharBuffer* webResponse;
+		FrameGovernor* frameGovernor;
+		LpFrameCache* frameCache;
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   frameGovernor		Pointer to the governor that adapts the frame rate (nullptr if none is used).
+		  @param   frameCache			Pointer to the cache of the frames of infinite repeats (nullptr if none is used).
+		*/
+		GetStatusCommand(
+			ILightWebServer* lightWebServer,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			FrameGovernor* frameGovernor,
+			LpFrameCache* frameCache = nullptr
+		) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->webResponse = webResponse;
+			this->frameGovernor = frameGovernor;
+			this->frameCache = frameCache;
+		}
+
+		/*!
+		  @brief   Executes the command that gets the
+				   run-time status of the server.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
@@ -30,6 +30,27 @@ namespace LS {
 				   false if it did not execute successfully.
 		*/
 		virtual bool ExecuteCommand() = 0;
+
+		/*!
+		  @brief   Gets whether the command has further work to carry out
+				   on later execution cycles, e.g. a large program that is
+				   loaded a few instructions at a time.
+		  @returns True if ContinueCommand should be called on the next
+				   execution cycle, false if the command is complete.
+		*/
+		virtual bool HasPendingWork() {
+			return false;
+		}
+
+		/*!
+		  @brief   Carries out the next part of the work of a command that
+				   has pending work.
+		  @returns True if the command is executing successfully or
+				   false if it did not execute successfully.
+		*/
+		virtual bool ContinueCommand() {
+			return true;
+		}
 	};
 }
 #endif
\ No newline at end of file
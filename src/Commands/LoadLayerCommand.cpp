@@ -0,0 +1,94 @@
+#include "LoadLayerCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Reads the properties of the layer from the POSTed body.  Only
+			   the properties of the layer are read (not the program, which
+			   does not fit in the JSON document) and the body is read as
+			   const so that it is left unchanged for the program to be loaded.
+	  @param   hasInstructions		Pointer to the value that is set to whether the body has instructions.
+	  @param   isStopped			Pointer to the value that is set to whether the layer is to be stopped.
+	  @returns True if the properties are valid, false otherwise.
+	*/
+	bool LoadLayerCommand::ReadLayer(bool* hasInstructions, bool* isStopped) {
+		StaticJsonDocument<LAYER_FILTER_SIZE> filter;
+		filter["layer"] = true;
+		filter["blend"] = true;
+		filter["alpha"] = true;
+		filter["stop"] = true;
+		filter["instructions"].to<JsonArray>();		// keeps the array, but none of the instructions, so it can be seen
+
+		webDoc->clear();
+		const char* body = lightWebServer->GetLoadingBuffer(false);
+		if (deserializeJson(*webDoc, body, DeserializationOption::Filter(filter)) != DeserializationError::Ok) {
+			return false;
+		}
+
+		JsonVariant layerVar = (*webDoc)["layer"];
+		if (!layerVar.is<uint8_t>()
+			|| layerVar.as<uint8_t>() == 0
+			|| layerVar.as<uint8_t>() > numberOfLayers) {
+			return false;
+		}
+		layer = layerVar.as<uint8_t>();
+
+		const char* blend = (*webDoc)["blend"] | "alpha";
+		if (strcmp(blend, "replace") == 0) blendMode = BlendMode::BlendReplace;
+		else if (strcmp(blend, "add") == 0) blendMode = BlendMode::BlendAdd;
+		else if (strcmp(blend, "alpha") == 0) blendMode = BlendMode::BlendAlpha;
+		else if (strcmp(blend, "max") == 0) blendMode = BlendMode::BlendMax;
+		else return false;
+
+		JsonVariant alphaVar = (*webDoc)["alpha"];
+		if (!alphaVar.isNull()
+			&& !alphaVar.is<uint8_t>()) {
+			return false;
+		}
+		alpha = alphaVar | 255;
+
+		*hasInstructions = webDoc->containsKey("instructions");
+		*isStopped = (*webDoc)["stop"] | false;
+
+		return true;
+	}
+
+	/*!
+	  @brief   Blends the layer as requested once its Light Program
+			   has been validated, before the program is built.
+	*/
+	void LoadLayerCommand::ProgramValidated() {
+		orchastor->SetLayerBlend(layer, blendMode, alpha);
+	}
+
+	/*!
+	  @brief   Executes the command that loads a Light Program into
+			   a layer or changes how the layer is blended.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool LoadLayerCommand::ExecuteCommand() {
+		bool hasInstructions = false;
+		bool isStopped = false;
+		if (!ReadLayer(&hasInstructions, &isStopped)) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		if (isStopped) {
+			orchastor->StopLayer(layer);
+			lightWebServer->RespondNoContent();
+			return true;
+		}
+
+		if (!hasInstructions) {
+			orchastor->SetLayerBlend(layer, blendMode, alpha);
+			lightWebServer->RespondNoContent();
+			return true;
+		}
+
+		// the program is loaded into the layer in the same way as any other program
+		lpState = layerStates[layer - 1];
+
+		return LoadProgramCommand::ExecuteCommand();
+	}
+}
\ No newline at end of file
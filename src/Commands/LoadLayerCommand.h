@@ -0,0 +1,116 @@
+/*!
+ * @file LoadLayerCommand.h
+ *
+ * Handles a command that has been received
+ * to load a Light Program into a layer that is
+ * composited over the executing program.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _LOADLAYERCOMMAND_H
+#define _LOADLAYERCOMMAND_H
+
+#include "LoadProgramCommand.h"
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../LPE/Validation/LpJsonValidator.h"
+#include "../LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "../LPE/StateBuilder/LpJsonState.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/IOrchastor.h"
+#include "../Renderer/LayerCompositor.h"
+
+#define LAYER_FILTER_SIZE		96		// the filter that reads the properties of the layer, not the program
+
+namespace LS {
+	/*!
+	@brief  LoadLayerCommand handles a command that has been received to
+			load a Light Program into a layer, e.g. a notification that is
+			flashed over the program.  The POSTed body is a Light Program
+			with the properties of the layer, e.g.
+
+			{ "layer": 1, "blend": "alpha", "alpha": 128, "name": ..., "instructions": [ ... ] }
+
+			The program is loaded, and responded to, in the same way as any
+			other program.  A body without instructions only changes how the
+			layer is blended, or stops it if it has "stop": true.
+	*/
+	class LoadLayerCommand : public LoadProgramCommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		IOrchastor* orchastor;
+		LpJsonState* layerStates[MAX_LAYERS];
+		uint8_t numberOfLayers = 0;
+
+		uint8_t layer = 0;
+		BlendMode blendMode = BlendMode::BlendAlpha;
+		uint8_t alpha = 255;
+
+	protected:
+		bool ReadLayer(bool* hasInstructions, bool* isStopped);
+
+		/*!
+		  @brief   Blends the layer as requested once its Light Program
+				   has been validated, before the program is built.
+		*/
+		void ProgramValidated();
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   lpValidator			Pointer to the class that validates Light Programs before they are loaded.
+		  @param   lpStateBuilder		Pointer to the class that builds a tree represents of a Light Program which
+										can then be executed.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   orchastor			Pointer to the orchastrating class that composites the layers.
+		*/
+		LoadLayerCommand(
+			ILightWebServer* lightWebServer,
+			LpJsonValidator* lpValidator,
+			LpJsonStateBuilder* lpStateBuilder,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			IOrchastor* orchastor
+		) : LoadProgramCommand(lightWebServer, lpValidator, lpStateBuilder, nullptr, webDoc, webResponse) {
+
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Adds the LP state of the next layer, which must be the
+				   LP state of the same layer added to the orchastrator.
+		  @param   layerState		Pointer to the LP state of the layer.
+		  @returns True if the layer was added or false if there are
+				   already MAX_LAYERS layers.
+		*/
+		bool AddLayer(LpJsonState* layerState) {
+			if (layerState == nullptr
+				|| numberOfLayers >= MAX_LAYERS) {
+				return false;
+			}
+
+			layerStates[numberOfLayers++] = layerState;
+			return true;
+		}
+
+		/*!
+		  @brief   Executes the command that loads a Light Program into
+				   a layer or changes how the layer is blended.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
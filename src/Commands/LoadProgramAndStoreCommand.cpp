@@ -2,21 +2,15 @@
 
 namespace LS {
 	/*!
-	  @brief   Executes the command that causes a Light
-			   Program to be loaded.
-	  @returns True if the command was executed successfully or
-			   false if it did not execute successfully.
+	  @brief   Stores the Light Program, once it has been validated,
+			   so the same program will be loaded next time.
 	*/
-	bool LoadProgramAndStoreCommand::ExecuteCommand() {
-		LoadProgramCommand::ExecuteCommand();
-		
+	void LoadProgramAndStoreCommand::ProgramValidated() {
 		// Persist the program in flash memory if required so the same program will be loaded next time
 		// max program: 2000 chars or less
 		if (strlen(lpBuffer->GetBuffer()) < 2000) {
 			strcpy(ledConfig->storedProgram, lpBuffer->GetBuffer());
 			configPersistance->SaveConfig(ledConfig);
 		}
-
-		return true;
 	}
 }
\ No newline at end of file
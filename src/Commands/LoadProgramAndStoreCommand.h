@@ -37,6 +37,12 @@ namespace LS {
 	private:
 		LEDConfig* ledConfig;
 		IConfigPersistance* configPersistance;
+	protected:
+		/*!
+		  @brief   Stores the Light Program, once it has been validated,
+				   so the same program will be loaded next time.
+		*/
+		void ProgramValidated();
 	public:
 		/*!
 		  @brief   Executes the command that cause a Light Program to be loaded.
@@ -47,6 +53,8 @@ namespace LS {
 		  @param   lpStateBuilder		Pointer to the class that builds a tree represents of a Light Program which
 										can then be executed.
 		  @param   lpState				Pointer to the class that stores the tree representations of a Light Program.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
 		  @param   ledConfig			The LED configuration values
 		  @param   configPersistance	The instance which permanently stores changes to the LED configuration, including the
 										program loaded that is to be stored permanently.
@@ -56,21 +64,15 @@ namespace LS {
 			LpJsonValidator* lpValidator,
 			LpJsonStateBuilder* lpStateBuilder,
 			LpJsonState* lpState,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
 			LEDConfig* ledConfig,
 			IConfigPersistance* configPersistance
-		) : LoadProgramCommand(lightWebServer, lpValidator, lpStateBuilder, lpState) {
+		) : LoadProgramCommand(lightWebServer, lpValidator, lpStateBuilder, lpState, webDoc, webResponse) {
 
 			this->ledConfig = ledConfig;
 			this->configPersistance = configPersistance;
 		}
-
-		/*!
-		  @brief   Executes the command that causes a Light
-				   Program to be loaded.
-		  @returns True if the command was executed successfully or
-				   false if it did not execute successfully.
-		*/
-		bool ExecuteCommand();
 	};
 }
 #endif
\ No newline at end of file
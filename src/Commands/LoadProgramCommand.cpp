@@ -14,38 +14,93 @@ namespace LS {
 		// FixedSizeCharBuffer* lpBuffer = lightWebServer->GetLoadingFixedSizeBuffer();
 		lpBuffer = lightWebServer->GetLoadingFixedSizeBuffer();
 
-		// Validate the Light Program
-		lpValidator->ValidateLp(lpBuffer, &validateResult);
+		// Begin validating the Light Program.  The program is validated, and
+		// then built, a few instructions on each execution cycle so that a large
+		// program does not hold up the execution cycle.  The current program
+		// continues to be rendered whilst the new program is validated and its
+		// last frame is held whilst the new program is built.
+		if (!lpValidator->BeginValidateLp(lpBuffer, &validateResult, lpState)) {
+			// The received Light Program is not validate.  Respond
+			// with an error code 400.
+			stage = LoadProgramStage::LoadComplete;
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		stage = LoadProgramStage::LoadValidating;
+
+		return ContinueCommand();
+	}
+
+	/*!
+	  @brief   Gets whether the Light Program is still being
+			   validated or built.
+	  @returns True if loading is not yet complete, false otherwise.
+	*/
+	bool LoadProgramCommand::HasPendingWork() {
+		return stage != LoadProgramStage::LoadComplete;
+	}
+
+	/*!
+	  @brief   Validates or builds the next few instructions
+			   of the Light Program.  A response is sent as soon
+			   as validation is complete, before the program is built.
+	  @returns True if loading is proceeding successfully or
+			   false if the Light Program is not valid.
+	*/
+	bool LoadProgramCommand::ContinueCommand() {
+		if (stage == LoadProgramStage::LoadBuilding) {
+			// The LP is valid so we need to build a tree representation of
+			// that Light Program which will be used to execute the program
+			if (lpStateBuilder->ContinueBuildState(LOAD_INSTRUCTIONS_PER_CYCLE)) {
+				stage = LoadProgramStage::LoadComplete;
+			}
+			return true;
+		}
+
+		if (stage != LoadProgramStage::LoadValidating
+			|| !lpValidator->ContinueValidateLp(LOAD_INSTRUCTIONS_PER_CYCLE, &validateResult)) {
+			return true;
+		}
 
 		if (validateResult.GetCode() != LS::LPValidateCode::Valid) {
 			// The received Light Program is not validate.  Respond
 			// with an error code 400.
+			stage = LoadProgramStage::LoadComplete;
 			lightWebServer->RespondError();
 			return false;
 		}
 
-		//// Persist the program in flash memory if required so the same program will be loaded next time
-		//if (1 == 1 
-		//	&& strlen(lpBuffer->GetBuffer()) < 2000) {
-		//	Serial.println("Persisting program to flash");
-		//	Serial.println(lpBuffer->GetBuffer());
-		//	Serial.println("Persisted program size");
-		//	Serial.println(strlen(lpBuffer->GetBuffer()));
-		//	Serial.println("Free memory");
-		//	Serial.println(freeMemory());
-
-		//	// ledConfig->storedProgram = lpBuffer->GetBuffer();
-		//	strcpy(ledConfig->storedProgram, lpBuffer->GetBuffer());
-		//	// configPersistance->SaveConfig(ledConfig);
-		//}
-
-		// The LP is valid so we need to build a tree representation of
-		// that Light Program which will be used to execute the program
-		lpStateBuilder->BuildState(lpBuffer, lpState);
-		
-		// Finally, we can respond with a successful response.
-		lightWebServer->RespondNoContent();
+		// The program is valid so we can respond with a successful response,
+		// including the estimated cost of the program, whilst the program is built.
+		RespondWithCostEstimate();
+		ProgramValidated();
+
+		stage = lpStateBuilder->BeginBuildState(lpBuffer, lpState) ? LoadProgramStage::LoadBuilding : LoadProgramStage::LoadComplete;
 
 		return true;
 	}
+
+	/*!
+	  @brief   Responds with the estimated cost of the Light
+			   Program that has been validated: the time taken by
+			   its most expensive frame and the frame budget (both in
+			   microseconds), its length in frames and the memory it
+			   uses once loaded.
+	*/
+	void LoadProgramCommand::RespondWithCostEstimate() {
+		LpCostEstimate* costEstimate = lpValidator->GetCostEstimate();
+
+		webDoc->clear();
+		(*webDoc)["peakFrame"] = costEstimate->peakFrameCost;
+		(*webDoc)["budget"] = lpValidator->GetFrameBudget();
+		(*webDoc)["frames"] = costEstimate->numberOfFrames;
+		(*webDoc)["infinite"] = costEstimate->isInfinite;
+		(*webDoc)["memory"] = costEstimate->GetMemoryFootprint();
+
+		serializeJson(*webDoc, webResponse->GetBuffer(), BUFFER_JSON_RESPONSE_SIZE);
+		// only requires about 80 bytes in the JSON document
+
+		lightWebServer->RespondOK(webResponse->GetBuffer());
+	}
 }
\ No newline at end of file
@@ -20,10 +20,23 @@
 #include "../LPE/StateBuilder/LpJsonStateBuilder.h"
 #include "../LPE/StateBuilder/LpJsonState.h"
 #include "../ValueDomainTypes.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../FixedSizeCharBuffer.h"
 #include "../ConfigPersistance/IConfigPersistance.h"
 #include "../MemoryFree.h"
 
+#define LOAD_INSTRUCTIONS_PER_CYCLE		8		// instructions validated or built on each execution cycle
+
 namespace LS {
+	/*!
+	@brief  The stages of loading a Light Program.
+	*/
+	enum LoadProgramStage {
+		LoadComplete,
+		LoadValidating,
+		LoadBuilding
+	};
+
 	/*!
 	@brief  LoadProgramCommand handles a command that has been received
 			to load a Light Program.
@@ -34,12 +47,28 @@ namespace LS {
 		ILightWebServer* lightWebServer;
 		LpJsonValidator* lpValidator;
 		LpJsonStateBuilder* lpStateBuilder;
-		LpJsonState* lpState;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		FixedSizeCharBuffer* webResponse;
 		//LEDConfig* ledConfig;
 		//IConfigPersistance* configPersistance;
 	protected:
+		LpJsonState* lpState;
 		LPValidateResult validateResult;
 		FixedSizeCharBuffer* lpBuffer;
+		LoadProgramStage stage = LoadProgramStage::LoadComplete;
+
+		/*!
+		  @brief   Responds with the estimated cost of the Light
+				   Program that has been validated.
+		*/
+		void RespondWithCostEstimate();
+
+		/*!
+		  @brief   Called once the Light Program has been validated, after the
+				   response has been sent and before the program is built.
+		*/
+		virtual void ProgramValidated() {
+		}
 	public:
 		/*!
 		  @brief   Executes the command that cause a Light Program to be loaded.
@@ -50,6 +79,8 @@ namespace LS {
 		  @param   lpStateBuilder		Pointer to the class that builds a tree represents of a Light Program which
 										can then be executed.
 		  @param   lpState				Pointer to the class that stores the tree representations of a Light Program.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
 		  @param   ledConfig			The LED configuration values
 		  @param   configPersistance	The instance which permanently stores changes to the LED configuration, including the
 										program loaded that is to be stored permanently.
@@ -58,7 +89,9 @@ namespace LS {
 			ILightWebServer* lightWebServer, 
 			LpJsonValidator* lpValidator, 
 			LpJsonStateBuilder* lpStateBuilder, 
-			LpJsonState* lpState
+			LpJsonState* lpState,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse
 			//LEDConfig* ledConfig,
 			//IConfigPersistance* configPersistance
 		) {
@@ -67,6 +100,8 @@ namespace LS {
 			this->lpValidator = lpValidator;
 			this->lpStateBuilder = lpStateBuilder;
 			this->lpState = lpState;
+			this->webDoc = webDoc;
+			this->webResponse = webResponse;
 			//this->ledConfig = ledConfig;
 			//this->configPersistance = configPersistance;
 		}
@@ -78,6 +113,21 @@ namespace LS {
 				   false if it did not execute successfully.
 		*/
 		virtual bool ExecuteCommand();
+
+		/*!
+		  @brief   Gets whether the Light Program is still being
+				   validated or built.
+		  @returns True if loading is not yet complete, false otherwise.
+		*/
+		virtual bool HasPendingWork();
+
+		/*!
+		  @brief   Validates or builds the next few instructions
+				   of the Light Program.
+		  @returns True if loading is proceeding successfully or
+				   false if the Light Program is not valid.
+		*/
+		virtual bool ContinueCommand();
 	};
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include "LoadSegmentCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Reads the segment from the POSTed body.  Only the properties
+			   of the segment are read (not the program, which does not fit in
+			   the JSON document) and the body is read as const so that it is
+			   left unchanged for the program to be loaded.
+	  @param   isStopped		Pointer to the value that is set to whether the segment is to be stopped.
+	  @returns The index of the segment or -1 if there is no such segment (or it has no LP state).
+	*/
+	int8_t LoadSegmentCommand::ReadSegment(bool* isStopped) {
+		StaticJsonDocument<SEGMENT_FILTER_SIZE> filter;
+		filter["segment"] = true;
+		filter["stop"] = true;
+
+		webDoc->clear();
+		const char* body = lightWebServer->GetLoadingBuffer(false);
+		if (deserializeJson(*webDoc, body, DeserializationOption::Filter(filter)) != DeserializationError::Ok) {
+			return -1;
+		}
+
+		int8_t segment = ledConfig->FindSegment((*webDoc)["segment"].as<const char*>());
+		if (segment >= numberOfSegments) {
+			return -1;
+		}
+
+		*isStopped = (*webDoc)["stop"] | false;
+
+		return segment;
+	}
+
+	/*!
+	  @brief   Executes the command that loads a Light Program into
+			   a segment or stops the program of the segment.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool LoadSegmentCommand::ExecuteCommand() {
+		bool isStopped = false;
+		int8_t segment = ReadSegment(&isStopped);
+		if (segment < 0) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		if (isStopped) {
+			orchastor->StopSegment(segment);
+			lightWebServer->RespondNoContent();
+			return true;
+		}
+
+		// the program is loaded into the segment in the same way as any other program
+		lpState = segmentStates[segment];
+
+		return LoadProgramCommand::ExecuteCommand();
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+/*!
+ * @file LoadSegmentCommand.h
+ *
+ * Handles a command that has been received
+ * to load a Light Program into a segment of
+ * the LEDs.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _LOADSEGMENTCOMMAND_H
+#define _LOADSEGMENTCOMMAND_H
+
+#include "LoadProgramCommand.h"
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../LPE/Validation/LpJsonValidator.h"
+#include "../LPE/StateBuilder/LpJsonStateBuilder.h"
+#include "../LPE/StateBuilder/LpJsonState.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/IOrchastor.h"
+
+#define SEGMENT_FILTER_SIZE		64		// the filter that reads the properties of the segment, not the program
+
+namespace LS {
+	/*!
+	@brief  LoadSegmentCommand handles a command that has been received to
+			load a Light Program into a segment of the LEDs (see SetSegmentsCommand),
+			which plays the program on its range of the LEDs whilst the rest
+			of the LEDs carry on with the program.  The POSTed body is a Light
+			Program with the name of the segment, e.g.
+
+			{ "segment": "tree", "name": ..., "instructions": [ ... ] }
+
+			The program is loaded, and responded to, in the same way as any
+			other program.  A body with "stop": true, rather than a program,
+			stops the program of the segment.
+	*/
+	class LoadSegmentCommand : public LoadProgramCommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		LEDConfig* ledConfig;
+		IOrchastor* orchastor;
+		LpJsonState* segmentStates[MAX_SEGMENTS];
+		uint8_t numberOfSegments = 0;
+
+	protected:
+		int8_t ReadSegment(bool* isStopped);
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   lpValidator			Pointer to the class that validates Light Programs before they are loaded.
+		  @param   lpStateBuilder		Pointer to the class that builds a tree represents of a Light Program which
+										can then be executed.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   ledConfig			Pointer to the configuration of the LEDs that contains the segments.
+		  @param   orchastor			Pointer to the orchastrating class that plays the programs of the segments.
+		*/
+		LoadSegmentCommand(
+			ILightWebServer* lightWebServer,
+			LpJsonValidator* lpValidator,
+			LpJsonStateBuilder* lpStateBuilder,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			LEDConfig* ledConfig,
+			IOrchastor* orchastor
+		) : LoadProgramCommand(lightWebServer, lpValidator, lpStateBuilder, nullptr, webDoc, webResponse) {
+
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->ledConfig = ledConfig;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Adds the LP state of the next segment, which must be the
+				   LP state of the same segment added to the orchastrator.
+		  @param   segmentState		Pointer to the LP state of the segment.
+		  @returns True if the segment was added or false if there are
+				   already MAX_SEGMENTS segments.
+		*/
+		bool AddSegment(LpJsonState* segmentState) {
+			if (segmentState == nullptr
+				|| numberOfSegments >= MAX_SEGMENTS) {
+				return false;
+			}
+
+			segmentStates[numberOfSegments++] = segmentState;
+			return true;
+		}
+
+		/*!
+		  @brief   Executes the command that loads a Light Program into
+				   a segment or stops the program of the segment.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
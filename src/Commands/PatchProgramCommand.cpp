@@ -0,0 +1,70 @@
+#include "PatchProgramCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Reads the change from the POSTed body.
+	  @param   patch	Pointer to the change that is read.
+	  @returns True if the body is a well-formed change, false otherwise.
+	*/
+	bool PatchProgramCommand::ReadPatch(LpPatch* patch) {
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+
+		webDoc->clear();
+		if (deserializeJson(*webDoc, buf) != DeserializationError::Ok) {
+			return false;
+		}
+
+		patch->path = (*webDoc)["path"];
+		patch->lpi = (*webDoc)["lpi"];
+		patch->hex = (*webDoc)["hex"];
+		patch->palette = (*webDoc)["palette"];
+
+		JsonVariant duration = (*webDoc)["duration"];
+		JsonVariant at = (*webDoc)["at"];
+		JsonVariant times = (*webDoc)["times"];
+		if ((!duration.isNull() && !duration.is<int>())
+			|| (!at.isNull() && !at.is<int>())
+			|| (!times.isNull() && !times.is<int>())) {
+			return false;
+		}
+
+		patch->duration = duration.isNull() ? PATCH_NOT_SET : duration.as<int>();
+		patch->at = at.isNull() ? PATCH_NOT_SET : at.as<int>();
+		patch->times = times.isNull() ? PATCH_NOT_SET : times.as<int>();
+
+		return patch->path != nullptr
+			|| !patch->palette.isNull();
+	}
+
+	/*!
+	  @brief   Executes the command that changes an instruction
+			   of the executing program.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool PatchProgramCommand::ExecuteCommand() {
+		LpPatch patch;
+		if (!ReadPatch(&patch)) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		// the frame on display is taken before the change as frames rendered
+		// ahead of time are discarded once the state has changed
+		uint32_t frame = orchastor->GetProgramFrame();
+		if (!statePatcher->Patch(lpState, &patch)) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		// discard frames rendered (or cached) from the instruction before it
+		// was changed and carry on from the same frame, which also shows the change
+		lpState->MarkChanged();
+		orchastor->SeekProgram(frame);
+
+		// Respond with a 204 - no content reponse
+		lightWebServer->RespondNoContent();
+
+		return true;
+	}
+}
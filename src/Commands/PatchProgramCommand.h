@@ -0,0 +1,84 @@
+/*!
+ * @file PatchProgramCommand.h
+ *
+ * Handles a command to change an instruction
+ * of the executing program in place.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _PATCHPROGRAMCOMMAND_H
+#define _PATCHPROGRAMCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/IOrchastor.h"
+#include "../LPE/StateBuilder/LpJsonState.h"
+#include "../LPE/StateBuilder/LpStatePatcher.h"
+
+namespace LS {
+	/*!
+	@brief  PatchProgramCommand handles a command that has been received
+			to change a single instruction of the executing program without
+			loading the program again, so the program carries on from the
+			same rendering frame, e.g. as a colour is picked.  The POSTed
+			body addresses the instruction by its path (see LpPatch) and
+			gives the change, e.g.:
+
+			{"path":"2.0","lpi":"01200000FF0000"}		replaces an LPI
+			{"path":"1","at":10,"hex":"00FF00"}			replaces part of an LPI, e.g. a colour
+			{"path":"1","duration":4}					replaces the duration of an LPI
+			{"path":"2","times":5}						replaces the iterations of a repeat
+			{"palette":["00FF00","0000FF"]}				replaces the colours of the palette of the program
+	*/
+	class PatchProgramCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		LpStatePatcher* statePatcher;
+		LpJsonState* lpState;
+		IOrchastor* orchastor;
+
+	protected:
+		bool ReadPatch(LpPatch* patch);
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to parse the request.
+		  @param   statePatcher			Pointer to the class that changes the instructions of the program.
+		  @param   lpState				Pointer to the state of the executing program.
+		  @param   orchastor		    Pointer to the orchastrating class.
+		*/
+		PatchProgramCommand(
+			ILightWebServer* lightWebServer,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			LpStatePatcher* statePatcher,
+			LpJsonState* lpState,
+			IOrchastor* orchastor
+		) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->statePatcher = statePatcher;
+			this->lpState = lpState;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Executes the command that changes an instruction
+				   of the executing program.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
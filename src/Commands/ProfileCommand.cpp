@@ -0,0 +1,138 @@
+#include "ProfileCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Applies the settings in the body of a POSTed request (if any).
+	  @returns True if there were no settings or the settings were valid,
+			   false otherwise.
+	*/
+	bool ProfileCommand::ApplySettings() {
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+		if (buf[0] == '\0') {
+			return true;
+		}
+
+		webDoc->clear();
+		if (deserializeJson(*webDoc, buf) != DeserializationError::Ok) {
+			return false;
+		}
+
+		JsonVariant enabled = (*webDoc)["enabled"];
+		if (enabled.is<bool>()) {
+			profiler->SetEnabled(enabled.as<bool>());
+		}
+
+		if ((*webDoc)["reset"] == true) {
+			profiler->Clear();
+		}
+
+		return true;
+	}
+
+	/*!
+	  @brief   Writes the profile of a single LPI to the response.
+	  @param   position			The index of the LPI, and of each of its parents, in their instructions arrays.
+	  @param   depth			The number of parents of the LPI.
+	  @param   lpInstruction	A pointer to the LPI.
+	  @param   isFirst			True if this is the first LPI to be written, false otherwise.
+	*/
+	void ProfileCommand::WriteInstructionProfile(uint8_t* position, uint8_t depth, LpInstruction* lpInstruction, bool isFirst) {
+		LpInstructionProfile* profile = profiler->GetProfile(programState->GetLpInstructionIndex(lpInstruction));
+		if (profile == nullptr) {
+			return;
+		}
+
+		// the position in the LDL program e.g. 2.0.1
+		char index[(MAX_NESTED_LOOPS + 1) * 4];
+		char* indexEnd = index;
+		for (uint8_t level = 0; level <= depth; level++) {
+			indexEnd += sprintf(indexEnd, level == 0 ? "%u" : ".%u", position[level]);
+		}
+
+		// formatted directly rather than via the JSON document as six members
+		// do not reliably fit in the document on every platform
+		snprintf(webResponse->GetBuffer(), BUFFER_JSON_RESPONSE_SIZE,
+			"%s{\"index\":\"%s\",\"steps\":%u,\"frames\":%u,\"parse\":%lu,\"execute\":%lu,\"pixels\":%lu}",
+			isFirst ? "" : ",",
+			index,
+			profile->steps,
+			profile->frames,
+			(unsigned long)profile->parseTime,
+			(unsigned long)profile->executeTime,
+			(unsigned long)profile->pixelsTime);
+		lightWebServer->WriteResponse(webResponse->GetBuffer());
+	}
+
+	/*!
+	  @brief   Executes the command that gets the profile of the LPIs.  The
+			   response is written an LPI at a time as the profile of a large
+			   program does not fit in the response buffer.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool ProfileCommand::ExecuteCommand() {
+		// discard a profile that belongs to a previous program
+		profiler->Validate(programState);
+
+		if (!ApplySettings()) {
+			lightWebServer->RespondError();
+
+			return false;
+		}
+
+		lightWebServer->StartResponseOK();
+		lightWebServer->WriteResponse(profiler->IsEnabled() ? "{\"enabled\":true,\"instructions\":[" : "{\"enabled\":false,\"instructions\":[");
+
+		// walk the program tree in the order the instructions appear in the LDL
+		uint8_t position[MAX_NESTED_LOOPS + 1] = {};
+		CallInstruction* calls[MAX_NESTED_LOOPS + 1] = {};		// the call that each level of instructions was reached by
+		uint8_t depth = 0;
+		bool isFirst = true;
+		Instruction* instruction = programState->getFirstInstruction();
+		while (instruction != nullptr) {
+			// a call is profiled as the instruction that it calls
+			Instruction* calledInstruction = instruction->getInstructionType() == InstructionType::Call
+				? ((CallInstruction*)instruction)->GetCalledInstruction()
+				: instruction;
+			if (calledInstruction == nullptr) {
+				// nothing to profile
+			}
+			else if (calledInstruction->getInstructionType() == InstructionType::Lpi) {
+				WriteInstructionProfile(position, depth, (LpInstruction*)calledInstruction, isFirst);
+				isFirst = false;
+			}
+			else if (calledInstruction->getInstructionType() == InstructionType::Repeat
+				&& ((InstructionWithChild*)calledInstruction)->getFirstChild() != nullptr
+				&& depth < MAX_NESTED_LOOPS) {
+				// move down in to the instructions of the repeat (or subroutine)
+				calls[depth + 1] = calledInstruction != instruction ? (CallInstruction*)instruction : nullptr;
+				instruction = ((InstructionWithChild*)calledInstruction)->getFirstChild();
+				position[++depth] = 0;
+				continue;
+			}
+
+			// move to the next instruction, moving back up out of repeats that are complete
+			// (and back to the call that the instructions of a called repeat were reached by)
+			while (instruction != nullptr
+				&& instruction->getNext() == nullptr) {
+				instruction = calls[depth] != nullptr ? calls[depth] : instruction->getParent();
+				if (depth == 0) {
+					instruction = nullptr;
+				}
+				else {
+					depth--;
+				}
+			}
+
+			if (instruction != nullptr) {
+				instruction = instruction->getNext();
+				position[depth]++;
+			}
+		}
+
+		lightWebServer->WriteResponse("]}");
+		lightWebServer->EndResponse();
+
+		return true;
+	}
+}
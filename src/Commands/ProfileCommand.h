@@ -0,0 +1,90 @@
+/*!
+ * @file ProfileCommand.h
+ *
+ * Handles a command to retrieve, and
+ * optionally control, the profile of
+ * the time spent on each instruction
+ * of the loaded program.
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _PROFILECOMMAND_H
+#define _PROFILECOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../FixedSizeCharBuffer.h"
+#include "../ValueDomainTypes.h"
+#include "../LPE/Executor/LpProfiler.h"
+#include "../LPE/StateBuilder/LpState.h"
+
+namespace LS {
+	/*!
+	@brief  ProfileCommand handles a command that has been
+			received in order to get the profile of the LPIs
+			of the loaded program.  The profile of each LPI is
+			reported against its position in the instructions
+			arrays of the LDL program, e.g. "1.0" is the first
+			instruction within the second instruction (a repeat).
+			An instruction that shares another instruction (an
+			identical instruction or a subroutine) is reported at
+			each of its positions with the profile of the shared
+			instruction, with the instructions of a subroutine
+			within the position of the call, e.g. "3.1" is the
+			second instruction of the subroutine called by the
+			fourth instruction.
+			A POSTed body of the form {"enabled":true,"reset":true}
+			turns profiling on or off and discards the profile
+			before it is returned.
+	*/
+	class ProfileCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		FixedSizeCharBuffer* webResponse;
+		LpProfiler* profiler;
+		LpState* programState;
+
+	protected:
+		bool ApplySettings();
+		void WriteInstructionProfile(uint8_t* position, uint8_t depth, LpInstruction* lpInstruction, bool isFirst);
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to construct the JSON web response.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   profiler				Pointer to the profiler that time is attributed to.
+		  @param   programState			Pointer to the state of the program that is profiled.
+		*/
+		ProfileCommand(
+			ILightWebServer* lightWebServer,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			LpProfiler* profiler,
+			LpState* programState
+		) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->webResponse = webResponse;
+			this->profiler = profiler;
+			this->programState = programState;
+		}
+
+		/*!
+		  @brief   Executes the command that gets the
+				   profile of the LPIs.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
@@ -0,0 +1,107 @@
+#include "QueueProgramCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Validates each of the LPIs in the POSTed body.  Each line
+			   is terminated in place so that it can be validated.
+	  @param   lpis				Pointer to the LPIs, one per line.
+	  @param   lpisLength		The number of characters in the body.
+	  @param   numberOfLpis		Pointer to the number of LPIs that is counted.
+	  @returns True if every LPI is valid, false otherwise.
+	*/
+	bool QueueProgramCommand::ValidateLpis(char* lpis, uint16_t lpisLength, uint8_t* numberOfLpis) {
+		for (uint16_t index = 0; index < lpisLength; index++) {
+			if (lpis[index] == '\n'
+				|| lpis[index] == '\r') {
+				lpis[index] = '\0';
+			}
+		}
+
+		IJsonInstructionValidator* lpiValidator = validatorFactory->GetValidator(InstructionType::Lpi);
+		*numberOfLpis = 0;
+		for (uint16_t lpiStart = 0; lpiStart < lpisLength; lpiStart += strlen(&lpis[lpiStart]) + 1) {
+			if (lpis[lpiStart] == '\0') {
+				continue;
+			}
+
+			// the validator takes the LPI as a JSON variant (that references the LPI)
+			webDoc->clear();
+			JsonVariant lpiVar = webDoc->to<JsonVariant>();
+			lpiVar.set((const char*)&lpis[lpiStart]);
+
+			validateResult.ResetResult(LPValidateCode::Valid);
+			lpiValidator->Validate(&lpiVar, &validateResult);
+			if (validateResult.GetCode() != LPValidateCode::Valid
+				|| ++(*numberOfLpis) > LPI_QUEUE_LPIS) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	  @brief   Appends the LPIs, in order, to the queue until the queue is full.
+	  @param   lpis				Pointer to the LPIs, each terminated.
+	  @param   lpisLength		The number of characters in the body.
+	  @returns The number of LPIs that were queued.
+	*/
+	uint8_t QueueProgramCommand::QueueLpis(const char* lpis, uint16_t lpisLength) {
+		uint8_t numberQueued = 0;
+		for (uint16_t lpiStart = 0; lpiStart < lpisLength; lpiStart += strlen(&lpis[lpiStart]) + 1) {
+			uint16_t lpiLength = strlen(&lpis[lpiStart]);
+			if (lpiLength == 0) {
+				continue;
+			}
+
+			// the LPIs that follow one that does not fit are held back
+			// so that the LPIs are always executed in order
+			if (!lpiQueue->Push(&lpis[lpiStart], lpiLength)) {
+				break;
+			}
+			numberQueued++;
+		}
+
+		return numberQueued;
+	}
+
+	/*!
+	  @brief   Executes the command that appends LPIs to the
+			   queue of a queue-fed show.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool QueueProgramCommand::ExecuteCommand() {
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+		uint16_t bodyLength = strlen(buf);
+
+		uint8_t numberOfLpis = 0;
+		if (!ValidateLpis(buf, bodyLength, &numberOfLpis)) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		if (lpState->GetLpiQueue() != lpiQueue) {
+			// the queue holds nothing of interest until the show is queue-fed
+			lpiQueue->Clear();
+
+			if (numberOfLpis > 0) {
+				// the queue-fed show takes the place of the program
+				orchastor->StopPrograms();
+				lpState->SetLpiQueue(lpiQueue);
+			}
+		}
+
+		uint8_t numberQueued = numberOfLpis > 0 ? QueueLpis(buf, bodyLength) : 0;
+
+		snprintf(webResponse->GetBuffer(), BUFFER_JSON_RESPONSE_SIZE,
+			"{\"accepted\":%u,\"queued\":%u,\"space\":%u}",
+			numberQueued,
+			lpiQueue->GetNumberOfLpis(),
+			lpiQueue->GetSpace());
+
+		lightWebServer->RespondOK(webResponse->GetBuffer());
+
+		return true;
+	}
+}
@@ -0,0 +1,102 @@
+/*!
+ * @file QueueProgramCommand.h
+ *
+ * Handles a command to append LPIs to the
+ * queue of a queue-fed show.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _QUEUEPROGRAMCOMMAND_H
+#define _QUEUEPROGRAMCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../FixedSizeCharBuffer.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/IOrchastor.h"
+#include "../LPE/InstructionType.h"
+#include "../LPE/StateBuilder/LpState.h"
+#include "../LPE/StateBuilder/LpiQueue.h"
+#include "../LPE/Validation/JsonInstructionValidatorFactory.h"
+
+namespace LS {
+	/*!
+	@brief  QueueProgramCommand handles a command that has been received
+			to append LPIs to the queue of a queue-fed show, in which the
+			LPIs are executed one after the other in place of a program so
+			that a show of unlimited length runs in constant memory.  The
+			POSTed body has one LPI per line, e.g.
+
+			01200000FF0000
+			0120000000FF00
+
+			The first LPIs that are POSTed stop the program and start the
+			queue-fed show, which continues until a program is loaded or the
+			programs are stopped.  Every LPI is validated before any is queued.
+			LPIs are queued, in order, until the queue is full so the response
+			reports the backpressure, e.g. {"accepted":2,"queued":5,"space":380}:
+			the number of LPIs accepted (the client re-sends the rest later), the
+			number of LPIs in the queue and the length of the longest LPI that
+			can be queued now.  A GET reports the same without queueing anything.
+	*/
+	class QueueProgramCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		FixedSizeCharBuffer* webResponse;
+		JsonInstructionValidatorFactory* validatorFactory;
+		LpiQueue* lpiQueue;
+		LpState* lpState;
+		IOrchastor* orchastor;
+		LPValidateResult validateResult;
+
+	protected:
+		bool ValidateLpis(char* lpis, uint16_t lpisLength, uint8_t* numberOfLpis);
+		uint8_t QueueLpis(const char* lpis, uint16_t lpisLength);
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to validate the LPIs.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   validatorFactory		Pointer to the factory of the validators of instructions.
+		  @param   lpiQueue				Pointer to the queue of LPIs.
+		  @param   lpState				Pointer to the state of the executing program.
+		  @param   orchastor		    Pointer to the orchastrating class.
+		*/
+		QueueProgramCommand(
+			ILightWebServer* lightWebServer,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			JsonInstructionValidatorFactory* validatorFactory,
+			LpiQueue* lpiQueue,
+			LpState* lpState,
+			IOrchastor* orchastor
+		) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->webResponse = webResponse;
+			this->validatorFactory = validatorFactory;
+			this->lpiQueue = lpiQueue;
+			this->lpState = lpState;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Executes the command that appends LPIs to the
+				   queue of a queue-fed show.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
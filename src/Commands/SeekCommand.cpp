@@ -0,0 +1,31 @@
+#include "SeekCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Executes the command that moves the executing
+			   program to a rendering frame.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool SeekCommand::ExecuteCommand() {
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+
+		webDoc->clear();
+		if (deserializeJson(*webDoc, buf) != DeserializationError::Ok) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		JsonVariant frame = (*webDoc)["frame"];
+		if (!frame.is<uint32_t>()
+			|| !orchastor->SeekProgram(frame.as<uint32_t>())) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		// Respond with a 204 - no content reponse
+		lightWebServer->RespondNoContent();
+
+		return true;
+	}
+}
@@ -0,0 +1,59 @@
+/*!
+ * @file SeekCommand.h
+ *
+ * Handles a command to move the executing
+ * program to a rendering frame.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _SEEKCOMMAND_H
+#define _SEEKCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../ValueDomainTypes.h"
+#include "../Orchastrator/IOrchastor.h"
+
+namespace LS {
+	/*!
+	@brief  SeekCommand handles a command that has been received
+			to move the executing program to a rendering frame, as
+			though it had been executing for that many frames, e.g.
+			to resume a program or to line up several servers.  The
+			POSTed body is of the form {"frame":1200}.
+	*/
+	class SeekCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		IOrchastor* orchastor;
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to parse the request.
+		  @param   orchastor		    Pointer to the orchastrating class.
+		*/
+		SeekCommand(ILightWebServer* lightWebServer, StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc, IOrchastor* orchastor) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Executes the command that moves the executing
+				   program to a rendering frame.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
@@ -23,10 +23,15 @@ namespace LS {
 		// clear all LEDs that are on at the moment and set the new length of pixels
 		pixelController->fill(0, 0, 0);
 		pixelController->show();
-		pixelController->updateLength((uint16_t)newNoLeds);
+		// the number of LEDs configured may be longer than the LEDs attached (e.g. on a fan-out master)
+		pixelController->updateLength((uint16_t)(localLeds != 0 && newNoLeds > localLeds ? localLeds : newNoLeds));
 
 		// save the new number of LEDs to config persistent storage
 		ledConfig->numberOfLEDs = newNoLeds;
+		if (!ledConfig->AreSegmentsValid()) {
+			// the segments no longer fit on the LEDs
+			ledConfig->numberOfSegments = 0;
+		}
 		configPersistance->SaveConfig(ledConfig);
 
 		// Reset the program state as it results in strange renderning behaviour
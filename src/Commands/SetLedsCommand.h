@@ -35,11 +35,14 @@ namespace LS {
 		IConfigPersistance* configPersistance;
 		IPixelController* pixelController;
 		LpState* programState;
+		uint16_t localLeds;
 	public:
 		/*!
 		  @brief   Executes the command to set the configuration of the connected leds.
 		  @param   lightWebServer		Pointer to the class that handles web requests.
 		  @param   stringProcessor		Pointer to the class that provides string parsing functionality.
+		  @param   localLeds			The most LEDs attached to this server, e.g. on a fan-out master
+										where the rest of the strip is on the followers (0 = no limit).
 		*/
 		SetLedsCommand(
 			ILightWebServer* lightWebServer, 
@@ -47,13 +50,15 @@ namespace LS {
 			LEDConfig* ledConfig, 
 			IConfigPersistance* configPersistance, 
 			IPixelController* pixelController, 
-			LpState* programState) {
+			LpState* programState,
+			uint16_t localLeds = 0) {
 			this->lightWebServer = lightWebServer;
 			this->stringProcessor = stringProcessor;
 			this->ledConfig = ledConfig;
 			this->configPersistance = configPersistance;
 			this->pixelController = pixelController;
 			this->programState = programState;
+			this->localLeds = localLeds;
 		}
 
 		/*!
@@ -0,0 +1,78 @@
+#include "SetSegmentsCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Reads the segments from the POSTed body.
+	  @param   segments				Pointer to the segments that are read.
+	  @param   numberOfSegments		Pointer to the value that is set to the number of segments read.
+	  @returns True if the segments were read, false if the body is not valid.
+	*/
+	bool SetSegmentsCommand::ReadSegments(LEDSegment* segments, uint8_t* numberOfSegments) {
+		StaticJsonDocument<SEGMENTS_JSON_SIZE> segmentsDoc;
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+		if (deserializeJson(segmentsDoc, buf) != DeserializationError::Ok) {
+			return false;
+		}
+
+		JsonVariant segmentsVar = segmentsDoc["segments"];
+		if (!segmentsVar.is<JsonArray>()
+			|| segmentsVar.size() > MAX_SEGMENTS) {
+			return false;
+		}
+
+		*numberOfSegments = 0;
+		for (JsonVariant segmentVar : segmentsVar.as<JsonArray>()) {
+			const char* name = segmentVar["name"];
+			if (name == nullptr
+				|| strlen(name) >= SEGMENT_NAME_SIZE
+				|| !segmentVar["first"].is<uint16_t>()
+				|| !segmentVar["leds"].is<uint16_t>()) {
+				return false;
+			}
+
+			LEDSegment* segment = &segments[(*numberOfSegments)++];
+			strcpy(segment->name, name);
+			segment->firstLed = segmentVar["first"];
+			segment->numberOfLEDs = segmentVar["leds"];
+		}
+
+		return true;
+	}
+
+	/*!
+	  @brief   Executes the command to set the segments of the connected leds.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool SetSegmentsCommand::ExecuteCommand() {
+		LEDSegment segments[MAX_SEGMENTS];
+		uint8_t numberOfSegments = 0;
+		if (!ReadSegments(segments, &numberOfSegments)) {
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		LEDSegment previousSegments[MAX_SEGMENTS];
+		uint8_t previousNumberOfSegments = ledConfig->numberOfSegments;
+		memcpy(previousSegments, ledConfig->segments, sizeof(previousSegments));
+
+		memcpy(ledConfig->segments, segments, sizeof(segments));
+		ledConfig->numberOfSegments = numberOfSegments;
+		if (!ledConfig->AreSegmentsValid()) {
+			// the segments overlap or do not fit on the LEDs so the segments are unchanged
+			memcpy(ledConfig->segments, previousSegments, sizeof(previousSegments));
+			ledConfig->numberOfSegments = previousNumberOfSegments;
+			lightWebServer->RespondError();
+			return false;
+		}
+
+		// the programs of the segments stop as the ranges they play on have changed
+		orchastor->StopSegments();
+
+		configPersistance->SaveConfig(ledConfig);
+
+		lightWebServer->RespondNoContent();
+
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+/*!
+ * @file SetSegmentsCommand.h
+ *
+ * Handles a command that has been received
+ * to set the segments of the connected leds.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _SETSEGMENTSCOMMAND_H
+#define _SETSEGMENTSCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../ValueDomainTypes.h"
+#include "../ConfigPersistance/IConfigPersistance.h"
+#include "../Orchastrator/IOrchastor.h"
+
+// the segments are read into a document of their own as the JSON response document is too small for them all
+#define SEGMENTS_JSON_SIZE		(JSON_OBJECT_SIZE(1) + JSON_ARRAY_SIZE(MAX_SEGMENTS) + MAX_SEGMENTS * JSON_OBJECT_SIZE(3))
+
+namespace LS {
+	/*!
+	@brief  SetSegmentsCommand handles a command that has been received
+			to set the segments of the connected leds: named ranges of the
+			LEDs that can each play a program of their own, e.g.
+
+			{ "segments": [ { "name": "roof", "first": 0, "leds": 100 }, { "name": "tree", "first": 100, "leds": 50 } ] }
+
+			The segments must be in order along the LEDs and not overlap.  An
+			empty array removes all of the segments.  The programs of the
+			segments are stopped and the segments are stored permanently.
+	*/
+	class SetSegmentsCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		LEDConfig* ledConfig;
+		IConfigPersistance* configPersistance;
+		IOrchastor* orchastor;
+
+	protected:
+		bool ReadSegments(LEDSegment* segments, uint8_t* numberOfSegments);
+
+	public:
+		/*!
+		  @brief   Executes the command to set the segments of the connected leds.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   ledConfig			Pointer to the configuration of the LEDs that stores the segments.
+		  @param   configPersistance	Pointer to the class that stores the configuration permanently.
+		  @param   orchastor			Pointer to the orchastrating class that plays the programs of the segments.
+		*/
+		SetSegmentsCommand(
+			ILightWebServer* lightWebServer,
+			LEDConfig* ledConfig,
+			IConfigPersistance* configPersistance,
+			IOrchastor* orchastor) {
+			this->lightWebServer = lightWebServer;
+			this->ledConfig = ledConfig;
+			this->configPersistance = configPersistance;
+			this->orchastor = orchastor;
+		}
+
+		/*!
+		  @brief   Executes the command to set the segments of the connected leds.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
@@ -0,0 +1,81 @@
+#include "SyncCommand.h"
+
+namespace LS {
+	/*!
+	  @brief   Applies the settings in the body of a POSTed request (if any).
+	  @returns True if there were no settings or the settings were valid,
+			   false otherwise.
+	*/
+	bool SyncCommand::ApplySettings() {
+		char* buf = lightWebServer->GetLoadingBuffer(false);
+		if (buf[0] == '\0') {
+			return true;
+		}
+
+		webDoc->clear();
+		if (deserializeJson(*webDoc, buf) != DeserializationError::Ok) {
+			return false;
+		}
+
+		const char* role = (*webDoc)["role"];
+		if (role == nullptr) {
+			return false;
+		}
+
+		if (strcmp(role, "master") == 0) {
+			frameSync->SetRole(FrameSyncRole::SyncMaster);
+		}
+		else if (strcmp(role, "follower") == 0) {
+			frameSync->SetRole(FrameSyncRole::SyncFollower);
+		}
+		else if (strcmp(role, "off") == 0) {
+			frameSync->SetRole(FrameSyncRole::SyncOff);
+		}
+		else {
+			return false;
+		}
+
+		return true;
+	}
+
+	/*!
+	  @brief   Executes the command that gets the quality
+			   of the frame clock synchronisation.
+	  @returns True if the command was executed successfully or
+			   false if it did not execute successfully.
+	*/
+	bool SyncCommand::ExecuteCommand() {
+		if (!ApplySettings()) {
+			lightWebServer->RespondError();
+
+			return false;
+		}
+
+		const char* role = "off";
+		if (frameSync->GetRole() == FrameSyncRole::SyncMaster) {
+			role = "master";
+		}
+		else if (frameSync->GetRole() == FrameSyncRole::SyncFollower) {
+			role = "follower";
+		}
+
+		// formatted directly rather than via the JSON document as the
+		// members do not fit in the document
+		FrameSyncQuality* quality = frameSync->GetQuality();
+		snprintf(webResponse->GetBuffer(), BUFFER_JSON_RESPONSE_SIZE,
+			"{\"role\":\"%s\",\"locked\":%s,\"error\":%ld,\"average\":%u,\"sent\":%lu,\"received\":%lu,\"ignored\":%lu,\"seeks\":%lu,\"age\":%lu}",
+			role,
+			frameSync->IsLocked() ? "true" : "false",
+			(long)quality->lastError,
+			quality->averageError,
+			(unsigned long)quality->beaconsSent,
+			(unsigned long)quality->beaconsReceived,
+			(unsigned long)quality->beaconsIgnored,
+			(unsigned long)quality->seeks,
+			(unsigned long)frameSync->GetTimeSinceLastBeacon());
+
+		lightWebServer->RespondOK(webResponse->GetBuffer());
+
+		return true;
+	}
+}
@@ -0,0 +1,72 @@
+/*!
+ * @file SyncCommand.h
+ *
+ * Handles a command to retrieve, and
+ * optionally change, how this server keeps
+ * its frame clock in step with other servers.
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _SYNCCOMMAND_H
+#define _SYNCCOMMAND_H
+
+#include "ICommand.h"
+#include "../DomainInterfaces.h"
+#include "../ArduinoJson-v6.17.2.h"
+#include "../FixedSizeCharBuffer.h"
+#include "../ValueDomainTypes.h"
+#include "../Networking/FrameClockSync.h"
+
+namespace LS {
+	/*!
+	@brief  SyncCommand handles a command that has been
+			received in order to get the quality of the frame
+			clock synchronisation.  A POSTed body of the form
+			{"role":"follower"} first changes the role of the
+			server to "master", "follower" or "off".
+	*/
+	class SyncCommand : public ICommand
+	{
+	private:
+		ILightWebServer* lightWebServer;
+		StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc;
+		FixedSizeCharBuffer* webResponse;
+		FrameClockSync* frameSync;
+
+	protected:
+		bool ApplySettings();
+
+	public:
+		/*!
+		  @brief   Constructor injects the dependencies.
+		  @param   lightWebServer		Pointer to the class that handles web requests.
+		  @param   webDoc				Pointer to the Arduino JSON document that is used to parse the request.
+		  @param   webResponse			Pointer to the buffer that stores the HTTP reponse.
+		  @param   frameSync			Pointer to the class that keeps the frame clock in step.
+		*/
+		SyncCommand(
+			ILightWebServer* lightWebServer,
+			StaticJsonDocument<BUFFER_JSON_RESPONSE_SIZE>* webDoc,
+			FixedSizeCharBuffer* webResponse,
+			FrameClockSync* frameSync
+		) {
+			this->lightWebServer = lightWebServer;
+			this->webDoc = webDoc;
+			this->webResponse = webResponse;
+			this->frameSync = frameSync;
+		}
+
+		/*!
+		  @brief   Executes the command that gets the quality
+				   of the frame clock synchronisation.
+		  @returns True if the command was executed successfully or
+				   false if it did not execute successfully.
+		*/
+		bool ExecuteCommand();
+	};
+}
+#endif
@@ -54,7 +54,18 @@ namespace LS {
 		POWERON,		// Turn on all LEDs to white unless an explicit colour has been specified
 		CHECKPOWER,		// Returns the state of the LEDS (whether any are curently on or not)
 		GETABOUT,		// Returns information about the server (versions and stuff)
-		SETLEDS			// Sets the number of connected LEDs
+		SETLEDS,		// Sets the number of connected LEDs
+		GETSTATUS,		// Returns the run-time status of the server (frame governor decisions and frame cache use)
+		PROFILE,		// Returns (and optionally controls) the profile of the time spent on each LPI
+		SEEKPROGRAM,	// Moves the executing LP to a rendering frame
+		SYNC,			// Returns (and optionally changes) how the frame clock is kept in step with other servers
+		BATCH,			// Executes an ordered list of commands and returns one combined response
+		PATCHPROGRAM,	// Changes an instruction of the executing LP in place
+		QUEUEPROGRAM,	// Appends LPIs to the queue of a queue-fed show
+		LOADLAYER,		// Loads an LP into a layer that is composited over the executing LP (or changes how it is blended)
+		SETSEGMENTS,	// Sets the named ranges of the LEDs that can play LPs of their own
+		LOADSEGMENT,	// Loads an LP into a segment of the LEDs (or stops the LP of the segment)
+		COMMANDTYPE_COUNT	// Not a command: the number of command types (new types are added above)
 	};
 
 	/*!
@@ -171,11 +182,38 @@ namespace LS {
 			*/
 			virtual void RespondOK(const char* str) = 0;
 
+			/*!
+			@brief		Starts a HTTP OK (200) response whose body is written in parts using
+						WriteResponse.  Used for bodies that are too large to be held in memory.
+			*/
+			virtual void StartResponseOK() = 0;
+
+			/*!
+			@brief		Writes part of the body of a response started with StartResponseOK.
+			@param		str			Pointer to a buffer that contains the text to be sent.
+			*/
+			virtual void WriteResponse(const char* str) = 0;
+
+			/*!
+			@brief		Closes the current connection once the body of a response started
+						with StartResponseOK has been written.
+			*/
+			virtual void EndResponse() = 0;
+
 			/*!
 			@brief		Checks whether a new command has been received and returns the command type.
 			@returns	CommandType		The type of command that has been received (if any).
 			*/
 			virtual CommandType HandleNextCommand() = 0;
+
+			/*!
+			@brief		Checks whether a new command has been received on a channel that is cheap
+						enough to check between rendering frames (e.g. UDP) and returns the command type.
+			@returns	CommandType		The type of command that has been received (if any).
+			*/
+			virtual CommandType HandleNextQuickCommand() {
+				return CommandType::NONE;
+			}
 	};
 }
 
@@ -0,0 +1,226 @@
+#include "ExpressionEffect.h"
+
+namespace LS {
+	// a quarter of a sine wave, from 0 to 127, that the whole wave is made from
+	const uint8_t ExpressionEffect::quarterSine[65] = {
+		0, 3, 6, 9, 12, 16, 19, 22, 25, 28, 31, 34, 37, 40, 43, 46,
+		49, 51, 54, 57, 60, 63, 65, 68, 71, 73, 76, 78, 81, 83, 85, 88,
+		90, 92, 94, 96, 98, 100, 102, 104, 106, 107, 109, 111, 112, 113, 115, 116,
+		117, 118, 120, 121, 122, 122, 123, 124, 125, 125, 126, 126, 126, 127, 127, 127,
+		127
+	};
+
+	/*!
+		@brief		Compiles an expression into bytecode, unless it is the expression
+					that was compiled last.  The expression is checked so that each operation
+					has the values it takes on the stack, there are never more than
+					EXPRESSION_MAX_STACK values on the stack and a single value, the result,
+					is left on the stack.
+		@param		expression			A pointer to the expression.
+		@param		stringProcessor		A pointer to the class that provides string parsing.
+		@returns	True if the expression is valid, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool ExpressionEffect::Compile(const char* expression, StringProcessor* stringProcessor) {
+		if (expression == nullptr
+			|| stringProcessor == nullptr) {
+			return false;
+		}
+
+		if (IsCompiledFrom(expression)) {
+			return true;
+		}
+
+		// nothing is evaluated unless the expression compiles
+		codeLength = 0;
+		numberOfOperations = 0;
+		if (strlen(expression) > EXPRESSION_MAX_LENGTH) {
+			return false;
+		}
+
+		uint8_t compiledLength = 0;
+		uint8_t compiledOperations = 0;
+		uint8_t stackDepth = 0;
+		const char* pExpression = expression;
+		while (*pExpression != '\0') {
+			uint8_t operation = 0;
+			uint8_t operands = 0;
+			int8_t stackChange = 0;
+			if (!GetOperation(*pExpression++, &operation, &operands, &stackChange)
+				|| stackDepth < operands
+				|| stackDepth + stackChange > EXPRESSION_MAX_STACK) {
+				return false;
+			}
+			stackDepth += stackChange;
+			code[compiledLength++] = operation;
+			compiledOperations++;
+
+			if (operation == ExpressionOp::PushLiteral) {
+				// the number of a literal is two hex digits
+				bool isValid = false;
+				uint8_t number = stringProcessor->ExtractNumberFromHexEncoded(pExpression, 0, 255, isValid);
+				if (!isValid) {
+					return false;
+				}
+				code[compiledLength++] = number;
+				pExpression += 2;
+			}
+		}
+
+		if (stackDepth != 1) {
+			return false;
+		}
+
+		codeLength = compiledLength;
+		numberOfOperations = compiledOperations;
+		strcpy(source, expression);
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets whether an expression is the one that has been compiled.
+		@param		expression		A pointer to the expression.
+		@returns	True if the expression has been compiled, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool ExpressionEffect::IsCompiledFrom(const char* expression) {
+		return expression != nullptr
+			&& codeLength > 0
+			&& strcmp(source, expression) == 0;
+	}
+
+	/*!
+		@brief		Gets the operation of a single character of an expression.
+		@param		token			The character.
+		@param		operation		A pointer to the value that is set to the operation.
+		@param		operands		A pointer to the value that is set to the number of values
+									that the operation takes from the top of the stack.
+		@param		stackChange		A pointer to the value that is set to the change in the
+									number of values on the stack once the operation is evaluated.
+		@returns	True if the character is an operation, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool ExpressionEffect::GetOperation(char token, uint8_t* operation, uint8_t* operands, int8_t* stackChange) {
+		*operands = 2;			// most operations take two values and push one
+		*stackChange = -1;
+		switch (token) {
+			case 'i': *operation = ExpressionOp::PushPixel; *operands = 0; *stackChange = 1; break;
+			case 't': *operation = ExpressionOp::PushStep; *operands = 0; *stackChange = 1; break;
+			case 'n': *operation = ExpressionOp::PushLeds; *operands = 0; *stackChange = 1; break;
+			case '#': *operation = ExpressionOp::PushLiteral; *operands = 0; *stackChange = 1; break;
+			case '+': *operation = ExpressionOp::Add; break;
+			case '-': *operation = ExpressionOp::Subtract; break;
+			case 'x': *operation = ExpressionOp::Multiply; break;
+			case '/': *operation = ExpressionOp::Divide; break;
+			case '%': *operation = ExpressionOp::Modulo; break;
+			case '&': *operation = ExpressionOp::BitwiseAnd; break;
+			case '|': *operation = ExpressionOp::BitwiseOr; break;
+			case '^': *operation = ExpressionOp::BitwiseXor; break;
+			case '>': *operation = ExpressionOp::Greater; break;
+			case 'q': *operation = ExpressionOp::Scale; break;
+			case 's': *operation = ExpressionOp::Sine; *operands = 1; *stackChange = 0; break;
+			case 'w': *operation = ExpressionOp::Triangle; *operands = 1; *stackChange = 0; break;
+			case 'h': *operation = ExpressionOp::Noise; *operands = 1; *stackChange = 0; break;
+			case 'd': *operation = ExpressionOp::Duplicate; *operands = 1; *stackChange = 1; break;
+			case '~': *operation = ExpressionOp::Swap; *stackChange = 0; break;
+			default:
+				return false;
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Evaluates the compiled expression for a pixel.
+		@param		pixel			The index of the pixel.
+		@param		step			The step of the animation.
+		@param		numberOfLeds	The number of LEDs.
+		@returns	The result of the expression, limited to 0 - 255 (0 if no
+					expression has been compiled).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t ExpressionEffect::Evaluate(uint16_t pixel, uint16_t step, uint16_t numberOfLeds) {
+		int32_t stack[EXPRESSION_MAX_STACK];
+		int32_t* top = stack - 1;		// the value on the top of the stack
+
+		for (uint8_t codeIndex = 0; codeIndex < codeLength; codeIndex++) {
+			int32_t value;
+			switch (code[codeIndex]) {
+				case ExpressionOp::PushPixel: *++top = pixel; break;
+				case ExpressionOp::PushStep: *++top = step; break;
+				case ExpressionOp::PushLeds: *++top = numberOfLeds; break;
+				case ExpressionOp::PushLiteral: *++top = code[++codeIndex]; break;
+				case ExpressionOp::Add: value = *top--; *top += value; break;
+				case ExpressionOp::Subtract: value = *top--; *top -= value; break;
+				case ExpressionOp::Multiply: value = *top--; *top *= value; break;
+				case ExpressionOp::Divide: value = *top--; *top = value == 0 ? 0 : *top / value; break;
+				case ExpressionOp::Modulo: value = *top--; *top = value == 0 ? 0 : *top % value; break;
+				case ExpressionOp::BitwiseAnd: value = *top--; *top &= value; break;
+				case ExpressionOp::BitwiseOr: value = *top--; *top |= value; break;
+				case ExpressionOp::BitwiseXor: value = *top--; *top ^= value; break;
+				case ExpressionOp::Greater: value = *top--; *top = *top > value ? 1 : 0; break;
+				case ExpressionOp::Scale: value = *top--; *top = (*top * value) >> 8; break;
+				case ExpressionOp::Sine: *top = Sine8((uint8_t)*top); break;
+				case ExpressionOp::Triangle: value = (uint8_t)*top; *top = value < 128 ? value * 2 : (255 - value) * 2; break;
+				case ExpressionOp::Noise: *top = Noise8((uint32_t)*top); break;
+				case ExpressionOp::Duplicate: value = *top; *++top = value; break;
+				case ExpressionOp::Swap: value = *top; *top = *(top - 1); *(top - 1) = value; break;
+			}
+		}
+
+		if (top < stack) {
+			return 0;
+		}
+
+		return *top < 0 ? 0 : *top > 255 ? 255 : *top;
+	}
+
+	/*!
+		@brief		Gets the number of operations of the compiled expression.
+		@returns	The number of operations (0 if no expression has been compiled).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t ExpressionEffect::GetNumberOfOperations() {
+		return numberOfOperations;
+	}
+
+	/*!
+		@brief		Calculates a sine wave from a table of a quarter of the wave.
+		@param		angle		The angle, where 0 - 255 is a whole period.
+		@returns	The value of the wave from 0 (at 192) to 255 (at 64), 128 at 0.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t ExpressionEffect::Sine8(uint8_t angle) {
+		uint8_t index = angle & 63;
+		switch (angle >> 6) {
+			case 0: return 128 + quarterSine[index];
+			case 1: return 128 + quarterSine[64 - index];
+			case 2: return 128 - quarterSine[index];
+			default: return 128 - quarterSine[64 - index];
+		}
+	}
+
+	/*!
+		@brief		Hashes a value so that neighbouring values give unrelated results,
+					e.g. to twinkle pixels without a random number generator (so the
+					same pixel and step always give the same result).
+		@param		value		The value.
+		@returns	The hash of the value from 0 - 255.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t ExpressionEffect::Noise8(uint32_t value) {
+		value *= 2654435761UL;
+		value ^= value >> 15;
+		value *= 2246822519UL;
+
+		return value >> 24;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef _ExpressionEffect_h
+#define _ExpressionEffect_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ValueDomainTypes.h"
+#include "../../StringProcessor.h"
+#include <string.h>
+
+#define EXPRESSION_MAX_LENGTH		64		// most characters of an expression
+#define EXPRESSION_MAX_STACK		8		// most values on the stack whilst an expression is evaluated
+
+namespace LS {
+	/*!
+		@brief		The operations of a compiled expression.
+	*/
+	enum ExpressionOp {
+		PushPixel,			// i: index of the pixel
+		PushStep,			// t: step of the animation
+		PushLeds,			// n: number of LEDs
+		PushLiteral,		// #hh: a number (00 - FF), held in the byte that follows the operation
+		Add,				// +
+		Subtract,			// -
+		Multiply,			// x
+		Divide,				// / (0 when dividing by 0)
+		Modulo,				// % (0 when dividing by 0)
+		BitwiseAnd,			// &
+		BitwiseOr,			// |
+		BitwiseXor,			// ^
+		Greater,			// > (1 if greater, otherwise 0)
+		Scale,				// q: a x b / 256
+		Sine,				// s: sine wave, one period over 0 - 255, from 0 - 255
+		Triangle,			// w: triangle wave, one period over 0 - 255, from 0 - 254
+		Noise,				// h: a hash of the value, from 0 - 255
+		Duplicate,			// d: pushes the value on the top of the stack again
+		Swap				// ~: swaps the two values on the top of the stack
+	};
+
+	/*!
+		@brief		Compiles an expression, written in postfix (reverse Polish)
+					notation with a single character for each operation, into
+					bytecode and evaluates it for each pixel using integer arithmetic
+					only.  For example "i#08xt#04x+s" is a sine wave of 32 pixels
+					that moves 4/256ths of a period on each step.  The expression
+					is only compiled again when it changes.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	class ExpressionEffect {
+	protected:
+		static const uint8_t quarterSine[65];
+
+		char source[EXPRESSION_MAX_LENGTH + 1] = {};		// the expression that was compiled
+		uint8_t code[EXPRESSION_MAX_LENGTH];				// each operation, followed by the number of a literal
+		uint8_t codeLength = 0;
+		uint8_t numberOfOperations = 0;
+
+		static bool GetOperation(char token, uint8_t* operation, uint8_t* operands, int8_t* stackChange);
+
+	public:
+		bool Compile(const char* expression, StringProcessor* stringProcessor);
+		bool IsCompiledFrom(const char* expression);
+		uint8_t Evaluate(uint16_t pixel, uint16_t step, uint16_t numberOfLeds);
+		uint8_t GetNumberOfOperations();
+
+		static uint8_t Sine8(uint8_t angle);
+		static uint8_t Noise8(uint32_t value);
+	};
+}
+
+#endif
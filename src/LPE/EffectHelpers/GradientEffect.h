@@ -4,10 +4,10 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
-#include "..\..\ValueDomainTypes.h"
+#include "../../ValueDomainTypes.h"
 #include <math.h>
 
 #define max(a,b) (a>b?a:b)
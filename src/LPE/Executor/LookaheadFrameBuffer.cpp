@@ -0,0 +1,210 @@
+#include "LookaheadFrameBuffer.h"
+
+namespace LS {
+	/*!
+		@brief		Gets an entry relative to the oldest entry.
+		@param		entryIndex	The index of the entry where 0 is the oldest entry.
+		@returns	A pointer to the entry.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LookaheadFrame* LookaheadFrameBuffer::GetEntry(uint8_t entryIndex) {
+		return &frames[(firstFrame + entryIndex) % LOOKAHEAD_FRAMES];
+	}
+
+	/*!
+		@brief		Removes all of the frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LookaheadFrameBuffer::Clear() {
+		firstFrame = 0;
+		numberOfEntries = 0;
+		numberOfFrames = 0;
+		riTail = 0;
+	}
+
+	/*!
+		@brief		Gets whether there are no frames.
+		@returns	True if there are no frames, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LookaheadFrameBuffer::IsEmpty() {
+		return numberOfEntries == 0;
+	}
+
+	/*!
+		@brief		Gets whether no further frames can be added.
+		@returns	True if no further frames can be added, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LookaheadFrameBuffer::IsFull() {
+		return numberOfEntries >= LOOKAHEAD_FRAMES
+			|| numberOfFrames >= LOOKAHEAD_FRAMES;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames that have been rendered ahead.
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LookaheadFrameBuffer::GetNumberOfFrames() {
+		return numberOfFrames;
+	}
+
+	/*!
+		@brief		Gets whether any of the frames have rendering instructions, i.e.
+					whether anything changes on any of the frames.
+		@returns	True if at least one frame has rendering instructions, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LookaheadFrameBuffer::HasFramesToRender() {
+		for (uint8_t entryIndex = 0; entryIndex < numberOfEntries; entryIndex++) {
+			if (GetEntry(entryIndex)->numberOfRis > 0) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Adds a frame, which is the output of executing the LP for a single
+					rendering frame, to the end of the buffer.  The rendering instructions
+					are copied so the output can be re-used as soon as this returns.
+					The RIs of the frames are stored one after another in the shared RI buffer
+					and wrap back to the start of the shared buffer when there's no space at the end.
+		@param		lpiExecutorOutput	A pointer to the output of executing the LP.
+		@param		lpInstruction		A pointer to the LPI that rendered the output (if known).
+		@returns	True if the frame was added or false if there is no space.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LookaheadFrameBuffer::Push(LpiExecutorOutput* lpiExecutorOutput, LpInstruction* lpInstruction) {
+		if (lpiExecutorOutput == nullptr
+			|| IsFull()) {
+			return false;
+		}
+
+		if (!lpiExecutorOutput->RenderingInstructionsSet()) {
+			// nothing changes on this frame so, if the newest entry is also a frame
+			// on which nothing changes, simply extend that entry
+			if (numberOfEntries > 0) {
+				LookaheadFrame* newestFrame = GetEntry(numberOfEntries - 1);
+				if (newestFrame->numberOfRis == 0) {
+					newestFrame->frames++;
+					numberOfFrames++;
+					return true;
+				}
+			}
+
+			LookaheadFrame* holdFrame = GetEntry(numberOfEntries);
+			holdFrame->riStart = 0;
+			holdFrame->numberOfRis = 0;
+			holdFrame->frames = 1;
+			holdFrame->repeat = false;
+			holdFrame->lpInstruction = nullptr;
+			numberOfEntries++;
+			numberOfFrames++;
+			return true;
+		}
+
+		// the RIs in use start from the oldest frame that has RIs
+		LookaheadFrame* oldestFrameWithRis = nullptr;
+		for (uint8_t entryIndex = 0; entryIndex < numberOfEntries; entryIndex++) {
+			LookaheadFrame* frame = GetEntry(entryIndex);
+			if (frame->numberOfRis > 0) {
+				oldestFrameWithRis = frame;
+				break;
+			}
+		}
+
+		uint16_t riStart = 0;
+		uint16_t numberCopied = 0;
+		if (oldestFrameWithRis == nullptr) {
+			// no RIs in use so the whole of the RI buffer is free
+			numberCopied = lpiExecutorOutput->CopyRenderingInstructions(renderingInstructions, LOOKAHEAD_RENDERING_INSTRUCTIONS);
+		}
+		else if (riTail > oldestFrameWithRis->riStart) {
+			// free space at the end of the RI buffer and possibly at the start
+			riStart = riTail;
+			numberCopied = lpiExecutorOutput->CopyRenderingInstructions(&renderingInstructions[riTail], LOOKAHEAD_RENDERING_INSTRUCTIONS - riTail);
+			if (numberCopied == 0) {
+				riStart = 0;
+				numberCopied = lpiExecutorOutput->CopyRenderingInstructions(renderingInstructions, oldestFrameWithRis->riStart);
+			}
+		}
+		else {
+			// RIs have wrapped so the free space is between the tail and the oldest frame
+			riStart = riTail;
+			numberCopied = lpiExecutorOutput->CopyRenderingInstructions(&renderingInstructions[riTail], oldestFrameWithRis->riStart - riTail);
+		}
+
+		if (numberCopied == 0) {
+			return false;
+		}
+
+		LookaheadFrame* frame = GetEntry(numberOfEntries);
+		frame->riStart = riStart;
+		frame->numberOfRis = numberCopied;
+		frame->frames = 1;
+		frame->repeat = lpiExecutorOutput->GetRepeatRenderingInstructions();
+		frame->lpInstruction = lpInstruction;
+		riTail = riStart + numberCopied;
+		numberOfEntries++;
+		numberOfFrames++;
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the oldest frame without removing it.
+		@returns	A pointer to the oldest frame or nullptr if there are no frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LookaheadFrame* LookaheadFrameBuffer::Peek() {
+		if (numberOfEntries == 0) {
+			return nullptr;
+		}
+
+		return GetEntry(0);
+	}
+
+	/*!
+		@brief		Gets the rendering instructions of a frame.
+		@param		frame		A pointer to the frame.
+		@returns	A pointer to the first rendering instruction of the frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	RI* LookaheadFrameBuffer::GetRenderingInstructions(LookaheadFrame* frame) {
+		return &renderingInstructions[frame->riStart];
+	}
+
+	/*!
+		@brief		Removes a single rendering frame from the oldest entry.  The
+					entry itself is removed once all of its frames have been removed.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LookaheadFrameBuffer::Pop() {
+		if (numberOfEntries == 0) {
+			return;
+		}
+
+		LookaheadFrame* frame = GetEntry(0);
+		numberOfFrames--;
+		if (frame->frames > 1) {
+			frame->frames--;
+			return;
+		}
+
+		firstFrame = (firstFrame + 1) % LOOKAHEAD_FRAMES;
+		numberOfEntries--;
+	}
+}
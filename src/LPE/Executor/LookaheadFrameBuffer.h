@@ -0,0 +1,75 @@
+#ifndef _LookaheadFrameBuffer_h
+#define _LookaheadFrameBuffer_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ValueDomainTypes.h"
+#include "../Instructions/LpInstruction.h"
+#include "../LpiExecutors/LpiExecutorOutput.h"
+
+// 680: *** BUFFER ALLOCATION *** - Frames rendered ahead of the display clock
+// NOTE: the RIs are not enough for a frame in which most pixels differ from their neighbours
+// (up to 1 RI per LED, e.g. a rainbow over 350 LEDs).  Such a frame is never stored; it is held
+// in the output of the executor instead so it is rendered at most one frame ahead.  Over the
+// programs in FunctionalTesting\Programs, the frames that do not fit are none of the rendered
+// frames with 60 LEDs, 29% with 150 LEDs and 57% with 350 LEDs.  A pool big enough for a
+// whole frame of 350 LEDs (2100 bytes) does not fit in the RAM budget of the MKR1010.
+#define LOOKAHEAD_FRAMES					8		// most frames that can be rendered ahead
+#define LOOKAHEAD_RENDERING_INSTRUCTIONS	96		// RIs shared by all of the frames rendered ahead
+
+namespace LS {
+	/*!
+		@brief	A single frame that has been rendered ahead of time.  A frame
+				with no rendering instructions is a frame on which nothing
+				changes; consecutive frames of this kind share the same entry.
+	*/
+	struct LookaheadFrame {
+		uint16_t riStart = 0;			// index of the first RI in the shared RI buffer
+		uint16_t numberOfRis = 0;		// number of RIs (0 = nothing to render)
+		uint16_t frames = 0;			// number of rendering frames covered by the entry
+		bool repeat = false;			// whether the RIs are repeated along the LEDs
+		LpInstruction* lpInstruction = nullptr;		// the LPI that rendered the frame (if any)
+	};
+
+	/*!
+		@brief	Ring buffer of frames that have been rendered ahead of the
+				display clock.  Frames are stored in a compact form: the
+				rendering instructions of each frame are copied, with neighbouring
+				instructions of the same colour merged, into a single shared
+				buffer and frames with nothing to render take no space at all.
+				A frame with more (merged) rendering instructions than the shared
+				buffer holds can never be added.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LookaheadFrameBuffer {
+	private:
+		LookaheadFrame frames[LOOKAHEAD_FRAMES];
+		RI renderingInstructions[LOOKAHEAD_RENDERING_INSTRUCTIONS];
+
+		uint8_t firstFrame = 0;				// index of the oldest entry
+		uint8_t numberOfEntries = 0;		// number of entries in use
+		uint16_t numberOfFrames = 0;		// number of rendering frames covered by all entries
+		uint16_t riTail = 0;				// index of the next free RI
+
+		LookaheadFrame* GetEntry(uint8_t entryIndex);
+
+	public:
+		void Clear();
+		bool IsEmpty();
+		bool IsFull();
+		uint16_t GetNumberOfFrames();
+		bool HasFramesToRender();
+
+		bool Push(LpiExecutorOutput* lpiExecutorOutput, LpInstruction* lpInstruction = nullptr);
+		LookaheadFrame* Peek();
+		RI* GetRenderingInstructions(LookaheadFrame* frame);
+		void Pop();
+	};
+}
+
+#endif
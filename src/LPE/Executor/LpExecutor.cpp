@@ -19,7 +19,7 @@ namespace LS {
 	/*!
 		
 	*/
-	bool LpExecutor::RenderCurrentInstruction(Instruction* currentInstruction, LpiExecutorOutput* lpiExecutorOutput) {
+	bool LpExecutor::RenderCurrentInstruction(LpState* state, Instruction* currentInstruction, LpiExecutorOutput* lpiExecutorOutput) {
 		LpInstruction* lpInstruction = (LpInstruction*)currentInstruction;
 
 		// Lets first see if the this instruction is already complete i.e
@@ -41,18 +41,17 @@ namespace LS {
 		// do not need to change them until the duration of the effect is complete.
 		if (lpInstruction->IsTimeToRender() 
 			&& lpInstruction->HasMoreSteps()) {
-			// get the basic LPI details incluing op-code
-			stringProcessor->ExtractLPIFromHexEncoded(lpInstruction->getLpi(), &basicLpiDetails);
-
-			// render the LPI
-			lpiBuffer.LoadFromBuffer(lpInstruction->getLpi());
-			// LPI* lpi = lpiFactory->GetLPI(&lpiBuffer, &basicLpiDetails);
-			LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(basicLpiDetails.opcode);
-
-			// TODO: fix the need to validate the instruction each time
-			// lpi->Reset(&basicLpiDetails);
-			// bool rendered = lpi->GetNextRI(renderingBuffer);
-			lpiExecutor->Execute(&lpiExecutorParams, lpInstruction->GetCurrentStep(), lpiExecutorOutput);
+			RenderCurrentStep(state, lpInstruction, lpiExecutorOutput);
+			if (transitionFrame != nullptr
+				&& lpInstruction->GetCurrentStep() == 0) {
+				// the LPI has just begun so it fades in from the frame before it (if it has a transition)
+				transitionFrame->Begin(basicLpiDetails.transition);
+			}
+		}
+		else if (lpiExecutorOutput != nullptr
+			&& IsTransitioning()) {
+			// the step on display is rendered again so that it is blended further in on this frame
+			RenderCurrentStep(state, lpInstruction, lpiExecutorOutput);
 		}
 
 		// reduce the currentDuration of the current instruction by 1
@@ -73,6 +72,140 @@ namespace LS {
 		return moveToNextInstruction;
 	}
 
+	/*!
+		@brief		Renders the current animation step of an LPI, replaying it from the
+					frame cache where possible.
+		@param		state				The LP state.
+		@param		lpInstruction		A pointer to the LPI.
+		@param		lpiExecutorOutput	A pointer to the output that the step is rendered to.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpExecutor::RenderCurrentStep(LpState* state, LpInstruction* lpInstruction, LpiExecutorOutput* lpiExecutorOutput) {
+		// time spent on the LPI is attributed to it when profiling
+		bool isProfiled = profiler != nullptr && profiler->IsEnabled();
+		uint32_t startTime = isProfiled ? profiler->GetTime() : 0;
+
+		// get the basic LPI details incluing op-code
+		stringProcessor->ExtractLPIFromHexEncoded(lpInstruction->getLpi(), &basicLpiDetails);
+
+		// replay the step from the frame cache if it has already been rendered
+		// on a previous iteration of an infinite repeat
+		uint16_t currentStep = lpInstruction->GetCurrentStep();
+		bool isCacheable = IsFrameCacheable(state, lpInstruction, basicLpiDetails.opcode);
+		if (!isCacheable
+			|| !frameCache->Load(lpInstruction, currentStep, lpiExecutorOutput)) {
+			// render the LPI with its colour references replaced by the colours of the palette
+			uint8_t numberOfColours = 0;
+			const Colour* palette = GetPalette(state, &numberOfColours);
+			stringProcessor->ExpandColourReferences(lpInstruction->getLpi(), &lpiBuffer, palette, numberOfColours);
+			// LPI* lpi = lpiFactory->GetLPI(&lpiBuffer, &basicLpiDetails);
+			LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(basicLpiDetails.opcode);
+
+			if (isProfiled) {
+				profiler->RecordParse(lpInstruction, startTime);
+				startTime = profiler->GetTime();
+			}
+
+			// TODO: fix the need to validate the instruction each time
+			// lpi->Reset(&basicLpiDetails);
+			// bool rendered = lpi->GetNextRI(renderingBuffer);
+			if (!isCacheable
+				&& !state->HasTransitions()
+				&& lpiExecutorOutput != nullptr
+				&& lpiExecutor->BeginRuns(&lpiExecutorParams, currentStep)) {
+				// the pixels are generated as they are set rather than rendered here first
+				lpiExecutorOutput->SetGenerator(lpiExecutor, &lpiExecutorParams, currentStep);
+			}
+			else {
+				lpiExecutor->Execute(&lpiExecutorParams, currentStep, lpiExecutorOutput);
+			}
+
+			if (isCacheable) {
+				frameCache->Store(lpInstruction, currentStep, lpiExecutorOutput);
+			}
+		}
+
+		if (isProfiled) {
+			profiler->RecordExecute(lpInstruction, startTime);
+		}
+		renderedInstruction = lpInstruction;
+	}
+
+	/*!
+		@brief		Gets whether an LPI is fading in from the frame before it, in which case
+					a frame is output on every frame until the transition completes.
+		@returns	True if an LPI is fading in, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpExecutor::IsTransitioning() {
+		return transitionFrame != nullptr
+			&& transitionFrame->IsTransitioning();
+	}
+
+	/*!
+		@brief		Determines whether the rendered steps of an LPI can be replayed from the
+					frame cache.  This is only worthwhile for LPIs within an infinite repeat
+					as they are rendered over and over again.  LPIs that do not render the same
+					output for the same step (i.e. stochastic) are never cached.  An LPI that
+					is executing in place of a call is within the repeats that contain the call.
+		@param		state			The LP state.
+		@param		lpInstruction	A pointer to the LPI.
+		@param		opcode			The op-code of the LPI.
+		@returns	True if the LPI can be cached, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpExecutor::IsFrameCacheable(LpState* state, LpInstruction* lpInstruction, uint8_t opcode) {
+		if (frameCache == nullptr
+			|| !frameCache->IsEnabled()
+			|| opcode == LpiOpCode::Stochastic) {
+			return false;
+		}
+
+		Instruction* instruction = lpInstruction;
+		uint8_t callDepth = state->GetCallDepth();
+		while (instruction != nullptr) {
+			if (callDepth > 0
+				&& instruction == state->GetCall(callDepth - 1)->GetCalledInstruction()) {
+				// the instruction is executing in place of a call so carry on from the call
+				instruction = state->GetCall(--callDepth);
+			}
+
+			instruction = instruction->getParent();
+			if (instruction != nullptr
+				&& instruction->getInstructionType() == InstructionType::Repeat
+				&& ((RepeatInstruction*)instruction)->isInfinite()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Gets the palette that colour references of the LPI that is executing
+					are replaced by, which is the palette passed by the innermost call
+					that passes one or, otherwise, the palette of the program.
+		@param		state				The LP state.
+		@param		numberOfColours		A pointer to the value that is set to the number
+										of colours of the palette.
+		@returns	A pointer to the colours of the palette or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	const Colour* LpExecutor::GetPalette(LpState* state, uint8_t* numberOfColours) {
+		for (uint8_t callDepth = state->GetCallDepth(); callDepth > 0; callDepth--) {
+			uint8_t paletteId = state->GetCall(callDepth - 1)->GetPaletteId();
+			if (paletteId != PALETTE_NONE) {
+				return state->GetPalette(paletteId, numberOfColours);
+			}
+		}
+
+		return state->GetPalette(state->GetProgramPaletteId(), numberOfColours);
+	}
+
 	/*!
 		@brief		Moves 'down' the tree until the next LPI is encountered.  This is
 					used when instructions are executing that have children instructions
@@ -80,7 +213,8 @@ namespace LS {
 					check whether that is another repeat.  If so then we must continue
 					moving down and so on until we get to the first child of a repeat
 					which is an LPI.  The first LPI that is encountered is set as the
-					currentInstruction in the LP state.
+					currentInstruction in the LP state.  A call is moved 'down' to
+					the instruction that it calls, which is added to the call stack.
 		@param		state	The LP state
 		@author		Kevin White
 		@date		31 Dec 2020
@@ -89,9 +223,20 @@ namespace LS {
 		Instruction* currentInstruction = state->getCurrentInstruction();
 
 		while (currentInstruction->getInstructionType() != InstructionType::Lpi) {
-			// currentInstruction must have an instruction that has child instructions
-			// so we need to get the first child to check whether it is an LPI
-			currentInstruction = ((InstructionWithChild*)currentInstruction)->getFirstChild();
+			if (currentInstruction->getInstructionType() == InstructionType::Call) {
+				// the called instruction is executed in place of the call
+				CallInstruction* callInstruction = (CallInstruction*)currentInstruction;
+				if (!state->PushCall(callInstruction)) {
+					state->setCurrentInstruction(nullptr);
+					return;
+				}
+				currentInstruction = callInstruction->GetCalledInstruction();
+			}
+			else {
+				// currentInstruction must have an instruction that has child instructions
+				// so we need to get the first child to check whether it is an LPI
+				currentInstruction = ((InstructionWithChild*)currentInstruction)->getFirstChild();
+			}
 
 			if (currentInstruction->getInstructionType() == InstructionType::Repeat) {
 				// however, if its a repeat then we need to reset the
@@ -116,11 +261,23 @@ namespace LS {
 							2.b If remaining iterations (or is infinite loop) on repeat then navigate 'down' to first LPI.
 							2.c Otherwise, recursively call this method to either move to the next
 							    instruction or the parent.
+					The instruction called by the innermost call moves on from the call,
+					rather than from where it is held, once it has completed.
 	*/
 	void LpExecutor::NavigateToNextInstruction(LpState* state) {
 		Instruction* currentInstruction = state->getCurrentInstruction();
 		state->setCurrentInstruction(nullptr);	// set to nullptr or otherwise previous instruction could be executed again
 
+		CallInstruction* callInstruction = state->GetCall(state->GetCallDepth() - 1);
+		if (callInstruction != nullptr
+			&& callInstruction->GetCalledInstruction() == currentInstruction) {
+			// the called instruction has completed so return to the call
+			state->PopCall();
+			state->setCurrentInstruction(callInstruction);
+			NavigateToNextInstruction(state);
+			return;
+		}
+
 		// 1. if currentInstruction has a sibling, move to the sibling.
 		if (currentInstruction->getNext() != nullptr) {
 			currentInstruction = currentInstruction->getNext();
@@ -156,6 +313,50 @@ namespace LS {
 		}
 	}
 
+	/*!
+		@brief		Moves a queue-fed state on to the next LPI in its queue once the
+					LPI that was executing has finished (or, if the queue had run dry,
+					once further LPIs have been queued).  The finished LPI is removed
+					from the queue as its string is no longer referenced.
+		@param		state	The LP state.
+		@returns	A pointer to the LPI that is now the current instruction or nullptr
+					if the state is not queue-fed or there are no LPIs in the queue.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	Instruction* LpExecutor::NavigateToQueuedInstruction(LpState* state) {
+		LpiQueue* lpiQueue = state->GetLpiQueue();
+		if (lpiQueue == nullptr) {
+			return nullptr;
+		}
+
+		if (state->getFirstInstruction() != nullptr) {
+			// the LPI that has finished is always at the head of the queue
+			lpiQueue->Pop();
+		}
+
+		const char* lpi = lpiQueue->Peek();
+		if (lpi == nullptr) {
+			// the queue has run dry so nothing changes until further LPIs are queued
+			return state->SetQueuedInstruction(nullptr);
+		}
+
+		// the LPI was validated when it was queued
+		stringProcessor->ExtractLPIFromHexEncoded(lpi, &basicLpiDetails);
+		if (basicLpiDetails.transition > 0) {
+			state->SetHasTransitions();
+		}
+		stringProcessor->ExpandColourReferences(lpi, &lpiBuffer, nullptr, 0);
+		LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(basicLpiDetails.opcode);
+
+		queuedInstruction.reset();
+		queuedInstruction.setLpi(lpi);
+		queuedInstruction.SetDuration(basicLpiDetails.duration);
+		queuedInstruction.SetNumberOfSteps(lpiExecutor->GetNumberOfSteps(&lpiExecutorParams));
+
+		return state->SetQueuedInstruction(&queuedInstruction);
+	}
+
 	/*!
 		@brief		Executes the LP by causing the current LPI to be rendered (if we have
 					an LPI then the renderingBuffer will be filled with the rendered output)
@@ -178,21 +379,54 @@ namespace LS {
 		// Reset the rendering buffer so that we do not return the previous
 		// buffer content if a new one is not rendered
 		lpiExecutorOutput->Reset();
+		renderedInstruction = nullptr;
+
+		if (state->IsBuilding()) {
+			// nothing is rendered until the program is built so the last frame shown is held
+			return;
+		}
+
+		// the LPIs see the length of the segment that the program is played on (if any) as the number of LEDs
+		lpiExecutorParams.SetSegment(state->GetSegment());
+
+		if (frameCache != nullptr) {
+			// discard cached frames that belong to a previous program
+			frameCache->Validate(state->GetGeneration(), lpiExecutorParams.GetNumberOfLeds());
+		}
+
+		if (transitionFrame != nullptr) {
+			// LPIs do not fade in from the frames of a previous program
+			transitionFrame->Validate(state->GetGeneration(), lpiExecutorParams.GetNumberOfLeds());
+		}
+
+		if (profiler != nullptr) {
+			// discard profiles that belong to a previous program
+			profiler->Validate(state);
+		}
 
 		// render the current instruction (if any as the state may have reached the end of program)
 		Instruction* currentInstruction = state->getCurrentInstruction();
+		if (currentInstruction == nullptr) {
+			// a queue-fed state that had run dry may since have had LPIs queued
+			currentInstruction = NavigateToQueuedInstruction(state);
+		}
 		if (currentInstruction == nullptr) {
 			// no current instruction so nothing to do - cannot render or navigate.  Probably
 			// the previous program has come to an end.
 			return;
 		}
 
-		if (currentInstruction->getInstructionType() == InstructionType::Repeat) {
+		state->SetFrame(state->GetFrame() + 1);
+
+		if (currentInstruction->getInstructionType() != InstructionType::Lpi) {
 			// first instruction in program may be a repeat so we need to navigate
 			// to the first actual LP.  This should only ever occur once when a
 			// LP is being executed.
 			NavigateDownToFirstLp(state);
 			currentInstruction = state->getCurrentInstruction();
+			if (currentInstruction == nullptr) {
+				return;
+			}
 		}
 
 		bool navigateToNextInstructon = true;
@@ -201,13 +435,303 @@ namespace LS {
 			// navigateToNextInstruction will be returned as true if the Lpi has finished rendering
 			// i.e. all animation steps complete (for animated LPIs) and duration has been
 			// reduced to 0.
-			navigateToNextInstructon = RenderCurrentInstruction(currentInstruction, lpiExecutorOutput);
+			navigateToNextInstructon = RenderCurrentInstruction(state, currentInstruction, lpiExecutorOutput);
 		}
 
 		if (navigateToNextInstructon) {
 			// navigate to the next LPI instruction, ready for the next cycle.  If there are no
 			// further instructions then the currentInstruction pointer will be state to nullptr.
 			NavigateToNextInstruction(state);
+			if (state->getCurrentInstruction() == nullptr) {
+				// a queue-fed state moves straight on to the next queued LPI
+				NavigateToQueuedInstruction(state);
+			}
+		}
+
+		if (transitionFrame != nullptr
+			&& state->HasTransitions()) {
+			// the output is blended whilst an LPI fades in and saved for the LPIs that follow to fade in from
+			transitionFrame->Apply(lpiExecutorOutput);
+		}
+	}
+
+	/*!
+		@brief		Sets the cache used to replay the rendered steps of LPIs within
+					infinite repeats.  Pass nullptr to always render LPIs.
+		@param		frameCache		A pointer to the frame cache.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpExecutor::SetFrameCache(LpFrameCache* frameCache) {
+		this->frameCache = frameCache;
+		if (frameCache != nullptr) {
+			frameCache->Clear();
 		}
 	}
+
+	/*!
+		@brief		Gets the cache used to replay the rendered steps of LPIs.
+		@returns	A pointer to the frame cache or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpFrameCache* LpExecutor::GetFrameCache() {
+		return frameCache;
+	}
+
+	/*!
+		@brief		Sets the profiler that the time spent parsing and executing each LPI
+					is attributed to.  Pass nullptr to not profile LPIs.
+		@param		profiler		A pointer to the profiler.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpExecutor::SetProfiler(LpProfiler* profiler) {
+		this->profiler = profiler;
+	}
+
+	/*!
+		@brief		Sets the frame that LPIs with a transition fade in from.  Pass
+					nullptr for LPIs to change without fading in.
+		@param		transitionFrame		A pointer to the transition frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpExecutor::SetTransitionFrame(LpTransitionFrame* transitionFrame) {
+		this->transitionFrame = transitionFrame;
+		if (transitionFrame != nullptr) {
+			transitionFrame->Clear();
+		}
+	}
+
+	/*!
+		@brief		Gets the frame that LPIs with a transition fade in from.
+		@returns	A pointer to the transition frame or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpTransitionFrame* LpExecutor::GetTransitionFrame() {
+		return transitionFrame;
+	}
+
+	/*!
+		@brief		Gets the profiler that time is attributed to.
+		@returns	A pointer to the profiler or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpProfiler* LpExecutor::GetProfiler() {
+		return profiler;
+	}
+
+	/*!
+		@brief		Gets the LPI that rendered the output of the last call to Execute.
+		@returns	A pointer to the LPI or nullptr if nothing was rendered.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpInstruction* LpExecutor::GetRenderedInstruction() {
+		return renderedInstruction;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames, from the next call to Execute, on which
+					nothing will be rendered.  This is the case when the current LPI is part way
+					through the duration of an animation step, unless an LPI is fading in.  The value
+					is a lower bound as the LPIs that follow are not inspected.
+		@param		state	The LP state.
+		@returns	The number of rendering frames on which nothing will be rendered (0 if the next frame
+					may render) or FRAMES_UNTIL_CHANGE_NEVER if the LP has come to an end.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpExecutor::GetFramesUntilNextChange(LpState* state) {
+		if (state == nullptr) {
+			return 0;
+		}
+
+		Instruction* currentInstruction = state->getCurrentInstruction();
+		if (currentInstruction == nullptr) {
+			// the program has come to an end unless LPIs have been queued for a queue-fed state
+			LpiQueue* lpiQueue = state->GetLpiQueue();
+			return lpiQueue != nullptr && !lpiQueue->IsEmpty() ? 0 : FRAMES_UNTIL_CHANGE_NEVER;
+		}
+
+		if (currentInstruction->getInstructionType() != InstructionType::Lpi
+			|| IsTransitioning()) {
+			return 0;
+		}
+
+		LpInstruction* lpInstruction = (LpInstruction*)currentInstruction;
+		if (lpInstruction->IsTimeToRender()
+			&& lpInstruction->HasMoreSteps()) {
+			return 0;
+		}
+
+		// the remainder of the duration of the current step
+		return lpInstruction->GetCurrentDuration();
+	}
+
+	/*!
+		@brief		Moves the LP state forward by a number of rendering frames on which
+					nothing is rendered, exactly as if Execute had been called once for
+					each of the frames.  Skipping stops at a frame that would render.
+		@param		state			The LP state.
+		@param		numberOfFrames	The number of rendering frames to skip which should not
+									exceed the value returned by GetFramesUntilNextChange.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpExecutor::SkipFrames(LpState* state, uint16_t numberOfFrames) {
+		if (state == nullptr) {
+			return;
+		}
+
+		for (; numberOfFrames > 0; numberOfFrames--) {
+			Instruction* currentInstruction = state->getCurrentInstruction();
+			if (currentInstruction == nullptr
+				|| currentInstruction->getInstructionType() != InstructionType::Lpi
+				|| IsTransitioning()) {
+				return;
+			}
+
+			LpInstruction* lpInstruction = (LpInstruction*)currentInstruction;
+			if (lpInstruction->IsTimeToRender()
+				&& lpInstruction->HasMoreSteps()) {
+				// this frame would render so it cannot be skipped
+				return;
+			}
+
+			// nothing is rendered on this frame so no output is required
+			state->SetFrame(state->GetFrame() + 1);
+			if (RenderCurrentInstruction(state, currentInstruction, nullptr)) {
+				NavigateToNextInstruction(state);
+				if (state->getCurrentInstruction() == nullptr) {
+					NavigateToQueuedInstruction(state);
+				}
+			}
+		}
+	}
+
+	/*!
+		@brief		Positions the LP state at a rendering frame of the program, exactly as if
+					Execute had been called for that many frames since the program started.
+					The frame lengths that the state builder stores with each instruction are
+					used to walk down the tree rather than executing the frames: an instruction
+					that ends before the frame, whether an LPI or an entire repeat, is passed
+					over in one step; a repeat that contains the frame skips its whole
+					iterations by division, is positioned at the iteration that contains the
+					frame (infinite repeats wrap around) and the walk continues into that
+					partial iteration; the LPI that contains the frame is positioned at the
+					step and duration of the frame.  Frames beyond the end of a program that
+					is not infinite end the program.
+					The cost does not depend on the frame or on the number of iterations or
+					steps: it is O(depth + siblings passed over on each level walked), as the
+					instructions of a level are singly linked and are passed over one at a
+					time, which is at worst the number of instructions in the program.  The
+					step on display is then rendered once.
+					A queue-fed state is positioned within the queued LPI that is executing,
+					which is ended by frames beyond its end.  An LPI that is fading in at the frame is shown
+					as it is, without the rest of its transition.
+		@param		state				The LP state.
+		@param		frame				The rendering frame to seek to (0 = start of program).
+		@param		lpiExecutorOutput	A pointer to the output that the step that is on
+										display at the frame is rendered to (may be nullptr).
+										Nothing is rendered if the frame starts a new step as
+										the step is then rendered by the next call to Execute.
+		@returns	True if the state was positioned or false if there is no program, the
+					program is still being built or the frame is before the queued LPI that
+					is executing.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpExecutor::Seek(LpState* state, uint32_t frame, LpiExecutorOutput* lpiExecutorOutput) {
+		if (state == nullptr
+			|| state->IsBuilding()
+			|| state->getFirstInstruction() == nullptr
+			|| frame < state->GetFirstFrame()) {
+			return false;
+		}
+
+		if (lpiExecutorOutput != nullptr) {
+			lpiExecutorOutput->Reset();
+		}
+		renderedInstruction = nullptr;
+		lpiExecutorParams.SetSegment(state->GetSegment());
+
+		if (frameCache != nullptr) {
+			frameCache->Validate(state->GetGeneration(), lpiExecutorParams.GetNumberOfLeds());
+		}
+
+		if (transitionFrame != nullptr) {
+			// the frame on display before the seek is not faded from
+			transitionFrame->Validate(state->GetGeneration(), lpiExecutorParams.GetNumberOfLeds());
+			transitionFrame->Clear();
+		}
+
+		if (profiler != nullptr) {
+			profiler->Validate(state);
+		}
+
+		// a queue-fed state can only be positioned within the queued LPI that is executing
+		uint32_t remainingFrames = frame - state->GetFirstFrame();
+		Instruction* instruction = state->getFirstInstruction();
+		state->ClearCalls();
+		while (instruction != nullptr) {
+			uint32_t frameLength = instruction->GetFrameLength();
+			if (remainingFrames >= frameLength) {
+				// the frame is after the whole of this instruction (every iteration of a repeat)
+				remainingFrames -= frameLength;
+				instruction = instruction->getNext();
+				continue;
+			}
+
+			if (instruction->getInstructionType() == InstructionType::Lpi) {
+				break;
+			}
+
+			if (instruction->getInstructionType() == InstructionType::Call) {
+				// the frame is within the instruction that is called in place of the call
+				if (!state->PushCall((CallInstruction*)instruction)) {
+					return false;
+				}
+				instruction = ((CallInstruction*)instruction)->GetCalledInstruction();
+				continue;
+			}
+
+			// the frame is within this repeat so skip the whole iterations before it and move
+			// down into the partial iteration that contains it
+			RepeatInstruction* repeatInstruction = (RepeatInstruction*)instruction;
+			uint32_t bodyFrameLength = repeatInstruction->GetBodyFrameLength();
+			if (bodyFrameLength == 0) {
+				return false;
+			}
+			repeatInstruction->SeekToIteration(remainingFrames / bodyFrameLength);
+			remainingFrames %= bodyFrameLength;
+			instruction = repeatInstruction->getFirstChild();
+		}
+
+		state->setCurrentInstruction(instruction);
+		if (instruction == nullptr) {
+			// the frame is beyond the end of the program which is where the program stops
+			state->SetFrame(frame - remainingFrames);
+			return true;
+		}
+		state->SetFrame(frame);
+
+		LpInstruction* lpInstruction = (LpInstruction*)instruction;
+		lpInstruction->SeekToFrame(remainingFrames);
+		if (lpiExecutorOutput != nullptr
+			&& !lpInstruction->IsTimeToRender()) {
+			// part way through a step so the step must be rendered now as it
+			// will not be rendered again by Execute
+			RenderCurrentStep(state, lpInstruction, lpiExecutorOutput);
+			if (transitionFrame != nullptr
+				&& state->HasTransitions()) {
+				transitionFrame->Apply(lpiExecutorOutput);
+			}
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
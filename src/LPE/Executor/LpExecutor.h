@@ -4,14 +4,19 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
-#include "..\StateBuilder\LpState.h"
-#include "..\..\FixedSizeCharBuffer.h"
-#include "..\..\ValueDomainTypes.h"
-#include "..\LpiExecutors\LpiExecutorFactory.h"
-#include "..\LpiExecutors\LpiExecutorOutput.h"
+#include "../StateBuilder/LpState.h"
+#include "../../FixedSizeCharBuffer.h"
+#include "../../ValueDomainTypes.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
+#include "../LpiExecutors/LpiExecutorOutput.h"
+#include "LpFrameCache.h"
+#include "LpTransitionFrame.h"
+#include "LpProfiler.h"
+
+#define FRAMES_UNTIL_CHANGE_NEVER		0xFFFF		// nothing will change until the LP state is changed
 
 namespace LS {
 	/**
@@ -30,15 +35,36 @@ namespace LS {
 		// 500:  *** BUFFER ALLOCATION *** - Individual LPI loading buffer
 		FixedSizeCharBuffer lpiBuffer = FixedSizeCharBuffer(BUFFER_LPI_LOADING);
 		LPIInstruction basicLpiDetails;
+		LpFrameCache* frameCache = nullptr;
+		LpProfiler* profiler = nullptr;
+		LpTransitionFrame* transitionFrame = nullptr;
+		LpInstruction* renderedInstruction = nullptr;		// LPI that rendered the output of the last call to Execute
+		LpInstruction queuedInstruction;					// used to build the LPI taken from the queue of a queue-fed state
 	protected:
-		bool RenderCurrentInstruction(Instruction* currentInstruction, LpiExecutorOutput* lpiExecutorOutput);
+		bool RenderCurrentInstruction(LpState* state, Instruction* currentInstruction, LpiExecutorOutput* lpiExecutorOutput);
+		void RenderCurrentStep(LpState* state, LpInstruction* lpInstruction, LpiExecutorOutput* lpiExecutorOutput);
+		bool IsTransitioning();
+		bool IsFrameCacheable(LpState* state, LpInstruction* lpInstruction, uint8_t opcode);
+		const Colour* GetPalette(LpState* state, uint8_t* numberOfColours);
 		void NavigateToNextInstruction(LpState* state);
 		void NavigateDownToFirstLp(LpState* state);
+		Instruction* NavigateToQueuedInstruction(LpState* state);
 
 	public:
 		LpExecutor(LpiExecutorFactory* lpiExecutorFactory, StringProcessor* stringProcessor, LEDConfig* ledConfig);
 
 		virtual void Execute(LpState* state, LpiExecutorOutput* lpiExecutorOutput);
+		void SetFrameCache(LpFrameCache* frameCache);
+		void SetProfiler(LpProfiler* profiler);
+		void SetTransitionFrame(LpTransitionFrame* transitionFrame);
+
+		uint16_t GetFramesUntilNextChange(LpState* state);
+		void SkipFrames(LpState* state, uint16_t numberOfFrames);
+		bool Seek(LpState* state, uint32_t frame, LpiExecutorOutput* lpiExecutorOutput);
+		LpFrameCache* GetFrameCache();
+		LpProfiler* GetProfiler();
+		LpTransitionFrame* GetTransitionFrame();
+		LpInstruction* GetRenderedInstruction();
 	};
 }
 #endif
\ No newline at end of file
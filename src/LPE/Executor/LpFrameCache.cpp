@@ -0,0 +1,123 @@
+#include "LpFrameCache.h"
+
+namespace LS {
+	/*!
+		@brief		Removes all of the cached frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpFrameCache::Clear() {
+		numberOfFrames = 0;
+		riTail = 0;
+	}
+
+	/*!
+		@brief		Clears the cache if the frames were rendered for a previous
+					program (i.e. the LP state has been reset since) or for a
+					different number of LEDs.
+		@param		stateGeneration		The current generation of the LP state.
+		@param		numberOfLeds		The current number of LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpFrameCache::Validate(uint16_t stateGeneration, uint16_t numberOfLeds) {
+		if (this->stateGeneration == stateGeneration
+			&& this->numberOfLeds == numberOfLeds) {
+			return;
+		}
+
+		Clear();
+		this->stateGeneration = stateGeneration;
+		this->numberOfLeds = numberOfLeds;
+	}
+
+	/*!
+		@brief		Sets whether frames are cached.  The cache is cleared when
+					it is disabled.
+		@param		enabled		True to cache frames, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpFrameCache::SetEnabled(bool enabled) {
+		this->enabled = enabled;
+		if (!enabled) {
+			Clear();
+		}
+	}
+
+	/*!
+		@brief		Gets whether frames are cached.
+		@returns	True if frames are cached, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpFrameCache::IsEnabled() {
+		return enabled;
+	}
+
+	/*!
+		@brief		Loads the cached output of a step of an LPI.
+		@param		lpInstruction		A pointer to the LPI.
+		@param		step				The step of the LPI.
+		@param		lpiExecutorOutput	A pointer to the output that is loaded with the cached RIs.
+		@returns	True if the step was found in the cache and loaded or false if the
+					step must be rendered.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpFrameCache::Load(LpInstruction* lpInstruction, uint16_t step, LpiExecutorOutput* lpiExecutorOutput) {
+		if (!enabled
+			|| lpInstruction == nullptr
+			|| lpiExecutorOutput == nullptr) {
+			return false;
+		}
+
+		for (uint8_t frameIndex = 0; frameIndex < numberOfFrames; frameIndex++) {
+			LpFrameCacheEntry* frame = &frames[frameIndex];
+			if (frame->lpInstruction == lpInstruction
+				&& frame->step == step) {
+				lpiExecutorOutput->LoadRenderingInstructions(&renderingInstructions[frame->riStart], frame->numberOfRis, frame->repeat);
+				hits++;
+				return true;
+			}
+		}
+
+		misses++;
+		return false;
+	}
+
+	/*!
+		@brief		Stores the output of rendering a step of an LPI.  The RIs are copied
+					with neighbouring RIs of the same colour merged.  Nothing is stored if
+					there is no space left in the cache or the output has no RIs.
+		@param		lpInstruction		A pointer to the LPI.
+		@param		step				The step of the LPI.
+		@param		lpiExecutorOutput	A pointer to the output of rendering the step.
+		@returns	True if the output was stored or false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpFrameCache::Store(LpInstruction* lpInstruction, uint16_t step, LpiExecutorOutput* lpiExecutorOutput) {
+		if (!enabled
+			|| lpInstruction == nullptr
+			|| lpiExecutorOutput == nullptr
+			|| numberOfFrames >= FRAME_CACHE_FRAMES) {
+			return false;
+		}
+
+		uint16_t numberCopied = lpiExecutorOutput->CopyRenderingInstructions(&renderingInstructions[riTail], FRAME_CACHE_RENDERING_INSTRUCTIONS - riTail);
+		if (numberCopied == 0) {
+			return false;
+		}
+
+		LpFrameCacheEntry* frame = &frames[numberOfFrames++];
+		frame->lpInstruction = lpInstruction;
+		frame->step = step;
+		frame->riStart = riTail;
+		frame->numberOfRis = numberCopied;
+		frame->repeat = lpiExecutorOutput->GetRepeatRenderingInstructions();
+		riTail += numberCopied;
+
+		return true;
+	}
+}
\ No newline at end of file
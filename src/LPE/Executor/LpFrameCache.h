@@ -0,0 +1,76 @@
+#ifndef _LpFrameCache_h
+#define _LpFrameCache_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ValueDomainTypes.h"
+#include "../Instructions/LpInstruction.h"
+#include "../LpiExecutors/LpiExecutorOutput.h"
+
+// xxxx: *** BUFFER ALLOCATION *** - Rendered frames of the body of an infinite repeat
+#define FRAME_CACHE_FRAMES					48		// most frames (LPI steps) that can be cached
+#define FRAME_CACHE_RENDERING_INSTRUCTIONS	160		// RIs shared by all of the cached frames
+
+namespace LS {
+	/*!
+		@brief	A single cached frame: the output of rendering a single
+				step of an LPI.
+	*/
+	struct LpFrameCacheEntry {
+		LpInstruction* lpInstruction = nullptr;		// the LPI that was rendered
+		uint16_t step = 0;							// the step of the LPI that was rendered
+		uint16_t riStart = 0;						// index of the first RI in the shared RI buffer
+		uint16_t numberOfRis = 0;					// number of RIs
+		bool repeat = false;						// whether the RIs are repeated along the LEDs
+	};
+
+	/*!
+		@brief	Cache of the rendered output of the steps of LPIs.  The
+				executor records each step of an LPI within an infinite repeat
+				the first time it is rendered and, on later iterations of
+				the repeat, replays the step from the cache rather than
+				parsing and executing the LPI again.  Frames are only added
+				whilst there is space; nothing is ever evicted, so a program
+				that does not fit is partly cached and partly executed.
+				The cache must be cleared whenever the instructions it refers
+				to change, which is detected using the generation of the LP state.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpFrameCache {
+	private:
+		LpFrameCacheEntry frames[FRAME_CACHE_FRAMES];
+		RI renderingInstructions[FRAME_CACHE_RENDERING_INSTRUCTIONS];
+
+		uint8_t numberOfFrames = 0;
+		uint16_t riTail = 0;				// index of the next free RI
+
+		uint16_t stateGeneration = 0;		// generation of the LP state that the frames belong to
+		uint16_t numberOfLeds = 0;			// number of LEDs the frames were rendered for
+		bool enabled = true;
+
+		// statistics reported via the status API
+		uint32_t hits = 0;
+		uint32_t misses = 0;
+
+	public:
+		void Clear();
+		void Validate(uint16_t stateGeneration, uint16_t numberOfLeds);
+		void SetEnabled(bool enabled);
+		bool IsEnabled();
+
+		bool Load(LpInstruction* lpInstruction, uint16_t step, LpiExecutorOutput* lpiExecutorOutput);
+		bool Store(LpInstruction* lpInstruction, uint16_t step, LpiExecutorOutput* lpiExecutorOutput);
+
+		uint8_t GetNumberOfFrames() { return numberOfFrames; }
+		uint16_t GetNumberOfRenderingInstructions() { return riTail; }
+		uint32_t GetHits() { return hits; }
+		uint32_t GetMisses() { return misses; }
+	};
+}
+
+#endif
\ No newline at end of file
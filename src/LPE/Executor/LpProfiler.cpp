@@ -0,0 +1,165 @@
+#include "LpProfiler.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor sets the clock used to time the LPIs.
+		@param		clock		The function that returns the time in microseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpProfiler::LpProfiler(LpProfilerClock clock) {
+		this->clock = clock;
+	}
+
+	/*!
+		@brief		Discards the profiles of all of the LPIs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::Clear() {
+		for (uint8_t lpInstructionIndex = 0; lpInstructionIndex < MAX_LPINSTRUCTIONS; lpInstructionIndex++) {
+			profiles[lpInstructionIndex] = LpInstructionProfile();
+		}
+	}
+
+	/*!
+		@brief		Sets the LP state that is being profiled.  The profiles are discarded
+					if they belong to a different state or the state has been reset since.
+		@param		state		A pointer to the LP state.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::Validate(LpState* state) {
+		if (state == nullptr
+			|| (this->state == state && stateGeneration == state->GetGeneration())) {
+			return;
+		}
+
+		Clear();
+		this->state = state;
+		stateGeneration = state->GetGeneration();
+	}
+
+	/*!
+		@brief		Sets whether LPIs are profiled.  The profiles are discarded when
+					profiling is enabled so that they only cover the new run.
+		@param		enabled		True to profile the LPIs, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::SetEnabled(bool enabled) {
+		if (enabled && !this->enabled) {
+			Clear();
+		}
+		this->enabled = enabled;
+	}
+
+	/*!
+		@brief		Gets whether LPIs are profiled.
+		@returns	True if the LPIs are profiled, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpProfiler::IsEnabled() {
+		return enabled;
+	}
+
+	/*!
+		@brief		Gets the current time from the clock.
+		@returns	The time in microseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpProfiler::GetTime() {
+		return clock();
+	}
+
+	/*!
+		@brief		Gets the profile of an LPI of the state that is being profiled.
+		@param		lpInstruction	A pointer to the LPI.
+		@returns	A pointer to the profile or nullptr if profiling is disabled or the
+					LPI does not belong to the state.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpInstructionProfile* LpProfiler::GetProfile(LpInstruction* lpInstruction) {
+		if (!enabled
+			|| state == nullptr) {
+			return nullptr;
+		}
+
+		return GetProfile(state->GetLpInstructionIndex(lpInstruction));
+	}
+
+	/*!
+		@brief		Gets the profile of an LPI by its position in the LP state.
+		@param		lpInstructionIndex	The position of the LPI.
+		@returns	A pointer to the profile or nullptr if the position is out of range.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpInstructionProfile* LpProfiler::GetProfile(uint8_t lpInstructionIndex) {
+		if (lpInstructionIndex >= MAX_LPINSTRUCTIONS) {
+			return nullptr;
+		}
+
+		return &profiles[lpInstructionIndex];
+	}
+
+	/*!
+		@brief		Increments a count, stopping at the largest value rather than wrapping.
+		@param		count		A pointer to the count.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::AddCount(uint16_t* count) {
+		if (*count < 0xFFFF) {
+			(*count)++;
+		}
+	}
+
+	/*!
+		@brief		Attributes the time taken to parse an LPI.
+		@param		lpInstruction	A pointer to the LPI.
+		@param		startTime		The time, from GetTime, at which parsing started.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::RecordParse(LpInstruction* lpInstruction, uint32_t startTime) {
+		LpInstructionProfile* profile = GetProfile(lpInstruction);
+		if (profile != nullptr) {
+			profile->parseTime += clock() - startTime;
+		}
+	}
+
+	/*!
+		@brief		Attributes the time taken to execute a step of an LPI.
+		@param		lpInstruction	A pointer to the LPI.
+		@param		startTime		The time, from GetTime, at which execution started.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::RecordExecute(LpInstruction* lpInstruction, uint32_t startTime) {
+		LpInstructionProfile* profile = GetProfile(lpInstruction);
+		if (profile != nullptr) {
+			profile->executeTime += clock() - startTime;
+			AddCount(&profile->steps);
+		}
+	}
+
+	/*!
+		@brief		Attributes the time taken to set and show the pixels of a frame
+					rendered by an LPI.
+		@param		lpInstruction	A pointer to the LPI that rendered the frame.
+		@param		startTime		The time, from GetTime, at which the pixels started to be set.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpProfiler::RecordPixels(LpInstruction* lpInstruction, uint32_t startTime) {
+		LpInstructionProfile* profile = GetProfile(lpInstruction);
+		if (profile != nullptr) {
+			profile->pixelsTime += clock() - startTime;
+			AddCount(&profile->frames);
+		}
+	}
+}
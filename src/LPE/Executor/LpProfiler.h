@@ -0,0 +1,71 @@
+#ifndef _LpProfiler_h
+#define _LpProfiler_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../StateBuilder/LpState.h"
+
+namespace LS {
+	/*!
+		@brief	Function that returns a free running time in microseconds,
+				i.e. micros() on the device or any other clock on a host.
+	*/
+	typedef uint32_t (*LpProfilerClock)();
+
+	/*!
+		@brief	The time and call counts attributed to a single LPI.
+				Times are in microseconds.
+	*/
+	struct LpInstructionProfile {
+		uint32_t parseTime = 0;			// extracting the LPI details and loading the LPI
+		uint32_t executeTime = 0;		// executing the LPI (or replaying it from the frame cache)
+		uint32_t pixelsTime = 0;		// setting and showing the pixels rendered by the LPI
+		uint16_t steps = 0;				// number of steps rendered by the executor
+		uint16_t frames = 0;			// number of frames shown on the LEDs
+	};
+
+	/*!
+		@brief	Attributes the time spent rendering a program to each of
+				its LPIs so that the expensive instructions can be found.
+				The profile of an LPI is keyed by its position in the LP
+				state and is discarded whenever the state is reset (i.e.
+				a new program is loaded).  Profiling is off by default
+				as reading the clock adds to the cost of every frame.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpProfiler {
+	private:
+		// xxxx: *** BUFFER ALLOCATION *** - Profile of each LPI in the LP state
+		LpInstructionProfile profiles[MAX_LPINSTRUCTIONS];
+
+		LpProfilerClock clock;
+		LpState* state = nullptr;			// state that the profiles belong to
+		uint16_t stateGeneration = 0;
+		bool enabled = false;
+
+		LpInstructionProfile* GetProfile(LpInstruction* lpInstruction);
+		static void AddCount(uint16_t* count);
+
+	public:
+		LpProfiler(LpProfilerClock clock);
+
+		void Clear();
+		void Validate(LpState* state);
+		void SetEnabled(bool enabled);
+		bool IsEnabled();
+		uint32_t GetTime();
+
+		void RecordParse(LpInstruction* lpInstruction, uint32_t startTime);
+		void RecordExecute(LpInstruction* lpInstruction, uint32_t startTime);
+		void RecordPixels(LpInstruction* lpInstruction, uint32_t startTime);
+
+		LpInstructionProfile* GetProfile(uint8_t lpInstructionIndex);
+	};
+}
+
+#endif
@@ -0,0 +1,172 @@
+#include "LpTransitionFrame.h"
+
+namespace LS {
+	/*!
+		@brief		Forgets the saved frame (and ends any transition) so that
+					the next LPI to begin does not fade in.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::Clear() {
+		hasFrame = false;
+		remainingFrames = 0;
+	}
+
+	/*!
+		@brief		Clears the frame if it was output for a previous program (i.e.
+					the LP state has been reset since) or for a different number of LEDs.
+		@param		stateGeneration		The current generation of the LP state.
+		@param		numberOfLeds		The current number of LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::Validate(uint16_t stateGeneration, uint16_t numberOfLeds) {
+		if (this->stateGeneration == stateGeneration
+			&& this->numberOfLeds == numberOfLeds) {
+			return;
+		}
+
+		Clear();
+		this->stateGeneration = stateGeneration;
+		this->numberOfLeds = numberOfLeds;
+	}
+
+	/*!
+		@brief		Begins the transition of an LPI that has just begun.  There is no
+					transition if no frame has been saved to fade in from.
+		@param		numberOfFrames		The number of frames over which the LPI fades in (0 = none,
+										which ends the transition of the LPI before it).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::Begin(uint8_t numberOfFrames) {
+		remainingFrames = hasFrame ? numberOfFrames : 0;
+	}
+
+	/*!
+		@brief		Ends the transition so that the output of the LPI is no longer blended.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::End() {
+		remainingFrames = 0;
+	}
+
+	/*!
+		@brief		Gets whether an LPI is fading in, i.e. whether a frame must be
+					output on every frame until the transition completes.
+		@returns	True if an LPI is fading in, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpTransitionFrame::IsTransitioning() {
+		return remainingFrames > 0;
+	}
+
+	/*!
+		@brief		Gets the number of pixels of the frame.
+		@returns	The number of pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpTransitionFrame::GetNumberOfPixels() {
+		return numberOfLeds < TRANSITION_FRAME_LEDS ? numberOfLeds : TRANSITION_FRAME_LEDS;
+	}
+
+	/*!
+		@brief		Saves the output of the executor, blending it in to the saved frame
+					whilst an LPI is fading in.  The output is replaced by the blended
+					frame on every frame of the transition but the last, on which the
+					output is shown as it is.
+		@param		lpiExecutorOutput	A pointer to the output of the executor.  Nothing
+										is saved if no rendering instructions were set.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::Apply(LpiExecutorOutput* lpiExecutorOutput) {
+		if (lpiExecutorOutput == nullptr
+			|| !lpiExecutorOutput->RenderingInstructionsSet()) {
+			return;
+		}
+
+		// each frame of the transition moves the fraction of the way that is left
+		// so the fade is linear and the last frame is the output itself
+		uint16_t weight = remainingFrames > 1 ? 256 / remainingFrames : 256;
+		if (!hasFrame) {
+			// pixels that the output does not reach are off
+			memset(pixels, 0, sizeof(pixels));
+		}
+		Expand(lpiExecutorOutput, weight);
+		hasFrame = true;
+
+		if (remainingFrames == 0) {
+			return;
+		}
+
+		remainingFrames--;
+		if (weight < 256) {
+			GetOutput(lpiExecutorOutput);
+		}
+	}
+
+	/*!
+		@brief		Blends the rendering instructions of an output into the frame.  The
+					pixel of each rendering instruction is packed once.  Pixels that the
+					rendering instructions do not reach are left as they are, as they
+					are on the LEDs.
+		@param		lpiExecutorOutput	A pointer to the output.
+		@param		weight				How far each pixel moves towards the output (0 - 256).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::Expand(LpiExecutorOutput* lpiExecutorOutput, uint16_t weight) {
+		RI* renderingInstructions = lpiExecutorOutput->GetRenderingInstructions();
+		uint16_t numberOfInstructions = lpiExecutorOutput->GetNumberOfRenderingInstructions();
+		bool repeat = lpiExecutorOutput->GetRepeatRenderingInstructions();
+
+		uint16_t numberOfPixels = GetNumberOfPixels();
+		uint16_t pixelIndex = 0;
+		uint16_t passStart;
+		do {
+			passStart = pixelIndex;
+			for (uint16_t riIndex = 0; riIndex < numberOfInstructions && pixelIndex < numberOfPixels; riIndex++) {
+				Colour* colour = &renderingInstructions[riIndex].colour;
+				uint32_t pixel = ((uint32_t)colour->red << 16) | ((uint32_t)colour->green << 8) | colour->blue;
+				uint16_t endIndex = renderingInstructions[riIndex].number < numberOfPixels - pixelIndex
+					? pixelIndex + renderingInstructions[riIndex].number
+					: numberOfPixels;
+
+				if (weight == 256) {
+					for (; pixelIndex < endIndex; pixelIndex++) pixels[pixelIndex] = pixel;
+				}
+				else {
+					for (; pixelIndex < endIndex; pixelIndex++) pixels[pixelIndex] = Lerp(pixels[pixelIndex], pixel, weight);
+				}
+			}
+		} while (repeat && pixelIndex < numberOfPixels && pixelIndex > passStart);
+	}
+
+	/*!
+		@brief		Replaces the rendering instructions of an output with those of the
+					frame.  Neighbouring pixels of the same colour share a rendering instruction.
+		@param		lpiExecutorOutput	A pointer to the output.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpTransitionFrame::GetOutput(LpiExecutorOutput* lpiExecutorOutput) {
+		lpiExecutorOutput->Reset();
+
+		uint16_t numberOfPixels = GetNumberOfPixels();
+		uint16_t runStart = 0;
+		for (uint16_t pixelIndex = 1; pixelIndex <= numberOfPixels; pixelIndex++) {
+			if (pixelIndex < numberOfPixels
+				&& pixels[pixelIndex] == pixels[runStart]) {
+				continue;
+			}
+
+			Colour colour(pixels[runStart] >> 16, pixels[runStart] >> 8, pixels[runStart]);
+			lpiExecutorOutput->SetNextRenderingInstruction(&colour, pixelIndex - runStart);
+			runStart = pixelIndex;
+		}
+	}
+}
\ No newline at end of file
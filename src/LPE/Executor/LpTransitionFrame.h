@@ -0,0 +1,77 @@
+#ifndef _LpTransitionFrame_h
+#define _LpTransitionFrame_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ValueDomainTypes.h"
+#include "../LpiExecutors/LpiExecutorOutput.h"
+
+// 1400: *** BUFFER ALLOCATION *** - The frame that LPIs with a transition fade in from
+#define TRANSITION_FRAME_LEDS		MAX_RENDERING_INSTRUCTIONS		// most LEDs of the frame (one packed colour per LED)
+#define TRANSITION_RED_BLUE			0x00FF00FF						// red and blue channels of a packed colour
+#define TRANSITION_GREEN			0x0000FF00						// green channel of a packed colour
+
+namespace LS {
+	/*!
+		@brief	The single frame that an LPI with a transition fades in from.  The
+				executor saves each frame that it outputs and, whilst an LPI is
+				fading in, blends the saved frame towards the output of the LPI on
+				every frame of the transition, saving the blended frame in its place.
+				Each frame moves a fraction of the way that is left, so the fade is
+				linear and completes on the last frame of the transition even when
+				the LPI that is fading in is animated.  Colours are packed in to a
+				32-bit value so that red and blue are blended together, then green.
+				The frame must be cleared whenever it is no longer on display, which
+				is detected using the generation of the LP state.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpTransitionFrame {
+	private:
+		uint32_t pixels[TRANSITION_FRAME_LEDS];		// the frame last output (0x00RRGGBB)
+		bool hasFrame = false;						// whether a frame has been saved since the frame was cleared
+
+		uint16_t stateGeneration = 0;				// generation of the LP state that the frame belongs to
+		uint16_t numberOfLeds = 0;					// number of LEDs the frame was rendered for
+		uint8_t remainingFrames = 0;				// frames until the transition completes (0 = none)
+
+	protected:
+		uint16_t GetNumberOfPixels();
+		void Expand(LpiExecutorOutput* lpiExecutorOutput, uint16_t weight);
+		void GetOutput(LpiExecutorOutput* lpiExecutorOutput);
+
+		/*!
+			@brief		Moves a pixel part of the way towards a target pixel:
+						pixel x (256 - weight) + target x weight, / 256.
+			@param		pixel		The pixel (0x00RRGGBB).
+			@param		target		The target pixel (0x00RRGGBB).
+			@param		weight		How far to move towards the target (0 - 256).
+			@returns	The moved pixel.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t Lerp(uint32_t pixel, uint32_t target, uint16_t weight) {
+			uint16_t pixelWeight = 256 - weight;
+			uint32_t redBlue = ((pixel & TRANSITION_RED_BLUE) * pixelWeight + (target & TRANSITION_RED_BLUE) * weight) >> 8;
+			uint32_t green = ((pixel & TRANSITION_GREEN) * pixelWeight + (target & TRANSITION_GREEN) * weight) >> 8;
+
+			return (redBlue & TRANSITION_RED_BLUE) | (green & TRANSITION_GREEN);
+		}
+
+	public:
+		void Clear();
+		void Validate(uint16_t stateGeneration, uint16_t numberOfLeds);
+
+		void Begin(uint8_t numberOfFrames);
+		void End();
+		bool IsTransitioning();
+
+		void Apply(LpiExecutorOutput* lpiExecutorOutput);
+	};
+}
+
+#endif
\ No newline at end of file
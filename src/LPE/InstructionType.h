@@ -4,13 +4,14 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../WProgram.h"
 #endif
 
 namespace LS {
 	enum InstructionType {
 		Lpi,
-		Repeat
+		Repeat,
+		Call
 	};
 }
 
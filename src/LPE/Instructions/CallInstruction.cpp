@@ -0,0 +1,85 @@
+#include "CallInstruction.h"
+
+namespace LS {
+	/*!
+		@brief		Gets the instruction that is executed in place of the call.
+		@returns	A pointer to the called instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	Instruction* CallInstruction::GetCalledInstruction() {
+		return calledInstruction;
+	}
+
+	/*!
+		@brief		Sets the instruction that is executed in place of the call.
+		@param		calledInstruction	A pointer to the called instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void CallInstruction::SetCalledInstruction(Instruction* calledInstruction) {
+		this->calledInstruction = calledInstruction;
+	}
+
+	/*!
+		@brief		Gets the palette that the call passes to the instruction it calls.
+		@returns	The identity of the palette (0 if the palette of the instructions
+					that contain the call is kept).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t CallInstruction::GetPaletteId() {
+		return paletteId;
+	}
+
+	/*!
+		@brief		Sets the palette that the call passes to the instruction it calls.
+		@param		paletteId	The identity of the palette (0 to keep the palette of
+								the instructions that contain the call).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void CallInstruction::SetPaletteId(uint8_t paletteId) {
+		this->paletteId = paletteId;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames the call lasts for.
+		@returns	The number of rendering frames of the called instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t CallInstruction::GetFrameLength() {
+		if (calledInstruction == nullptr) {
+			return 0;
+		}
+
+		return calledInstruction->GetFrameLength();
+	}
+
+	/*!
+		@brief		Resets the state of the call back to default values.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void CallInstruction::reset() {
+		Instruction::reset();
+		calledInstruction = nullptr;
+		paletteId = 0;
+	}
+
+	/*!
+		@brief		Initialises the state of this call from an existing
+					call instance.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void CallInstruction::init(CallInstruction* callInstruction) {
+		if (callInstruction == nullptr) {
+			return;
+		}
+
+		calledInstruction = callInstruction->GetCalledInstruction();
+		paletteId = callInstruction->GetPaletteId();
+	}
+}
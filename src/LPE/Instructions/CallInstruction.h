@@ -0,0 +1,45 @@
+#ifndef _CallInstruction_h
+#define _CallInstruction_h
+
+#include "Instruction.h"
+
+namespace LS {
+	/*!
+		@brief		Stores an instruction that executes an instruction held
+					elsewhere in the tree in its place.  This allows an instruction
+					(an LPI or an entire repeat) that appears more than once in a
+					program to be held once and shared.  The called instruction
+					keeps the parent and next pointers of where it is held so the
+					executor returns to the call, by way of a call stack, once the
+					called instruction has completed.  A call of a subroutine may
+					pass a palette that the colour references of the LPIs it
+					executes are replaced by.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	class CallInstruction : public Instruction {
+		private:
+			Instruction* calledInstruction;
+			uint8_t paletteId;
+		public:
+			Instruction* GetCalledInstruction();
+			void SetCalledInstruction(Instruction* calledInstruction);
+			uint8_t GetPaletteId();
+			void SetPaletteId(uint8_t paletteId);
+			uint32_t GetFrameLength();
+
+			void reset();
+			void init(CallInstruction* callInstruction);
+
+			/*!
+				@brief		Gets the type of instruction.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			InstructionType getInstructionType() {
+				return InstructionType::Call;
+			}
+	};
+}
+
+#endif
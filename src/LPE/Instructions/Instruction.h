@@ -1,7 +1,10 @@
 #ifndef _Instruction_h
 #define _Instruction_h
 
-#include "..\InstructionType.h"
+#include <stdint.h>
+#include "../InstructionType.h"
+
+#define FRAME_LENGTH_INFINITE		0xFFFFFFFF		// the instruction never completes (or is too long to count)
 
 namespace LS {
 	/*!
@@ -26,6 +29,7 @@ namespace LS {
 			bool HasParent();
 
 			virtual InstructionType getInstructionType() = 0;
+			virtual uint32_t GetFrameLength() = 0;
 	};
 }
 #endif
@@ -165,4 +165,39 @@ uint8_t LpInstruction::DecrementCurrentDuration() {
 	uint8_t LpInstruction::GetDuration() {
 		return duration;
 	}
+
+	/*!
+		@brief		Gets the number of rendering frames remaining of the current animation step.
+		@returns	The remaining duration in rendering frames.
+	*/
+	uint8_t LpInstruction::GetCurrentDuration() {
+		return currentDuration;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames the instruction lasts for.
+		@returns	The number of steps multiplied by the duration of each step.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpInstruction::GetFrameLength() {
+		return (uint32_t)steps * duration;
+	}
+
+	/*!
+		@brief		Positions the instruction at a rendering frame part way through,
+					exactly as if it had been executed for that many frames.
+		@param		frame		The rendering frame relative to the start of the instruction
+								which must be less than the frame length.
+		@returns	The animation step that the frame belongs to.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpInstruction::SeekToFrame(uint32_t frame) {
+		uint16_t step = frame / duration;
+		remainingSteps = steps - step;
+		currentDuration = duration - (frame % duration);
+
+		return step;
+	}
 }
\ No newline at end of file
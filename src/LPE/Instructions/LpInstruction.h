@@ -1,7 +1,7 @@
 #ifndef _LpInstruction_h
 #define _LpInstruction_h
 
-#include "instruction.h"
+#include "Instruction.h"
 #include "LpInstruction.h"
 #include <stdint.h>
 
@@ -41,6 +41,11 @@ namespace LS {
 			uint8_t DecrementCurrentDuration();
 			void SetDuration(uint8_t duration);
 			uint8_t GetDuration();
+			uint8_t GetCurrentDuration();
+
+			// methods to position the instruction part way through
+			uint32_t GetFrameLength();
+			uint16_t SeekToFrame(uint32_t frame);
 
 			/*!
 				@brief		Gets the type of instruction.
@@ -87,6 +87,7 @@ namespace LS {
 		InstructionWithChild::reset();
 		numberOfIterations = -1;
 		remainingIterations = -1;
+		bodyFrameLength = 0;
 	}
 
 	/*!
@@ -103,4 +104,57 @@ namespace LS {
 		numberOfIterations = repeatInstruction->getNumberOfIterations();
 		remainingIterations = repeatInstruction->getRemainingIterations();
 	}
+
+	/*!
+		@brief		Sets the number of rendering frames of a single iteration of the
+					repeat i.e. the total of the frame lengths of its instructions.
+		@param		bodyFrameLength		The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void RepeatInstruction::SetBodyFrameLength(uint32_t bodyFrameLength) {
+		this->bodyFrameLength = bodyFrameLength;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames of a single iteration of the repeat.
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t RepeatInstruction::GetBodyFrameLength() {
+		return bodyFrameLength;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames the repeat lasts for.
+		@returns	The number of rendering frames of all of the iterations or
+					FRAME_LENGTH_INFINITE if the repeat is infinite.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t RepeatInstruction::GetFrameLength() {
+		if (isInfinite()
+			|| numberOfIterations < 0
+			|| (bodyFrameLength > 0 && (uint32_t)numberOfIterations > FRAME_LENGTH_INFINITE / bodyFrameLength)) {
+			return FRAME_LENGTH_INFINITE;
+		}
+
+		return bodyFrameLength * numberOfIterations;
+	}
+
+	/*!
+		@brief		Positions the repeat at the start of an iteration, exactly as if
+					the earlier iterations had been executed.
+		@param		iteration		The iteration (0 = first) which must be less than
+									the number of iterations.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void RepeatInstruction::SeekToIteration(uint32_t iteration) {
+		ResetRemainingIterations();
+		if (!isInfinite()) {
+			remainingIterations -= iteration;
+		}
+	}
 }
\ No newline at end of file
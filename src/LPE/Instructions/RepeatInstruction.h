@@ -1,7 +1,7 @@
 #ifndef _RepeatInstruction_h
 #define _RepeatInstruction_h
 
-#include "instructionWithChild.h"
+#include "InstructionWithChild.h"
 #include "LpInstruction.h"
 
 namespace LS {
@@ -16,6 +16,7 @@ namespace LS {
 		private:
 			int numberOfIterations = -1;
 			int remainingIterations = -1;
+			uint32_t bodyFrameLength = 0;		// number of rendering frames of a single iteration
 		public:
 			int getNumberOfIterations();
 			void setNumberOfIterations(int numberOfIterations);
@@ -25,6 +26,12 @@ namespace LS {
 			int decrementRemainingIterations();
 			bool isInfinite();
 
+			// methods to position the repeat part way through
+			void SetBodyFrameLength(uint32_t bodyFrameLength);
+			uint32_t GetBodyFrameLength();
+			uint32_t GetFrameLength();
+			void SeekToIteration(uint32_t iteration);
+
 			void reset();
 			void init(RepeatInstruction* repeatInstrution);
 
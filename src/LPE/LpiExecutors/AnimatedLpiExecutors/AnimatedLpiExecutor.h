@@ -4,11 +4,11 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
-#include "..\LpiExecutor.h"
-#include "..\LpiExecutorParams.h"
+#include "../LpiExecutor.h"
+#include "../LpiExecutorParams.h"
 
 namespace LS {
 	/*!
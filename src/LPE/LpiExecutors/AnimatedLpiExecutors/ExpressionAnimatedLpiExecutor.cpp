@@ -0,0 +1,266 @@
+#include "ExpressionAnimatedLpiExecutor.h"
+
+namespace LS {
+	/*!
+		@brief		Compiles the expression of an expression LPI, unless it is one of
+					the expressions that have already been compiled.  Several compiled
+					expressions are kept so that the programs of different layers, which
+					share the executor, do not replace each other's compiled expressions.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		numberOfColours		A pointer to the value that is set to the number of colours of the LPI.
+		@param		expressionEffect	A pointer to the value that is set to the compiled expression.
+		@returns	A pointer to the colours of the LPI or nullptr if the number of colours
+					or the expression is invalid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	const char* ExpressionAnimatedLpiExecutor::CompileExpression(LpiExecutorParams* lpiExecParams, uint8_t* numberOfColours, ExpressionEffect** expressionEffect) {
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+
+		bool isValid = false;
+		*numberOfColours = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 2, 1, MAX_PALETTE_SIZE, isValid);
+		if (!isValid
+			|| strlen(lpiBuffer + EXPRESSION_HEADER_LENGTH) <= (size_t)*numberOfColours * 6) {
+			return nullptr;
+		}
+
+		const char* coloursBuffer = lpiBuffer + EXPRESSION_HEADER_LENGTH;
+		const char* expression = coloursBuffer + *numberOfColours * 6;
+		for (uint8_t effectIndex = 0; effectIndex < EXPRESSION_CACHE_SIZE; effectIndex++) {
+			if (expressionEffects[effectIndex].IsCompiledFrom(expression)) {
+				*expressionEffect = &expressionEffects[effectIndex];
+				return coloursBuffer;
+			}
+		}
+
+		// replace the compiled expressions in turn
+		*expressionEffect = &expressionEffects[nextExpressionEffect];
+		nextExpressionEffect = (nextExpressionEffect + 1) % EXPRESSION_CACHE_SIZE;
+		if (!(*expressionEffect)->Compile(expression, stringProcessor)) {
+			return nullptr;
+		}
+
+		return coloursBuffer;
+	}
+
+	/*!
+		@brief		Valites that the LPI string is valid according to the
+					rules for the expression instruction.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@returns	True if the expression instruction is valid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool ExpressionAnimatedLpiExecutor::ValidateLpi(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return false;
+		}
+
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+
+		// we should have a number specifying the number of steps (1 - 255)
+		bool lpiIsValid = false;
+		stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer, 1, 255, lpiIsValid);
+		if (!lpiIsValid) {
+			return false;
+		}
+
+		// next, the colours of the gradient followed by an expression that compiles
+		uint8_t numberOfColours = 0;
+		ExpressionEffect* expressionEffect = nullptr;
+		const char* coloursBuffer = CompileExpression(lpiExecParams, &numberOfColours, &expressionEffect);
+		if (coloursBuffer == nullptr) {
+			return false;
+		}
+		for (uint8_t colourCounter = 0; colourCounter < numberOfColours; colourCounter++) {
+			stringProcessor->ExtractColourFromHexEncoded(coloursBuffer, lpiIsValid);
+			if (!lpiIsValid) {
+				return false;
+			}
+			coloursBuffer += 6;
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the number of animation steps of a specified expression LPI.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@returns	The number of animation steps of the expression.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t ExpressionAnimatedLpiExecutor::GetNumberOfSteps(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		bool isValid;
+		return lpiExecParams->GetStringProcesor()->ExtractNumberFromHexEncoded(lpiExecParams->GetLpiBufferWithoutBasicDetails(), 1, 255, isValid);
+	}
+
+	/*!
+		@brief		Executes the expression instruction and populates the output.  The
+					result of the expression, for each pixel, is a position along the
+					gradient of the colours: 0 is the first colour and 255 the last
+					(when there is only one colour, the result is its brightness).  Pixels
+					next to each other of the same colour share a rendering instruction.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		step				The step number in the animation which is to be rendered.
+		@param		output				A pointer to the class that is used to set the pixel
+										outputs from executing the instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void ExpressionAnimatedLpiExecutor::Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output) {
+		if (lpiExecParams == nullptr
+			|| output == nullptr) {
+			return;
+		}
+
+		if (!BeginRuns(lpiExecParams, step)) {
+			return;
+		}
+
+		// reset the state of the output, including a flag that states that output has been set!
+		output->Reset();
+
+		Colour runColour;
+		uint16_t pixelIndex = 0;
+		uint16_t runLength;
+		while ((runLength = GetNextRun(lpiExecParams, pixelIndex, &runColour)) > 0) {
+			output->SetNextRenderingInstruction(&runColour, runLength);
+			pixelIndex += runLength;
+		}
+	}
+
+	/*!
+		@brief		Prepares to generate the pixels of a step of the expression instruction
+					by compiling the expression (if it has not already been compiled) and
+					extracting the colours of the gradient.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		step				The step number in the animation which is to be generated.
+		@returns	True if the pixels can be generated or false if the step or expression is not valid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool ExpressionAnimatedLpiExecutor::BeginRuns(LpiExecutorParams* lpiExecParams, uint16_t step) {
+		if (lpiExecParams == nullptr) {
+			return false;
+		}
+
+		// ensure that specified step does not exceed the max number of steps
+		uint16_t totalSteps = GetNumberOfSteps(lpiExecParams);
+		if (step > totalSteps - 1) {
+			return false;
+		}
+
+		uint8_t numberOfColours = 0;
+		const char* coloursBuffer = CompileExpression(lpiExecParams, &numberOfColours, &runEffect);
+		if (coloursBuffer == nullptr) {
+			return false;
+		}
+
+		// a single colour is a gradient from black
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+		bool isValid;
+		uint8_t firstColour = numberOfColours == 1 ? 1 : 0;
+		runColours[0] = Colour();
+		for (uint8_t colourCounter = 0; colourCounter < numberOfColours; colourCounter++) {
+			runColours[firstColour + colourCounter] = stringProcessor->ExtractColourFromHexEncoded(coloursBuffer + colourCounter * 6, isValid);
+		}
+		numberOfSections = numberOfColours == 1 ? 1 : numberOfColours - 1;
+
+		numberOfLeds = lpiExecParams->GetNumberOfLeds();
+		runStep = step;
+		nextPixelIndex = EXPRESSION_NO_PIXEL;
+
+		return true;
+	}
+
+	/*!
+		@brief		Generates the next run of pixels of the same colour of the step of the
+					expression instruction that was prepared by BeginRuns.  The pixel that ends
+					a run is kept so that it is not evaluated again for the next run.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		pixelIndex			The pixel that the run starts at.
+		@param		colour				A pointer to the colour that is set to that of the run.
+		@returns	The number of pixels of the run or 0 if there are no more pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t ExpressionAnimatedLpiExecutor::GetNextRun(LpiExecutorParams* /*lpiExecParams*/, uint16_t pixelIndex, Colour* colour) {
+		if (pixelIndex >= numberOfLeds) {
+			return 0;
+		}
+
+		*colour = pixelIndex == nextPixelIndex ? nextPixelColour : GetPixel(pixelIndex);
+		nextPixelIndex = EXPRESSION_NO_PIXEL;
+
+		uint16_t runLength = 1;
+		for (; pixelIndex + runLength < numberOfLeds; runLength++) {
+			Colour pixelColour = GetPixel(pixelIndex + runLength);
+			if (pixelColour.red != colour->red
+				|| pixelColour.green != colour->green
+				|| pixelColour.blue != colour->blue) {
+				nextPixelIndex = pixelIndex + runLength;
+				nextPixelColour = pixelColour;
+				break;
+			}
+		}
+
+		return runLength;
+	}
+
+	/*!
+		@brief		Evaluates the expression for a pixel of the step that was prepared by
+					BeginRuns.  The result of the expression is a position along the
+					gradient of the colours.
+		@param		pixelIndex			The pixel.
+		@returns	The colour of the pixel.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	Colour ExpressionAnimatedLpiExecutor::GetPixel(uint16_t pixelIndex) {
+		// find the two colours the result is between and how far it is from the first
+		uint16_t position = (uint16_t)runEffect->Evaluate(pixelIndex, runStep, numberOfLeds) * numberOfSections;
+		uint8_t section = position / 255;
+		uint8_t fraction = position % 255;
+		Colour pixelColour = runColours[section];
+		if (fraction > 0) {
+			Colour* nextColour = &runColours[section + 1];
+			pixelColour.red += ((int16_t)nextColour->red - pixelColour.red) * fraction / 255;
+			pixelColour.green += ((int16_t)nextColour->green - pixelColour.green) * fraction / 255;
+			pixelColour.blue += ((int16_t)nextColour->blue - pixelColour.blue) * fraction / 255;
+		}
+
+		return pixelColour;
+	}
+
+	/*!
+			@brief		Estimates the time taken to execute a step of the expression instruction.
+					The expression is evaluated, and may add an RI, for every pixel.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t ExpressionAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		uint8_t numberOfColours = 0;
+		ExpressionEffect* expressionEffect = nullptr;
+		if (CompileExpression(lpiExecParams, &numberOfColours, &expressionEffect) == nullptr) {
+			return COST_LPI_BASE;
+		}
+
+		return COST_LPI_BASE
+			+ (uint32_t)numberOfColours * COST_LPI_RENDERING_INSTRUCTION
+			+ (uint32_t)lpiExecParams->GetNumberOfLeds()
+				* (expressionEffect->GetNumberOfOperations() * COST_EXPRESSION_OPERATION + COST_LPI_RENDERING_INSTRUCTION);
+	}
+}
\ No newline at end of file
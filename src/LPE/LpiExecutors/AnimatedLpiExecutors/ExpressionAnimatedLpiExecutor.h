@@ -0,0 +1,58 @@
+#ifndef _ExpressionAnimatedLpiExecutor_h
+#define _ExpressionAnimatedLpiExecutor_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../../WProgram.h"
+#endif
+
+#include "AnimatedLpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
+#include "../../EffectHelpers/ExpressionEffect.h"
+#include <string.h>
+
+#define EXPRESSION_HEADER_LENGTH	4		// steps (2) and number of colours (2)
+#define EXPRESSION_CACHE_SIZE		4		// most compiled expressions kept so that layers do not compile each other's again
+#define EXPRESSION_NO_PIXEL			0xFFFF	// no pixel has been evaluated ahead of the run being generated
+
+namespace LS {
+	/*!
+		@brief		Provides an executor implementation for the expression LPI.  An
+					expression, of the pixel index and the step, is evaluated for
+					each pixel and its result (0 - 255) picks the colour of the pixel
+					from a gradient through the colours of the LPI.  The expression
+					is compiled into bytecode once, rather than parsed for each pixel.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	class ExpressionAnimatedLpiExecutor : public AnimatedLpiExecutor {
+	protected:
+		ExpressionEffect expressionEffects[EXPRESSION_CACHE_SIZE];
+		uint8_t nextExpressionEffect = 0;		// the compiled expression that is replaced next
+
+		// the step whose pixels are being generated
+		ExpressionEffect* runEffect = nullptr;
+		Colour runColours[MAX_PALETTE_SIZE + 1];
+		uint8_t numberOfSections = 0;
+		uint16_t runStep = 0;
+		uint16_t numberOfLeds = 0;
+		uint16_t nextPixelIndex = EXPRESSION_NO_PIXEL;	// the pixel that ended the last run, which has already been evaluated
+		Colour nextPixelColour;
+
+		const char* CompileExpression(LpiExecutorParams* lpiExecParams, uint8_t* numberOfColours, ExpressionEffect** expressionEffect);
+		Colour GetPixel(uint16_t pixelIndex);
+
+	public:
+		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams);
+		virtual uint16_t GetNumberOfSteps(LpiExecutorParams* lpiExecParams);
+		virtual void Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output);
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
+		virtual bool BeginRuns(LpiExecutorParams* lpiExecParams, uint16_t step);
+		virtual uint16_t GetNextRun(LpiExecutorParams* lpiExecParams, uint16_t pixelIndex, Colour* colour);
+	};
+}
+
+#endif
@@ -146,7 +146,7 @@ namespace LS {
 			fadeColour.blue = max(newB, endColour.blue);
 		}
 
-		// output->SetNextRenderingInstruction(&fadeColour, lpiExecParams->GetLedConfig()->numberOfLEDs);
+		// output->SetNextRenderingInstruction(&fadeColour, lpiExecParams->GetNumberOfLeds());
 		output->SetNextRenderingInstruction(&fadeColour, 1);
 		output->SetRepeatRenderingInstructions();
 	}
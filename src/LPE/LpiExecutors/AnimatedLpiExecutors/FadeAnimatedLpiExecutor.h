@@ -4,13 +4,13 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
 #include "AnimatedLpiExecutor.h"
-#include "..\..\..\ValueDomainTypes.h"
-#include "..\LpiExecutorParams.h"
-#include "..\LpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
 #include <math.h>
 
 #define max(a,b) (a>b?a:b)
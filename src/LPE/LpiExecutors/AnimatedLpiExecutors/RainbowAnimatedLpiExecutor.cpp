@@ -97,64 +97,119 @@ namespace LS {
 			return;
 		}
 
-		// ensure that specified step does not exceed the max number of steps
-		uint16_t totalSteps = GetNumberOfSteps(lpiExecParams);
-		if (step > totalSteps - 1) {
+		if (!BeginRuns(lpiExecParams, step)) {
 			return;
 		}
 
 		// reset the state of the output, including a flag that states that output has been set!
 		output->Reset();
 
+		// add a rendering instruction for each pixel
+		Colour rainbowPixelColour;
+		for (uint16_t pixelIndex = 0; pixelIndex < numberOfLeds; pixelIndex++) {
+			GetNextRun(lpiExecParams, pixelIndex, &rainbowPixelColour);
+			output->SetNextRenderingInstruction(&rainbowPixelColour, 1);
+		}
+	}
+
+	/*!
+		@brief		Prepares to generate the pixels of a step of the rainbow instruction
+					by extracting the parameters of the rainbow effect from the LPI.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		step				The step number in the animation which is to be generated.
+		@returns	True if the pixels can be generated or false if the step is not valid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool RainbowAnimatedLpiExecutor::BeginRuns(LpiExecutorParams* lpiExecParams, uint16_t step) {
+		if (lpiExecParams == nullptr) {
+			return false;
+		}
+
+		// ensure that specified step does not exceed the max number of steps
+		uint16_t totalSteps = GetNumberOfSteps(lpiExecParams);
+		if (step > totalSteps - 1) {
+			return false;
+		}
+
 		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
-		const char* colourBuffer = lpiBuffer + 7;
-		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+		colourBuffer = lpiBuffer + 7;
+		stringProcessor = lpiExecParams->GetStringProcesor();
 
 		// get the parameters of the rainbow effect from the LPI
 		bool isValid;
 		uint8_t effectLength = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer, 1, 255, isValid);
-		uint8_t effectSteps = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 2, 1, 255, isValid);
-		bool startFar = stringProcessor->ExtractBoolFromHexEncoded(lpiBuffer + 4, isValid);
-		uint8_t numberOfColours = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 5, 1, 10, isValid);
+		effectSteps = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 2, 1, 255, isValid);
+		startFar = stringProcessor->ExtractBoolFromHexEncoded(lpiBuffer + 4, isValid);
+		numberOfColours = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 5, 1, 10, isValid);
+
+		numEffectStepsDivLength = effectSteps / effectLength;
+		numEffectStepsDivNumColours = effectSteps / numberOfColours;
+		numberOfLeds = lpiExecParams->GetNumberOfLeds();
+		runStep = step;
 
-		// calculate the value of each pixel for this step of the rainbow effect
+		return true;
+	}
+
+	/*!
+		@brief		Generates the next pixel of the step of the rainbow instruction that was
+					prepared by BeginRuns.  Each pixel is a run of its own.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		pixelIndex			The pixel to generate.
+		@param		colour				A pointer to the colour that is set to that of the pixel.
+		@returns	1 or 0 if there are no more pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t RainbowAnimatedLpiExecutor::GetNextRun(LpiExecutorParams* /*lpiExecParams*/, uint16_t pixelIndex, Colour* colour) {
+		if (pixelIndex >= numberOfLeds) {
+			return 0;
+		}
+
+		// calculate the value of the pixel for this step of the rainbow effect
 		uint16_t ind = 0;
-		uint8_t colourIndex1, colourIndex2;
-		int switchVal = 0;
-		float factor1, factor2 = 0;
-		float numEffectStepsDivLength = effectSteps / effectLength;;
-		float numEffectStepsDivNumColours = effectSteps / numberOfColours;
+		if (!startFar) {
+			ind = runStep + pixelIndex * numEffectStepsDivLength;
+		}
+		else {
+			ind = effectSteps - ((uint16_t)abs(runStep - pixelIndex * (uint16_t)numEffectStepsDivLength)) % effectSteps;
+		}
+
+		int switchVal = (int)(ind % effectSteps) / numEffectStepsDivNumColours;
+		float factor1 = 1.0 - ((float)(ind % effectSteps - switchVal * numEffectStepsDivNumColours) / numEffectStepsDivNumColours);
+		float factor2 = (float)((int)(ind - (switchVal * numEffectStepsDivNumColours)) % effectSteps) / numEffectStepsDivNumColours;
+
+		// get the colours from the buffer.  The first 7 bytes of the
+		// instruction buffer contain the configuration properties.
+		// The reamining 6x (x = number of colours) contain the colours.
 		bool colourIsValid;
-		Colour rainbowPixelColour;
+		uint8_t colourIndex1 = switchVal * 6;
+		uint8_t colourIndex2 = (switchVal == numberOfColours - 1 ? 0 : switchVal + 1) * 6;
+		Colour colour1 = stringProcessor->ExtractColourFromHexEncoded(colourBuffer + colourIndex1, colourIsValid);
+		Colour colour2 = stringProcessor->ExtractColourFromHexEncoded(colourBuffer + colourIndex2, colourIsValid);
 
-		for (uint16_t pixelIndex = 0; pixelIndex < lpiExecParams->GetLedConfig()->numberOfLEDs; pixelIndex++) {
-			if (!startFar) {
-				ind = step + pixelIndex * numEffectStepsDivLength;
-			}
-			else {
-				ind = effectSteps - ((uint16_t)abs(step - pixelIndex * (uint16_t)numEffectStepsDivLength)) % effectSteps;
-			}
+		// now blend the colours and calculate the component r g b
+		colour->red = colour1.red * factor1 + colour2.red * factor2;
+		colour->green = colour1.green * factor1 + colour2.green * factor2;
+		colour->blue = colour1.blue * factor1 + colour2.blue * factor2;
 
-			switchVal = (int)(ind % effectSteps) / numEffectStepsDivNumColours;
-			factor1 = 1.0 - ((float)(ind % effectSteps - switchVal * numEffectStepsDivNumColours) / numEffectStepsDivNumColours);
-			factor2 = (float)((int)(ind - (switchVal * numEffectStepsDivNumColours)) % effectSteps) / numEffectStepsDivNumColours;
-
-			// get the colours from the buffer.  The first 7 bytes of the
-			// instruction buffer contain the configuration properties.
-			// The reamining 6x (x = number of colours) contain the colours.
-			colourIndex1 = switchVal * 6;
-			colourIndex2 = (switchVal == numberOfColours - 1 ? 0 : switchVal + 1) * 6;
-			Colour colour1 = stringProcessor->ExtractColourFromHexEncoded(colourBuffer + colourIndex1, colourIsValid);
-			Colour colour2 = stringProcessor->ExtractColourFromHexEncoded(colourBuffer + colourIndex2, colourIsValid);
-
-			// now blend the colours and calculate the component r g b
-			rainbowPixelColour.red = colour1.red * factor1 + colour2.red * factor2;
-			rainbowPixelColour.green = colour1.green * factor1 + colour2.green * factor2;
-			rainbowPixelColour.blue = colour1.blue * factor1 + colour2.blue * factor2;
-			
-
-			// add a rendering instruction for the pixel
-			output->SetNextRenderingInstruction(&rainbowPixelColour, 1);
+		return 1;
+	}
+
+	/*!
+			@brief		Estimates the time taken to execute a step of the rainbow instruction.  Two
+					colours are extracted and blended, and an RI added, for every LED.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t RainbowAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
 		}
+
+		return COST_LPI_BASE
+			+ (uint32_t)lpiExecParams->GetNumberOfLeds() * (COST_LPI_BLENDED_PIXEL + 2 * COST_LPI_RENDERING_INSTRUCTION);
 	}
 }
\ No newline at end of file
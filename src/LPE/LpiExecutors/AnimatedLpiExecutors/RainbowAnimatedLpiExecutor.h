@@ -4,13 +4,13 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
 #include "AnimatedLpiExecutor.h"
-#include "..\..\..\ValueDomainTypes.h"
-#include "..\LpiExecutorParams.h"
-#include "..\LpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
 #include <string.h>
 
 namespace LS {
@@ -20,10 +20,25 @@ namespace LS {
 		@date		2 Jan 2021
 	*/
 	class RainbowAnimatedLpiExecutor : public AnimatedLpiExecutor {
+	protected:
+		// the parameters of the step whose pixels are being generated
+		StringProcessor* stringProcessor = nullptr;
+		const char* colourBuffer = nullptr;
+		uint16_t runStep = 0;
+		uint16_t numberOfLeds = 0;
+		uint8_t effectSteps = 0;
+		uint8_t numberOfColours = 0;
+		bool startFar = false;
+		float numEffectStepsDivLength = 0;
+		float numEffectStepsDivNumColours = 0;
+
 	public:
 		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams);
 		virtual uint16_t GetNumberOfSteps(LpiExecutorParams* lpiExecParams);
 		virtual void Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output);
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
+		virtual bool BeginRuns(LpiExecutorParams* lpiExecParams, uint16_t step);
+		virtual uint16_t GetNextRun(LpiExecutorParams* lpiExecParams, uint16_t pixelIndex, Colour* colour);
 	};
 }
 
@@ -78,7 +78,7 @@ namespace LS {
 		uint8_t sliderWidth = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer, 1, 255, isValid);
 
 		// now we can calculate the total steps involved
-		uint16_t totalSteps = lpiExecParams->GetLedConfig()->numberOfLEDs - sliderWidth + 1;
+		uint16_t totalSteps = lpiExecParams->GetNumberOfLeds() - sliderWidth + 1;
 
 		return totalSteps;
 	}
@@ -123,7 +123,7 @@ namespace LS {
 
 		// calculate the values that determine the number of LEDs to be rendered
 		uint16_t numLedsBeforeSlider = step;
-		uint16_t numLedsAfterSlider = lpiExecParams->GetLedConfig()->numberOfLEDs - sliderWidth - numLedsBeforeSlider;
+		uint16_t numLedsAfterSlider = lpiExecParams->GetNumberOfLeds() - sliderWidth - numLedsBeforeSlider;
 
 		// we need to reserve those two values if the slider starts far
 		if (startFar) {
@@ -180,7 +180,7 @@ namespace LS {
 		Colour &backgroundColour,
 		Colour &sliderColour
 	) {
-		uint16_t numTailPixels = (lpiExecParams->GetLedConfig()->numberOfLEDs - sliderWidth) * ((float)tailLength / 100);
+		uint16_t numTailPixels = (lpiExecParams->GetNumberOfLeds() - sliderWidth) * ((float)tailLength / 100);
 		uint16_t tailStep = min(numLedsBeforeSlider, numTailPixels);
 		uint16_t tailPixelsToRender = numLedsBeforeSlider - numTailPixels < 0 ? numLedsBeforeSlider : numTailPixels;
 
@@ -189,6 +189,9 @@ namespace LS {
 			output->SetNextRenderingInstruction(&backgroundColour, numLedsBeforeSlider);
 		}
 
+		// the gradient is local so that nothing is kept from one execution to the next
+		// (the executor is shared by the programs of every layer)
+		GradientEffect gradientEffect;
 		gradientEffect.Reset(sliderColour, backgroundColour, numTailPixels);
 		Colour newTailColour;
 		for (int i = 0; i < tailPixelsToRender; i++) {
@@ -219,8 +222,9 @@ namespace LS {
 		Colour& backgroundColour,
 		Colour& sliderColour
 	) {
-		uint16_t numHeadPixels = (lpiExecParams->GetLedConfig()->numberOfLEDs - sliderWidth) * ((float)headLength / 100);
+		uint16_t numHeadPixels = (lpiExecParams->GetNumberOfLeds() - sliderWidth) * ((float)headLength / 100);
 
+		GradientEffect gradientEffect;
 		gradientEffect.Reset(sliderColour, backgroundColour, numHeadPixels);
 		Colour newHeadColour;
 		if (numHeadPixels > numLedsAfterSlider) numHeadPixels = numLedsAfterSlider;
@@ -230,4 +234,28 @@ namespace LS {
 			numLedsAfterSlider--;
 		}
 	}
+
+	/*!
+			@brief		Estimates the time taken to execute a step of the slider instruction.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t SliderAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+
+		// an RI for the background either side of the slider, the slider itself and
+		// each pixel of the head and tail
+		bool isValid;
+		uint8_t headLength = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 3, 0, 100, isValid);
+		uint8_t tailLength = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 5, 0, 100, isValid);
+
+		return COST_LPI_BASE + (uint32_t)(3 + headLength + tailLength) * COST_LPI_RENDERING_INSTRUCTION;
+	}
 }
\ No newline at end of file
@@ -4,14 +4,14 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
 #include "AnimatedLpiExecutor.h"
-#include "..\..\..\ValueDomainTypes.h"
-#include "..\LpiExecutorParams.h"
-#include "..\LpiExecutor.h"
-#include "..\..\EffectHelpers\GradientEffect.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
+#include "../../EffectHelpers/GradientEffect.h"
 
 #define max(a,b) (a>b?a:b)
 #define min(a,b) (a<b?a:b)
@@ -23,9 +23,6 @@ namespace LS {
 		@date		2 Jan 2021
 	*/
 	class SliderAnimatedLpiExecutor : public AnimatedLpiExecutor {
-	private:
-		GradientEffect gradientEffect;
-
 	protected:
 		void RenderTail(
 			uint16_t& numLedsBeforeSlider,
@@ -51,6 +48,7 @@ namespace LS {
 		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams);
 		virtual uint16_t GetNumberOfSteps(LpiExecutorParams* lpiExecParams);
 		virtual void Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output);
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
 	};
 }
 
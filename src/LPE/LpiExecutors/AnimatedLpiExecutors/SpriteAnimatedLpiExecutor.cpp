@@ -0,0 +1,197 @@
+#include "SpriteAnimatedLpiExecutor.h"
+
+namespace LS {
+	/*!
+		@brief		Valites that the LPI string is valid according to the
+					rules for the sprite instruction.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@returns	True if the sprite instruction is valid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool SpriteAnimatedLpiExecutor::ValidateLpi(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return false;
+		}
+
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+
+		// we should have a number specifying the number of steps (1 - 255)
+		bool lpiIsValid = false;
+		stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer, 1, 255, lpiIsValid);
+		if (!lpiIsValid) {
+			return false;
+		}
+
+		// next, the number of pixels the image is scrolled by on each step (0 - 255)
+		stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 2, 0, 255, lpiIsValid);
+		if (!lpiIsValid) {
+			return false;
+		}
+
+		// next, we should have a boolean for whether the image scrolls away from (0) or towards (1) the near end
+		stringProcessor->ExtractBoolFromHexEncoded(lpiBuffer + 4, lpiIsValid);
+		if (!lpiIsValid) {
+			return false;
+		}
+
+		// now we need the colours that the runs refer to
+		uint8_t numberOfColours = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 5, 1, MAX_PALETTE_SIZE, lpiIsValid);
+		if (!lpiIsValid) {
+			return false;
+		}
+		const char* coloursBuffer = lpiBuffer + SPRITE_HEADER_LENGTH;
+		for (uint8_t colourCounter = 0; colourCounter < numberOfColours; colourCounter++) {
+			stringProcessor->ExtractColourFromHexEncoded(coloursBuffer, lpiIsValid);
+			if (!lpiIsValid) {
+				return false;
+			}
+			coloursBuffer += 6;
+		}
+
+		// finally, the rest of the LPI is made up of at least one run
+		uint16_t runsLength = strlen(coloursBuffer);
+		if (runsLength == 0
+			|| runsLength % SPRITE_RUN_LENGTH != 0
+			|| runsLength / SPRITE_RUN_LENGTH >= MAX_RENDERING_INSTRUCTIONS) {
+			return false;
+		}
+		for (const char* runBuffer = coloursBuffer; *runBuffer != '\0'; runBuffer += SPRITE_RUN_LENGTH) {
+			stringProcessor->ExtractNumberFromHexEncoded(runBuffer, 1, 255, lpiIsValid);
+			if (!lpiIsValid) {
+				return false;
+			}
+			stringProcessor->ExtractDigitFromHexEncoded(runBuffer + 2, numberOfColours - 1, lpiIsValid);
+			if (!lpiIsValid) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the number of animation steps of a specified sprite LPI.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@returns	The number of animation steps of the sprite.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t SpriteAnimatedLpiExecutor::GetNumberOfSteps(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		bool isValid;
+		return lpiExecParams->GetStringProcesor()->ExtractNumberFromHexEncoded(lpiExecParams->GetLpiBufferWithoutBasicDetails(), 1, 255, isValid);
+	}
+
+	/*!
+		@brief		Executes the sprite instruction and populates the output.  The image
+					is scrolled by (step x shift) pixels, wrapping around, so the run that
+					contains the first pixel is split: the part from the first pixel is
+					rendered, then the runs that follow it, then the runs from the start
+					of the image and, finally, the part of the split run before the first pixel.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		step				The step number in the animation which is to be rendered.
+		@param		output				A pointer to the class that is used to set the pixel
+										outputs from executing the instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SpriteAnimatedLpiExecutor::Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output) {
+		if (lpiExecParams == nullptr
+			|| output == nullptr) {
+			return;
+		}
+
+		// ensure that specified step does not exceed the max number of steps
+		uint16_t totalSteps = GetNumberOfSteps(lpiExecParams);
+		if (step > totalSteps - 1) {
+			return;
+		}
+
+		// reset the state of the output, including a flag that states that output has been set!
+		output->Reset();
+
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		StringProcessor* stringProcessor = lpiExecParams->GetStringProcesor();
+
+		// get the parameters of the sprite, and its colours, from the LPI
+		bool isValid;
+		uint8_t shift = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 2, 0, 255, isValid);
+		bool towardsNear = stringProcessor->ExtractBoolFromHexEncoded(lpiBuffer + 4, isValid);
+		uint8_t numberOfColours = stringProcessor->ExtractNumberFromHexEncoded(lpiBuffer + 5, 1, MAX_PALETTE_SIZE, isValid);
+		Colour colours[MAX_PALETTE_SIZE];
+		const char* coloursBuffer = lpiBuffer + SPRITE_HEADER_LENGTH;
+		for (uint8_t colourCounter = 0; colourCounter < numberOfColours; colourCounter++) {
+			colours[colourCounter] = stringProcessor->ExtractColourFromHexEncoded(coloursBuffer, isValid);
+			coloursBuffer += 6;
+		}
+
+		// the length of the image is needed to wrap it around as it scrolls
+		const char* runsBuffer = coloursBuffer;
+		uint16_t numberOfRuns = strlen(runsBuffer) / SPRITE_RUN_LENGTH;
+		uint16_t imageLength = 0;
+		for (uint16_t runCounter = 0; runCounter < numberOfRuns; runCounter++) {
+			imageLength += stringProcessor->ExtractNumberFromHexEncoded(runsBuffer + runCounter * SPRITE_RUN_LENGTH, 1, 255, isValid);
+		}
+		if (numberOfRuns == 0) {
+			return;
+		}
+
+		// the position, within the image, of the pixel that is rendered first
+		uint16_t offset = (uint32_t)step * shift % imageLength;
+		uint16_t firstPixel = towardsNear || offset == 0 ? offset : imageLength - offset;
+
+		// find the run that contains the first pixel
+		uint16_t splitRun = 0;
+		uint16_t runStart = 0;
+		uint8_t runLength = stringProcessor->ExtractNumberFromHexEncoded(runsBuffer, 1, 255, isValid);
+		while (runStart + runLength <= firstPixel) {
+			runStart += runLength;
+			runLength = stringProcessor->ExtractNumberFromHexEncoded(runsBuffer + ++splitRun * SPRITE_RUN_LENGTH, 1, 255, isValid);
+		}
+		uint8_t pixelsBeforeFirst = firstPixel - runStart;
+
+		// add a rendering instruction for each run, starting with the split run
+		for (uint16_t runCounter = 0; runCounter <= numberOfRuns; runCounter++) {
+			const char* runBuffer = runsBuffer + (splitRun + runCounter) % numberOfRuns * SPRITE_RUN_LENGTH;
+			runLength = stringProcessor->ExtractNumberFromHexEncoded(runBuffer, 1, 255, isValid);
+			uint8_t colourIndex = stringProcessor->ExtractDigitFromHexEncoded(runBuffer + 2, numberOfColours - 1, isValid);
+			if (runCounter == 0) {
+				runLength -= pixelsBeforeFirst;
+			}
+			else if (runCounter == numberOfRuns) {
+				runLength = pixelsBeforeFirst;
+			}
+
+			if (runLength > 0) {
+				output->SetNextRenderingInstruction(&colours[colourIndex], runLength);
+			}
+		}
+		output->SetRepeatRenderingInstructions();
+	}
+
+	/*!
+			@brief		Estimates the time taken to execute a step of the sprite instruction.
+					Each colour is extracted and an RI is added for each run.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t SpriteAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		const char* lpiBuffer = lpiExecParams->GetLpiBufferWithoutBasicDetails();
+		bool isValid = true;
+		uint8_t numberOfColours = lpiExecParams->GetStringProcesor()->ExtractNumberFromHexEncoded(lpiBuffer + 5, 1, MAX_PALETTE_SIZE, isValid);
+		uint16_t numberOfRuns = strlen(lpiBuffer + SPRITE_HEADER_LENGTH + numberOfColours * 6) / SPRITE_RUN_LENGTH;
+
+		return COST_LPI_BASE + (uint32_t)(numberOfColours + numberOfRuns + 1) * COST_LPI_RENDERING_INSTRUCTION;
+	}
+}
\ No newline at end of file
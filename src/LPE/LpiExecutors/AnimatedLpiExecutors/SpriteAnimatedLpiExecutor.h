@@ -0,0 +1,39 @@
+#ifndef _SpriteAnimatedLpiExecutor_h
+#define _SpriteAnimatedLpiExecutor_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../../WProgram.h"
+#endif
+
+#include "AnimatedLpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
+#include <string.h>
+
+#define SPRITE_HEADER_LENGTH		7		// steps (2), shift (2), towards near (1) and number of colours (2)
+#define SPRITE_RUN_LENGTH			3		// length (2) and colour index (1) of each run of pixels
+
+namespace LS {
+	/*!
+		@brief		Provides an executor implementation for the sprite LPI.  The
+					sprite is an image drawn as runs of pixels of the same colour,
+					each run giving its length and the index of its colour, which is
+					repeated along the LEDs.  The image can be scrolled by a number
+					of pixels on each step.  Each step is rendered as one RI for
+					each run so its cost does not depend on the number of pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	class SpriteAnimatedLpiExecutor : public AnimatedLpiExecutor {
+	public:
+		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams);
+		virtual uint16_t GetNumberOfSteps(LpiExecutorParams* lpiExecParams);
+		virtual void Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output);
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
+	};
+}
+
+#endif
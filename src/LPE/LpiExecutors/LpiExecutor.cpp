@@ -1,4 +1,48 @@
 #include "LpiExecutor.h"
 
 namespace LS {
+	/*!
+		@brief		Estimates the time taken to execute a single step of an LPI.  By default
+					an LPI is assumed to output a single RI (e.g. solid) regardless of the number
+					of LEDs.  Executors whose work depends on their parameters or the number of
+					LEDs override this.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@returns	The estimated time in microseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpiExecutor::EstimateExecutionCost(LpiExecutorParams* /*lpiExecParams*/) {
+		return COST_LPI_BASE + COST_LPI_RENDERING_INSTRUCTION;
+	}
+
+	/*!
+		@brief		Prepares to generate the pixels of a step of an LPI, run by run, so that
+					they can be set directly on the LEDs rather than being output as RIs.  By
+					default an LPI cannot be generated; executors of per-pixel LPIs override
+					this and GetNextRun.  The runs of one step must be generated, in order, before
+					the executor is used for anything else.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		step				The step number in the animation which is to be generated.
+		@returns	True if the pixels can be generated or false if the LPI must be executed.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiExecutor::BeginRuns(LpiExecutorParams* /*lpiExecParams*/, uint16_t /*step*/) {
+		return false;
+	}
+
+	/*!
+		@brief		Generates the next run of pixels of the same colour of the step that
+					was prepared by BeginRuns.
+		@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+		@param		pixelIndex			The pixel that the run starts at, which is the pixel after
+										the end of the previous run (0 for the first run).
+		@param		colour				A pointer to the colour that is set to that of the run.
+		@returns	The number of pixels of the run or 0 if there are no more pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpiExecutor::GetNextRun(LpiExecutorParams* /*lpiExecParams*/, uint16_t /*pixelIndex*/, Colour* /*colour*/) {
+		return 0;
+	}
 }
\ No newline at end of file
@@ -4,12 +4,27 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "LpiExecutorOutput.h"
 #include "LpiExecutorParams.h"
 
+// Estimated costs, in microseconds, of the work carried out to render a frame on the
+// device.  These can be checked against the profile of a program (GET /profile).
+// They have not yet been measured on the device so, until they have been, the
+// estimate is only reported and a "strict" program is not rejected on it.
+#define COSTS_CALIBRATED					false	// whether the costs below have been measured on the device
+#define COST_LPI_BASE						150		// extracting the LPI and dispatching it to its executor
+#define COST_LPI_RENDERING_INSTRUCTION		12		// extracting a colour and adding an RI
+#define COST_LPI_RANDOM_PIXEL				6		// picking a random colour for a pixel
+#define COST_EXPRESSION_OPERATION			2		// evaluating a single operation of a compiled expression for a pixel
+#define COST_LPI_BLENDED_PIXEL				45		// blending two colours for a pixel (software floating point)
+#define COST_TRANSITION_PIXEL				5		// blending a pixel of an LPI that is fading in with the frame before it (packed integer)
+#define COST_PIXEL_SET						2		// setting the colour of a single pixel
+#define COST_PIXEL_SHOW						30		// sending a single pixel to the LEDs (24 bits at 800KHz)
+#define COST_PIXEL_LATCH					80		// latching the pixels once they have been sent
+
 namespace LS {
 	/*!
 		@brief		Abstract base-class for a class that executes an LPI.
@@ -21,6 +36,11 @@ namespace LS {
 		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams) = 0;
 		virtual uint16_t GetNumberOfSteps(LpiExecutorParams* lpiExecParams) = 0;
 		virtual void Execute(LpiExecutorParams* lpiExecParams, uint16_t step, LpiExecutorOutput* output) = 0;
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
+
+		// executors of per-pixel LPIs can generate runs of pixels on demand rather than outputting RIs
+		virtual bool BeginRuns(LpiExecutorParams* lpiExecParams, uint16_t step);
+		virtual uint16_t GetNextRun(LpiExecutorParams* lpiExecParams, uint16_t pixelIndex, Colour* colour);
 	};
 }
 
@@ -15,6 +15,8 @@ namespace LS {
 		lpiExecutors[LpiOpCode::Stochastic] = new StochasticNonAnimatedLpiExecutor();
 		lpiExecutors[LpiOpCode::Blocks] = new BlocksNonAnimatedLpiExecutor();
 		lpiExecutors[LpiOpCode::Rainbow] = new RainbowAnimatedLpiExecutor();
+		lpiExecutors[LpiOpCode::Sprite] = new SpriteAnimatedLpiExecutor();
+		lpiExecutors[LpiOpCode::Expression] = new ExpressionAnimatedLpiExecutor();
 	}
 
 	/*!
@@ -31,6 +33,8 @@ namespace LS {
 		free(lpiExecutors[LpiOpCode::Stochastic]);
 		free(lpiExecutors[LpiOpCode::Blocks]);
 		free(lpiExecutors[LpiOpCode::Rainbow]);
+		free(lpiExecutors[LpiOpCode::Sprite]);
+		free(lpiExecutors[LpiOpCode::Expression]);
 	}
 
 	/*!
@@ -51,6 +55,8 @@ namespace LS {
 			case LpiOpCode::Stochastic:
 			case LpiOpCode::Blocks:
 			case LpiOpCode::Rainbow:
+			case LpiOpCode::Sprite:
+			case LpiOpCode::Expression:
 				return lpiExecutors[opCode];
 		}
 
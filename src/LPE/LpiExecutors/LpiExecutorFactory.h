@@ -4,19 +4,21 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "LpiExecutor.h"
+#include "AnimatedLpiExecutors/ExpressionAnimatedLpiExecutor.h"
 #include "AnimatedLpiExecutors/FadeAnimatedLpiExecutor.h"
 #include "AnimatedLpiExecutors/RainbowAnimatedLpiExecutor.h"
 #include "AnimatedLpiExecutors/SliderAnimatedLpiExecutor.h"
+#include "AnimatedLpiExecutors/SpriteAnimatedLpiExecutor.h"
 #include "NonAnimatedLpiExecutors/BlocksNonAnimatedLpiExecutor.h"
 #include "NonAnimatedLpiExecutors/ClearNonAnimatedLpiExecutor.h"
 #include "NonAnimatedLpiExecutors/PatternNonAnimatedLpiExecutor.h"
 #include "NonAnimatedLpiExecutors/SolidNonAnimatedLpiExecutor.h"
 #include "NonAnimatedLpiExecutors/StochasticNonAnimatedLpiExecutor.h"
-#include "..\InstructionType.h"
+#include "../InstructionType.h"
 
 namespace LS {
 	enum LpiOpCode{
@@ -27,7 +29,9 @@ namespace LS {
 		Fade,
 		Stochastic,
 		Blocks,
-		Rainbow
+		Rainbow,
+		Sprite,
+		Expression
 	};
 
 	/*!
@@ -38,7 +42,7 @@ namespace LS {
 	*/
 	class LpiExecutorFactory {
 	private:
-		LpiExecutor* lpiExecutors[8];
+		LpiExecutor* lpiExecutors[10];
 
 	public:
 		LpiExecutorFactory();
@@ -1,4 +1,5 @@
 #include "LpiExecutorOutput.h"
+#include "LpiExecutor.h"
 
 namespace LS {
 	/*!
@@ -13,6 +14,7 @@ namespace LS {
 		renderingInstructionIndex = 0;
 		renderingInstructionsSet = false;
 		repeat = false;
+		generator = nullptr;
 	}
 
 	/*!
@@ -26,6 +28,11 @@ namespace LS {
 		@date		2 Jan 2021
 	*/
 	void LpiExecutorOutput::SetNextRenderingInstruction(Colour* colour, uint16_t numPixels) {
+		if (renderingInstructionIndex >= MAX_RENDERING_INSTRUCTIONS) {
+			// no more space - the remaining pixels are not rendered
+			return;
+		}
+
 		renderingInstructions[renderingInstructionIndex].colour.SetFromColour(colour);
 		renderingInstructions[renderingInstructionIndex++].number = numPixels;
 		renderingInstructionsSet = true;
@@ -48,6 +55,7 @@ namespace LS {
 		@date		3 Jan 2021
 	*/
 	RI* LpiExecutorOutput::GetRenderingInstructions() {
+		Materialise();
 		return renderingInstructions;
 	}
 
@@ -58,6 +66,7 @@ namespace LS {
 		@date		3 Jan 2021
 	*/
 	uint16_t LpiExecutorOutput::GetNumberOfRenderingInstructions() {
+		Materialise();
 		return renderingInstructionIndex;
 	}
 
@@ -84,6 +93,144 @@ namespace LS {
 		@date		4 Jan 2021
 	*/
 	bool LpiExecutorOutput::GetRepeatRenderingInstructions() {
+		Materialise();
 		return repeat;
 	}
+
+	/*!
+		@brief		Copies the rendering instructions to another buffer, merging
+					neighbouring instructions of the same colour so that the copy
+					is as compact as possible.  The rendered pixels are identical.
+		@param		destination		The buffer to which the rendering instructions are copied.
+		@param		maxInstructions	The number of rendering instructions the buffer can hold.
+		@returns	The number of rendering instructions that were copied or 0 if none have been
+					set or they do not fit in the buffer.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpiExecutorOutput::CopyRenderingInstructions(RI* destination, uint16_t maxInstructions) {
+		Materialise();
+		if (destination == nullptr
+			|| !renderingInstructionsSet) {
+			return 0;
+		}
+
+		uint16_t numberCopied = 0;
+		for (uint16_t riIndex = 0; riIndex < renderingInstructionIndex; riIndex++) {
+			RI* renderingInstruction = &renderingInstructions[riIndex];
+
+			if (numberCopied > 0
+				&& destination[numberCopied - 1].colour == renderingInstruction->colour
+				&& (uint32_t)destination[numberCopied - 1].number + renderingInstruction->number <= 0xFFFF) {
+				destination[numberCopied - 1].number += renderingInstruction->number;
+				continue;
+			}
+
+			if (numberCopied >= maxInstructions) {
+				return 0;
+			}
+
+			destination[numberCopied++] = *renderingInstruction;
+		}
+
+		return numberCopied;
+	}
+
+	/*!
+		@brief		Replaces the rendering instructions with a copy of previously
+					stored rendering instructions, e.g. ones stored by CopyRenderingInstructions.
+		@param		source					The rendering instructions to be loaded.
+		@param		numberOfInstructions	The number of rendering instructions to be loaded.
+		@param		repeat					True if the rendering instructions are repeated along the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiExecutorOutput::LoadRenderingInstructions(RI* source, uint16_t numberOfInstructions, bool repeat) {
+		Reset();
+
+		if (source == nullptr) {
+			return;
+		}
+
+		for (uint16_t riIndex = 0; riIndex < numberOfInstructions; riIndex++) {
+			SetNextRenderingInstruction(&source[riIndex].colour, source[riIndex].number);
+		}
+
+		if (repeat) {
+			SetRepeatRenderingInstructions();
+		}
+	}
+
+	/*!
+		@brief		Sets the output to be generated, on demand, by the executor of a
+					per-pixel LPI rather than by rendering instructions.
+		@param		generator		A pointer to the executor that generates the pixels.
+		@param		lpiExecParams	A pointer to the parameters of the LPI, which must be
+									unchanged until the output has been used.
+		@param		step			The step of the LPI that is generated.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiExecutorOutput::SetGenerator(LpiExecutor* generator, LpiExecutorParams* lpiExecParams, uint16_t step) {
+		Reset();
+		this->generator = generator;
+		generatorParams = lpiExecParams;
+		generatorStep = step;
+		renderingInstructionsSet = true;
+	}
+
+	/*!
+		@brief		Gets whether the output is generated on demand, i.e. the rendering
+					instructions have not been executed.
+		@returns	True if the output is generated, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiExecutorOutput::IsGenerated() {
+		return generator != nullptr;
+	}
+
+	/*!
+		@brief		Prepares to pull the runs of pixels of a generated output.
+		@returns	True if the runs can be pulled or false if the output is not generated.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiExecutorOutput::BeginRuns() {
+		return generator != nullptr
+			&& generator->BeginRuns(generatorParams, generatorStep);
+	}
+
+	/*!
+		@brief		Pulls the next run of pixels of the same colour of a generated output.
+		@param		pixelIndex		The pixel that the run starts at (0 for the first run).
+		@param		colour			A pointer to the colour that is set to that of the run.
+		@returns	The number of pixels of the run or 0 if there are no more pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpiExecutorOutput::GetNextRun(uint16_t pixelIndex, Colour* colour) {
+		if (generator == nullptr) {
+			return 0;
+		}
+
+		return generator->GetNextRun(generatorParams, pixelIndex, colour);
+	}
+
+	/*!
+		@brief		Executes the LPI of a generated output so that its rendering
+					instructions are set, for the users of the output that need them
+					(e.g. the frame cache or the compositing of layers).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiExecutorOutput::Materialise() {
+		if (generator == nullptr) {
+			return;
+		}
+
+		LpiExecutor* executor = generator;
+		generator = nullptr;
+		executor->Execute(generatorParams, generatorStep, this);
+	}
 }
\ No newline at end of file
@@ -4,25 +4,43 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
-#include "..\..\ValueDomainTypes.h"
+#include "../../ValueDomainTypes.h"
+
+#define		MAX_RENDERING_INSTRUCTIONS		350			// i.e. 350 pixels max
 
 namespace LS {
+	class LpiExecutor;
+	class LpiExecutorParams;
+
 	/*!
 		@brief		Stores the output from executing an LPI.  The output consists
 					of one or more rendering instructions which are simply colours
-					and number of pixels to be rendered.
+					and number of pixels to be rendered.  The output of a per-pixel
+					LPI may instead be generated: the executor is kept so that the
+					renderer can pull runs of pixels from it on demand, and the
+					rendering instructions are only executed if they are asked for.
+					A generated output must be used before its executor is used again.
 		@author		Kevin White
 		@date		2 Jan 2021
 	*/
 	class LpiExecutorOutput {
 		// RI renderingInstructions[200];
-		RI renderingInstructions[350];			// i.e. 350 pixels max
+		RI renderingInstructions[MAX_RENDERING_INSTRUCTIONS];
 		uint16_t renderingInstructionIndex = 0;
 		bool renderingInstructionsSet = false;
 		bool repeat = false;
+
+		// the LPI that generates the pixels on demand (nullptr = the rendering instructions are set)
+		LpiExecutor* generator = nullptr;
+		LpiExecutorParams* generatorParams = nullptr;
+		uint16_t generatorStep = 0;
+
+	protected:
+		void Materialise();
+
 	public:
 		void Reset();
 		void SetNextRenderingInstruction(Colour* colour, uint16_t numPixels);
@@ -32,6 +50,14 @@ namespace LS {
 
 		void SetRepeatRenderingInstructions();
 		bool GetRepeatRenderingInstructions();
+
+		uint16_t CopyRenderingInstructions(RI* destination, uint16_t maxInstructions);
+		void LoadRenderingInstructions(RI* source, uint16_t numberOfInstructions, bool repeat);
+
+		void SetGenerator(LpiExecutor* generator, LpiExecutorParams* lpiExecParams, uint16_t step);
+		bool IsGenerated();
+		bool BeginRuns();
+		uint16_t GetNextRun(uint16_t pixelIndex, Colour* colour);
 	};
 }
 
@@ -28,7 +28,7 @@ namespace LS {
 
 	/*!
 		@brief		Gets a pointer to the portion of the LPI buffer with the basic
-					details (instruction #, duration, reserved bytes) skipped over.  In another,
+					details (instruction #, duration, transition, reserved byte) skipped over.  In another,
 					at the details of the specific LPI to be executed.
 		@returns	A pointer to the specific LPI instruction details.
 		@author		Kevin White
@@ -48,6 +48,27 @@ namespace LS {
 		return ledConfig;
 	}
 
+	/*!
+		@brief		Sets the segment of the LEDs that the LPI is executed on.
+		@param		segment		A pointer to the segment or nullptr for all of the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiExecutorParams::SetSegment(LEDSegment* segment) {
+		this->segment = segment;
+	}
+
+	/*!
+		@brief		Gets the number of LEDs that the LPI is executed on: the length
+					of the segment, if any, or otherwise all of the LEDs.
+		@returns	The number of LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpiExecutorParams::GetNumberOfLeds() {
+		return segment != nullptr ? segment->numberOfLEDs : ledConfig->numberOfLEDs;
+	}
+
 	/*!
 		@brief		Gets a pointer to instance that provides string parsing functionality.
 		@returns	A pointer to the class that provides string parsing functionality.
@@ -4,12 +4,12 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
-#include "..\..\ValueDomainTypes.h"
-#include "..\..\StringProcessor.h"
-#include "..\..\FixedSizeCharBuffer.h"
+#include "../../ValueDomainTypes.h"
+#include "../../StringProcessor.h"
+#include "../../FixedSizeCharBuffer.h"
 
 #define BASIC_LPI_DETAILS_LENGTH	8
 
@@ -25,11 +25,14 @@ namespace LS {
 		FixedSizeCharBuffer* lpiBuffer;
 		LEDConfig* ledConfig;
 		StringProcessor* stringProcessor;
+		LEDSegment* segment = nullptr;		// the segment the LPI is executed on (nullptr = all of the LEDs)
 	public:
 		void Reset(FixedSizeCharBuffer* lpiBuffer, LEDConfig* ledConfig, StringProcessor* stringProcessor);
 		FixedSizeCharBuffer* GetLpiBuffer();
 		const char* GetLpiBufferWithoutBasicDetails();
 		LEDConfig* GetLedConfig();
+		void SetSegment(LEDSegment* segment);
+		uint16_t GetNumberOfLeds();
 		StringProcessor* GetStringProcesor();
 	};
 }
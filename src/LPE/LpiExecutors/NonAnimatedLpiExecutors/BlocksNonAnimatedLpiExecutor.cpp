@@ -89,7 +89,7 @@ namespace LS {
 
 			// Calculate the number of pixels that the block width represents
 			// as block width is a percent figure
-			double pixelsToCover = (double)blockWidth / 100 * lpiExecParams->GetLedConfig()->numberOfLEDs;
+			double pixelsToCover = (double)blockWidth / 100 * lpiExecParams->GetNumberOfLeds();
 
 			// Now, either round up or down depending on roundUp.  This alternatves per value which
 			// kinda 'smooths' the effect.
@@ -101,7 +101,7 @@ namespace LS {
 				pixels = floor(pixelsToCover);
 			};
 
-			pixels = (blockCounter == penultimateBlock ? lpiExecParams->GetLedConfig()->numberOfLEDs - pixelsCovered : pixels);
+			pixels = (blockCounter == penultimateBlock ? lpiExecParams->GetNumberOfLeds() - pixelsCovered : pixels);
 
 			// add the rendering instruction for the colour and width
 			output->SetNextRenderingInstruction(&blockColour, pixels);
@@ -112,4 +112,23 @@ namespace LS {
 			pixelsCovered += pixels;
 		}
 	}
+
+	/*!
+			@brief		Estimates the time taken to execute the blocks instruction.  An RI is
+					added for each block.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t BlocksNonAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		bool isValid = true;
+		uint8_t numberOfBlocks = lpiExecParams->GetStringProcesor()->ExtractNumberFromHexEncoded(lpiExecParams->GetLpiBufferWithoutBasicDetails(), 1, 10, isValid);
+
+		return COST_LPI_BASE + (uint32_t)numberOfBlocks * COST_LPI_RENDERING_INSTRUCTION;
+	}
 }
\ No newline at end of file
@@ -4,13 +4,13 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
 #include "NonAnimatedLpiExecutor.h"
-#include "..\..\..\ValueDomainTypes.h"
-#include "..\LpiExecutorParams.h"
-#include "..\LpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
 #include <math.h>
 
 namespace LS {
@@ -23,6 +23,7 @@ namespace LS {
 	public:
 		virtual bool ValidateLpi(LpiExecutorParams* lpiExecParams);
 		virtual void ExecuteNonAnimated(LpiExecutorParams* lpiExecParams, LpiExecutorOutput* output);
+		virtual uint32_t EstimateExecutionCost(LpiExecutorParams* lpiExecParams);
 	};
 }
 
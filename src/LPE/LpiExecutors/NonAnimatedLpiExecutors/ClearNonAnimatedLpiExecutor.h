@@ -4,13 +4,13 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\..\WProgram.h"
+#include "../../../WProgram.h"
 #endif
 
 #include "NonAnimatedLpiExecutor.h"
-#include "..\..\..\ValueDomainTypes.h"
-#include "..\LpiExecutorParams.h"
-#include "..\LpiExecutor.h"
+#include "../../../ValueDomainTypes.h"
+#include "../LpiExecutorParams.h"
+#include "../LpiExecutor.h"
 
 namespace LS {
 	/*!
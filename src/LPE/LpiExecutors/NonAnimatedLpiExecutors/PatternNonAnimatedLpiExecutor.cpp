@@ -86,4 +86,23 @@ namespace LS {
 		}
 		output->SetRepeatRenderingInstructions();
 	}
+
+	/*!
+			@brief		Estimates the time taken to execute the pattern instruction.  An RI is
+					added for each block of the pattern, which is then repeated along the LEDs.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t PatternNonAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		bool isValid = true;
+		uint8_t numberOfBlocks = lpiExecParams->GetStringProcesor()->ExtractNumberFromHexEncoded(lpiExecParams->GetLpiBufferWithoutBasicDetails(), 1, 255, isValid);
+
+		return COST_LPI_BASE + (uint32_t)numberOfBlocks * COST_LPI_RENDERING_INSTRUCTION;
+	}
 }
\ No newline at end of file
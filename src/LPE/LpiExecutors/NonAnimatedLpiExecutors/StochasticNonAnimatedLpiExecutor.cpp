@@ -64,11 +64,28 @@ namespace LS {
 		// now, for each pixel pick, by random selection, one of the colours
 		// that have been specified in the LPI
 		Colour chosenRandomColour;
-		for (uint16_t ledCounter = 0; ledCounter < lpiExecParams->GetLedConfig()->numberOfLEDs; ledCounter++) {
+		for (uint16_t ledCounter = 0; ledCounter < lpiExecParams->GetNumberOfLeds(); ledCounter++) {
 			uint8_t randColour = rand() % numberOfColours;
 
 			chosenRandomColour = stringProcessor->ExtractColourFromHexEncoded(coloursBuffer + (6 * randColour), isValid);
 			output->SetNextRenderingInstruction(&chosenRandomColour, 1);
 		}
 	}
+
+	/*!
+			@brief		Estimates the time taken to execute the stochastic instruction.  A colour
+					is picked at random, and an RI added, for every LED.
+			@param		lpiExecParams		The basic parametes necessary to execute an instruction.
+			@returns	The estimated time in microseconds.
+			@author		Kevin White
+			@date		19 Oct 2026
+	*/
+	uint32_t StochasticNonAnimatedLpiExecutor::EstimateExecutionCost(LpiExecutorParams* lpiExecParams) {
+		if (lpiExecParams == nullptr) {
+			return 0;
+		}
+
+		return COST_LPI_BASE
+			+ (uint32_t)lpiExecParams->GetNumberOfLeds() * (COST_LPI_RANDOM_PIXEL + COST_LPI_RENDERING_INSTRUCTION);
+	}
 }
\ No newline at end of file
@@ -1,10 +1,10 @@
 #ifndef _IJsonInstructionBuilder_h
 #define _IJsonInstructionBuilder_h
 
-#include "..\..\ArduinoJson-v6.17.2.h"
-#include "..\..\ValueDomainTypes.h"
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
 #include "LpState.h"
-#include "..\Instructions\Instruction.h"
+#include "../Instructions/Instruction.h"
 
 namespace LS {
 	/*
@@ -36,6 +36,9 @@ namespace LS {
 			case InstructionType::Lpi:
 			case InstructionType::Repeat:
 				return builders[instructionType];
+			case InstructionType::Call:
+				// calls are built by the state builder as they refer to other instructions
+				return nullptr;
 			}
 
 		return nullptr;
@@ -4,14 +4,14 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "IJsonInstructionBuilder.h"
 #include "LpJsonInstructionBuilder.h"
 #include "RepeatJsonInstructionBuilder.h"
-#include "..\InstructionType.h"
-#include "..\LpiExecutors\LpiExecutorFactory.h"
+#include "../InstructionType.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
 
 namespace LS {
 	/*!
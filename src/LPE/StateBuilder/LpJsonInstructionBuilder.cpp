@@ -41,15 +41,19 @@ namespace LS {
 
 		// get the basic LPI details including the duration
 		stringProcessor->ExtractLPIFromHexEncoded(lpi, &lpiBasics);
+		if (lpiBasics.transition > 0) {
+			state->SetHasTransitions();
+		}
 
 		// get the LPI executor so we can the number of steps
 		// to complete the LPI
 		
-		//// DON'T KNOW WHAT THS WAS FOR - TO BE REMOVED
-		lpiBuffer.LoadFromBuffer(lpi);
+		// the number of steps depends on the colours that colour references are replaced by
+		stringProcessor->ExpandColourReferences(lpi, &lpiBuffer, palette, numberOfColours);
 		
 		
 		LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(lpiBasics.opcode);
+		lpiExecutorParams.SetSegment(state->GetSegment());
 		uint16_t steps = lpiExecutor->GetNumberOfSteps(&lpiExecutorParams);
 
 		lpInstruction.SetDuration(lpiBasics.duration);
@@ -61,4 +65,43 @@ namespace LS {
 
 		return lpIns;
 	}
+
+	/*!
+		@brief	Sets the palette that colour references of the LPIs that are built
+				next are replaced by when their number of steps is calculated.
+		@param	palette				A pointer to the colours of the palette (nullptr for none).
+		@param	numberOfColours		The number of colours of the palette.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	void LpJsonInstructionBuilder::SetPalette(const Colour* palette, uint8_t numberOfColours) {
+		this->palette = palette;
+		this->numberOfColours = numberOfColours;
+	}
+
+	/*!
+		@brief	Adds a palette, taken from a JSON input document, to the program.
+				NOTE: we do not verify the colours here, they must already
+				have been verified.
+		@param	paletteColours		The JSON array of hex-encoded colours.
+		@param	state				The Light Program state.
+		@returns	The identity of the palette or PALETTE_NONE if the program has
+					no space for it.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	uint8_t LpJsonInstructionBuilder::BuildPalette(JsonArray paletteColours, LpState* state) {
+		if (state == nullptr) {
+			return PALETTE_NONE;
+		}
+
+		Colour colours[MAX_PALETTE_SIZE];
+		uint8_t numberOfColours = 0;
+		for (JsonArray::iterator colour = paletteColours.begin(); colour != paletteColours.end() && numberOfColours < MAX_PALETTE_SIZE; ++colour) {
+			bool isValid = false;
+			colours[numberOfColours++] = stringProcessor->ExtractColourFromHexEncoded(colour->as<const char*>(), isValid);
+		}
+
+		return state->AddPalette(colours, numberOfColours);
+	}
 }
\ No newline at end of file
@@ -1,13 +1,13 @@
 #ifndef _LpJsonInstructionBuilder_h
 #define _LpJsonInstructionBuilder_h
 
-#include "..\..\ArduinoJson-v6.17.2.h"
-#include "..\..\ValueDomainTypes.h"
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
 #include "LpState.h"
-#include "..\Instructions\LpInstruction.h"
+#include "../Instructions/LpInstruction.h"
 #include "IJsonInstructionBuilder.h"
-#include "..\LpiExecutors\LpiExecutorFactory.h"
-#include "..\..\StringProcessor.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
+#include "../../StringProcessor.h"
 
 namespace LS {
 	/*!
@@ -31,10 +31,16 @@ namespace LS {
 
 
 		LPIInstruction lpiBasics;
+
+		// the palette that colour references of the LPIs are replaced by
+		const Colour* palette = nullptr;
+		uint8_t numberOfColours = 0;
 	public:
 		LpJsonInstructionBuilder(LpiExecutorFactory* lpiInstructionFactory, StringProcessor* stringBuilder, LEDConfig* ledConfig);
 
 		Instruction* BuildInstruction(JsonVariant* jsonVar, LpState* state);
+		void SetPalette(const Colour* palette, uint8_t numberOfColours);
+		uint8_t BuildPalette(JsonArray paletteColours, LpState* state);
 	};
 }
 
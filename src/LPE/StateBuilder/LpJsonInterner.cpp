@@ -0,0 +1,226 @@
+#include "LpJsonInterner.h"
+
+namespace LS {
+	/*!
+		@brief		Forgets all of the instructions and subroutines, ready for a new program.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpJsonInterner::Clear() {
+		numberOfInstructions = 0;
+		numberOfSubroutines = 0;
+	}
+
+	/*!
+		@brief		Finds an instruction that has already been remembered which is
+					identical to an instruction.
+		@param		instructionVar		A pointer to the JSON of the instruction (an LPI
+										string or a repeat object).
+		@param		paletteId			The palette that the instruction is built with.
+		@returns	A pointer to the identical instruction or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	InternedInstruction* LpJsonInterner::Find(JsonVariant* instructionVar, uint8_t paletteId) {
+		if (instructionVar == nullptr
+			|| numberOfInstructions == 0) {
+			return nullptr;
+		}
+
+		bool hasColourReferences = false;
+		uint32_t hash = GetHash(*instructionVar, 2166136261UL, &hasColourReferences);
+		if (!hasColourReferences) {
+			paletteId = 0;
+		}
+		for (uint8_t instructionIndex = 0; instructionIndex < numberOfInstructions; instructionIndex++) {
+			InternedInstruction* internedInstruction = &internedInstructions[instructionIndex];
+			if (internedInstruction->hash == hash
+				&& internedInstruction->paletteId == paletteId
+				&& IsSameInstruction(internedInstruction->instructionVar, *instructionVar)) {
+				return internedInstruction;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/*!
+		@brief		Remembers an instruction, once it is complete, so that it can be
+					shared by later instructions that are identical to it.
+		@param		instructionVar		A pointer to the JSON of the instruction.
+		@param		instruction			A pointer to the instruction built from the JSON
+										(nullptr if the instruction is only being validated).
+		@param		paletteId			The palette that the instruction was built with.
+		@returns	True if the instruction is remembered or false if no more instructions
+					can be remembered.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonInterner::Add(JsonVariant* instructionVar, Instruction* instruction, uint8_t paletteId) {
+		if (instructionVar == nullptr
+			|| numberOfInstructions >= MAX_INTERNED_INSTRUCTIONS) {
+			return false;
+		}
+
+		bool hasColourReferences = false;
+		InternedInstruction* internedInstruction = &internedInstructions[numberOfInstructions++];
+		internedInstruction->hash = GetHash(*instructionVar, 2166136261UL, &hasColourReferences);
+		internedInstruction->instructionVar = *instructionVar;
+		internedInstruction->instruction = instruction;
+		internedInstruction->paletteId = hasColourReferences ? paletteId : 0;
+
+		return true;
+	}
+
+	/*!
+		@brief		Forgets an instruction, e.g. because it has been changed so that it
+					is no longer the same as the JSON it was built from.
+		@param		instruction		A pointer to the instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpJsonInterner::Remove(Instruction* instruction) {
+		for (uint8_t instructionIndex = 0; instructionIndex < numberOfInstructions; instructionIndex++) {
+			if (internedInstructions[instructionIndex].instruction == instruction) {
+				internedInstructions[instructionIndex] = internedInstructions[--numberOfInstructions];
+				return;
+			}
+		}
+	}
+
+	/*!
+		@brief		Finds a subroutine that has already been built for a palette.
+		@param		name			A pointer to the name of the subroutine.
+		@param		paletteId		The palette that the subroutine is built with.
+		@returns	A pointer to the subroutine or nullptr if there is none.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	InternedSubroutine* LpJsonInterner::FindSubroutine(const char* name, uint8_t paletteId) {
+		if (name == nullptr) {
+			return nullptr;
+		}
+
+		for (uint8_t subroutineIndex = 0; subroutineIndex < numberOfSubroutines; subroutineIndex++) {
+			InternedSubroutine* internedSubroutine = &internedSubroutines[subroutineIndex];
+			if (internedSubroutine->paletteId == paletteId
+				&& strcmp(internedSubroutine->name, name) == 0) {
+				return internedSubroutine;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/*!
+		@brief		Remembers a subroutine that has been built for a palette so that
+					later calls of the subroutine, for the same palette, can share it.
+		@param		name			A pointer to the name of the subroutine.
+		@param		paletteId		The palette that the subroutine is built with.
+		@param		instruction		A pointer to the instruction that holds the instructions of
+									the subroutine (nullptr if the subroutine is only being validated).
+		@returns	True if the subroutine is remembered or false if no more subroutines
+					can be remembered.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonInterner::AddSubroutine(const char* name, uint8_t paletteId, Instruction* instruction) {
+		if (name == nullptr
+			|| numberOfSubroutines >= MAX_INTERNED_SUBROUTINES) {
+			return false;
+		}
+
+		InternedSubroutine* internedSubroutine = &internedSubroutines[numberOfSubroutines++];
+		internedSubroutine->name = name;
+		internedSubroutine->paletteId = paletteId;
+		internedSubroutine->instruction = instruction;
+
+		return true;
+	}
+
+	/*!
+		@brief		Adds the JSON of an instruction, including all of the instructions
+					of a repeat, to a hash (32-bit FNV-1a).
+		@param		instructionVar			The JSON of the instruction.
+		@param		hash					The hash so far.
+		@param		hasColourReferences		A pointer to the value that is set to true if
+											an LPI of the instruction has a colour reference.
+		@returns	The hash.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpJsonInterner::GetHash(JsonVariant instructionVar, uint32_t hash, bool* hasColourReferences) {
+		const char* lpi = instructionVar.as<const char*>();
+		if (lpi != nullptr) {
+			while (*lpi != '\0') {
+				if (*lpi == COLOUR_REFERENCE) {
+					*hasColourReferences = true;
+				}
+				hash ^= (uint8_t)*lpi++;
+				hash *= 16777619UL;
+			}
+		}
+		else {
+			// a repeat is hashed as the number of times followed by its instructions
+			JsonVariant repeatVar = instructionVar["repeat"];
+			hash ^= (uint16_t)repeatVar["times"].as<int>();
+			hash *= 16777619UL;
+
+			JsonArray instructions = repeatVar["instructions"];
+			for (JsonArray::iterator instruction = instructions.begin(); instruction != instructions.end(); ++instruction) {
+				hash = GetHash(*instruction, hash, hasColourReferences);
+			}
+		}
+
+		// separates the instruction from those that follow
+		hash ^= '|';
+		hash *= 16777619UL;
+
+		return hash;
+	}
+
+	/*!
+		@brief		Compares the JSON of two instructions, including all of the
+					instructions of repeats.
+		@param		instructionVar			The JSON of an instruction.
+		@param		otherInstructionVar		The JSON of the other instruction.
+		@returns	True if the instructions are identical, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonInterner::IsSameInstruction(JsonVariant instructionVar, JsonVariant otherInstructionVar) {
+		const char* lpi = instructionVar.as<const char*>();
+		const char* otherLpi = otherInstructionVar.as<const char*>();
+		if (lpi != nullptr
+			|| otherLpi != nullptr) {
+			// the JSON document usually holds a single copy of identical strings
+			return lpi != nullptr
+				&& otherLpi != nullptr
+				&& (lpi == otherLpi || strcmp(lpi, otherLpi) == 0);
+		}
+
+		JsonVariant repeatVar = instructionVar["repeat"];
+		JsonVariant otherRepeatVar = otherInstructionVar["repeat"];
+		if (repeatVar.isNull()
+			|| otherRepeatVar.isNull()
+			|| repeatVar["times"].as<int>() != otherRepeatVar["times"].as<int>()) {
+			return false;
+		}
+
+		JsonArray instructions = repeatVar["instructions"];
+		JsonArray otherInstructions = otherRepeatVar["instructions"];
+		JsonArray::iterator instruction = instructions.begin();
+		JsonArray::iterator otherInstruction = otherInstructions.begin();
+		while (instruction != instructions.end()
+			&& otherInstruction != otherInstructions.end()) {
+			if (!IsSameInstruction(*instruction, *otherInstruction)) {
+				return false;
+			}
+			++instruction;
+			++otherInstruction;
+		}
+
+		return instruction == instructions.end()
+			&& otherInstruction == otherInstructions.end();
+	}
+}
@@ -0,0 +1,74 @@
+#ifndef _LpJsonInterner_h
+#define _LpJsonInterner_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
+#include "../Instructions/Instruction.h"
+
+// xxxx: *** BUFFER ALLOCATION *** - instructions of a program that can be shared
+#define MAX_INTERNED_INSTRUCTIONS		16		// most instructions that are remembered for sharing
+#define MAX_INTERNED_SUBROUTINES		8		// most subroutines (for each palette) that are remembered for sharing
+
+namespace LS {
+	/*!
+		@brief	An instruction of a Light Program that can be shared
+				by later instructions that are identical to it.
+	*/
+	struct InternedInstruction {
+		uint32_t hash;						// hash of the JSON of the instruction
+		JsonVariant instructionVar;			// the instruction in the JSON document
+		Instruction* instruction;			// the instruction built from it (nullptr when validating)
+		uint8_t paletteId;					// palette its colour references were built with (0 = no references)
+	};
+
+	/*!
+		@brief	A subroutine of a Light Program that has been built, or validated,
+				for a palette so that later calls of the subroutine, for the same
+				palette, can share it.
+	*/
+	struct InternedSubroutine {
+		const char* name;					// name of the subroutine in the JSON document
+		uint8_t paletteId;					// palette the subroutine was built with
+		Instruction* instruction;			// the instruction built from it (nullptr when validating)
+	};
+
+	/*!
+		@brief	Remembers the instructions of a Light Program (LPIs and entire repeats)
+				that have been built, or validated, so that a later instruction that is
+				identical to one of them can share it rather than being built again.  The
+				JSON of each instruction is hashed so that instructions are only compared
+				in full when their hashes match.  Only instructions that are complete are
+				remembered as an instruction cannot share an instruction that contains it.
+				An instruction with colour references is only shared by instructions that
+				are built with the same palette, as is a subroutine.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpJsonInterner {
+	private:
+		InternedInstruction internedInstructions[MAX_INTERNED_INSTRUCTIONS];
+		uint8_t numberOfInstructions = 0;
+		InternedSubroutine internedSubroutines[MAX_INTERNED_SUBROUTINES];
+		uint8_t numberOfSubroutines = 0;
+
+	protected:
+		static uint32_t GetHash(JsonVariant instructionVar, uint32_t hash, bool* hasColourReferences);
+		static bool IsSameInstruction(JsonVariant instructionVar, JsonVariant otherInstructionVar);
+
+	public:
+		void Clear();
+		InternedInstruction* Find(JsonVariant* instructionVar, uint8_t paletteId);
+		bool Add(JsonVariant* instructionVar, Instruction* instruction, uint8_t paletteId);
+		void Remove(Instruction* instruction);
+		InternedSubroutine* FindSubroutine(const char* name, uint8_t paletteId);
+		bool AddSubroutine(const char* name, uint8_t paletteId, Instruction* instruction);
+	};
+}
+
+#endif
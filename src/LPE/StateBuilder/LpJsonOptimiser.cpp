@@ -0,0 +1,131 @@
+#include "LpJsonOptimiser.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor sets the mandatory dependencies.
+		@param		stringProcessor	A pointer to the class that provides string parsing.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpJsonOptimiser::LpJsonOptimiser(StringProcessor* stringProcessor) {
+		this->stringProcessor = stringProcessor;
+	}
+
+	/*!
+		@brief		Gets whether an LPI is static i.e. renders the same output for the
+					whole of its duration and each time that it is rendered.
+		@param		lpi		A pointer to the LPI string.
+		@returns	True if the LPI is static, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonOptimiser::IsStaticLpi(const char* lpi) {
+		if (lpi == nullptr
+			|| !stringProcessor->ExtractLPIFromHexEncoded(lpi, &lpiBasics)) {
+			return false;
+		}
+
+		switch (lpiBasics.opcode) {
+			case LpiOpCode::Clear:
+			case LpiOpCode::Solid:
+			case LpiOpCode::Pattern:
+			case LpiOpCode::Blocks:
+				return true;
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Gets whether two LPIs are the same apart from their durations.
+		@param		lpi			A pointer to the LPI string.
+		@param		otherLpi	A pointer to the other LPI string.
+		@returns	True if the LPIs are the same, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonOptimiser::IsSameLpi(const char* lpi, const char* otherLpi) {
+		if (lpi == nullptr
+			|| otherLpi == nullptr
+			|| strlen(lpi) != strlen(otherLpi)
+			|| strlen(lpi) < BASIC_LPI_DETAILS_LENGTH) {
+			return false;
+		}
+
+		return strncmp(lpi, otherLpi, LPI_DURATION_POSITION) == 0
+			&& strcmp(&lpi[LPI_DURATION_POSITION + 2], &otherLpi[LPI_DURATION_POSITION + 2]) == 0;
+	}
+
+	/*!
+		@brief		Gets whether a repeat is replaced by its instructions, which is
+					the case when it has a single iteration.
+		@param		repeatVar	The JSON variant of the repeat.
+		@returns	True if the repeat is replaced by its instructions, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonOptimiser::IsFlattenedRepeat(JsonVariant* repeatVar) {
+		return (*repeatVar)["times"].as<int>() == 1;
+	}
+
+	/*!
+		@brief		Gets the duration for which the LPI of a finite repeat of a single
+					static LPI is held when the repeat is replaced by the LPI.
+		@param		repeatVar	The JSON variant of the repeat.
+		@returns	The duration of all of the iterations of the repeat or 0 if the repeat
+					cannot be replaced (e.g. the duration would be too long).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpJsonOptimiser::GetHoldDuration(JsonVariant* repeatVar) {
+		int times = (*repeatVar)["times"].as<int>();
+		JsonArray instructions = (*repeatVar)["instructions"];
+		if (times < 1
+			|| instructions.size() != 1) {
+			return 0;
+		}
+
+		const char* lpi = instructions[0].as<const char*>();
+		if (!IsStaticLpi(lpi)
+			|| (uint32_t)times * lpiBasics.duration > LPI_MAX_DURATION) {
+			return 0;
+		}
+
+		return (uint8_t)(times * lpiBasics.duration);
+	}
+
+	/*!
+		@brief		Merges a static LPI in to the LPI that precedes it, if that is
+					the same static LPI, by extending the duration of the earlier LPI.
+		@param		prevInstruction		A pointer to the instruction that precedes the LPI (may be nullptr).
+		@param		lpi					A pointer to the LPI string.
+		@param		duration			The duration of the LPI or 0 for the duration in the LPI string.
+		@returns	The number of rendering frames that were added to the earlier LPI or 0
+					if the LPI was not merged.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpJsonOptimiser::MergeLpi(Instruction* prevInstruction, const char* lpi, uint8_t duration) {
+		if (prevInstruction == nullptr
+			|| prevInstruction->getInstructionType() != InstructionType::Lpi) {
+			return 0;
+		}
+
+		LpInstruction* prevLpInstruction = (LpInstruction*)prevInstruction;
+		if (!IsSameLpi(prevLpInstruction->getLpi(), lpi)
+			|| !IsStaticLpi(lpi)) {
+			return 0;
+		}
+
+		if (duration == 0) {
+			duration = lpiBasics.duration;
+		}
+		if ((uint16_t)prevLpInstruction->GetDuration() + duration > LPI_MAX_DURATION) {
+			return 0;
+		}
+
+		prevLpInstruction->SetDuration(prevLpInstruction->GetDuration() + duration);
+
+		return duration;
+	}
+}
@@ -0,0 +1,54 @@
+#ifndef _LpJsonOptimiser_h
+#define _LpJsonOptimiser_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
+#include "../../StringProcessor.h"
+#include "../Instructions/LpInstruction.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
+
+#define		LPI_DURATION_POSITION		2		// position of the duration in an LPI string
+#define		LPI_MAX_DURATION			255		// longest duration of an LPI
+
+namespace LS {
+	/*!
+		@brief	Decides how the instructions of a Light Program can be built into
+				fewer instructions whilst the program is built (see LpJsonStateBuilder),
+				so that programs generated by an editor take fewer instruction slots and
+				less navigation whilst the frames rendered are unchanged:
+					1. a repeat with a single iteration is replaced by its instructions;
+					2. a finite repeat of a single static LPI is replaced by that LPI
+					   held for the duration of all of the iterations;
+					3. a static LPI that follows the same static LPI (which may differ
+					   only in its duration) is merged in to the earlier LPI.
+				A static LPI renders the same output for the whole of its duration
+				and each time that it is rendered, i.e. it is not animated or stochastic.
+				Held durations are limited to the longest duration of an LPI.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpJsonOptimiser {
+	private:
+		StringProcessor* stringProcessor;
+		LPIInstruction lpiBasics;
+
+	protected:
+		bool IsStaticLpi(const char* lpi);
+		bool IsSameLpi(const char* lpi, const char* otherLpi);
+
+	public:
+		LpJsonOptimiser(StringProcessor* stringProcessor);
+
+		bool IsFlattenedRepeat(JsonVariant* repeatVar);
+		uint8_t GetHoldDuration(JsonVariant* repeatVar);
+		uint8_t MergeLpi(Instruction* prevInstruction, const char* lpi, uint8_t duration);
+	};
+}
+
+#endif
@@ -1,6 +1,20 @@
 #include "LpJsonState.h"
 
 namespace LS {
+	/*!
+		@brief		Allocates the JSON document and the storage of the instructions
+					of the state.
+		@param		documentSize			The size, in bytes, of the JSON document.
+		@param		maxLpInstructions		The most LPIs the state can hold.
+		@param		maxRepeatInstructions	The most repeat instructions the state can hold.
+		@param		maxCallInstructions		The most call instructions the state can hold.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpJsonState::LpJsonState(size_t documentSize, uint8_t maxLpInstructions, uint8_t maxRepeatInstructions, uint8_t maxCallInstructions)
+		: LpState(maxLpInstructions, maxRepeatInstructions, maxCallInstructions), lpJsonDoc(documentSize) {
+	}
+
 	/*!
 		@brief		Gets a pointer to the light program's source JSON
 					document.
@@ -8,7 +22,7 @@ namespace LS {
 		@author		Kevin White
 		@date		21 Dec 2020
 	*/
-	StaticJsonDocument<BUFFER_LP>* LpJsonState::getLpJsonDoc() {
+	JsonDocument* LpJsonState::getLpJsonDoc() {
 		return &lpJsonDoc;
 	}
 }
\ No newline at end of file
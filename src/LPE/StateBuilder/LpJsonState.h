@@ -4,12 +4,12 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "LpState.h"
-#include "..\..\ValueDomainTypes.h"
-#include "..\..\ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
+#include "../../ArduinoJson-v6.17.2.h"
 
 namespace LS {
 	/*!
@@ -26,11 +26,13 @@ namespace LS {
 	*/
 	class LpJsonState : public LpState {
 		private:
-			// 2000: *** BUFFER ALLOCATION *** - Store an entire LP state
-			StaticJsonDocument<BUFFER_LP> lpJsonDoc;
+			// 2000: *** BUFFER ALLOCATION *** - Store an entire LP state (BUFFER_LP unless smaller)
+			DynamicJsonDocument lpJsonDoc;
 
 		public:
-			StaticJsonDocument<BUFFER_LP>* getLpJsonDoc();
+			LpJsonState(size_t documentSize = BUFFER_LP, uint8_t maxLpInstructions = MAX_LPINSTRUCTIONS, uint8_t maxRepeatInstructions = MAX_REPEATINSTRUCTIONS, uint8_t maxCallInstructions = MAX_CALLINSTRUCTIONS);
+
+			JsonDocument* getLpJsonDoc();
 	};
 }
 #endif
\ No newline at end of file
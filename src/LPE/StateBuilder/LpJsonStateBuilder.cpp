@@ -13,63 +13,331 @@ namespace LS {
 	}
 
 	/*!
-		@brief		Builds the instruction tree from the values that are
-					contained in a JSON array.  This is a recursive method
-					that is called each time an instructions array is encountered
-					in the Light Program.
-		@param		instructions		A point to the JSON array which contains the Light Program instructions.
-		@param		state				A pointer to the class that stores the state of the Light Program.
-		@param		parentInstruction	A pointer to the instruction that is the parent of the instructions
-										contained in the JSON array.
+		@brief		Sets the optimiser that decides how instructions of a Light Program
+					can be built into fewer instructions.  Pass nullptr to build every
+					instruction as it is in the Light Program.
+		@param		optimiser		A pointer to the optimiser.
 		@author		Kevin White
-		@date		23 Dec 2020
+		@date		19 Oct 2026
 	*/
-	void LpJsonStateBuilder::BuildInstructions(JsonArray* instructions, LpJsonState* state, InstructionWithChild* parentInstruction) {
-		Instruction* prevInstruction = nullptr;
-		Instruction* currentInstruction = nullptr;
-		IJsonInstructionBuilder* builder = nullptr;
+	void LpJsonStateBuilder::SetOptimiser(LpJsonOptimiser* optimiser) {
+		this->optimiser = optimiser;
+	}
+
+	/*!
+		@brief		Builds the next instruction of the instruction tree.  When the end of an
+					instructions array is reached, building moves back up to the array that
+					contains it.  When the instruction is a repeat, building moves down into
+					the instructions array of the repeat.  When the instruction is a call
+					of a subroutine that has not yet been built for its palette, building
+					moves down into the instructions of the subroutine.
+		@returns	True if the instruction was built or false if the state has no
+					space for the instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonStateBuilder::BuildNextInstruction() {
+		uint8_t level = nestingDepth - 1;
+		if (instructionIterators[level] == JsonArray::iterator()) {
+			// end of the instructions array
+			EndInstructions();
+			return true;
+		}
 
-		int len = instructions->size();
+		JsonVariant value = *instructionIterators[level];
+		++instructionIterators[level];
 
-		for (JsonVariant value : *instructions) {
-			bool isRepeat = value.containsKey("repeat");
+		InstructionWithChild* parentInstruction = parentInstructions[level];
+		Instruction* currentInstruction = nullptr;
+		JsonArray repeatInstructions;
 
-			if (isRepeat) {
-				builder = instructionFactory->GetInstructionBuilder(InstructionType::Repeat);
-				JsonVariant repeatVar = value["repeat"];
-				currentInstruction = builder->BuildInstruction(&repeatVar, state);
+		bool isRepeat = value.containsKey("repeat");
+		bool isCall = value.containsKey("call");
+		JsonVariant lpiVar = value;
+		uint8_t holdDuration = 0;		// duration of an LPI that is built in place of its repeat
+		RepeatInstruction* subroutine = nullptr;		// a subroutine that is built for the first time
+		JsonArray subroutineInstructions;
+		uint8_t paletteId = paletteIds[level];
 
-				// Now, this repeat becomes the parent instruction of the instructions
-				// contained in the instructions array of this repeat
-				JsonArray repeatInstructions = repeatVar["instructions"];
-				BuildInstructions(&repeatInstructions, state, (InstructionWithChild*)currentInstruction);
+		if (isRepeat && optimiser != nullptr) {
+			JsonVariant repeatVar = value["repeat"];
+			if (optimiser->IsFlattenedRepeat(&repeatVar)) {
+				// the instructions of the repeat are built in place of the repeat
+				if (nestingDepth > MAX_NESTED_LOOPS) {
+					return false;
+				}
+				BeginInstructions(repeatVar["instructions"], parentInstruction, true);
+				buildState->SetOptimised();
+				return true;
 			}
-			else {
-				// lpi
-				IJsonInstructionBuilder* builder = instructionFactory->GetInstructionBuilder(InstructionType::Lpi);
-				currentInstruction = builder->BuildInstruction(&value, state);
+
+			holdDuration = optimiser->GetHoldDuration(&repeatVar);
+			if (holdDuration > 0) {
+				// the LPI of the repeat is built, and held, in place of the repeat
+				isRepeat = false;
+				lpiVar = repeatVar["instructions"][0];
+				buildState->SetOptimised();
 			}
+		}
 
-			// ensure that we set the parent instruction of the current instruction
-			// (if one) so that we can navigate 'back-up' the tree e.g. from the last
-			// instruction of a repeat back up to the repeat itself
-			currentInstruction->setParent(parentInstruction);
+		if (!isRepeat && !isCall && optimiser != nullptr) {
+			uint8_t mergedFrames = optimiser->MergeLpi(prevInstructions[level], lpiVar.as<const char*>(), holdDuration);
+			if (mergedFrames > 0) {
+				// the LPI extends the previous LPI rather than being built, which
+				// then no longer matches the LPI it was built from so cannot be shared
+				nestedFrames[level] = AddFrameLength(nestedFrames[level], mergedFrames);
+				interner.Remove(prevInstructions[level]);
+				buildState->SetOptimised();
+				return true;
+			}
+		}
 
-			// also, ensure that the first child of the parent is also set
-			// so that we can navigate from, e.g., a repeat to the first
-			// instruction of the repreat
-			if (parentInstruction != nullptr && parentInstruction->getFirstChild() == nullptr) {
-				parentInstruction->setFirstChild(currentInstruction);
+		if (isCall) {
+			currentInstruction = BuildCall(value["call"], &subroutine, &subroutineInstructions, &paletteId);
+			if (currentInstruction == nullptr) {
+				return false;
+			}
+		}
+		else {
+			InternedInstruction* internedInstruction = interner.Find(&value, paletteId);
+			if (internedInstruction != nullptr) {
+				// the instruction is identical to one that has already been
+				// built so that instruction is called rather than built again
+				callInstruction.reset();
+				callInstruction.SetCalledInstruction(internedInstruction->instruction);
+				currentInstruction = buildState->addInstruction(&callInstruction);
+				if (currentInstruction != nullptr) {
+					isRepeat = false;
+					buildState->SetOptimised();
+				}
 			}
+		}
 
-			// finally, set the previous instruction's subling instruction
-			// to the current instruction.  This allows us to navigate
-			// from one instruction to the next one.
-			if (prevInstruction) {
-				prevInstruction->setNext(currentInstruction);
+		if (currentInstruction == nullptr
+			&& isRepeat) {
+			IJsonInstructionBuilder* builder = instructionFactory->GetInstructionBuilder(InstructionType::Repeat);
+			JsonVariant repeatVar = value["repeat"];
+			currentInstruction = builder->BuildInstruction(&repeatVar, buildState);
+			repeatInstructions = repeatVar["instructions"];
+		}
+		else if (currentInstruction == nullptr) {
+			// lpi (the number of steps depends on the colours of the palette)
+			LpJsonInstructionBuilder* builder = (LpJsonInstructionBuilder*)instructionFactory->GetInstructionBuilder(InstructionType::Lpi);
+			uint8_t numberOfColours = 0;
+			const Colour* palette = buildState->GetPalette(paletteId, &numberOfColours);
+			builder->SetPalette(palette, numberOfColours);
+			currentInstruction = builder->BuildInstruction(&lpiVar, buildState);
+			if (currentInstruction != nullptr
+				&& holdDuration > 0) {
+				((LpInstruction*)currentInstruction)->SetDuration(holdDuration);
+			}
+			if (currentInstruction != nullptr) {
+				interner.Add(&value, currentInstruction, paletteId);
 			}
-			prevInstruction = currentInstruction;
 		}
+
+		if (currentInstruction == nullptr) {
+			return false;
+		}
+
+		// ensure that we set the parent instruction of the current instruction
+		// (if one) so that we can navigate 'back-up' the tree e.g. from the last
+		// instruction of a repeat back up to the repeat itself
+		currentInstruction->setParent(parentInstruction);
+
+		// also, ensure that the first child of the parent is also set
+		// so that we can navigate from, e.g., a repeat to the first
+		// instruction of the repreat
+		if (parentInstruction != nullptr && parentInstruction->getFirstChild() == nullptr) {
+			parentInstruction->setFirstChild(currentInstruction);
+		}
+
+		// finally, set the previous instruction's subling instruction
+		// to the current instruction.  This allows us to navigate
+		// from one instruction to the next one.
+		if (prevInstructions[level]) {
+			prevInstructions[level]->setNext(currentInstruction);
+		}
+		prevInstructions[level] = currentInstruction;
+
+		if (subroutine != nullptr) {
+			// the instructions of the subroutine are built next, with the palette of the
+			// call, and the subroutine is then shared by its name rather than as a repeat
+			if (nestingDepth > MAX_NESTED_LOOPS) {
+				return false;
+			}
+			BeginInstructions(subroutineInstructions, subroutine, false);
+			repeatVars[level + 1] = JsonVariant();
+			paletteIds[level + 1] = paletteId;
+		}
+		else if (!isRepeat) {
+			// the frame length of a repeat is only known once its instructions are built
+			nestedFrames[level] = AddFrameLength(nestedFrames[level], currentInstruction->GetFrameLength());
+		}
+		else {
+			// Now, this repeat becomes the parent instruction of the instructions
+			// contained in the instructions array of this repeat
+			if (nestingDepth > MAX_NESTED_LOOPS) {
+				return false;
+			}
+			BeginInstructions(repeatInstructions, (InstructionWithChild*)currentInstruction, false);
+			repeatVars[level + 1] = value;
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Builds a call of a subroutine.  The palette of the call, if it has
+					one, is added to the state and the subroutine is called with it;
+					otherwise the subroutine is called with the palette of the instructions
+					that contain the call.  The first time that a subroutine is called with
+					a palette an instruction is added to hold its instructions, which are
+					then built, and later calls with the same palette call that instruction.
+		@param		callVar					The JSON variant of the call.
+		@param		subroutine				A pointer to the value that is set to the instruction
+											that holds the instructions of the subroutine when they
+											are to be built (otherwise it is not changed).
+		@param		subroutineInstructions	A pointer to the value that is set to the instructions
+											array of the subroutine when they are to be built.
+		@param		paletteId				A pointer to the palette of the instructions that contain
+											the call, which is set to the palette the subroutine is
+											called with.
+		@returns	A pointer to the call or nullptr if the state has no space for it.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CallInstruction* LpJsonStateBuilder::BuildCall(JsonVariant callVar, RepeatInstruction** subroutine, JsonArray* subroutineInstructions, uint8_t* paletteId) {
+		const char* name = callVar["name"];
+		JsonArray paletteColours = callVar["palette"];
+		if (!paletteColours.isNull()) {
+			// colour references within the subroutine are replaced by the colours of the palette
+			LpJsonInstructionBuilder* builder = (LpJsonInstructionBuilder*)instructionFactory->GetInstructionBuilder(InstructionType::Lpi);
+			*paletteId = builder->BuildPalette(paletteColours, buildState);
+		}
+
+		callInstruction.reset();
+		callInstruction.SetPaletteId(paletteColours.isNull() ? PALETTE_NONE : *paletteId);
+		CallInstruction* builtCall = (CallInstruction*)buildState->addInstruction(&callInstruction);
+		if (builtCall == nullptr) {
+			return nullptr;
+		}
+		buildState->SetOptimised();
+
+		InternedSubroutine* internedSubroutine = interner.FindSubroutine(name, *paletteId);
+		if (internedSubroutine != nullptr) {
+			// already built for the palette
+			builtCall->SetCalledInstruction(internedSubroutine->instruction);
+			return builtCall;
+		}
+
+		// the instructions of the subroutine are held by a repeat of a single iteration
+		// that is not part of the tree, so has no parent, and is only reached by its calls
+		subroutineInstruction.reset();
+		subroutineInstruction.setNumberOfIterations(1);
+		subroutineInstruction.setRemainingIterations(1);
+		*subroutine = (RepeatInstruction*)buildState->addInstruction(&subroutineInstruction);
+		if (*subroutine == nullptr) {
+			return nullptr;
+		}
+		builtCall->SetCalledInstruction(*subroutine);
+		*subroutineInstructions = (*buildState->getLpJsonDoc())["subroutines"][name];
+		interner.AddSubroutine(name, *paletteId, *subroutine);
+
+		return builtCall;
+	}
+
+	/*!
+		@brief		Moves down in to an instructions array so that its instructions are
+					built next.
+		@param		instructions		The instructions array.
+		@param		parentInstruction	The instruction that is the parent of the instructions (nullptr
+										for the instructions of the program).
+		@param		isFlattened			True if the instructions are built in place of their repeat, in
+										which case they carry on from the instructions that contain them.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpJsonStateBuilder::BeginInstructions(JsonArray instructions, InstructionWithChild* parentInstruction, bool isFlattened) {
+		instructionIterators[nestingDepth] = instructions.begin();
+		parentInstructions[nestingDepth] = parentInstruction;
+		prevInstructions[nestingDepth] = isFlattened ? prevInstructions[nestingDepth - 1] : nullptr;
+		nestedFrames[nestingDepth] = 0;
+		flattenedRepeats[nestingDepth] = isFlattened;
+		paletteIds[nestingDepth] = nestingDepth > 0 ? paletteIds[nestingDepth - 1] : buildState->GetProgramPaletteId();
+		nestingDepth++;
+	}
+
+	/*!
+		@brief		Ends the innermost instructions array that is being built and moves
+					back up to the array that contains it.  The frame length of the instructions
+					is the length of a single iteration of the repeat that contains them, which
+					then adds to the frame length of the instructions of the containing array.
+					The repeat can then be shared by later repeats that are identical to it.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpJsonStateBuilder::EndInstructions() {
+		uint8_t level = --nestingDepth;
+		if (flattenedRepeats[level]) {
+			// the instructions were built in place of their repeat so the
+			// instructions that contain them carry on from the last of them
+			prevInstructions[level - 1] = prevInstructions[level];
+			nestedFrames[level - 1] = AddFrameLength(nestedFrames[level - 1], nestedFrames[level]);
+			return;
+		}
+
+		InstructionWithChild* parentInstruction = parentInstructions[level];
+		if (level == 0
+			|| parentInstruction == nullptr
+			|| parentInstruction->getInstructionType() != InstructionType::Repeat) {
+			return;
+		}
+
+		RepeatInstruction* repeatInstruction = (RepeatInstruction*)parentInstruction;
+		repeatInstruction->SetBodyFrameLength(nestedFrames[level]);
+		nestedFrames[level - 1] = AddFrameLength(nestedFrames[level - 1], repeatInstruction->GetFrameLength());
+
+		// the repeat is complete so can now be shared (a subroutine is already shared)
+		if (!repeatVars[level].isNull()) {
+			interner.Add(&repeatVars[level], repeatInstruction, paletteIds[level]);
+		}
+	}
+
+	/*!
+		@brief		Adds the frame length of an instruction to a number of frames.  The
+					result is FRAME_LENGTH_INFINITE if either is infinite or the total is too
+					large to count.
+		@param		frames			The number of frames.
+		@param		frameLength		The frame length of the instruction.
+		@returns	The total number of frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpJsonStateBuilder::AddFrameLength(uint32_t frames, uint32_t frameLength) {
+		if (frameLength >= FRAME_LENGTH_INFINITE - frames) {
+			return FRAME_LENGTH_INFINITE;
+		}
+
+		return frames + frameLength;
+	}
+
+	/*!
+		@brief		Gets the identity of a Light Program, which is a hash (32-bit FNV-1a)
+					of the JSON text of the program.
+		@param		lp		The Light Program in JSON format.
+		@returns	The identity of the program (never 0).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpJsonStateBuilder::GetProgramId(const char* lp) {
+		uint32_t hash = 2166136261UL;
+		while (*lp != '\0') {
+			hash ^= (uint8_t)*lp++;
+			hash *= 16777619UL;
+		}
+
+		return hash == 0 ? 1 : hash;
 	}
 
 	/*!
@@ -90,23 +358,110 @@ namespace LS {
 		@date		23 Dec 2020
 	*/
 	bool LpJsonStateBuilder::BuildState(FixedSizeCharBuffer* lp, LpJsonState* state) {
+		if (!BeginBuildState(lp, state)) {
+			return false;
+		}
+
+		return ContinueBuildState(0xFFFF);
+	}
+
+	/*!
+		@brief		Begins building the state of a Light Program.  The existing state is
+					reset and the Light Program is loaded into the JSON document of the state.
+					The instruction tree is then built, a few instructions at a time, by calling
+					ContinueBuildState so that building a large program can be spread across
+					several execution cycles.  The state is marked as building, and so nothing
+					is executed and the last frame shown is held, until the instruction tree is
+					complete.  The program is built in place, rather than into a second state
+					that is swapped in once complete, as there is not the memory for a second
+					state.  The whole document is parsed on this call as ArduinoJson has no
+					incremental parser.
+		@param		lp		A pointer to the buffer that contains the Light Program
+							in JSON format.
+		@param		state	A pointer to the class that stores the tree representation
+							of the parsed Light Program.
+		@returns	True if the instruction tree is to be built or false if the program could
+					not be parsed (the state is then left empty).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonStateBuilder::BeginBuildState(FixedSizeCharBuffer* lp, LpJsonState* state) {
+		nestingDepth = 0;
+		buildState = nullptr;
+
 		if (lp == nullptr || state == nullptr) {
 			return false;
 		}
 
+		buildState = state;
+		interner.Clear();
+
 		// reset the existing state, if any, back to default values
 		state->reset();
 
 		// load the JSON document with the JSON string contained in lp
 		// ready for processing and building the instruction tree
 		const char* pLp = lp->GetBuffer();
+		state->SetProgramId(GetProgramId(pLp));
 		DeserializationError error = deserializeJson(*state->getLpJsonDoc(), pLp);
+		if (error != DeserializationError::Ok) {
+			buildState = nullptr;
+			return false;
+		}
+		state->SetBuilding(true);
+
+		// the optional palette of the program is decoded once, ahead of the instructions
+		// whose colour references are replaced by its colours
+		JsonArray paletteColours = (*state->getLpJsonDoc())["palette"];
+		if (!paletteColours.isNull()) {
+			LpJsonInstructionBuilder* builder = (LpJsonInstructionBuilder*)instructionFactory->GetInstructionBuilder(InstructionType::Lpi);
+			state->SetProgramPaletteId(builder->BuildPalette(paletteColours, state));
+		}
 
 		// get the initial instructions array which contain
 		// at least one LPI or repeat instruction
 		JsonArray instructions = (*state->getLpJsonDoc())["instructions"];
 
-		BuildInstructions(&instructions, state, nullptr);
+		BeginInstructions(instructions, nullptr, false);
+
+		return true;
+	}
+
+	/*!
+		@brief		Continues building the instruction tree of the Light Program that was
+					passed to BeginBuildState.  Once the tree is complete, the first instruction
+					becomes the current instruction so that the Light Program starts executing.
+		@param		maxInstructions		The most instructions to build on this call.
+		@returns	True if building is complete or false if there are further instructions
+					to be built.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpJsonStateBuilder::ContinueBuildState(uint16_t maxInstructions) {
+		if (buildState == nullptr) {
+			return true;
+		}
+
+		while (nestingDepth > 0) {
+			if (maxInstructions-- == 0) {
+				// not yet complete so nothing must be executed
+				buildState->setCurrentInstruction(nullptr);
+				return false;
+			}
+
+			if (!BuildNextInstruction()) {
+				// no space for further instructions - execute what has been built
+				// once the frame lengths of the unfinished repeats are known
+				interner.Clear();
+				while (nestingDepth > 0) {
+					EndInstructions();
+				}
+			}
+		}
+
+		buildState->setCurrentInstruction(buildState->getFirstInstruction());
+		buildState->SetBuilding(false);
+		buildState = nullptr;
 
 		return true;
 	}
@@ -4,30 +4,64 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "JsonInstructionBuilderFactory.h"
 #include "LpJsonState.h"
+#include "LpJsonOptimiser.h"
+#include "LpJsonInterner.h"
 
 namespace LS {
 	/*!
 		@brief	Builds a tree of instructions that represents the values
 				to be executed that form a Light Program.  Building a tree
 				allows us to easily navigate from one instruction to the next.
+				An instruction (LPI or repeat) that is identical to one already
+				built is built as a call to the earlier instruction so that it
+				is held, along with its decoded details, only once.  Likewise, a
+				subroutine is built the first time it is called with a palette
+				and later calls, with the same palette, call it.
 		@author	Kevin White
 		@date	23 Dec 2020
 	*/
 	class LpJsonStateBuilder {
 	private:
 		JsonInstructionBuilderFactory* instructionFactory;
+		LpJsonOptimiser* optimiser = nullptr;
+		LpJsonInterner interner;
+		CallInstruction callInstruction;
+		RepeatInstruction subroutineInstruction;
+
+		// the position reached within each of the nested instructions arrays, along
+		// with the parent and last instruction built at that position, so that the
+		// state can be built over several calls
+		LpJsonState* buildState = nullptr;
+		JsonArray::iterator instructionIterators[MAX_NESTED_LOOPS + 1];
+		InstructionWithChild* parentInstructions[MAX_NESTED_LOOPS + 1];
+		Instruction* prevInstructions[MAX_NESTED_LOOPS + 1];
+		uint32_t nestedFrames[MAX_NESTED_LOOPS + 1];		// frame length of the instructions built at each position
+		bool flattenedRepeats[MAX_NESTED_LOOPS + 1];		// the instructions at each position replace their repeat
+		JsonVariant repeatVars[MAX_NESTED_LOOPS + 1];		// the repeat that contains the instructions at each position
+		uint8_t paletteIds[MAX_NESTED_LOOPS + 1];			// the palette the instructions at each position are built with
+		uint8_t nestingDepth = 0;
 
 	protected:
-		void BuildInstructions(JsonArray* instructions, LpJsonState* state, InstructionWithChild* parentInstruction);
+		bool BuildNextInstruction();
+		CallInstruction* BuildCall(JsonVariant callVar, RepeatInstruction** subroutine, JsonArray* subroutineInstructions, uint8_t* paletteId);
+		void BeginInstructions(JsonArray instructions, InstructionWithChild* parentInstruction, bool isFlattened);
+		void EndInstructions();
+		static uint32_t GetProgramId(const char* lp);
 	public:
+		static uint32_t AddFrameLength(uint32_t frames, uint32_t frameLength);
+
 		LpJsonStateBuilder(JsonInstructionBuilderFactory* instructionFactory);
 
+		void SetOptimiser(LpJsonOptimiser* optimiser);
+
 		virtual bool BuildState(FixedSizeCharBuffer* lp, LpJsonState* state);
+		virtual bool BeginBuildState(FixedSizeCharBuffer* lp, LpJsonState* state);
+		virtual bool ContinueBuildState(uint16_t maxInstructions);
 	};
 }
 
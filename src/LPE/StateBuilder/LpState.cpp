@@ -1,6 +1,36 @@
 #include "LpState.h"
 
 namespace LS {
+	/*!
+		@brief	Allocates the storage of the instructions of the state.  States of
+				programs that are played alongside the program (e.g. on a segment)
+				can be given less storage so that they fit in the RAM.
+		@param	maxLpInstructions		The most LPIs the state can hold.
+		@param	maxRepeatInstructions	The most repeat instructions the state can hold.
+		@param	maxCallInstructions		The most call instructions the state can hold.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	LpState::LpState(uint8_t maxLpInstructions, uint8_t maxRepeatInstructions, uint8_t maxCallInstructions) {
+		this->maxLpInstructions = maxLpInstructions;
+		this->maxRepeatInstructions = maxRepeatInstructions;
+		this->maxCallInstructions = maxCallInstructions;
+		lpInstructions = new LpInstruction[maxLpInstructions];
+		repeatInstructions = new RepeatInstruction[maxRepeatInstructions];
+		callInstructions = new CallInstruction[maxCallInstructions];
+	}
+
+	/*!
+		@brief	Destructor ensures the storage of the instructions is freed.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	LpState::~LpState() {
+		delete[] lpInstructions;
+		delete[] repeatInstructions;
+		delete[] callInstructions;
+	}
+
 	/*!
 		@brief	Resets the state back to the initial state, in preparation
 				for a new LP to be executed.
@@ -9,15 +39,20 @@ namespace LS {
 	*/
 	void LpState::reset() {
 		// reset the state of each of the LP instructions
-		for (uint8_t instructionIndex = 0; instructionIndex < MAX_LPINSTRUCTIONS; instructionIndex++) {
+		for (uint8_t instructionIndex = 0; instructionIndex < maxLpInstructions; instructionIndex++) {
 			lpInstructions[instructionIndex].reset();
 		}
 
 		// reset the state of each of the repeat instructions
-		for (uint8_t repeatIndex = 0; repeatIndex < MAX_REPEATINSTRUCTIONS; repeatIndex++) {
+		for (uint8_t repeatIndex = 0; repeatIndex < maxRepeatInstructions; repeatIndex++) {
 			repeatInstructions[repeatIndex].reset();
 		}
 
+		// reset the state of each of the call instructions
+		for (uint8_t callIndex = 0; callIndex < maxCallInstructions; callIndex++) {
+			callInstructions[callIndex].reset();
+		}
+
 		// reset the instruction pointers back to defaults, nullptr
 		firstInstruction = nullptr;
 		currentInstruction = nullptr;
@@ -25,6 +60,477 @@ namespace LS {
 		// reset the index values back to 0
 		lpInstructionIndex = 0;
 		repeatIndex = 0;
+		callIndex = 0;
+		callDepth = 0;
+		numberOfPalettes = 0;
+		numberOfPaletteColours = 0;
+		programPaletteId = PALETTE_NONE;
+
+		frame = 0;
+		programId = 0;
+		lpiQueue = nullptr;
+		firstFrame = 0;
+		isOptimised = false;
+		hasTransitions = false;
+		isBuilding = false;
+		generation++;
+	}
+
+	/*!
+		@brief		Gets the generation of the state.  The generation changes
+					each time the state is reset, for example when a new program
+					is loaded or the program is stopped.
+		@returns	The generation of the state.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpState::GetGeneration() {
+		return generation;
+	}
+
+	/*!
+		@brief		Gets the position of the program as the number of rendering frames
+					that have been executed since the program started.
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpState::GetFrame() {
+		return frame;
+	}
+
+	/*!
+		@brief		Sets the position of the program as a number of rendering frames.
+		@param		frame		The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetFrame(uint32_t frame) {
+		this->frame = frame;
+	}
+
+	/*!
+		@brief		Gets the identity of the loaded program.  Servers that have loaded
+					the same program have the same identity.
+		@returns	The identity of the program or 0 if no program is loaded.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpState::GetProgramId() {
+		return programId;
+	}
+
+	/*!
+		@brief		Sets the identity of the loaded program.
+		@param		programId		The identity of the program.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetProgramId(uint32_t programId) {
+		this->programId = programId;
+	}
+
+	/*!
+		@brief		Marks that instructions have been changed in place, e.g. an LPI has
+					been patched, without resetting the state.  The generation changes
+					so that anything derived from the instructions is discarded.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::MarkChanged() {
+		generation++;
+	}
+
+	/*!
+		@brief		Gets whether the LPI string of an LPI is also used by another LPI,
+					which happens when the same LPI appears more than once in a program
+					as the JSON document holds a single copy of identical strings.
+		@param		lpInstruction	A pointer to the LPI.
+		@returns	True if another LPI uses the same string, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::IsLpiShared(LpInstruction* lpInstruction) {
+		for (uint8_t instructionIndex = 0; instructionIndex < lpInstructionIndex; instructionIndex++) {
+			if (&lpInstructions[instructionIndex] != lpInstruction
+				&& lpInstructions[instructionIndex].getLpi() == lpInstruction->getLpi()) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Gets the queue of LPIs that are executed one after the other
+					in place of a program.
+		@returns	A pointer to the queue or nullptr if the state is not queue-fed.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpiQueue* LpState::GetLpiQueue() {
+		return lpiQueue;
+	}
+
+	/*!
+		@brief		Sets the queue of LPIs that are executed one after the other in
+					place of a program.  The state should be reset beforehand and is
+					no longer queue-fed once it is next reset.
+		@param		lpiQueue		A pointer to the queue.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetLpiQueue(LpiQueue* lpiQueue) {
+		this->lpiQueue = lpiQueue;
+	}
+
+	/*!
+		@brief		Gets the segment of the LEDs that the program is played on.
+		@returns	A pointer to the segment or nullptr if the program is played on all of the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LEDSegment* LpState::GetSegment() {
+		return segment;
+	}
+
+	/*!
+		@brief		Sets the segment of the LEDs that the program is played on.  The LPIs of
+					the program see the length of the segment as the number of LEDs, both as
+					the program is built and as it is executed.  The segment is kept when
+					the state is reset.
+		@param		segment		A pointer to the segment or nullptr for all of the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetSegment(LEDSegment* segment) {
+		this->segment = segment;
+	}
+
+	/*!
+		@brief		Gets the most LPIs the state can hold.
+		@returns	The most LPIs the state can hold.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetMaxLpInstructions() {
+		return maxLpInstructions;
+	}
+
+	/*!
+		@brief		Gets the most repeat instructions the state can hold.
+		@returns	The most repeat instructions the state can hold.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetMaxRepeatInstructions() {
+		return maxRepeatInstructions;
+	}
+
+	/*!
+		@brief		Gets the most call instructions the state can hold.
+		@returns	The most call instructions the state can hold.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetMaxCallInstructions() {
+		return maxCallInstructions;
+	}
+
+	/*!
+		@brief		Gets the rendering frame at which the first instruction started.
+					This is 0 for a program but, when the state is queue-fed, it is
+					the frame at which the queued LPI that is executing started.
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpState::GetFirstFrame() {
+		return firstFrame;
+	}
+
+	/*!
+		@brief		Replaces the instructions with a single LPI, taken from the queue,
+					that starts at the current frame.  The LPI takes the place of the
+					previous queued LPI so the state holds one LPI however long the
+					queue-fed show runs for.
+		@param		lpInstruction	A pointer to the LPI that will be used to initialise
+									the LPI of the state or nullptr if there is no LPI
+									to execute (i.e. the queue has run dry).
+		@returns	A pointer to the LpInstruction or nullptr if there is no LPI.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	Instruction* LpState::SetQueuedInstruction(LpInstruction* lpInstruction) {
+		firstInstruction = nullptr;
+		currentInstruction = nullptr;
+		lpInstructionIndex = 0;
+		callDepth = 0;
+		firstFrame = frame;
+
+		return addInstruction(lpInstruction);
+	}
+
+	/*!
+		@brief		Gets whether instructions of the program were optimised whilst
+					the program was built, in which case the instructions no longer
+					match the instructions of the LDL one for one.
+		@returns	True if the program was optimised, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::IsOptimised() {
+		return isOptimised;
+	}
+
+	/*!
+		@brief		Marks that instructions of the program have been optimised.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetOptimised() {
+		isOptimised = true;
+	}
+
+	/*!
+		@brief		Gets whether any LPI of the program has a transition, in which
+					case each frame that is output must be kept so that the LPI can
+					fade in from it.
+		@returns	True if an LPI of the program has a transition, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::HasTransitions() {
+		return hasTransitions;
+	}
+
+	/*!
+		@brief		Marks that an LPI of the program has a transition.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetHasTransitions() {
+		hasTransitions = true;
+	}
+
+	/*!
+		@brief		Gets whether the instruction tree of the program is being built, over
+					several execution cycles, in which case the state must not be executed
+					or positioned as the tree is not yet complete.
+		@returns	True if the program is being built, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::IsBuilding() {
+		return isBuilding;
+	}
+
+	/*!
+		@brief		Sets whether the instruction tree of the program is being built.
+		@param		isBuilding		True whilst the program is being built, false once it is complete.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetBuilding(bool isBuilding) {
+		this->isBuilding = isBuilding;
+	}
+
+	/*!
+		@brief		Adds a call to the calls that are executing as the called
+					instruction is about to be executed.
+		@param		callInstruction		A pointer to the call.
+		@returns	True if the call was added or false if too many calls are
+					executing within each other.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::PushCall(CallInstruction* callInstruction) {
+		if (callDepth >= MAX_CALL_DEPTH) {
+			return false;
+		}
+
+		callStack[callDepth++] = callInstruction;
+
+		return true;
+	}
+
+	/*!
+		@brief		Removes the innermost call from the calls that are executing
+					as its called instruction has completed.
+		@returns	A pointer to the call or nullptr if no calls are executing.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CallInstruction* LpState::PopCall() {
+		if (callDepth == 0) {
+			return nullptr;
+		}
+
+		return callStack[--callDepth];
+	}
+
+	/*!
+		@brief		Gets one of the calls that are executing.
+		@param		depth		The position of the call (0 = outermost).
+		@returns	A pointer to the call or nullptr if there is no call at the position.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CallInstruction* LpState::GetCall(uint8_t depth) {
+		if (depth >= callDepth) {
+			return nullptr;
+		}
+
+		return callStack[depth];
+	}
+
+	/*!
+		@brief		Gets the number of calls that are executing within each other.
+		@returns	The number of calls.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetCallDepth() {
+		return callDepth;
+	}
+
+	/*!
+		@brief		Removes all of the calls that are executing, e.g. before the
+					state is positioned again from the first instruction.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::ClearCalls() {
+		callDepth = 0;
+	}
+
+	/*!
+		@brief		Adds a palette, i.e. the colours that colour references of
+					LPIs are replaced by.  A palette that is identical to one that
+					has already been added is shared rather than added again, other
+					than the palette of the program which is never shared so that it
+					can be changed without changing the palettes passed by calls.
+		@param		colours				A pointer to the colours of the palette.
+		@param		numberOfColours		The number of colours (at most MAX_PALETTE_SIZE).
+		@returns	The identity of the palette or PALETTE_NONE if there is no space
+					for the palette.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::AddPalette(const Colour* colours, uint8_t numberOfColours) {
+		if (colours == nullptr
+			|| numberOfColours == 0
+			|| numberOfColours > MAX_PALETTE_SIZE) {
+			return PALETTE_NONE;
+		}
+
+		for (uint8_t paletteIndex = 0; paletteIndex < numberOfPalettes; paletteIndex++) {
+			if (paletteIndex + 1 != programPaletteId
+				&& paletteSizes[paletteIndex] == numberOfColours
+				&& memcmp(&paletteColours[paletteStarts[paletteIndex]], colours, numberOfColours * sizeof(Colour)) == 0) {
+				return paletteIndex + 1;
+			}
+		}
+
+		if (numberOfPalettes >= MAX_PALETTES
+			|| numberOfPaletteColours + numberOfColours > MAX_PALETTE_COLOURS) {
+			return PALETTE_NONE;
+		}
+
+		memcpy(&paletteColours[numberOfPaletteColours], colours, numberOfColours * sizeof(Colour));
+		paletteStarts[numberOfPalettes] = numberOfPaletteColours;
+		paletteSizes[numberOfPalettes] = numberOfColours;
+		numberOfPaletteColours += numberOfColours;
+
+		return ++numberOfPalettes;
+	}
+
+	/*!
+		@brief		Gets the colours of a palette.
+		@param		paletteId			The identity of the palette.
+		@param		numberOfColours		A pointer to the value that is set to the
+										number of colours of the palette.
+		@returns	A pointer to the colours of the palette or nullptr if there is no
+					palette with the identity (the number of colours is then 0).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	const Colour* LpState::GetPalette(uint8_t paletteId, uint8_t* numberOfColours) {
+		if (paletteId == PALETTE_NONE
+			|| paletteId > numberOfPalettes) {
+			*numberOfColours = 0;
+			return nullptr;
+		}
+
+		*numberOfColours = paletteSizes[paletteId - 1];
+
+		return &paletteColours[paletteStarts[paletteId - 1]];
+	}
+
+	/*!
+		@brief		Changes the colours of a palette in place, e.g. so that a program
+					can be recoloured whilst it plays.
+		@param		paletteId			The identity of the palette.
+		@param		colours				A pointer to the new colours of the palette.
+		@param		numberOfColours		The number of new colours, which must be the same
+										as the number of colours of the palette.
+		@returns	True if the palette was changed, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpState::ChangePalette(uint8_t paletteId, const Colour* colours, uint8_t numberOfColours) {
+		if (colours == nullptr
+			|| paletteId == PALETTE_NONE
+			|| paletteId > numberOfPalettes
+			|| paletteSizes[paletteId - 1] != numberOfColours) {
+			return false;
+		}
+
+		memcpy(&paletteColours[paletteStarts[paletteId - 1]], colours, numberOfColours * sizeof(Colour));
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the palette of the program, which colour references of LPIs
+					are replaced by when they are not within a call that passes a palette.
+		@returns	The identity of the palette (PALETTE_NONE if the program has none).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetProgramPaletteId() {
+		return programPaletteId;
+	}
+
+	/*!
+		@brief		Sets the palette of the program.
+		@param		paletteId		The identity of the palette, which has already been
+									added (PALETTE_NONE if the program has none).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpState::SetProgramPaletteId(uint8_t paletteId) {
+		programPaletteId = paletteId;
+	}
+
+	/*!
+		@brief		Gets the position of an LPI within the storage of the state.  The
+					position is stable for as long as the program is loaded and can be
+					used to key data that is held for each LPI.
+		@param		instruction		A pointer to the LPI.
+		@returns	The position of the LPI or MAX_LPINSTRUCTIONS if the instruction
+					is not an LPI held by this state.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpState::GetLpInstructionIndex(Instruction* instruction) {
+		if (instruction == nullptr
+			|| instruction < &lpInstructions[0]
+			|| instruction >= &lpInstructions[lpInstructionIndex]) {
+			return MAX_LPINSTRUCTIONS;
+		}
+
+		return (uint8_t)((LpInstruction*)instruction - lpInstructions);
 	}
 
 	/*!
@@ -71,7 +577,7 @@ namespace LS {
 		@date		21 Dec 2020
 	*/
 	Instruction* LpState::addRepeatInstruction(RepeatInstruction* repeatInstruction) {
-		if (repeatIndex >= MAX_REPEATINSTRUCTIONS) {
+		if (repeatIndex >= maxRepeatInstructions) {
 			return nullptr;
 		}
 
@@ -92,7 +598,7 @@ namespace LS {
 		@date		21 Dec 2020
 	*/
 	Instruction* LpState::addLpInstruction(LpInstruction* lpInstruction) {
-		if (lpInstructionIndex >= MAX_LPINSTRUCTIONS) {
+		if (lpInstructionIndex >= maxLpInstructions) {
 			return nullptr;
 		}
 
@@ -101,6 +607,27 @@ namespace LS {
 		return &lpInstructions[lpInstructionIndex - 1];
 	}
 
+	/*!
+		@brief		Adds a new call instruction to the program state.
+		@param		callInstruction	A pointer to the callInstruction that will
+									be used to initialise a callInstruction in the
+									collection of call instructions.
+		@returns	A pointer to the CallInstruction or nullptr if adding
+					a new call instruction would exceed the maximum number
+					of allowable call instructions.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	Instruction* LpState::addCallInstruction(CallInstruction* callInstruction) {
+		if (callIndex >= maxCallInstructions) {
+			return nullptr;
+		}
+
+		callInstructions[callIndex++].init(callInstruction);
+
+		return &callInstructions[callIndex - 1];
+	}
+
 	/*!
 		@brief		Adds a new instruction to the program state.
 		@param		newInstruction	A pointer to the instruction to be added
@@ -123,6 +650,9 @@ namespace LS {
 		else if (newInstruction->getInstructionType() == InstructionType::Lpi) {
 			addedInstruction = addLpInstruction((LpInstruction*)newInstruction);
 		}
+		else if (newInstruction->getInstructionType() == InstructionType::Call) {
+			addedInstruction = addCallInstruction((CallInstruction*)newInstruction);
+		}
 
 		if (firstInstruction == nullptr && addedInstruction != nullptr) {
 			currentInstruction = firstInstruction = addedInstruction;
@@ -4,13 +4,16 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include <stdint.h>
 #include "../Instructions/Instruction.h"
 #include "../Instructions/LpInstruction.h"
 #include "../Instructions/RepeatInstruction.h"
+#include "../Instructions/CallInstruction.h"
+#include "../../ValueDomainTypes.h"
+#include "LpiQueue.h"
 
 // #define MAX_LPINSTRUCTIONS		100
 // #define MAX_REPEATINSTRUCTIONS	25
@@ -18,6 +21,11 @@
 // xxxx: *** BUFFER ALLOCATION *** - Store a tree structure of a entire LP state
 #define MAX_LPINSTRUCTIONS		65
 #define MAX_REPEATINSTRUCTIONS	15
+#define MAX_CALLINSTRUCTIONS	24		// instructions that share an earlier, identical, instruction
+#define MAX_CALL_DEPTH			(MAX_NESTED_LOOPS + 1)		// most calls that can be executing within each other
+#define MAX_PALETTES			8		// distinct palettes of the program and those that calls of subroutines can pass
+#define MAX_PALETTE_COLOURS		32		// colours of all of the palettes
+#define PALETTE_NONE			0		// identity of no palette
 
 
 namespace LS {
@@ -29,10 +37,27 @@ namespace LS {
 	*/
 	class LpState {
 		private:
-			// allocate enough space to store 100 light program instructions
-			LpInstruction lpInstructions[MAX_LPINSTRUCTIONS] = {};
-			// allocate enough space to store 25 loop instructions
-			RepeatInstruction repeatInstructions[MAX_REPEATINSTRUCTIONS] = {};
+			// storage of the instructions, allocated when the state is constructed
+			// (MAX_LPINSTRUCTIONS, MAX_REPEATINSTRUCTIONS and MAX_CALLINSTRUCTIONS unless smaller)
+			LpInstruction* lpInstructions;
+			RepeatInstruction* repeatInstructions;
+			CallInstruction* callInstructions;
+			uint8_t maxLpInstructions;
+			uint8_t maxRepeatInstructions;
+			uint8_t maxCallInstructions;
+
+			// the calls that are executing, innermost last, so that execution
+			// returns to the call once its called instruction has completed
+			CallInstruction* callStack[MAX_CALL_DEPTH] = {};
+			uint8_t callDepth = 0;
+
+			// the colours of the palettes of the program and those passed by calls, each palette being a run of colours
+			Colour paletteColours[MAX_PALETTE_COLOURS] = {};
+			uint8_t paletteStarts[MAX_PALETTES] = {};
+			uint8_t paletteSizes[MAX_PALETTES] = {};
+			uint8_t numberOfPalettes = 0;
+			uint8_t numberOfPaletteColours = 0;
+			uint8_t programPaletteId = PALETTE_NONE;		// palette of the program, used outside of calls that pass one
 
 			// various pointers to instruction positions,
 			// required to track instructions as the program executes
@@ -42,17 +67,83 @@ namespace LS {
 			// indexes to the instructions storage arrays
 			uint8_t lpInstructionIndex = 0;
 			uint8_t repeatIndex = 0;
+			uint8_t callIndex = 0;
+
+			// incremented each time the state is reset so that anything derived
+			// from the state (e.g. pre-rendered frames) can tell that it is stale
+			uint16_t generation = 0;
+
+			// number of rendering frames of the program that have been executed
+			uint32_t frame = 0;
+
+			// identifies the program that is loaded so that servers running the same program can tell
+			uint32_t programId = 0;
+
+			// LPIs that are executed one after the other in place of a program (nullptr = not queue-fed)
+			LpiQueue* lpiQueue = nullptr;
+
+			// rendering frame at which the first instruction started (only moves on when queue-fed)
+			uint32_t firstFrame = 0;
+
+			// the instructions were optimised so they no longer match the LDL one for one
+			bool isOptimised = false;
+
+			// an LPI of the program fades in from the frame before it
+			bool hasTransitions = false;
+
+			// the instruction tree is being built so the state must not be executed
+			bool isBuilding = false;
+
+			// the segment of the LEDs that the program is played on (nullptr = all of the LEDs)
+			LEDSegment* segment = nullptr;
 
 		protected:
 			Instruction* addRepeatInstruction(RepeatInstruction* repeatInstruction);
 			Instruction* addLpInstruction(LpInstruction* lpInstruction);
+			Instruction* addCallInstruction(CallInstruction* callInstruction);
 
 		public:
+			LpState(uint8_t maxLpInstructions = MAX_LPINSTRUCTIONS, uint8_t maxRepeatInstructions = MAX_REPEATINSTRUCTIONS, uint8_t maxCallInstructions = MAX_CALLINSTRUCTIONS);
+			virtual ~LpState();
+
 			virtual void reset();
 			virtual Instruction* getFirstInstruction();
 			virtual Instruction* getCurrentInstruction();
 			virtual void setCurrentInstruction(Instruction* currentInstruction);
 			virtual Instruction* addInstruction(Instruction* newInstruction);
+			uint16_t GetGeneration();
+			uint32_t GetFrame();
+			void SetFrame(uint32_t frame);
+			uint32_t GetProgramId();
+			void SetProgramId(uint32_t programId);
+			uint8_t GetLpInstructionIndex(Instruction* instruction);
+			void MarkChanged();
+			bool IsLpiShared(LpInstruction* lpInstruction);
+			LpiQueue* GetLpiQueue();
+			void SetLpiQueue(LpiQueue* lpiQueue);
+			uint32_t GetFirstFrame();
+			Instruction* SetQueuedInstruction(LpInstruction* lpInstruction);
+			bool IsOptimised();
+			void SetOptimised();
+			bool HasTransitions();
+			void SetHasTransitions();
+			bool IsBuilding();
+			void SetBuilding(bool isBuilding);
+			bool PushCall(CallInstruction* callInstruction);
+			CallInstruction* PopCall();
+			CallInstruction* GetCall(uint8_t depth);
+			uint8_t GetCallDepth();
+			void ClearCalls();
+			uint8_t AddPalette(const Colour* colours, uint8_t numberOfColours);
+			const Colour* GetPalette(uint8_t paletteId, uint8_t* numberOfColours);
+			bool ChangePalette(uint8_t paletteId, const Colour* colours, uint8_t numberOfColours);
+			uint8_t GetProgramPaletteId();
+			void SetProgramPaletteId(uint8_t paletteId);
+			LEDSegment* GetSegment();
+			void SetSegment(LEDSegment* segment);
+			uint8_t GetMaxLpInstructions();
+			uint8_t GetMaxRepeatInstructions();
+			uint8_t GetMaxCallInstructions();
 	};
 }
 #endif
@@ -0,0 +1,371 @@
+#include "LpStatePatcher.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor sets the mandatory dependencies.
+		@param		lpiFactory		Factory class that provides access to the LPI executors.
+		@param		stringProcessor	A pointer to the class that provides string parsing.
+		@param		ledConfig		A pointer to the class that contains configuration information about the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpStatePatcher::LpStatePatcher(LpiExecutorFactory* lpiFactory, StringProcessor* stringProcessor, LEDConfig* ledConfig) {
+		this->lpiFactory = lpiFactory;
+		this->stringProcessor = stringProcessor;
+
+		lpiExecutorParams.Reset(&lpiBuffer, ledConfig, stringProcessor);
+	}
+
+	/*!
+		@brief		Changes an instruction of the program in place.  Nothing is changed
+					if the patch is not valid.  The position of the program is not changed
+					so it must be positioned again (e.g. seeked to the frame it was on) if
+					the frame length of the instruction is changed.
+		@param		state		A pointer to the state of the loaded program.
+		@param		patch		A pointer to the change.
+		@returns	True if the instruction was changed or false if the path does not
+					address an instruction, the changed instruction is not valid or the
+					program was optimised (as paths then no longer address the instructions).
+					The palette of the program can be changed once it has been optimised.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpStatePatcher::Patch(LpJsonState* state, LpPatch* patch) {
+		if (state == nullptr
+			|| patch == nullptr) {
+			return false;
+		}
+
+		if (!patch->palette.isNull()) {
+			return PatchPalette(state, patch);
+		}
+
+		if (state->IsOptimised()
+			|| !FindInstruction(state, patch->path)) {
+			return false;
+		}
+
+		bool isPatched = instruction->getInstructionType() == InstructionType::Repeat
+			? PatchRepeat(patch)
+			: PatchLpi(state, patch);
+		if (!isPatched) {
+			return false;
+		}
+
+		UpdateFrameLengths();
+
+		return true;
+	}
+
+	/*!
+		@brief		Finds the instruction addressed by a path, along with the JSON
+					variant from which it was built.
+		@param		state		A pointer to the state of the loaded program.
+		@param		path		A pointer to the path, e.g. "2.0".
+		@returns	True if the instruction was found, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpStatePatcher::FindInstruction(LpJsonState* state, const char* path) {
+		instruction = nullptr;
+		if (path == nullptr) {
+			return false;
+		}
+
+		Instruction* firstInstruction = state->getFirstInstruction();
+		JsonArray instructions = (*state->getLpJsonDoc())["instructions"];
+		const char* pPath = path;
+		for (uint8_t level = 0; level <= MAX_NESTED_LOOPS; level++) {
+			if (*pPath < '0' || *pPath > '9') {
+				return false;
+			}
+
+			uint16_t position = 0;
+			while (*pPath >= '0' && *pPath <= '9') {
+				position = position * 10 + (*pPath++ - '0');
+				if (position > MAX_LPINSTRUCTIONS + MAX_REPEATINSTRUCTIONS) {
+					return false;
+				}
+			}
+
+			// the instructions of the tree are in the same order as those of the document
+			Instruction* foundInstruction = firstInstruction;
+			for (uint16_t instructionIndex = 0; instructionIndex < position && foundInstruction != nullptr; instructionIndex++) {
+				foundInstruction = foundInstruction->getNext();
+			}
+			JsonVariant foundVar = instructions[position];
+			if (foundInstruction == nullptr
+				|| foundVar.isNull()) {
+				return false;
+			}
+
+			bool isRepeat = foundInstruction->getInstructionType() == InstructionType::Repeat;
+			if (*pPath == '\0') {
+				instruction = foundInstruction;
+				instructionVar = isRepeat ? foundVar["repeat"].as<JsonVariant>() : foundVar;
+				return true;
+			}
+
+			if (*pPath != '.'
+				|| !isRepeat) {
+				return false;
+			}
+
+			pPath++;
+			firstInstruction = ((InstructionWithChild*)foundInstruction)->getFirstChild();
+			instructions = foundVar["repeat"]["instructions"];
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Changes the LPI that has been found.  The changed LPI is built in
+					the patched LPI buffer and, with its colour references replaced by the
+					colours of the palette of the program (as when it is executed), validated
+					by the LpiExecutor of its opcode before it replaces the LPI.
+		@param		state		A pointer to the state of the loaded program.
+		@param		patch		A pointer to the change.
+		@returns	True if the LPI was changed, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpStatePatcher::PatchLpi(LpJsonState* state, LpPatch* patch) {
+		LpInstruction* lpInstruction = (LpInstruction*)instruction;
+		const char* currentLpi = lpInstruction->getLpi();
+		if (patch->times != PATCH_NOT_SET
+			|| currentLpi == nullptr
+			|| (patch->lpi != nullptr && strlen(patch->lpi) >= patchedLpiBuffer.GetBufferSize())) {
+			return false;
+		}
+
+		patchedLpiBuffer.ClearBuffer();
+		patchedLpiBuffer.LoadFromBuffer(patch->lpi != nullptr ? patch->lpi : currentLpi);
+		char* lpi = patchedLpiBuffer.GetBuffer();
+		uint16_t lpiLength = strlen(lpi);
+
+		if (patch->duration != PATCH_NOT_SET) {
+			if (patch->duration < 1
+				|| patch->duration > 255
+				|| lpiLength < BASIC_LPI_DETAILS_LENGTH) {
+				return false;
+			}
+
+			char duration[3];
+			snprintf(duration, sizeof(duration), "%02X", patch->duration);
+			lpi[2] = duration[0];
+			lpi[3] = duration[1];
+		}
+
+		if (patch->hex != nullptr) {
+			uint16_t hexLength = strlen(patch->hex);
+			if (patch->at < 0
+				|| patch->at + hexLength > lpiLength) {
+				return false;
+			}
+
+			memcpy(&lpi[patch->at], patch->hex, hexLength);
+		}
+
+		// paths only address the instructions of programs that have no calls, so
+		// the LPI is executed with the palette of the program
+		uint8_t numberOfColours = 0;
+		const Colour* palette = state->GetPalette(state->GetProgramPaletteId(), &numberOfColours);
+		if (!stringProcessor->ExpandColourReferences(lpi, &lpiBuffer, palette, numberOfColours)
+			|| !stringProcessor->ExtractLPIFromHexEncoded(lpiBuffer.GetBuffer(), &lpiBasics)) {
+			return false;
+		}
+
+		LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(lpiBasics.opcode);
+		if (lpiExecutor == nullptr
+			|| !lpiExecutor->ValidateLpi(&lpiExecutorParams)) {
+			return false;
+		}
+
+		if (lpiBasics.transition > 0) {
+			state->SetHasTransitions();
+		}
+
+		if (lpiLength <= strlen(currentLpi)
+			&& !state->IsLpiShared(lpInstruction)) {
+			// the string is held by the JSON document for this LPI alone so it can be written over
+			strcpy((char*)currentLpi, lpi);
+		}
+		else {
+			// a copy is added to the JSON document (set with a char* copies the string)
+			if (!instructionVar.set(lpi)) {
+				return false;
+			}
+			lpInstruction->setLpi(instructionVar.as<const char*>());
+		}
+
+		lpInstruction->SetDuration(lpiBasics.duration);
+		lpInstruction->SetNumberOfSteps(lpiExecutor->GetNumberOfSteps(&lpiExecutorParams));
+
+		return true;
+	}
+
+	/*!
+		@brief		Changes the number of iterations of the repeat that has been found.
+		@param		patch		A pointer to the change.
+		@returns	True if the repeat was changed, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpStatePatcher::PatchRepeat(LpPatch* patch) {
+		if (patch->lpi != nullptr
+			|| patch->duration != PATCH_NOT_SET
+			|| patch->hex != nullptr
+			|| patch->times < 0
+			|| patch->times > 1000) {
+			return false;
+		}
+
+		RepeatInstruction* repeatInstruction = (RepeatInstruction*)instruction;
+		repeatInstruction->setNumberOfIterations(patch->times);
+		repeatInstruction->setRemainingIterations(patch->times);
+		instructionVar["times"] = patch->times;
+
+		return true;
+	}
+
+	/*!
+		@brief		Updates the frame length of a single iteration of each of the
+					repeats that contain the instruction that has been changed.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpStatePatcher::UpdateFrameLengths() {
+		Instruction* parentInstruction = instruction->getParent();
+		while (parentInstruction != nullptr
+			&& parentInstruction->getInstructionType() == InstructionType::Repeat) {
+			RepeatInstruction* repeatInstruction = (RepeatInstruction*)parentInstruction;
+
+			uint32_t bodyFrameLength = 0;
+			for (Instruction* childInstruction = repeatInstruction->getFirstChild(); childInstruction != nullptr; childInstruction = childInstruction->getNext()) {
+				bodyFrameLength = LpJsonStateBuilder::AddFrameLength(bodyFrameLength, childInstruction->GetFrameLength());
+			}
+			repeatInstruction->SetBodyFrameLength(bodyFrameLength);
+
+			parentInstruction = parentInstruction->getParent();
+		}
+	}
+
+	/*!
+		@brief		Changes the colours of the palette of the program.  The palette must
+					have the same number of colours as it had when the program was loaded.
+					The number of steps of each LPI that refers to the palette is then worked
+					out again, as it can depend on the colours (e.g. of a fade), along with
+					the frame lengths of the repeats that contain them.
+		@param		state		A pointer to the state of the loaded program.
+		@param		patch		A pointer to the change, which only has the palette.
+		@returns	True if the palette was changed or false if the program has no palette
+					or the palette is not valid.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpStatePatcher::PatchPalette(LpJsonState* state, LpPatch* patch) {
+		if (patch->path != nullptr
+			|| patch->lpi != nullptr
+			|| patch->duration != PATCH_NOT_SET
+			|| patch->hex != nullptr
+			|| patch->times != PATCH_NOT_SET) {
+			return false;
+		}
+
+		Colour colours[MAX_PALETTE_SIZE];
+		uint8_t numberOfColours = 0;
+		for (JsonArray::iterator colour = patch->palette.begin(); colour != patch->palette.end(); ++colour) {
+			const char* colourStr = colour->as<const char*>();
+			bool isValid = false;
+			if (numberOfColours >= MAX_PALETTE_SIZE
+				|| colourStr == nullptr
+				|| strlen(colourStr) != 6) {
+				return false;
+			}
+			colours[numberOfColours++] = stringProcessor->ExtractColourFromHexEncoded(colourStr, isValid);
+			if (!isValid) {
+				return false;
+			}
+		}
+
+		uint8_t paletteId = state->GetProgramPaletteId();
+		if (!state->ChangePalette(paletteId, colours, numberOfColours)) {
+			return false;
+		}
+
+		UpdatePaletteSteps(state, state->getFirstInstruction(), paletteId);
+
+		return true;
+	}
+
+	/*!
+		@brief		Works out again the number of steps of each LPI, within an instructions
+					array, that refers to the palette of the program, including the LPIs
+					of repeats and of the instructions that are called.  Instructions that
+					are executed with another palette (that of a call) are not changed.
+		@param		state				A pointer to the state of the loaded program.
+		@param		firstInstruction	A pointer to the first instruction of the array.
+		@param		paletteId			The palette that the instructions are executed with.
+		@returns	The frame length of the instructions of the array.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpStatePatcher::UpdatePaletteSteps(LpJsonState* state, Instruction* firstInstruction, uint8_t paletteId) {
+		uint32_t frameLength = 0;
+		for (Instruction* currentInstruction = firstInstruction; currentInstruction != nullptr; currentInstruction = currentInstruction->getNext()) {
+			Instruction* executedInstruction = currentInstruction;
+			uint8_t executedPaletteId = paletteId;
+			if (currentInstruction->getInstructionType() == InstructionType::Call) {
+				CallInstruction* callInstruction = (CallInstruction*)currentInstruction;
+				executedInstruction = callInstruction->GetCalledInstruction();
+				if (callInstruction->GetPaletteId() != PALETTE_NONE) {
+					executedPaletteId = callInstruction->GetPaletteId();
+				}
+			}
+
+			if (executedInstruction != nullptr
+				&& executedPaletteId == state->GetProgramPaletteId()) {
+				if (executedInstruction->getInstructionType() == InstructionType::Repeat) {
+					RepeatInstruction* repeatInstruction = (RepeatInstruction*)executedInstruction;
+					repeatInstruction->SetBodyFrameLength(UpdatePaletteSteps(state, repeatInstruction->getFirstChild(), executedPaletteId));
+				}
+				else if (executedInstruction->getInstructionType() == InstructionType::Lpi) {
+					UpdateLpiSteps(state, (LpInstruction*)executedInstruction, executedPaletteId);
+				}
+			}
+
+			frameLength = LpJsonStateBuilder::AddFrameLength(frameLength, currentInstruction->GetFrameLength());
+		}
+
+		return frameLength;
+	}
+
+	/*!
+		@brief		Works out again the number of steps of an LPI that has colour references.
+		@param		state			A pointer to the state of the loaded program.
+		@param		lpInstruction	A pointer to the LPI.
+		@param		paletteId		The palette that the LPI is executed with.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpStatePatcher::UpdateLpiSteps(LpJsonState* state, LpInstruction* lpInstruction, uint8_t paletteId) {
+		const char* lpi = lpInstruction->getLpi();
+		if (lpi == nullptr
+			|| strchr(lpi, COLOUR_REFERENCE) == nullptr) {
+			return;
+		}
+
+		uint8_t numberOfColours = 0;
+		const Colour* palette = state->GetPalette(paletteId, &numberOfColours);
+		if (!stringProcessor->ExpandColourReferences(lpi, &lpiBuffer, palette, numberOfColours)
+			|| !stringProcessor->ExtractLPIFromHexEncoded(lpiBuffer.GetBuffer(), &lpiBasics)) {
+			return;
+		}
+
+		LpiExecutor* lpiExecutor = lpiFactory->GetLpiExecutor(lpiBasics.opcode);
+		if (lpiExecutor != nullptr) {
+			lpInstruction->SetNumberOfSteps(lpiExecutor->GetNumberOfSteps(&lpiExecutorParams));
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#ifndef _LpStatePatcher_h
+#define _LpStatePatcher_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "LpJsonState.h"
+#include "LpJsonStateBuilder.h"
+#include "../InstructionType.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
+#include "../../FixedSizeCharBuffer.h"
+#include "../../StringProcessor.h"
+#include "../../ValueDomainTypes.h"
+
+#define		PATCH_NOT_SET		-1		// the field of the patch is not changed
+
+namespace LS {
+	/*!
+		@brief	A change to a single instruction of the loaded program.  The instruction
+				is addressed by its path: the position of the instruction in each of the
+				nested instructions arrays separated by '.', e.g. "2.0" is the first
+				instruction of the repeat that is the third instruction of the program.
+	*/
+	struct LpPatch {
+		const char* path = nullptr;
+		const char* lpi = nullptr;			// replaces the whole LPI
+		int duration = PATCH_NOT_SET;		// replaces the duration of the LPI (1 - 255)
+		int at = PATCH_NOT_SET;				// position, in the LPI, of the characters replaced by hex
+		const char* hex = nullptr;			// replaces characters of the LPI, e.g. a colour
+		int times = PATCH_NOT_SET;			// replaces the number of iterations of a repeat (0 = infinite)
+		JsonArray palette;					// replaces the colours of the palette of the program (no path)
+	};
+
+	/*!
+		@brief	Changes an instruction of the loaded program in place, without
+				rebuilding the program, so that e.g. a colour can be changed whilst
+				the program plays.  The changed LPI is validated by the LpiExecutor of
+				its opcode, with its colour references replaced by the colours of the
+				palette of the program, before anything is changed.  The LPI is written
+				over the existing LPI in the JSON document when it fits and is not shared
+				with another LPI; otherwise a copy is added to the JSON document.  The frame
+				lengths of the repeats that contain the instruction are updated so the
+				program can still be positioned (seeked) by rendering frame.  The colours
+				of the palette of the program can also be changed, which recolours every
+				LPI that refers to them, without changing the JSON document.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpStatePatcher {
+	private:
+		LpiExecutorFactory* lpiFactory;
+		StringProcessor* stringProcessor;
+		LpiExecutorParams lpiExecutorParams;
+		// *** BUFFER ALLOCATION *** - the patched LPI, as it is held by the program
+		FixedSizeCharBuffer patchedLpiBuffer = FixedSizeCharBuffer(BUFFER_LPI_VALIDATION);
+		// *** BUFFER ALLOCATION *** - the LPI, with its colour references replaced, whilst it is validated
+		FixedSizeCharBuffer lpiBuffer = FixedSizeCharBuffer(BUFFER_LPI_VALIDATION);
+		LPIInstruction lpiBasics;
+
+		Instruction* instruction = nullptr;
+		JsonVariant instructionVar;
+
+	protected:
+		bool FindInstruction(LpJsonState* state, const char* path);
+		bool PatchLpi(LpJsonState* state, LpPatch* patch);
+		bool PatchRepeat(LpPatch* patch);
+		void UpdateFrameLengths();
+		bool PatchPalette(LpJsonState* state, LpPatch* patch);
+		uint32_t UpdatePaletteSteps(LpJsonState* state, Instruction* firstInstruction, uint8_t paletteId);
+		void UpdateLpiSteps(LpJsonState* state, LpInstruction* lpInstruction, uint8_t paletteId);
+
+	public:
+		LpStatePatcher(LpiExecutorFactory* lpiFactory, StringProcessor* stringProcessor, LEDConfig* ledConfig);
+
+		bool Patch(LpJsonState* state, LpPatch* patch);
+	};
+}
+
+#endif
@@ -0,0 +1,136 @@
+#include "LpiQueue.h"
+
+namespace LS {
+	/*!
+		@brief		Removes all of the LPIs from the queue.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiQueue::Clear() {
+		firstLpi = 0;
+		numberOfLpis = 0;
+		charactersTail = 0;
+	}
+
+	/*!
+		@brief		Gets whether there are no LPIs in the queue.
+		@returns	True if the queue is empty, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiQueue::IsEmpty() {
+		return numberOfLpis == 0;
+	}
+
+	/*!
+		@brief		Gets the number of LPIs in the queue, including the LPI at
+					the head of the queue that may be executing.
+		@returns	The number of LPIs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t LpiQueue::GetNumberOfLpis() {
+		return numberOfLpis;
+	}
+
+	/*!
+		@brief		Gets the length of the longest LPI that can be added to the queue
+					now.  Space is freed as the LPIs at the head of the queue finish
+					executing so clients use this to hold back further LPIs.
+		@returns	The number of characters or 0 if no LPI can be added.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LpiQueue::GetSpace() {
+		if (numberOfLpis >= LPI_QUEUE_LPIS) {
+			return 0;
+		}
+
+		if (numberOfLpis == 0) {
+			return LPI_QUEUE_CHARACTERS - 1;
+		}
+
+		uint16_t headStart = lpiStarts[firstLpi];
+		uint16_t largestSpace = 0;
+		if (charactersTail > headStart) {
+			// free space at the end of the buffer and possibly at the start
+			uint16_t endSpace = LPI_QUEUE_CHARACTERS - charactersTail;
+			largestSpace = endSpace > headStart ? endSpace : headStart;
+		}
+		else {
+			// LPIs have wrapped so the free space is between the tail and the head
+			largestSpace = headStart - charactersTail;
+		}
+
+		// space is required for the terminator of the LPI
+		return largestSpace > 0 ? largestSpace - 1 : 0;
+	}
+
+	/*!
+		@brief		Adds a copy of an LPI to the end of the queue.  The LPI is placed
+					at the tail of the shared buffer or, if there's no space at the end,
+					wraps back to the start of the shared buffer.
+		@param		lpi			A pointer to the LPI (need not be terminated).
+		@param		length		The number of characters in the LPI.
+		@returns	True if the LPI was added or false if there is no space.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiQueue::Push(const char* lpi, uint16_t length) {
+		if (lpi == nullptr
+			|| length == 0
+			|| length > GetSpace()) {
+			return false;
+		}
+
+		uint16_t lpiStart = charactersTail;
+		if (numberOfLpis == 0) {
+			lpiStart = 0;
+		}
+		else if (charactersTail > lpiStarts[firstLpi]
+			&& LPI_QUEUE_CHARACTERS - charactersTail <= length) {
+			// no space at the end of the buffer so wrap back to the start
+			lpiStart = 0;
+		}
+
+		memcpy(&lpis[lpiStart], lpi, length);
+		lpis[lpiStart + length] = '\0';
+
+		lpiStarts[(firstLpi + numberOfLpis) % LPI_QUEUE_LPIS] = lpiStart;
+		numberOfLpis++;
+		charactersTail = lpiStart + length + 1;
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the LPI at the head of the queue without removing it.
+		@returns	A pointer to the LPI or nullptr if the queue is empty.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	const char* LpiQueue::Peek() {
+		if (numberOfLpis == 0) {
+			return nullptr;
+		}
+
+		return &lpis[lpiStarts[firstLpi]];
+	}
+
+	/*!
+		@brief		Removes the LPI at the head of the queue, which frees its space.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LpiQueue::Pop() {
+		if (numberOfLpis == 0) {
+			return;
+		}
+
+		firstLpi = (firstLpi + 1) % LPI_QUEUE_LPIS;
+		numberOfLpis--;
+		if (numberOfLpis == 0) {
+			charactersTail = 0;
+		}
+	}
+}
@@ -0,0 +1,49 @@
+#ifndef _LpiQueue_h
+#define _LpiQueue_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+// xxxx: *** BUFFER ALLOCATION *** - LPIs queued for a show of unlimited length
+#define LPI_QUEUE_LPIS				16		// most LPIs that can be queued
+#define LPI_QUEUE_CHARACTERS		1000	// characters shared by all of the queued LPIs
+
+namespace LS {
+	/*!
+		@brief	Bounded ring of LPIs that are executed, in order, one after the
+				other so that a show of unlimited length runs in constant memory:
+				clients append LPIs whilst the LPI at the head of the queue is
+				executed.  The LPI strings are copied, each terminated, into a single
+				shared buffer and the LPI at the head is not removed until it has
+				finished executing as its string is referenced whilst it executes.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpiQueue {
+	private:
+		uint16_t lpiStarts[LPI_QUEUE_LPIS];		// index of each LPI in the shared buffer
+		char lpis[LPI_QUEUE_CHARACTERS];
+
+		uint8_t firstLpi = 0;				// index of the oldest entry
+		uint8_t numberOfLpis = 0;			// number of entries in use
+		uint16_t charactersTail = 0;		// index of the next free character
+
+	public:
+		void Clear();
+		bool IsEmpty();
+		uint8_t GetNumberOfLpis();
+		uint16_t GetSpace();
+
+		bool Push(const char* lpi, uint16_t length);
+		const char* Peek();
+		void Pop();
+	};
+}
+
+#endif
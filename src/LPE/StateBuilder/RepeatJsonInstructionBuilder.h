@@ -1,10 +1,10 @@
 #ifndef _RepeatJsonInstructionBuilder_h
 #define _RepeatJsonInstructionBuilder_h
 
-#include "..\..\ArduinoJson-v6.17.2.h"
-#include "..\..\ValueDomainTypes.h"
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
 #include "LpState.h"
-#include "..\Instructions\RepeatInstruction.h"
+#include "../Instructions/RepeatInstruction.h"
 #include "IJsonInstructionBuilder.h"
 
 namespace LS {
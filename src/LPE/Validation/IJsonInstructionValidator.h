@@ -1,8 +1,8 @@
 #ifndef _IInstructionValidator_h
 #define _IInstructionValidator_h
 
-#include "..\..\ArduinoJson-v6.17.2.h"
-#include "..\..\ValueDomainTypes.h"
+#include "../../ArduinoJson-v6.17.2.h"
+#include "../../ValueDomainTypes.h"
 
 namespace LS {
 	/*
@@ -35,6 +35,9 @@ namespace LS {
 			case InstructionType::Lpi:
 			case InstructionType::Repeat:
 				return validators[instructionType];
+			case InstructionType::Call:
+				// calls are validated by the program validator as they refer to other instructions
+				return nullptr;
 		}
 
 		return nullptr;
@@ -4,15 +4,15 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "IJsonInstructionValidator.h"
 #include "LpiJsonInstructionValidator.h"
 #include "RepeatJsonInstructionValidator.h"
-#include "..\InstructionType.h"
+#include "../InstructionType.h"
 
-#include "..\LpiExecutors\LpiExecutorFactory.h"
+#include "../LpiExecutors/LpiExecutorFactory.h"
 
 namespace LS {
 	/*!
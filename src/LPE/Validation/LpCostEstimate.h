@@ -0,0 +1,77 @@
+#ifndef _LpCostEstimate_h
+#define _LpCostEstimate_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../../WProgram.h"
+#endif
+
+#include "../StateBuilder/LpState.h"
+
+namespace LS {
+	/*!
+		@brief	The estimated cost of executing a Light Program, produced
+				whilst the program is validated.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LpCostEstimate {
+	public:
+		uint32_t peakFrameCost = 0;			// estimated time (microseconds) of the most expensive rendering frame
+		uint32_t numberOfFrames = 0;		// length of the program in rendering frames (the body of an infinite repeat is counted once)
+		bool isInfinite = false;			// whether the program repeats forever
+		uint8_t numberOfLpis = 0;
+		uint8_t numberOfRepeats = 0;
+		uint8_t numberOfCalls = 0;			// instructions that share an earlier, identical, instruction or call a subroutine
+		uint8_t numberOfPalettes = 0;		// distinct palettes of the program and passed by calls of subroutines
+		uint8_t numberOfPaletteColours = 0;
+
+		/*!
+			@brief		Resets the estimate ready for a new program.
+		*/
+		void Reset() {
+			peakFrameCost = 0;
+			numberOfFrames = 0;
+			isInfinite = false;
+			numberOfLpis = 0;
+			numberOfRepeats = 0;
+			numberOfCalls = 0;
+			numberOfPalettes = 0;
+			numberOfPaletteColours = 0;
+		}
+
+		/*!
+			@brief		Gets the memory used by the program once it has been loaded.
+			@returns	The number of bytes of the LP state used by the instructions and palettes.
+		*/
+		uint32_t GetMemoryFootprint() {
+			return (uint32_t)numberOfLpis * sizeof(LpInstruction)
+				+ (uint32_t)numberOfRepeats * sizeof(RepeatInstruction)
+				+ (uint32_t)numberOfCalls * sizeof(CallInstruction)
+				+ (uint32_t)numberOfPaletteColours * sizeof(Colour);
+		}
+
+		/*!
+			@brief		Adds two numbers of frames, stopping at the largest value rather than wrapping.
+			@param		frames			The number of frames.
+			@param		moreFrames		The number of frames to add.
+			@returns	The total number of frames.
+		*/
+		static uint32_t AddFrames(uint32_t frames, uint32_t moreFrames) {
+			return frames > 0xFFFFFFFF - moreFrames ? 0xFFFFFFFF : frames + moreFrames;
+		}
+
+		/*!
+			@brief		Multiplies a number of frames, stopping at the largest value rather than wrapping.
+			@param		frames			The number of frames.
+			@param		times			The number of times the frames are repeated.
+			@returns	The total number of frames.
+		*/
+		static uint32_t MultiplyFrames(uint32_t frames, uint32_t times) {
+			return times != 0 && frames > 0xFFFFFFFF / times ? 0xFFFFFFFF : frames * times;
+		}
+	};
+}
+
+#endif
@@ -13,74 +13,346 @@ namespace LS {
 	}
 
 	/*!
-		@brief	Validates a collection of individual instruction elements
-				that are contained in an array.
-		@param	instructions	The JSON array which contains the instructions to be validated.
+		@brief	Validates the next instruction of the LP.  When the end of an instructions
+				array is reached, validation moves back up to the array that contains it.
+				When the instruction is a repeat, validation moves down into the instructions
+				array of the repeat.
 		@param	result			A pointer to the object that contains the result of verifying the LP.
-		@returns	True if the instructions are valid, false otherwise.
 		@author	Kevin White
-		@date	18 Dec 2020
+		@date	19 Oct 2026
 	*/
-	void LpJsonValidator::ValidateInstructions(JsonArray* instructions, LPValidateResult* result) {
-		for (JsonVariant value : *instructions) {
-			bool isRepeat = value.containsKey("repeat");
-
-			if (isRepeat) {
-				// Validate the repeat...
-				IJsonInstructionValidator* repeatValidator = validatorFactory->GetValidator(InstructionType::Repeat);
-				JsonVariant repeatVariant = value["repeat"];
-
-				// ...basics are OK (has a "times" property and "instructions" array)...
-				repeatValidator->Validate(&repeatVariant, result);
-				if (result->GetCode() != LPValidateCode::Valid) {
+	void LpJsonValidator::ValidateNextInstruction(LPValidateResult* result) {
+		JsonArray::iterator* instructionIterator = &instructionIterators[nestingDepth - 1];
+		if (*instructionIterator == JsonArray::iterator()) {
+			// end of the instructions array
+			EndInstructions();
+			return;
+		}
+
+		JsonVariant value = **instructionIterator;
+		++(*instructionIterator);
+
+		bool isRepeat = value.containsKey("repeat");
+
+		if (value.containsKey("call")) {
+			ValidateCall(&value, result);
+		}
+		else if (isRepeat) {
+			// Validate the repeat...
+			IJsonInstructionValidator* repeatValidator = validatorFactory->GetValidator(InstructionType::Repeat);
+			JsonVariant repeatVariant = value["repeat"];
+
+			// ...basics are OK (has a "times" property and "instructions" array)...
+			repeatValidator->Validate(&repeatVariant, result);
+			if (result->GetCode() != LPValidateCode::Valid) {
+				return;
+			}
+
+			// ...an infinite loop is not already present (only one allowed in a program)...
+			int times = repeatVariant["times"].as<int>();
+			if (times == 0) {
+				if (hasInfiniteLoop) {
+					result->ResetResult(LPValidateCode::OnlyOneInfiniteLoopAllowed);
 					return;
 				}
+				hasInfiniteLoop = true;
+			}
+
+			// ...it fits in the LP state (an identical repeat is shared, along with its instructions)...
+			bool isShared = sharedDepth == 0 && ShareInstruction(&value, paletteIds[nestingDepth - 1]);
+			if (sharedDepth == 0
+				&& !isShared
+				&& ++costEstimate.numberOfRepeats > maxRepeatInstructions) {
+				result->ResetResult(LPValidateCode::ProgramTooBig);
+				return;
+			}
+
+			// ...and, finally, that the instructions array are also valid
+			if (nestingDepth > MAX_NESTED_LOOPS) {
+				result->ResetResult(LPValidateCode::Maximum5NestedLoopsAllowed);
+				return;
+			}
+			JsonArray repeatInstructions = repeatVariant["instructions"];
+			nestedFrames[nestingDepth] = 0;
+			nestedTimes[nestingDepth] = times;
+			nestedRepeats[nestingDepth] = value;
+			nestedSubroutines[nestingDepth] = nullptr;
+			paletteIds[nestingDepth] = paletteIds[nestingDepth - 1];
+			instructionIterators[nestingDepth++] = repeatInstructions.begin();
+			if (isShared) {
+				sharedDepth = nestingDepth;
+			}
+		}
+		else {
+			// Validate the LPI
+			LpiJsonInstructionValidator* lpiValidator = (LpiJsonInstructionValidator*)validatorFactory->GetValidator(InstructionType::Lpi);
+			lpiValidator->Validate(&value, result);
+			if (result->GetCode() != LPValidateCode::Valid) {
+				return;
+			}
 
-				// ...an infinite loop is not already present (only one allowed in a program)...
-				int times = repeatVariant["times"].as<int>();
-				if (times == 0) {
-					if (hasInfiniteLoop) {
-						result->ResetResult(LPValidateCode::OnlyOneInfiniteLoopAllowed);
-						return;
-					}
-					hasInfiniteLoop = true;
+			// ...it fits in the LP state (an identical LPI is shared)
+			uint8_t paletteId = paletteIds[nestingDepth - 1];
+			if (sharedDepth == 0
+				&& !ShareInstruction(&value, paletteId)) {
+				if (++costEstimate.numberOfLpis > maxLpInstructions) {
+					result->ResetResult(LPValidateCode::ProgramTooBig);
+					return;
 				}
+				interner.Add(&value, nullptr, paletteId);
+			}
 
-				// ...and, finally, that the instructions array are also valid
-				JsonArray repeatInstructions = repeatVariant["instructions"];
-				ValidateInstructions(&repeatInstructions, result);
+			// add the estimated cost of the LPI
+			if (lpiValidator->GetFrameCost() > costEstimate.peakFrameCost) {
+				costEstimate.peakFrameCost = lpiValidator->GetFrameCost();
 			}
-			else {
-				// Validate the LPI
-				IJsonInstructionValidator* lpiValidator = validatorFactory->GetValidator(InstructionType::Lpi);
-				lpiValidator->Validate(&value, result);
+			nestedFrames[nestingDepth - 1] = LpCostEstimate::AddFrames(nestedFrames[nestingDepth - 1], lpiValidator->GetNumberOfFrames());
+		}
+	}
+
+	/*!
+		@brief	Validates a call of a subroutine.  The subroutine must be defined by
+				the "subroutines" object of the program and must not be called from within
+				itself.  The instructions of the subroutine are validated each time that it
+				is called, as if it was a repeat of a single iteration, but only take space
+				in the LP state the first time that it is called with a palette.
+		@param	value			A pointer to the call.
+		@param	result			A pointer to the object that contains the result of verifying the LP.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	void LpJsonValidator::ValidateCall(JsonVariant* value, LPValidateResult* result) {
+		// Validate the call...
+		JsonVariant callVar = (*value)["call"];
+		const char* name = callVar["name"];
+
+		// ...the subroutine is defined...
+		JsonArray subroutineInstructions;
+		if (name != nullptr) {
+			subroutineInstructions = validateJsonDoc["subroutines"][name];
+		}
+		if (subroutineInstructions.isNull() || subroutineInstructions.size() == 0) {
+			result->ResetResult(LPValidateCode::UnknownSubroutine);
+			return;
+		}
+
+		// ...and not called from within itself...
+		for (uint8_t level = 0; level < nestingDepth; level++) {
+			if (nestedSubroutines[level] != nullptr
+				&& strcmp(nestedSubroutines[level], name) == 0) {
+				result->ResetResult(LPValidateCode::RecursiveSubroutine);
+				return;
 			}
+		}
 
+		// ...its palette, if it has one, is valid (otherwise that of the instructions
+		// that contain the call is kept)...
+		uint8_t paletteId = paletteIds[nestingDepth - 1];
+		JsonVariant paletteVar = callVar["palette"];
+		if (!paletteVar.isNull()) {
+			paletteId = AddPalette(&paletteVar, result);
 			if (result->GetCode() != LPValidateCode::Valid) {
 				return;
 			}
 		}
+
+		// ...it fits in the LP state (the subroutine is shared by later calls with the same palette)...
+		bool isShared = interner.FindSubroutine(name, paletteId) != nullptr;
+		if (sharedDepth == 0) {
+			if (++costEstimate.numberOfCalls > maxCallInstructions
+				|| (!isShared && ++costEstimate.numberOfRepeats > maxRepeatInstructions)) {
+				result->ResetResult(LPValidateCode::ProgramTooBig);
+				return;
+			}
+			if (!isShared) {
+				interner.AddSubroutine(name, paletteId, nullptr);
+			}
+		}
+
+		// ...and, finally, that the instructions of the subroutine are also valid
+		if (nestingDepth > MAX_NESTED_LOOPS) {
+			result->ResetResult(LPValidateCode::Maximum5NestedLoopsAllowed);
+			return;
+		}
+		nestedFrames[nestingDepth] = 0;
+		nestedTimes[nestingDepth] = 1;
+		nestedRepeats[nestingDepth] = JsonVariant();
+		nestedSubroutines[nestingDepth] = name;
+		paletteIds[nestingDepth] = paletteId;
+		instructionIterators[nestingDepth++] = subroutineInstructions.begin();
+		if (sharedDepth == 0 && isShared) {
+			sharedDepth = nestingDepth;
+		}
 	}
-	
+
+	/*!
+		@brief	Validates the palette of the program, or of a call, and adds it to the
+				palettes of the program unless it is identical to one that has already
+				been added (the palette of the program is never shared as it can be changed).
+		@param	paletteVar		A pointer to the palette.
+		@param	result			A pointer to the object that contains the result of verifying the LP.
+		@returns	The identity of the palette.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	uint8_t LpJsonValidator::AddPalette(JsonVariant* paletteVar, LPValidateResult* result) {
+		LpiJsonInstructionValidator* lpiValidator = (LpiJsonInstructionValidator*)validatorFactory->GetValidator(InstructionType::Lpi);
+		if (!lpiValidator->ValidatePalette(paletteVar)) {
+			result->ResetResult(LPValidateCode::InvalidProperty);
+			return PALETTE_NONE;
+		}
+
+		for (uint8_t paletteIndex = 0; paletteIndex < costEstimate.numberOfPalettes; paletteIndex++) {
+			if (paletteIndex + 1 != programPaletteId
+				&& palettes[paletteIndex] == *paletteVar) {
+				return paletteIndex + 1;
+			}
+		}
+
+		uint8_t numberOfColours = paletteVar->size();
+		if (costEstimate.numberOfPalettes >= MAX_PALETTES
+			|| costEstimate.numberOfPaletteColours + numberOfColours > MAX_PALETTE_COLOURS) {
+			result->ResetResult(LPValidateCode::ProgramTooBig);
+			return PALETTE_NONE;
+		}
+
+		palettes[costEstimate.numberOfPalettes] = *paletteVar;
+		costEstimate.numberOfPaletteColours += numberOfColours;
+
+		return ++costEstimate.numberOfPalettes;
+	}
+
+	/*!
+		@brief	Moves back up out of an instructions array once all of its instructions
+				have been validated.  The length of the array, multiplied by the number of times
+				it is repeated, is added to the length of the array that contains it.  The body
+				of an infinite repeat is counted once.  The repeat can then be shared by later
+				repeats that are identical to it.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	void LpJsonValidator::EndInstructions() {
+		nestingDepth--;
+		if (nestingDepth == 0) {
+			costEstimate.numberOfFrames = nestedFrames[0];
+			return;
+		}
+
+		if (sharedDepth == 0
+			&& nestedSubroutines[nestingDepth] == nullptr) {
+			interner.Add(&nestedRepeats[nestingDepth], nullptr, paletteIds[nestingDepth]);
+		}
+		else if (sharedDepth > nestingDepth) {
+			// moving back up out of the repeat that is shared
+			sharedDepth = 0;
+		}
+
+		uint32_t frames = nestedFrames[nestingDepth];
+		if (nestedTimes[nestingDepth] == 0) {
+			costEstimate.isInfinite = true;
+		}
+		else {
+			frames = LpCostEstimate::MultiplyFrames(frames, nestedTimes[nestingDepth]);
+		}
+		nestedFrames[nestingDepth - 1] = LpCostEstimate::AddFrames(nestedFrames[nestingDepth - 1], frames);
+	}
+
+	/*!
+		@brief	Gets whether an instruction will share an earlier instruction that is
+				identical to it, rather than being built, when the program is loaded.
+		@param	instructionVar	A pointer to the instruction.
+		@param	paletteId		The palette that the instruction is validated with.
+		@returns	True if the instruction is shared, false otherwise.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	bool LpJsonValidator::ShareInstruction(JsonVariant* instructionVar, uint8_t paletteId) {
+		if (costEstimate.numberOfCalls >= maxCallInstructions
+			|| interner.Find(instructionVar, paletteId) == nullptr) {
+			return false;
+		}
+
+		costEstimate.numberOfCalls++;
+
+		return true;
+	}
+
+	/*!
+		@brief	Checks the estimated cost of a Light Program, once all of its instructions
+				have been validated, against the frame budget.  A program whose most expensive
+				frame exceeds the budget is only invalid if the program has asked to be
+				validated strictly and the costs have been measured on the device
+				(COSTS_CALIBRATED); until then the estimate is only reported.
+		@param	result			A pointer to the object that contains the result of verifying the LP.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	void LpJsonValidator::CheckCostEstimate(LPValidateResult* result) {
+		if (COSTS_CALIBRATED
+			&& isStrict
+			&& frameBudget > 0
+			&& costEstimate.peakFrameCost > frameBudget) {
+			result->ResetResult(LPValidateCode::ExceedsFrameBudget);
+		}
+	}
+
 	/*!
 		@brief	Validates an entire Light Program according to the following rules:
 				1. LPI instructions are valid according to the specific rules for individual LPIs.
 				2. Repeat instructions are well formed.
 				3. The mandatory basic properties are present: name and instructions.
 				4. There is only a single at most infinite loop in a program.
+				5. The program fits in the LP state it is to be built in.
+				6. If the program has "strict" set, its most expensive frame is estimated to
+				   be within the frame budget (only once the costs are calibrated).
+				7. Calls are of subroutines that are defined, not from within themselves, and
+				   pass valid palettes.
+				8. The palette of the program, if it has one, is valid.
+				The cost of the program is estimated as it is validated (see GetCostEstimate).
 		@param	lp		A pointer to the buffer that contains the Light Program to be validated.
 		@param	result	A pointer to the object that contains the result of verifying the LP.
+		@param	state	A pointer to the LP state the program is to be built in (nullptr = a state of the default size).
 		@returns	True if the Light Program is valid, false otherwise.
 		@author	Kevin White
 		@date	18 Dec 2020
 	*/
-	void LpJsonValidator::ValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result) {
+	void LpJsonValidator::ValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result, LpJsonState* state) {
+		if (!BeginValidateLp(lp, result, state)) {
+			return;
+		}
+
+		ContinueValidateLp(0xFFFF, result);
+	}
+
+	/*!
+		@brief	Begins validating a Light Program by checking the basic properties of
+				the program.  The instructions are then validated, a few at a time, by
+				calling ContinueValidateLp so that validating a large program can be
+				spread across several execution cycles.
+		@param	lp		A pointer to the buffer that contains the Light Program to be validated.
+		@param	result	A pointer to the object that contains the result of verifying the LP.
+		@param	state	A pointer to the LP state the program is to be built in (nullptr = a state of the default size).
+		@returns	True if the instructions are to be validated or false if the Light Program
+					is already known to be invalid.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	bool LpJsonValidator::BeginValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result, LpJsonState* state) {
 		result->ResetResult(LPValidateCode::Valid);
+		documentSize = state == nullptr ? BUFFER_LP : state->getLpJsonDoc()->capacity();
+		maxLpInstructions = state == nullptr ? MAX_LPINSTRUCTIONS : state->GetMaxLpInstructions();
+		maxRepeatInstructions = state == nullptr ? MAX_REPEATINSTRUCTIONS : state->GetMaxRepeatInstructions();
+		maxCallInstructions = state == nullptr ? MAX_CALLINSTRUCTIONS : state->GetMaxCallInstructions();
 		hasInfiniteLoop = false;
+		nestingDepth = 0;
+		sharedDepth = 0;
+		interner.Clear();
+		costEstimate.Reset();
+		isStrict = false;
 
 		if (lp == nullptr) {
 			result->ResetResult(LPValidateCode::NoIntructions);
-			return;
+			return false;
 		}
 
 		// Load the JSON document first from the lp.  Is the JSON well-formed
@@ -94,7 +366,13 @@ namespace LS {
 			else {
 				result->ResetResult(LPValidateCode::MissingMandatoryProperties, nullptr);
 			}
-			return;
+			return false;
+		}
+
+		// The document must also fit in the JSON document of the LP state
+		if (validateJsonDoc.memoryUsage() > documentSize) {
+			result->ResetResult(LPValidateCode::ProgramTooBig, nullptr);
+			return false;
 		}
 
 		// Validate basic details: has a name property and collection
@@ -103,15 +381,98 @@ namespace LS {
 		const char* progName = validateJsonDoc["name"];
 		if (progName == nullptr || strlen(progName) < 5) {
 			result->ResetResult(LPValidateCode::MissingMandatoryProperties, nullptr);
-			return;
+			return false;
 		}
 
 		JsonArray instructionsArr = validateJsonDoc["instructions"];
 		if (instructionsArr.isNull() || instructionsArr.size() == 0) {
 			result->ResetResult(LPValidateCode::NoIntructions);
-			return;
+			return false;
 		}
 
-		ValidateInstructions(&instructionsArr, result);
+		// an optional "strict" property rejects programs that cannot be rendered
+		// within the frame budget
+		isStrict = validateJsonDoc["strict"].as<bool>();
+
+		// an optional "palette" property holds the colours that colour references
+		// of the LPIs are replaced by
+		programPaletteId = PALETTE_NONE;
+		JsonVariant paletteVar = validateJsonDoc["palette"];
+		if (!paletteVar.isNull()) {
+			uint8_t paletteId = AddPalette(&paletteVar, result);
+			if (result->GetCode() != LPValidateCode::Valid) {
+				return false;
+			}
+			programPaletteId = paletteId;
+		}
+
+		nestedFrames[nestingDepth] = 0;
+		nestedTimes[nestingDepth] = 1;
+		nestedSubroutines[nestingDepth] = nullptr;
+		paletteIds[nestingDepth] = programPaletteId;
+		instructionIterators[nestingDepth++] = instructionsArr.begin();
+
+		return true;
+	}
+
+	/*!
+		@brief	Continues validating the instructions of a Light Program that was
+				passed to BeginValidateLp.
+		@param	maxInstructions		The most instructions to validate on this call.
+		@param	result				A pointer to the object that contains the result of verifying the LP.
+		@returns	True if validation is complete (the result is then final) or false if there
+					are further instructions to be validated.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	bool LpJsonValidator::ContinueValidateLp(uint16_t maxInstructions, LPValidateResult* result) {
+		while (nestingDepth > 0) {
+			if (maxInstructions-- == 0) {
+				return false;
+			}
+
+			ValidateNextInstruction(result);
+
+			if (result->GetCode() != LPValidateCode::Valid) {
+				nestingDepth = 0;
+				return true;
+			}
+		}
+
+		CheckCostEstimate(result);
+
+		return true;
+	}
+
+	/*!
+		@brief	Sets the time available to render a frame.  Programs that ask to be
+				validated strictly are invalid if they are estimated to exceed this.
+		@param	frameBudget		The frame budget in microseconds (0 for no budget).
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	void LpJsonValidator::SetFrameBudget(uint32_t frameBudget) {
+		this->frameBudget = frameBudget;
+	}
+
+	/*!
+		@brief		Gets the time available to render a frame.
+		@returns	The frame budget in microseconds (0 for no budget).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpJsonValidator::GetFrameBudget() {
+		return frameBudget;
+	}
+
+	/*!
+		@brief		Gets the estimated cost of the last Light Program to be validated.  The
+					estimate is only complete once validation is complete and the program is valid.
+		@returns	A pointer to the estimate.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LpCostEstimate* LpJsonValidator::GetCostEstimate() {
+		return &costEstimate;
 	}
 }
\ No newline at end of file
@@ -4,10 +4,13 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "JsonInstructionValidatorFactory.h"
+#include "LpCostEstimate.h"
+#include "../StateBuilder/LpJsonInterner.h"
+#include "../StateBuilder/LpJsonState.h"
 
 namespace LS {
 	/*!
@@ -24,13 +27,56 @@ namespace LS {
 			
 			bool hasInfiniteLoop = false;
 
+			// the position reached within each of the nested instructions arrays so
+			// that validation can be carried out over several calls
+			JsonArray::iterator instructionIterators[MAX_NESTED_LOOPS + 1];
+			uint8_t nestingDepth = 0;
+
+			// the length, in frames, of each of the nested instructions arrays validated so far
+			// and the number of times each is repeated (0 = infinite)
+			uint32_t nestedFrames[MAX_NESTED_LOOPS + 1];
+			uint16_t nestedTimes[MAX_NESTED_LOOPS + 1];
+
+			// instructions that are identical to an earlier instruction share it, so do not
+			// take space in the LP state, as do the instructions within them
+			LpJsonInterner interner;
+			JsonVariant nestedRepeats[MAX_NESTED_LOOPS + 1];	// the repeat that contains each of the nested instructions arrays
+			uint8_t sharedDepth = 0;							// nesting depth of the repeat that shares an earlier repeat (0 = none)
+
+			// subroutines are validated each time they are called, with the palette of the call
+			const char* nestedSubroutines[MAX_NESTED_LOOPS + 1];	// the subroutine of each of the nested instructions arrays (nullptr = none)
+			uint8_t paletteIds[MAX_NESTED_LOOPS + 1];				// the palette each of the nested instructions arrays is validated with
+			JsonVariant palettes[MAX_PALETTES];						// the distinct palettes, identified by their position + 1
+			uint8_t programPaletteId = PALETTE_NONE;				// the palette of the program (PALETTE_NONE = none)
+
+			LpCostEstimate costEstimate;
+			uint32_t frameBudget = 0;			// time (microseconds) available to render a frame (0 = no budget)
+
+			// the capacity of the LP state that the program is to be built in
+			size_t documentSize = BUFFER_LP;
+			uint8_t maxLpInstructions = MAX_LPINSTRUCTIONS;
+			uint8_t maxRepeatInstructions = MAX_REPEATINSTRUCTIONS;
+			uint8_t maxCallInstructions = MAX_CALLINSTRUCTIONS;
+			bool isStrict = false;				// whether programs that exceed the frame budget are invalid
+
 		protected:
-			void ValidateInstructions(JsonArray* instructions, LPValidateResult* result);
+			void ValidateNextInstruction(LPValidateResult* result);
+			void ValidateCall(JsonVariant* value, LPValidateResult* result);
+			uint8_t AddPalette(JsonVariant* paletteVar, LPValidateResult* result);
+			void EndInstructions();
+			bool ShareInstruction(JsonVariant* instructionVar, uint8_t paletteId);
+			void CheckCostEstimate(LPValidateResult* result);
 
 		public:
 			LpJsonValidator(JsonInstructionValidatorFactory* factory);
 
-			virtual void ValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result);
+			virtual void ValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result, LpJsonState* state = nullptr);
+			virtual bool BeginValidateLp(FixedSizeCharBuffer* lp, LPValidateResult* result, LpJsonState* state = nullptr);
+			virtual bool ContinueValidateLp(uint16_t maxInstructions, LPValidateResult* result);
+
+			void SetFrameBudget(uint32_t frameBudget);
+			uint32_t GetFrameBudget();
+			LpCostEstimate* GetCostEstimate();
 	};
 }
 
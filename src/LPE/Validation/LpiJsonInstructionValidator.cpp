@@ -44,8 +44,12 @@ namespace LS {
 			return;
 		}
 
-		// now, validate the specific LPI
-		lpiToBeValidatedBuffer.LoadFromBuffer(lpiStr);
+		// now, validate the specific LPI (colour references are validated as black
+		// as the palette they are replaced by is only known when they are executed)
+		if (!stringProcessor->ExpandColourReferences(lpiStr, &lpiToBeValidatedBuffer, nullptr, 0)) {
+			result->ResetResult(LPValidateCode::InvalidInstruction);
+			return;
+		}
 		LpiExecutor* lpiExecutor = lpiExecutorFactory->GetLpiExecutor(lpiToBeValidated.opcode);
 
 		isValid = lpiExecutor->ValidateLpi(&lpiExecutorParams);
@@ -54,6 +58,19 @@ namespace LS {
 			return;
 		}
 
+		// estimate the time taken by a frame on which a step of the LPI is rendered
+		// (executing the LPI then setting and showing every pixel) and how many
+		// frames the LPI lasts for
+		frameCost = lpiExecutor->EstimateExecutionCost(&lpiExecutorParams)
+			+ (uint32_t)ledConfig->numberOfLEDs * (COST_PIXEL_SET + COST_PIXEL_SHOW)
+			+ COST_PIXEL_LATCH;
+		if (lpiToBeValidated.transition > 0) {
+			// whilst the LPI fades in every frame blends the step with the frame before it
+			frameCost += (uint32_t)ledConfig->numberOfLEDs * COST_TRANSITION_PIXEL;
+		}
+		numberOfFrames = (uint32_t)lpiExecutor->GetNumberOfSteps(&lpiExecutorParams)
+			* lpiToBeValidated.duration;
+
 		// now, get the LPI and validate the actual instruction against the
 		// rules specific to that LPI
 		// lpiToBeValidatedBuffer.LoadFromBuffer(lpiStr);
@@ -68,4 +85,62 @@ namespace LS {
 			return;
 		}*/
 	}
+
+	/*!
+		@brief		Validates a palette that colour references of LPIs are replaced by.
+					A palette is an array of between 1 and 16 hex-encoded colours.
+		@param		paletteVar	Pointer to the element that contains the palette.
+		@returns	True if the palette is valid, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LpiJsonInstructionValidator::ValidatePalette(JsonVariant* paletteVar) {
+		if (paletteVar == nullptr
+			|| !paletteVar->is<JsonArray>()) {
+			return false;
+		}
+
+		JsonArray paletteColours = paletteVar->as<JsonArray>();
+		if (paletteColours.size() == 0
+			|| paletteColours.size() > MAX_PALETTE_SIZE) {
+			return false;
+		}
+
+		for (JsonArray::iterator colour = paletteColours.begin(); colour != paletteColours.end(); ++colour) {
+			const char* colourStr = colour->as<const char*>();
+			bool isValid = false;
+			if (colourStr == nullptr
+				|| strlen(colourStr) != 6) {
+				return false;
+			}
+			stringProcessor->ExtractColourFromHexEncoded(colourStr, isValid);
+			if (!isValid) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the estimated time taken by a rendering frame on which a step of
+					the last LPI to be validated is rendered.
+		@returns	The estimated time in microseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpiJsonInstructionValidator::GetFrameCost() {
+		return frameCost;
+	}
+
+	/*!
+		@brief		Gets the number of rendering frames that the last LPI to be validated
+					lasts for (the number of steps multiplied by the duration).
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LpiJsonInstructionValidator::GetNumberOfFrames() {
+		return numberOfFrames;
+	}
 }
\ No newline at end of file
@@ -4,7 +4,7 @@
 #if defined(ARDUINO) && ARDUINO >= 100
 #include "arduino.h"
 #else
-#include "..\..\WProgram.h"
+#include "../../WProgram.h"
 #endif
 
 #include "IJsonInstructionValidator.h"
@@ -32,11 +32,19 @@ namespace LS {
 			// 500:  *** BUFFER ALLOCATION *** - Individual LPI for validation
 			FixedSizeCharBuffer lpiToBeValidatedBuffer = FixedSizeCharBuffer(BUFFER_LPI_VALIDATION);
 			LPIInstruction lpiToBeValidated;
+
+			// estimated cost of the last LPI to be validated
+			uint32_t frameCost = 0;
+			uint32_t numberOfFrames = 0;
 		public:
 			// LpiJsonInstructionValidator(LPIFactory* factory);
 			LpiJsonInstructionValidator(LpiExecutorFactory* factory, StringProcessor* stringProcessor, LEDConfig* ledConfig);
 
 			void Validate(JsonVariant* jsonVar, LPValidateResult* result);
+			bool ValidatePalette(JsonVariant* paletteVar);
+
+			uint32_t GetFrameCost();
+			uint32_t GetNumberOfFrames();
 	};
 }
 
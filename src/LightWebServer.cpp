@@ -9,11 +9,21 @@ namespace LS{
 		// Initialises the event hooks
 		webServer->addCommand("program", &LightWebServer::HandleCommandLoadProgram);
 		webServer->addCommand("program/stored", &LightWebServer::HandleCommandLoadProgramAndStore);
+		webServer->addCommand("program/seek", &LightWebServer::HandleCommandSeekProgram);
+		webServer->addCommand("program/patch", &LightWebServer::HandleCommandPatchProgram);
+		webServer->addCommand("program/queue", &LightWebServer::HandleCommandQueueProgram);
+		webServer->addCommand("program/layer", &LightWebServer::HandleCommandLoadLayer);
+		webServer->addCommand("program/segment", &LightWebServer::HandleCommandLoadSegment);
 		webServer->addCommand("power/off", &LightWebServer::HandleCommandPowerOff);
 		webServer->addCommand("power/on", &LightWebServer::HandleCommandPowerOn);
 		webServer->addCommand("power", &LightWebServer::HandleCommandCheckPower);
 		webServer->addCommand("about", &LightWebServer::HandleCommandGetAbout);
 		webServer->addCommand("config/leds", &LightWebServer::HandleCommandSetLeds);
+		webServer->addCommand("config/segments", &LightWebServer::HandleCommandSetSegments);
+		webServer->addCommand("status", &LightWebServer::HandleCommandGetStatus);
+		webServer->addCommand("profile", &LightWebServer::HandleCommandProfile);
+		webServer->addCommand("sync", &LightWebServer::HandleCommandSync);
+		webServer->addCommand("batch", &LightWebServer::HandleCommandBatch);
 		webServer->setDefaultCommand(&LightWebServer::HandleCommandInvalid);
 		webServer->setFailureCommand(&LightWebServer::HandleCommandInvalid);
 
@@ -133,6 +143,143 @@ namespace LS{
 		LightWebServer::LoadBody(lightWebServer, server);
 	}
 
+	void LightWebServer::HandleCommandGetStatus(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::GET) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::GETSTATUS);
+	}
+
+	void LightWebServer::HandleCommandProfile(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::GET
+			&& type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::PROFILE);
+
+		if (type == IWebServer::ConnectionType::POST) {
+			LightWebServer::LoadBody(lightWebServer, server);
+		}
+	}
+
+	void LightWebServer::HandleCommandSeekProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::SEEKPROGRAM);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
+	void LightWebServer::HandleCommandPatchProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::PATCHPROGRAM);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
+	void LightWebServer::HandleCommandQueueProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::GET
+			&& type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::QUEUEPROGRAM);
+
+		if (type == IWebServer::ConnectionType::POST) {
+			LightWebServer::LoadBody(lightWebServer, server);
+		}
+	}
+
+	void LightWebServer::HandleCommandLoadLayer(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::LOADLAYER);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
+	void LightWebServer::HandleCommandLoadSegment(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::LOADSEGMENT);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
+	void LightWebServer::HandleCommandSetSegments(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::SETSEGMENTS);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
+	void LightWebServer::HandleCommandSync(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::GET
+			&& type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::SYNC);
+
+		if (type == IWebServer::ConnectionType::POST) {
+			LightWebServer::LoadBody(lightWebServer, server);
+		}
+	}
+
+	void LightWebServer::HandleCommandBatch(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char*, bool) {
+		if (LightWebServer::CheckAuth(lightWebServer, server) == false) return;	// Check authentication
+
+		if (type != IWebServer::ConnectionType::POST) {
+			lightWebServer->SetCommandType(CommandType::INVALID);
+			return;
+		}
+
+		lightWebServer->SetCommandType(CommandType::BATCH);
+
+		LightWebServer::LoadBody(lightWebServer, server);
+	}
+
 	CommandType LightWebServer::HandleNextCommand() {
 		currentCommand = CommandType::NONE;
 
@@ -153,6 +300,20 @@ namespace LS{
 		webServer->closeConnection();
 	}
 
+	void LightWebServer::StartResponseOK() {
+		webServer->httpSuccess();
+	}
+
+	void LightWebServer::WriteResponse(const char* str) {
+		if (str != nullptr) {
+			webServer->printP(str);
+		}
+	}
+
+	void LightWebServer::EndResponse() {
+		webServer->closeConnection();
+	}
+
 	void LightWebServer::RespondNoContent() {
 		webServer->httpNoContent();
 		webServer->closeConnection();
@@ -129,6 +129,104 @@ namespace LS {
 			@param	tailComplete		True if the tail is complete
 			*/
 			static void HandleCommandSetLeds(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to GET the run-time status of the server.  Sets the web server status to "GETSTATUS".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandGetStatus(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to GET the profile of the LPIs or, when POSTed, to change how LPIs are profiled and
+					then get the profile.  Sets the web server status to "PROFILE".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandProfile(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST the rendering frame that the executing program is moved to.  Sets the web server
+					status to "SEEKPROGRAM".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandSeekProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST a change to an instruction of the executing program.  Sets the web server
+					status to "PATCHPROGRAM".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandPatchProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST LPIs to the queue of a queue-fed show or to GET how full the queue is.  Sets the
+					web server status to "QUEUEPROGRAM".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandQueueProgram(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST a program to a layer that is composited over the executing program, or to
+					change how the layer is blended.  Sets the web server status to "LOADLAYER".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandLoadLayer(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST a program to a segment of the LEDs, or to stop the program of the segment.
+					Sets the web server status to "LOADSEGMENT".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandLoadSegment(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST the segments of the LEDs.  Sets the web server status to "SETSEGMENTS".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandSetSegments(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to GET the quality of the frame clock synchronisation or, when POSTed, to change the
+					role of the server and then get the quality.  Sets the web server status to "SYNC".
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandSync(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
+			/*!
+			@brief  Handles a request to POST an ordered list of commands that are all executed for the one request.
+					Sets the web server status to "BATCH" and loads the list of commands into the loading buffer.
+			@param	lightWebServer		A pointer to this LightWebServer instance.  Required as the handler has to be a static method.
+			@param	server				A pointer to the web server.
+			@param	type				The verb of the connection or INVALID for an invalid request.
+			@param	header				A pointer to the header.
+			@param	tailComplete		True if the tail is complete
+			*/
+			static void HandleCommandBatch(ILightWebServer* lightWebServer, IWebServer& server, IWebServer::ConnectionType type, char* head, bool tailComplete);
 		public:
 			/*!
 			@brief  Default constructor sets references to the mandatory properties.
@@ -192,6 +290,22 @@ namespace LS {
 			*/
 			void RespondOK(const char* str = nullptr);
 
+			/*!
+			@brief		Starts a HTTP OK response whose body is written in parts.
+			*/
+			void StartResponseOK();
+
+			/*!
+			@brief		Writes part of the body of a response started with StartResponseOK.
+			@param		str				The part of the body to be written.
+			*/
+			void WriteResponse(const char* str);
+
+			/*!
+			@brief		Closes the current connection once the body of the response has been written.
+			*/
+			void EndResponse();
+
 			/*!
 			@brief		Closes the current connection and respons with a HTTP NO CONTENT (204).
 			*/
@@ -0,0 +1,221 @@
+#include "DdpReceiver.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects the dependencies.
+		@param		port				The port that DDP packets are received on (4048 by convention).
+		@param		udp					A pointer to the UDP service used to receive packets.
+		@param		pixelController		A pointer to the class that interacts with the LED hardware.
+		@param		orchastor			A pointer to the orchastrating class that executes the program.
+		@param		timer				A pointer to the timer used to time out the stream.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	DdpReceiver::DdpReceiver(uint16_t port, IUdpService* udp, IPixelController* pixelController, IOrchastor* orchastor, Timer* timer) {
+		this->port = port;
+		this->udp = udp;
+		this->pixelController = pixelController;
+		this->orchastor = orchastor;
+		this->timer = timer;
+	}
+
+	/*!
+		@brief		Starts listening for DDP packets.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void DdpReceiver::Start() {
+		udp->begin(port);
+	}
+
+	/*!
+		@brief		Writes the pixels of the packets that have been received to the LEDs and
+					hands the LEDs back to the program once the stream has timed out.  This
+					should be called on every loop as it returns straight away when there
+					is nothing to do.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void DdpReceiver::Execute() {
+		uint32_t now = timer->GetTime();
+
+		for (uint8_t packetCount = 0; packetCount < DDP_MAX_PACKETS; packetCount++) {
+			int packetSize = udp->parsePacket();
+			if (packetSize <= 0) {
+				break;
+			}
+
+			statistics.packetsReceived++;
+			if (!ReceivePacket(packetSize, now)) {
+				statistics.packetsIgnored++;
+			}
+		}
+
+		if (isStreaming
+			&& now - lastPacketTime >= timeout) {
+			isStreaming = false;
+			orchastor->ResumePrograms();
+		}
+	}
+
+	/*!
+		@brief		Gets whether pixels are being streamed, i.e. the program has been preempted.
+		@returns	True if pixels are being streamed, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool DdpReceiver::IsStreaming() {
+		return isStreaming;
+	}
+
+	/*!
+		@brief		Sets how long the stream can go without a packet before the program takes
+					back the LEDs.
+		@param		timeout		The time (ms).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void DdpReceiver::SetTimeout(uint32_t timeout) {
+		this->timeout = timeout;
+	}
+
+	/*!
+		@brief		Gets the counts of the packets received.
+		@returns	A pointer to the counts.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	DdpStatistics* DdpReceiver::GetStatistics() {
+		return &statistics;
+	}
+
+	/*!
+		@brief		Reads the header of a packet that has been received and, if the packet
+					has pixel data for display, writes the pixels to the LEDs.  The header is:
+
+					flags (version in the top two bits)
+					sequence (bottom four bits, 0 = not used)
+					data type (assumed to be 8-bit RGB)
+					destination id
+					data offset in bytes (4 bytes, big endian)
+					data length in bytes (2 bytes, big endian)
+					timecode (4 bytes, only if flagged)
+		@param		packetSize		The size of the packet that has been received.
+		@param		now				The current time (ms).
+		@returns	True if the packet was written to the LEDs or false if it was ignored.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool DdpReceiver::ReceivePacket(int packetSize, uint32_t now) {
+		if (packetSize < DDP_HEADER_SIZE
+			|| udp->read((char*)header, DDP_HEADER_SIZE) != DDP_HEADER_SIZE) {
+			return false;
+		}
+
+		uint8_t flags = header[0];
+		uint8_t destination = header[3];
+		if ((flags >> 6) != DDP_VERSION
+			|| (flags & (DDP_FLAG_STORAGE | DDP_FLAG_REPLY | DDP_FLAG_QUERY)) != 0
+			|| (destination != DDP_ID_DISPLAY && destination != DDP_ID_ALL)) {
+			return false;
+		}
+
+		uint16_t headerSize = DDP_HEADER_SIZE;
+		if ((flags & DDP_FLAG_TIMECODE) != 0) {
+			// the timecode is not used; the pixels are written as they arrive
+			headerSize += DDP_TIMECODE_SIZE;
+			if (packetSize < headerSize
+				|| udp->read((char*)&header[DDP_HEADER_SIZE], DDP_TIMECODE_SIZE) != DDP_TIMECODE_SIZE) {
+				return false;
+			}
+		}
+
+		uint32_t offset = ((uint32_t)header[4] << 24) | ((uint32_t)header[5] << 16) | ((uint32_t)header[6] << 8) | header[7];
+		uint16_t length = (uint16_t)((header[8] << 8) | header[9]);
+		if (length > packetSize - headerSize) {
+			length = packetSize - headerSize;
+		}
+
+		uint8_t sequence = header[1] & 0x0F;
+		if (sequence != 0
+			&& lastSequence != 0
+			&& sequence != (lastSequence % 15) + 1) {
+			statistics.outOfSequence++;
+		}
+		lastSequence = sequence;
+
+		if (!isStreaming) {
+			// the stream takes the LEDs from the program until it times out
+			orchastor->PreemptPrograms();
+			isStreaming = true;
+		}
+		lastPacketTime = now;
+
+		WritePixels(offset, length);
+
+		if ((flags & DDP_FLAG_PUSH) != 0) {
+			pixelController->show();
+			statistics.framesShown++;
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Reads the pixel data of the current packet, a chunk at a time, and writes
+					it straight to the pixel controller.  The data is RGB bytes starting from a
+					byte offset into the frame; an offset that does not fall on the start of a
+					pixel keeps the other channels of the pixel it starts in.  Pixels beyond the
+					number of LEDs are ignored.
+		@param		offset		The byte offset of the data into the frame.
+		@param		length		The number of bytes of data.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void DdpReceiver::WritePixels(uint32_t offset, uint16_t length) {
+		uint32_t numberOfPixels = pixelController->numPixels();
+		uint32_t pixelIndex = offset / 3;
+		uint8_t channel = offset % 3;
+		uint8_t rgb[3] = { 0, 0, 0 };
+
+		if (channel != 0
+			&& pixelIndex < numberOfPixels) {
+			uint32_t colour = pixelController->getPixelColor(pixelIndex);
+			rgb[0] = (uint8_t)(colour >> 16);
+			rgb[1] = (uint8_t)(colour >> 8);
+			rgb[2] = (uint8_t)colour;
+		}
+
+		while (length > 0
+			&& pixelIndex < numberOfPixels) {
+			uint16_t chunkSize = length > DDP_READ_CHUNK ? DDP_READ_CHUNK : length;
+			int bytesRead = udp->read((char*)chunk, chunkSize);
+			if (bytesRead <= 0) {
+				break;
+			}
+
+			for (int byteIndex = 0; byteIndex < bytesRead; byteIndex++) {
+				rgb[channel++] = chunk[byteIndex];
+				if (channel == 3) {
+					pixelController->setPixelColor(pixelIndex++, rgb[0], rgb[1], rgb[2]);
+					channel = 0;
+					if (pixelIndex >= numberOfPixels) {
+						return;
+					}
+				}
+			}
+
+			length -= bytesRead;
+		}
+
+		if (channel != 0
+			&& pixelIndex < numberOfPixels) {
+			// the data ends part way through a pixel so keep its other channels
+			uint32_t colour = pixelController->getPixelColor(pixelIndex);
+			for (; channel < 3; channel++) {
+				rgb[channel] = (uint8_t)(colour >> (16 - channel * 8));
+			}
+			pixelController->setPixelColor(pixelIndex, rgb[0], rgb[1], rgb[2]);
+		}
+	}
+}
@@ -0,0 +1,97 @@
+/*!
+ * @file DdpReceiver.h
+ *
+ * Receives a stream of pixels sent using the Distributed
+ * Display Protocol (DDP) and writes them straight to the
+ * LEDs, bypassing the Light Program.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _DdpReceiver_h
+#define _DdpReceiver_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "IUdpService.h"
+#include "../DomainInterfaces.h"
+#include "../Orchastrator/Timer.h"
+#include "../Orchastrator/IOrchastor.h"
+
+#define		DDP_HEADER_SIZE					10		// bytes in the header without a timecode
+#define		DDP_TIMECODE_SIZE				4		// bytes of timecode that follow the header when flagged
+#define		DDP_VERSION						1		// version of the protocol (top two bits of the flags)
+#define		DDP_FLAG_TIMECODE				0x10	// the header is followed by a timecode
+#define		DDP_FLAG_STORAGE				0x08	// the data is for storage rather than display
+#define		DDP_FLAG_REPLY					0x04	// the packet is a reply
+#define		DDP_FLAG_QUERY					0x02	// the packet is a query
+#define		DDP_FLAG_PUSH					0x01	// show the pixels once the data has been written
+#define		DDP_ID_DISPLAY					1		// destination: the default output display
+#define		DDP_ID_ALL						255		// destination: all devices
+#define		DDP_READ_CHUNK					60		// bytes of pixel data read from the packet at a time (20 RGB pixels)
+#define		DDP_MAX_PACKETS					8		// most packets read on each call
+#define		DDP_TIMEOUT						2500	// ms without a packet before the program takes back the LEDs
+
+namespace LS {
+	/*!
+		@brief	Counts of the packets received.
+	*/
+	struct DdpStatistics {
+		uint32_t packetsReceived = 0;
+		uint32_t packetsIgnored = 0;		// not DDP, not for display or a query
+		uint32_t framesShown = 0;
+		uint32_t outOfSequence = 0;			// packets that did not follow on from the previous packet
+	};
+
+	/*!
+		@brief	Writes the RGB pixel data of DDP packets straight into the buffer
+				of the pixel controller, so pixels can be streamed from a PC at a high
+				frame rate without going through LDL.  The LEDs are shown when a packet
+				has the push flag.  The Light Program is preempted when the first packet
+				arrives and takes back the LEDs once no packets have been received for
+				DDP_TIMEOUT ms.  Pixel data is read from the packet a chunk at a time
+				and written to the LEDs as it is read, so no frame buffer is required.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class DdpReceiver {
+	private:
+		uint16_t port;
+		IUdpService* udp;
+		IPixelController* pixelController;
+		IOrchastor* orchastor;
+		Timer* timer;
+
+		uint8_t header[DDP_HEADER_SIZE + DDP_TIMECODE_SIZE];
+		uint8_t chunk[DDP_READ_CHUNK];
+		uint32_t timeout = DDP_TIMEOUT;
+		bool isStreaming = false;
+		uint32_t lastPacketTime = 0;
+		uint8_t lastSequence = 0;
+		DdpStatistics statistics;
+
+	protected:
+		bool ReceivePacket(int packetSize, uint32_t now);
+		void WritePixels(uint32_t offset, uint16_t length);
+
+	public:
+		DdpReceiver(uint16_t port, IUdpService* udp, IPixelController* pixelController, IOrchastor* orchastor, Timer* timer);
+
+		void Start();
+		void Execute();
+		bool IsStreaming();
+		void SetTimeout(uint32_t timeout);
+		DdpStatistics* GetStatistics();
+	};
+}
+
+#endif
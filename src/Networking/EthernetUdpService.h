@@ -50,6 +50,9 @@ namespace LS {
 		virtual size_t write(const char* str) {
 			return udp.write(str);
 		}
+		virtual size_t write(const uint8_t* buffer, size_t size) {
+			return udp.write(buffer, size);
+		}
 		virtual int endPacket() {
 			return udp.endPacket();
 		}
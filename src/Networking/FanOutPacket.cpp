@@ -0,0 +1,200 @@
+#include "FanOutPacket.h"
+
+namespace LS {
+	/*!
+		@brief		Starts a new packet with no runs.
+		@param		sequence		The sequence number of the rendering frame.
+		@param		packetIndex		The index of the packet within the rendering frame.
+		@param		firstLed		The LED of the follower's segment that the first run starts from.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPacket::Begin(uint16_t sequence, uint8_t packetIndex, uint16_t firstLed) {
+		packet[0] = 'L';
+		packet[1] = 'S';
+		packet[2] = 'P';
+		packet[3] = FAN_OUT_VERSION;
+		packet[4] = (uint8_t)sequence;
+		packet[5] = (uint8_t)(sequence >> 8);
+		packet[6] = packetIndex;
+		packet[7] = 0;
+		packet[8] = (uint8_t)firstLed;
+		packet[9] = (uint8_t)(firstLed >> 8);
+		packet[10] = 0;
+		numberOfRuns = 0;
+		numberOfLeds = 0;
+	}
+
+	/*!
+		@brief		Adds a run of LEDs of the same colour to the packet.  The run is
+					merged with the last run when both are the same colour.
+		@param		colour		The colour of the LEDs.
+		@param		count		The number of LEDs.
+		@returns	True if the run was added or false if the packet is full.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPacket::AddRun(Colour colour, uint8_t count) {
+		if (count == 0) {
+			return true;
+		}
+
+		if (numberOfRuns > 0) {
+			uint8_t* lastRun = &packet[FAN_OUT_HEADER_SIZE + (numberOfRuns - 1) * FAN_OUT_RUN_SIZE];
+			if (lastRun[1] == colour.red
+				&& lastRun[2] == colour.green
+				&& lastRun[3] == colour.blue
+				&& lastRun[0] + count <= FAN_OUT_MAX_RUN_LENGTH) {
+				lastRun[0] += count;
+				numberOfLeds += count;
+				return true;
+			}
+		}
+
+		if (numberOfRuns >= FAN_OUT_MAX_RUNS) {
+			return false;
+		}
+
+		uint8_t* run = &packet[FAN_OUT_HEADER_SIZE + numberOfRuns * FAN_OUT_RUN_SIZE];
+		run[0] = count;
+		run[1] = colour.red;
+		run[2] = colour.green;
+		run[3] = colour.blue;
+		numberOfRuns++;
+		numberOfLeds += count;
+		packet[10] = numberOfRuns;
+
+		return true;
+	}
+
+	/*!
+		@brief		Marks the packet as the last packet of the rendering frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPacket::SetLast() {
+		packet[7] |= FAN_OUT_FLAG_LAST;
+	}
+
+	/*!
+		@brief		Gets the buffer that holds the packet.
+		@returns	A pointer to the first byte of the packet.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t* FanOutPacket::GetBuffer() {
+		return packet;
+	}
+
+	/*!
+		@brief		Gets the number of bytes of the packet that are in use.
+		@returns	The size of the packet.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPacket::GetSize() {
+		return FAN_OUT_HEADER_SIZE + numberOfRuns * FAN_OUT_RUN_SIZE;
+	}
+
+	/*!
+		@brief		Gets the number of LEDs covered by the runs added to the packet.
+		@returns	The number of LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPacket::GetNumberOfLeds() {
+		return numberOfLeds;
+	}
+
+	/*!
+		@brief		Checks a packet that has been read into the buffer.
+		@param		packetSize		The number of bytes that were read.
+		@returns	True if the buffer holds a valid packet or false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPacket::Decode(int packetSize) {
+		numberOfRuns = 0;
+		numberOfLeds = 0;
+
+		if (packetSize < FAN_OUT_HEADER_SIZE
+			|| packetSize > FAN_OUT_PACKET_SIZE
+			|| packet[0] != 'L'
+			|| packet[1] != 'S'
+			|| packet[2] != 'P'
+			|| packet[3] != FAN_OUT_VERSION
+			|| packet[10] > FAN_OUT_MAX_RUNS
+			|| packetSize != FAN_OUT_HEADER_SIZE + packet[10] * FAN_OUT_RUN_SIZE) {
+			return false;
+		}
+
+		numberOfRuns = packet[10];
+		for (uint8_t runIndex = 0; runIndex < numberOfRuns; runIndex++) {
+			numberOfLeds += packet[FAN_OUT_HEADER_SIZE + runIndex * FAN_OUT_RUN_SIZE];
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the sequence number of the rendering frame.
+		@returns	The sequence number.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPacket::GetSequence() {
+		return (uint16_t)(packet[4] | (packet[5] << 8));
+	}
+
+	/*!
+		@brief		Gets the index of the packet within the rendering frame.
+		@returns	The packet index.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t FanOutPacket::GetPacketIndex() {
+		return packet[6];
+	}
+
+	/*!
+		@brief		Gets the LED of the follower's segment that the first run starts from.
+		@returns	The first LED.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPacket::GetFirstLed() {
+		return (uint16_t)(packet[8] | (packet[9] << 8));
+	}
+
+	/*!
+		@brief		Gets whether the packet is the last packet of the rendering frame.
+		@returns	True if it is the last packet, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPacket::IsLast() {
+		return (packet[7] & FAN_OUT_FLAG_LAST) != 0;
+	}
+
+	/*!
+		@brief		Gets the number of runs in the packet.
+		@returns	The number of runs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t FanOutPacket::GetNumberOfRuns() {
+		return numberOfRuns;
+	}
+
+	/*!
+		@brief		Gets a run of the packet as a rendering instruction.
+		@param		runIndex		The index of the run.
+		@returns	The rendering instruction for the run.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	RI FanOutPacket::GetRun(uint8_t runIndex) {
+		uint8_t* run = &packet[FAN_OUT_HEADER_SIZE + runIndex * FAN_OUT_RUN_SIZE];
+		return RI(Colour(run[1], run[2], run[3]), run[0]);
+	}
+}
@@ -0,0 +1,75 @@
+/*!
+ * @file FanOutPacket.h
+ *
+ * A packet of run-length encoded LED colours that a
+ * fan-out master sends to each of its followers.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _FanOutPacket_h
+#define _FanOutPacket_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "../ValueDomainTypes.h"
+
+#define		FAN_OUT_VERSION					1		// version of the packet format
+#define		FAN_OUT_HEADER_SIZE				11		// bytes before the first run
+#define		FAN_OUT_RUN_SIZE				4		// bytes in each run: count, red, green, blue
+#define		FAN_OUT_MAX_RUNS				60		// most runs in a single packet
+#define		FAN_OUT_PACKET_SIZE				(FAN_OUT_HEADER_SIZE + FAN_OUT_MAX_RUNS * FAN_OUT_RUN_SIZE)
+#define		FAN_OUT_MAX_RUN_LENGTH			255		// most LEDs in a single run
+#define		FAN_OUT_FLAG_LAST				0x01	// the packet is the last packet of the frame
+
+namespace LS {
+	/*!
+		@brief	A packet of a rendering frame sent from a fan-out master to
+				a follower.  A frame is sent as one or more packets, numbered
+				from 0, each of which holds runs of LEDs of the same colour
+				starting from an LED of the follower's segment.  The packet is:
+
+				'L' 'S' 'P' version
+				sequence (2 bytes, little endian)
+				packet index
+				flags
+				first LED (2 bytes, little endian)
+				number of runs
+				runs: count red green blue
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class FanOutPacket {
+	private:
+		uint8_t packet[FAN_OUT_PACKET_SIZE];
+		uint8_t numberOfRuns = 0;
+		uint16_t numberOfLeds = 0;
+
+	public:
+		void Begin(uint16_t sequence, uint8_t packetIndex, uint16_t firstLed);
+		bool AddRun(Colour colour, uint8_t count);
+		void SetLast();
+		uint8_t* GetBuffer();
+		uint16_t GetSize();
+		uint16_t GetNumberOfLeds();
+
+		bool Decode(int packetSize);
+		uint16_t GetSequence();
+		uint8_t GetPacketIndex();
+		uint16_t GetFirstLed();
+		bool IsLast();
+		uint8_t GetNumberOfRuns();
+		RI GetRun(uint8_t runIndex);
+	};
+}
+
+#endif
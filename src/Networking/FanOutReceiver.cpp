@@ -0,0 +1,142 @@
+#include "FanOutReceiver.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects the dependencies.
+		@param		port		The port that frames are received on.
+		@param		udp			A pointer to the UDP service used to receive frames.
+		@param		renderer	A pointer to the renderer of the LEDs of this server.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FanOutReceiver::FanOutReceiver(uint16_t port, IUdpService* udp, PixelRenderer* renderer) {
+		this->port = port;
+		this->udp = udp;
+		this->renderer = renderer;
+	}
+
+	/*!
+		@brief		Starts listening for frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutReceiver::Start() {
+		udp->begin(port);
+	}
+
+	/*!
+		@brief		Renders the packets that have been received.  This should be called
+					on every loop as it returns straight away when nothing has been received.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutReceiver::Execute() {
+		for (uint8_t packetCount = 0; packetCount < FAN_OUT_MAX_PACKETS; packetCount++) {
+			int packetSize = udp->parsePacket();
+			if (packetSize <= 0) {
+				return;
+			}
+
+			statistics.packetsReceived++;
+			if (packetSize > FAN_OUT_PACKET_SIZE
+				|| udp->read((char*)packet.GetBuffer(), packetSize) != packetSize
+				|| !packet.Decode(packetSize)) {
+				statistics.packetsIgnored++;
+				continue;
+			}
+
+			ReceivePacket();
+		}
+	}
+
+	/*!
+		@brief		Gets the counts of the frames received from the master.
+		@returns	A pointer to the counts.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FanOutStatistics* FanOutReceiver::GetStatistics() {
+		return &statistics;
+	}
+
+	/*!
+		@brief		Gets whether a frame is the last frame shown or a frame sent before it.
+					Frames more than FAN_OUT_REORDER_WINDOW behind are assumed to come from a
+					master that has restarted its sequence.
+		@param		sequence	The sequence number of the frame.
+		@returns	True if the frame is old and should be ignored, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutReceiver::IsOldFrame(uint16_t sequence) {
+		if (!frameShown) {
+			return false;
+		}
+
+		uint16_t framesBehind = shownSequence - sequence;
+		return framesBehind < FAN_OUT_REORDER_WINDOW;
+	}
+
+	/*!
+		@brief		Renders the packet that has just been decoded, if it is the next
+					packet of the frame being received, and shows the LEDs if it is
+					the last packet of the frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutReceiver::ReceivePacket() {
+		uint16_t sequence = packet.GetSequence();
+		uint8_t packetIndex = packet.GetPacketIndex();
+
+		if (IsOldFrame(sequence)) {
+			statistics.packetsIgnored++;
+			return;
+		}
+
+		if (packetIndex == 0) {
+			if (assembling) {
+				// the frame being received never got its last packet
+				statistics.framesDropped++;
+			}
+
+			assembling = true;
+			assemblingSequence = sequence;
+			nextPacketIndex = 0;
+		}
+		else if (!assembling
+			|| sequence != assemblingSequence
+			|| packetIndex != nextPacketIndex) {
+			// a packet was lost so hold the last frame rather than show part of this one
+			if (assembling
+				&& sequence != assemblingSequence) {
+				// the frame being received never got its last packet
+				statistics.framesDropped++;
+			}
+			if (assembling
+				|| sequence != assemblingSequence) {
+				statistics.framesDropped++;
+			}
+
+			assembling = false;
+			assemblingSequence = sequence;
+			return;
+		}
+
+		RI run;
+		uint16_t ledIndex = packet.GetFirstLed();
+		for (uint8_t runIndex = 0; runIndex < packet.GetNumberOfRuns(); runIndex++) {
+			run = packet.GetRun(runIndex);
+			renderer->SetPixels(&run, 1, false, ledIndex);
+			ledIndex += run.number;
+		}
+		nextPacketIndex++;
+
+		if (packet.IsLast()) {
+			renderer->ShowPixels();
+			assembling = false;
+			frameShown = true;
+			shownSequence = sequence;
+			statistics.framesShown++;
+		}
+	}
+}
@@ -0,0 +1,80 @@
+/*!
+ * @file FanOutReceiver.h
+ *
+ * Receives the rendering frames sent by a fan-out master
+ * and renders them on the LEDs of a follower.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _FanOutReceiver_h
+#define _FanOutReceiver_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "IUdpService.h"
+#include "FanOutPacket.h"
+#include "../Renderer/PixelRenderer.h"
+
+#define		FAN_OUT_MAX_PACKETS				8		// most packets read on each call
+#define		FAN_OUT_REORDER_WINDOW			16		// frames behind the last frame shown that are treated as late rather than a restarted master
+
+namespace LS {
+	/*!
+		@brief	Counts of the frames received from the master.
+	*/
+	struct FanOutStatistics {
+		uint32_t packetsReceived = 0;
+		uint32_t packetsIgnored = 0;		// not a fan-out packet, a duplicate or from an old frame
+		uint32_t framesShown = 0;
+		uint32_t framesDropped = 0;			// frames with a missing packet
+	};
+
+	/*!
+		@brief	Renders the frames sent by a fan-out master (see FanOutPixelRenderer)
+				without running a program.  The runs of each packet are written straight
+				into the pixel renderer as the packet arrives and the LEDs are shown once
+				the last packet of the frame has arrived.  Packets must arrive in order: when
+				a packet of a frame is missing the rest of the frame is ignored and the LEDs
+				are not shown, so they hold the last complete frame until the next frame (or
+				the master sending the last frame again) arrives.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class FanOutReceiver {
+	private:
+		uint16_t port;
+		IUdpService* udp;
+		PixelRenderer* renderer;
+
+		FanOutPacket packet;
+		bool frameShown = false;			// whether any frame has been shown
+		uint16_t shownSequence = 0;			// sequence of the last frame shown
+		bool assembling = false;			// whether a frame is being received
+		uint16_t assemblingSequence = 0;	// sequence of the frame being received
+		uint8_t nextPacketIndex = 0;		// index of the packet expected next
+		FanOutStatistics statistics;
+
+	protected:
+		bool IsOldFrame(uint16_t sequence);
+		void ReceivePacket();
+
+	public:
+		FanOutReceiver(uint16_t port, IUdpService* udp, PixelRenderer* renderer);
+
+		void Start();
+		void Execute();
+		FanOutStatistics* GetStatistics();
+	};
+}
+
+#endif
@@ -0,0 +1,283 @@
+#include "FrameClockSync.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects the dependencies.
+		@param		port			The port that beacons are sent to and received on.
+		@param		udp				A pointer to the UDP service used to send and receive beacons.
+		@param		timer			A pointer to the timer that drives the rendering frames.
+		@param		orchastor		A pointer to the orchastrating class that executes the program.
+		@param		programState	A pointer to the state of the program that is kept in step.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FrameClockSync::FrameClockSync(uint16_t port, IUdpService* udp, Timer* timer, IOrchastor* orchastor, LpState* programState) {
+		this->port = port;
+		this->udp = udp;
+		this->timer = timer;
+		this->orchastor = orchastor;
+		this->programState = programState;
+	}
+
+	/*!
+		@brief		Starts listening for beacons.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::Start() {
+		udp->begin(port);
+	}
+
+	/*!
+		@brief		Sends a beacon, when the server is the master and a beacon is due, or
+					follows the beacons that have been received, when the server is a follower.
+					This should be called on every loop as it returns straight away when there
+					is nothing to do.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::Execute() {
+		uint32_t now = timer->GetTime();
+
+		if (role == FrameSyncRole::SyncMaster) {
+			if (quality.beaconsSent == 0
+				|| now - quality.lastBeaconTime >= FRAME_SYNC_BEACON_INTERVAL) {
+				SendBeacon(now);
+			}
+		}
+		else if (role == FrameSyncRole::SyncFollower) {
+			ReceiveBeacons(now);
+		}
+	}
+
+	/*!
+		@brief		Sets the part that the server plays in keeping frame clocks in step.
+					The sync quality is reset.
+		@param		role		The part to play.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::SetRole(FrameSyncRole role) {
+		this->role = role;
+		quality = FrameSyncQuality();
+		sequence = 0;
+	}
+
+	/*!
+		@brief		Gets the part that the server plays in keeping frame clocks in step.
+		@returns	The role of the server.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FrameSyncRole FrameClockSync::GetRole() {
+		return role;
+	}
+
+	/*!
+		@brief		Gets whether the server is a follower that is in step with the master.
+		@returns	True if a beacon has been received recently and the frame clock was
+					within FRAME_SYNC_LOCKED_ERROR ms of the master, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FrameClockSync::IsLocked() {
+		return role == FrameSyncRole::SyncFollower
+			&& quality.beaconsReceived > 0
+			&& GetTimeSinceLastBeacon() < FRAME_SYNC_TIMEOUT
+			&& quality.lastError <= FRAME_SYNC_LOCKED_ERROR
+			&& quality.lastError >= -FRAME_SYNC_LOCKED_ERROR;
+	}
+
+	/*!
+		@brief		Gets the statistics of how closely the server is in step.
+		@returns	A pointer to the statistics.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FrameSyncQuality* FrameClockSync::GetQuality() {
+		return &quality;
+	}
+
+	/*!
+		@brief		Gets the time since the last beacon was sent or received.
+		@returns	The time in ms.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t FrameClockSync::GetTimeSinceLastBeacon() {
+		return timer->GetTime() - quality.lastBeaconTime;
+	}
+
+	/*!
+		@brief		Gets the time since the current rendering frame was shown.
+		@returns	The time in ms, which is the frame interval if the next frame is due.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t FrameClockSync::GetPhase() {
+		uint8_t interval = timer->GetInterval();
+		uint32_t timeUntilNext = timer->GetTimeUntilNext();
+		if (timeUntilNext == 0) {
+			return interval;
+		}
+
+		// frames skipped whilst idle move the timer on by whole intervals
+		return interval - (uint8_t)((timeUntilNext - 1) % interval + 1);
+	}
+
+	/*!
+		@brief		Broadcasts a beacon of the frame clock of this server.
+		@param		now		The current time.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::SendBeacon(uint32_t now) {
+		FrameSyncBeacon beacon;
+		beacon.programId = programState->GetProgramId();
+		beacon.frame = orchastor->GetProgramFrame();
+		beacon.sequence = ++sequence;
+		beacon.phase = GetPhase();
+		beacon.interval = timer->GetInterval();
+		EncodeBeacon(&beacon);
+
+		IP broadcast = { 255, 255, 255, 255 };
+		udp->beginPacket(broadcast, port);
+		udp->write(packet, FRAME_SYNC_PACKET_SIZE);
+		udp->endPacket();
+
+		quality.beaconsSent++;
+		quality.lastBeaconTime = now;
+	}
+
+	/*!
+		@brief		Reads the beacons that have been received and follows those that
+					are for the program that this server is running.  Beacons that arrive
+					out of order are ignored unless the master has not been heard from
+					for a while, in which case it may have been restarted.
+		@param		now		The current time.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::ReceiveBeacons(uint32_t now) {
+		for (uint8_t packetIndex = 0; packetIndex < FRAME_SYNC_MAX_PACKETS; packetIndex++) {
+			int packetSize = udp->parsePacket();
+			if (packetSize <= 0) {
+				return;
+			}
+
+			FrameSyncBeacon beacon;
+			if (!DecodeBeacon(packetSize, &beacon)) {
+				continue;
+			}
+
+			bool isInOrder = quality.beaconsReceived == 0
+				|| (int16_t)(beacon.sequence - sequence) > 0
+				|| now - quality.lastBeaconTime >= FRAME_SYNC_TIMEOUT;
+			if (!isInOrder
+				|| beacon.programId != programState->GetProgramId()) {
+				quality.beaconsIgnored++;
+				continue;
+			}
+
+			sequence = beacon.sequence;
+			FollowBeacon(&beacon, now);
+		}
+	}
+
+	/*!
+		@brief		Moves the frame clock of this server towards that of the master.  The
+					difference is measured in ms, from the frame and phase of each server, and
+					the timer is moved by at most FRAME_SYNC_MAX_SLEW ms.  If the servers are more
+					than FRAME_SYNC_SEEK_FRAMES apart then the program jumps to the master's frame
+					and the timer is moved into phase with the master straight away.
+		@param		beacon		A pointer to the beacon received from the master.
+		@param		now			The current time.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::FollowBeacon(FrameSyncBeacon* beacon, uint32_t now) {
+		quality.beaconsReceived++;
+		quality.lastBeaconTime = now;
+
+		int32_t interval = timer->GetInterval();
+		int32_t frameError = (int32_t)(beacon->frame - orchastor->GetProgramFrame());
+		int32_t maxSlew = FRAME_SYNC_MAX_SLEW;
+		if (frameError > FRAME_SYNC_SEEK_FRAMES
+			|| frameError < -FRAME_SYNC_SEEK_FRAMES) {
+			if (!orchastor->SeekProgram(beacon->frame)) {
+				return;
+			}
+			quality.seeks++;
+			frameError = (int32_t)(beacon->frame - orchastor->GetProgramFrame());
+			maxSlew = interval;
+		}
+
+		// the phase of the master in terms of this server's frame interval
+		int32_t masterPhase = beacon->interval == 0 ? 0 : (int32_t)beacon->phase * interval / beacon->interval;
+		int32_t error = frameError * interval + masterPhase - GetPhase();
+
+		quality.lastError = error;
+		uint32_t absoluteError = error < 0 ? -error : error;
+		if (absoluteError > 0xFFFF) {
+			absoluteError = 0xFFFF;
+		}
+		quality.averageError = (uint16_t)(((uint32_t)quality.averageError * 7 + absoluteError) / 8);
+
+		// behind the master so the next frame must be shown earlier, or later if ahead
+		int32_t slew = error > maxSlew ? maxSlew : (error < -maxSlew ? -maxSlew : error);
+		timer->Shift((int16_t)-slew);
+	}
+
+	/*!
+		@brief		Writes a beacon into the packet buffer.  Values are written
+					least significant byte first.
+		@param		beacon		A pointer to the beacon.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameClockSync::EncodeBeacon(FrameSyncBeacon* beacon) {
+		packet[0] = 'L';
+		packet[1] = 'S';
+		packet[2] = 'F';
+		packet[3] = FRAME_SYNC_VERSION;
+		for (uint8_t byteIndex = 0; byteIndex < 4; byteIndex++) {
+			packet[4 + byteIndex] = (uint8_t)(beacon->programId >> (byteIndex * 8));
+			packet[8 + byteIndex] = (uint8_t)(beacon->frame >> (byteIndex * 8));
+		}
+		packet[12] = (uint8_t)beacon->sequence;
+		packet[13] = (uint8_t)(beacon->sequence >> 8);
+		packet[14] = beacon->phase;
+		packet[15] = beacon->interval;
+	}
+
+	/*!
+		@brief		Reads a beacon that has been received.
+		@param		packetSize		The size of the packet that has been received.
+		@param		beacon			A pointer to the beacon that is read.
+		@returns	True if the packet is a beacon or false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FrameClockSync::DecodeBeacon(int packetSize, FrameSyncBeacon* beacon) {
+		if (packetSize != FRAME_SYNC_PACKET_SIZE
+			|| udp->read((char*)packet, FRAME_SYNC_PACKET_SIZE) != FRAME_SYNC_PACKET_SIZE
+			|| packet[0] != 'L'
+			|| packet[1] != 'S'
+			|| packet[2] != 'F'
+			|| packet[3] != FRAME_SYNC_VERSION) {
+			return false;
+		}
+
+		beacon->programId = 0;
+		beacon->frame = 0;
+		for (uint8_t byteIndex = 0; byteIndex < 4; byteIndex++) {
+			beacon->programId |= (uint32_t)packet[4 + byteIndex] << (byteIndex * 8);
+			beacon->frame |= (uint32_t)packet[8 + byteIndex] << (byteIndex * 8);
+		}
+		beacon->sequence = (uint16_t)(packet[12] | (packet[13] << 8));
+		beacon->phase = packet[14];
+		beacon->interval = packet[15];
+
+		return true;
+	}
+}
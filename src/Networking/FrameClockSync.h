@@ -0,0 +1,123 @@
+/*!
+ * @file FrameClockSync.h
+ *
+ * Keeps the rendering frames of several Light Servers
+ * that run the same program in step by broadcasting
+ * the frame clock of one server over UDP.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _FrameClockSync_h
+#define _FrameClockSync_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "IUdpService.h"
+#include "../Orchastrator/Timer.h"
+#include "../Orchastrator/IOrchastor.h"
+#include "../LPE/StateBuilder/LpState.h"
+
+#define		FRAME_SYNC_PACKET_SIZE			16		// bytes in a beacon
+#define		FRAME_SYNC_VERSION				1		// version of the beacon format
+#define		FRAME_SYNC_BEACON_INTERVAL		500		// ms between the beacons sent by the master
+#define		FRAME_SYNC_TIMEOUT				3000	// ms without a beacon before a follower is no longer locked
+#define		FRAME_SYNC_MAX_SLEW				2		// most ms a follower's frame clock is moved by each beacon
+#define		FRAME_SYNC_SEEK_FRAMES			4		// frames a follower can be out by before it jumps rather than slews
+#define		FRAME_SYNC_LOCKED_ERROR			5		// ms a follower can be out by and still be locked to the master
+#define		FRAME_SYNC_MAX_PACKETS			4		// most packets read on each call
+
+namespace LS {
+	/*!
+		@brief	The part that a server plays in keeping frame clocks in step.
+	*/
+	enum FrameSyncRole {
+		SyncOff,				// neither sends nor follows beacons
+		SyncMaster,				// sends beacons of its frame clock
+		SyncFollower			// disciplines its frame clock to the beacons it receives
+	};
+
+	/*!
+		@brief	The frame clock of the master as sent in a beacon.
+	*/
+	struct FrameSyncBeacon {
+		uint32_t programId = 0;			// identity of the program the master is running
+		uint32_t frame = 0;				// rendering frames shown since the program started
+		uint16_t sequence = 0;			// incremented with each beacon
+		uint8_t phase = 0;				// ms since the current frame was shown
+		uint8_t interval = 0;			// ms between rendering frames
+	};
+
+	/*!
+		@brief	How closely a follower is following the master (or,
+				for the master, how many beacons it has sent).
+	*/
+	struct FrameSyncQuality {
+		uint32_t beaconsSent = 0;
+		uint32_t beaconsReceived = 0;
+		uint32_t beaconsIgnored = 0;		// received for a different program or out of order
+		uint32_t seeks = 0;					// times the follower jumped to the master's frame
+		int32_t lastError = 0;				// ms the follower was behind (+) or ahead (-) of the master at the last beacon
+		uint16_t averageError = 0;			// moving average of the size of the error (ms)
+		uint32_t lastBeaconTime = 0;		// time the last beacon was sent or received
+	};
+
+	/*!
+		@brief	Keeps the frame clocks of Light Servers that run the same
+				program in step.  The master broadcasts a compact beacon of its
+				frame clock (program identity, frame and phase within the frame)
+				every FRAME_SYNC_BEACON_INTERVAL ms.  Followers compare each beacon
+				with their own frame clock and move the next time their timer fires
+				by at most FRAME_SYNC_MAX_SLEW ms towards the master, so that the
+				correction is never visible, unless they are more than
+				FRAME_SYNC_SEEK_FRAMES frames out in which case they jump straight
+				to the master's frame.  Beacons for a different program are ignored.
+				All networking goes through IUdpService so the protocol can be run
+				against any UDP implementation.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class FrameClockSync {
+	private:
+		uint16_t port;
+		IUdpService* udp;
+		Timer* timer;
+		IOrchastor* orchastor;
+		LpState* programState;
+
+		FrameSyncRole role = FrameSyncRole::SyncOff;
+		uint8_t packet[FRAME_SYNC_PACKET_SIZE];
+		uint16_t sequence = 0;				// sequence of the last beacon sent or received
+		FrameSyncQuality quality;
+
+	protected:
+		uint8_t GetPhase();
+		void SendBeacon(uint32_t now);
+		void ReceiveBeacons(uint32_t now);
+		void FollowBeacon(FrameSyncBeacon* beacon, uint32_t now);
+		void EncodeBeacon(FrameSyncBeacon* beacon);
+		bool DecodeBeacon(int packetSize, FrameSyncBeacon* beacon);
+
+	public:
+		FrameClockSync(uint16_t port, IUdpService* udp, Timer* timer, IOrchastor* orchastor, LpState* programState);
+
+		void Start();
+		void Execute();
+		void SetRole(FrameSyncRole role);
+		FrameSyncRole GetRole();
+		bool IsLocked();
+		FrameSyncQuality* GetQuality();
+		uint32_t GetTimeSinceLastBeacon();
+	};
+}
+
+#endif
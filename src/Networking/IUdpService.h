@@ -7,6 +7,7 @@
 #include "../WProgram.h"
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 
 namespace LS {
@@ -26,6 +27,7 @@ namespace LS {
 		virtual IP remoteIP() = 0;
 		virtual uint16_t remotePort() = 0;
 		virtual size_t write(const char* str) = 0;
+		virtual size_t write(const uint8_t* buffer, size_t size) = 0;
 		virtual int endPacket() = 0;
 	};
 
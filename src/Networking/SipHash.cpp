@@ -0,0 +1,132 @@
+#include "SipHash.h"
+
+#define ROTATE_LEFT(x, b)	(((x) << (b)) | ((x) >> (64 - (b))))
+
+namespace LS {
+	/*!
+		@brief		Reads a little endian 64-bit word.
+		@param		bytes		A pointer to the first of 8 bytes.
+		@returns	The word.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint64_t SipHash::ReadWord(const uint8_t* bytes) {
+		uint64_t word = 0;
+		for (uint8_t byteIndex = 0; byteIndex < 8; byteIndex++) {
+			word |= (uint64_t)bytes[byteIndex] << (byteIndex * 8);
+		}
+
+		return word;
+	}
+
+	/*!
+		@brief		Carries out a single SipRound on the state.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SipHash::Round() {
+		v0 += v1; v1 = ROTATE_LEFT(v1, 13); v1 ^= v0; v0 = ROTATE_LEFT(v0, 32);
+		v2 += v3; v3 = ROTATE_LEFT(v3, 16); v3 ^= v2;
+		v0 += v3; v3 = ROTATE_LEFT(v3, 21); v3 ^= v0;
+		v2 += v1; v1 = ROTATE_LEFT(v1, 17); v1 ^= v2; v2 = ROTATE_LEFT(v2, 32);
+	}
+
+	/*!
+		@brief		Mixes a word of the message into the state (2 compression rounds).
+		@param		word		The word of the message.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SipHash::Compress(uint64_t word) {
+		v3 ^= word;
+		Round();
+		Round();
+		v0 ^= word;
+	}
+
+	/*!
+		@brief		Starts calculating the tag of a new message.
+		@param		key		A pointer to the SIPHASH_KEY_SIZE bytes of the key.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SipHash::Begin(const uint8_t* key) {
+		uint64_t k0 = ReadWord(key);
+		uint64_t k1 = ReadWord(&key[8]);
+
+		v0 = k0 ^ 0x736f6d6570736575ULL;
+		v1 = k1 ^ 0x646f72616e646f6dULL;
+		v2 = k0 ^ 0x6c7967656e657261ULL;
+		v3 = k1 ^ 0x7465646279746573ULL;
+		tail = 0;
+		length = 0;
+	}
+
+	/*!
+		@brief		Feeds the next part of the message.
+		@param		data		A pointer to the part of the message.
+		@param		size		The number of bytes.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SipHash::Update(const uint8_t* data, size_t size) {
+		for (size_t byteIndex = 0; byteIndex < size; byteIndex++) {
+			tail |= (uint64_t)data[byteIndex] << ((length % 8) * 8);
+			length++;
+			if (length % 8 == 0) {
+				Compress(tail);
+				tail = 0;
+			}
+		}
+	}
+
+	/*!
+		@brief		Finishes the message and gets its tag.
+		@returns	The tag.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint64_t SipHash::End() {
+		Compress(tail | ((uint64_t)(length & 0xFF) << 56));
+
+		v2 ^= 0xFF;
+		Round();
+		Round();
+		Round();
+		Round();
+
+		return v0 ^ v1 ^ v2 ^ v3;
+	}
+
+	/*!
+		@brief		Writes a tag as little endian bytes.
+		@param		tag			The tag.
+		@param		bytes		A pointer to the SIPHASH_TAG_SIZE bytes written.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void SipHash::WriteTag(uint64_t tag, uint8_t* bytes) {
+		for (uint8_t byteIndex = 0; byteIndex < SIPHASH_TAG_SIZE; byteIndex++) {
+			bytes[byteIndex] = (uint8_t)(tag >> (byteIndex * 8));
+		}
+	}
+
+	/*!
+		@brief		Compares a tag with the tag held in bytes without stopping at the
+					first difference, so the time taken does not give away how much
+					of a forged tag was correct.
+		@param		tag			The tag that was calculated.
+		@param		bytes		A pointer to the SIPHASH_TAG_SIZE bytes of the tag received.
+		@returns	True if the tags are the same, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool SipHash::IsTag(uint64_t tag, const uint8_t* bytes) {
+		uint8_t difference = 0;
+		for (uint8_t byteIndex = 0; byteIndex < SIPHASH_TAG_SIZE; byteIndex++) {
+			difference |= bytes[byteIndex] ^ (uint8_t)(tag >> (byteIndex * 8));
+		}
+
+		return difference == 0;
+	}
+}
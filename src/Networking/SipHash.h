@@ -0,0 +1,58 @@
+/*!
+ * @file SipHash.h
+ *
+ * SipHash-2-4: a keyed hash used to authenticate
+ * short messages with a pre-shared key.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _SipHash_h
+#define _SipHash_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define		SIPHASH_KEY_SIZE				16		// bytes in a key
+#define		SIPHASH_TAG_SIZE				8		// bytes in a tag
+
+namespace LS {
+	/*!
+		@brief	Calculates the SipHash-2-4 tag of a message, which is fed in one or
+				more parts, using a 128-bit key.  SipHash is a message authentication
+				code designed for short messages that is cheap enough to calculate
+				on a microcontroller for every packet received.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class SipHash {
+	private:
+		uint64_t v0, v1, v2, v3;
+		uint64_t tail = 0;				// bytes not yet making up a whole 8-byte word
+		uint32_t length = 0;			// bytes fed in so far
+
+		static uint64_t ReadWord(const uint8_t* bytes);
+		void Round();
+		void Compress(uint64_t word);
+
+	public:
+		void Begin(const uint8_t* key);
+		void Update(const uint8_t* data, size_t size);
+		uint64_t End();
+
+		static void WriteTag(uint64_t tag, uint8_t* bytes);
+		static bool IsTag(uint64_t tag, const uint8_t* bytes);
+	};
+}
+
+#endif
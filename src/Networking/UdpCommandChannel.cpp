@@ -0,0 +1,358 @@
+#include "UdpCommandChannel.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects the dependencies.
+		@param		port		The port that command packets are received on.
+		@param		udp			A pointer to the UDP service used to receive commands and send acks.
+		@param		webServer	A pointer to the Restful interface that commands are otherwise received on.
+		@param		key			A pointer to the SIPHASH_KEY_SIZE bytes of the key shared with the clients.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	UdpCommandChannel::UdpCommandChannel(uint16_t port, IUdpService* udp, ILightWebServer* webServer, const uint8_t* key) {
+		this->port = port;
+		this->udp = udp;
+		this->webServer = webServer;
+		this->key = key;
+
+		for (uint8_t clientIndex = 0; clientIndex < UDP_COMMAND_MAX_CLIENTS; clientIndex++) {
+			lastSequences[clientIndex] = 0;
+		}
+	}
+
+	/*!
+		@brief		Starts listening for command packets.
+		@param		sessionId	An id that differs each time the server starts (e.g. from a random
+								source) so that packets from a previous session are refused.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void UdpCommandChannel::Start(uint32_t sessionId) {
+		this->sessionId = sessionId;
+		udp->begin(port);
+	}
+
+	/*!
+		@brief		Gets the counts of the command packets received.
+		@returns	A pointer to the counts.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	UdpCommandStatistics* UdpCommandChannel::GetStatistics() {
+		return &statistics;
+	}
+
+	/*!
+		@brief		Reads a little endian 32-bit value.
+		@param		bytes		A pointer to the first of 4 bytes.
+		@returns	The value.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t UdpCommandChannel::ReadLong(const uint8_t* bytes) {
+		return (uint32_t)bytes[0]
+			| ((uint32_t)bytes[1] << 8)
+			| ((uint32_t)bytes[2] << 16)
+			| ((uint32_t)bytes[3] << 24);
+	}
+
+	/*!
+		@brief		Writes a little endian 32-bit value.
+		@param		value		The value.
+		@param		bytes		A pointer to the first of 4 bytes written.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void UdpCommandChannel::WriteLong(uint32_t value, uint8_t* bytes) {
+		for (uint8_t byteIndex = 0; byteIndex < 4; byteIndex++) {
+			bytes[byteIndex] = (uint8_t)(value >> (byteIndex * 8));
+		}
+	}
+
+	/*!
+		@brief		Reads the next command packet, if any, and checks that it comes from a
+					client that holds the key, is for the current session and has not been
+					executed before.  The body of the command is copied into the loading buffer
+					once the tag of the packet has been checked and the command is to be executed.
+		@returns	The type of command to execute or NONE if there is no command to execute
+					(any ack that is due has already been sent).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CommandType UdpCommandChannel::ReceiveCommand() {
+		int packetSize = udp->parsePacket();
+		if (packetSize <= 0) {
+			return CommandType::NONE;
+		}
+
+		statistics.packetsReceived++;
+
+		if (packetSize < UDP_COMMAND_HEADER_SIZE + SIPHASH_TAG_SIZE
+			|| udp->read((char*)header, UDP_COMMAND_HEADER_SIZE) != UDP_COMMAND_HEADER_SIZE) {
+			statistics.packetsRejected++;
+			return CommandType::NONE;
+		}
+
+		// the body is read into the channel's own buffer: it is only copied to the loading
+		// buffer, as for a HTTP request, once the packet is known to come from a client that
+		// holds the key so that a forged packet cannot overwrite a program that is being loaded
+		FixedSizeCharBuffer* loadingBuffer = webServer->GetLoadingFixedSizeBuffer();
+		uint16_t bodyLength = (uint16_t)(header[14] | (header[15] << 8));
+		if (header[0] != 'L'
+			|| header[1] != 'S'
+			|| header[2] != 'C'
+			|| header[3] != UDP_COMMAND_VERSION
+			|| packetSize != UDP_COMMAND_HEADER_SIZE + bodyLength + SIPHASH_TAG_SIZE
+			|| bodyLength > UDP_COMMAND_MAX_BODY
+			|| bodyLength >= loadingBuffer->GetBufferSize()
+			|| udp->read((char*)body, bodyLength) != bodyLength
+			|| udp->read((char*)tag, SIPHASH_TAG_SIZE) != SIPHASH_TAG_SIZE) {
+			statistics.packetsRejected++;
+			return CommandType::NONE;
+		}
+
+		sipHash.Begin(key);
+		sipHash.Update(header, UDP_COMMAND_HEADER_SIZE);
+		sipHash.Update(body, bodyLength);
+		if (!SipHash::IsTag(sipHash.End(), tag)) {
+			// not from a client that holds the key so do not give anything away by acknowledging
+			statistics.packetsRejected++;
+			return CommandType::NONE;
+		}
+
+		isUdpCommand = true;
+		clientId = header[4];
+		sequence = ReadLong(&header[10]);
+		remoteIp = udp->remoteIP();
+		remotePort = udp->remotePort();
+
+		if (clientId >= UDP_COMMAND_MAX_CLIENTS) {
+			BeginAck(UdpCommandStatus::UdpAckInvalid);
+			SendAck();
+			return CommandType::NONE;
+		}
+
+		if (ReadLong(&header[6]) != sessionId) {
+			BeginAck(UdpCommandStatus::UdpAckSession);
+			SendAck();
+			return CommandType::NONE;
+		}
+
+		uint32_t lastSequence = lastSequences[clientId];
+		if (sequence == lastSequence
+			&& sequence != 0) {
+			// the command has already been executed: its ack was probably lost
+			statistics.duplicates++;
+			if (isAckSent
+				&& ack[4] == clientId
+				&& ReadLong(&ack[10]) == sequence) {
+				udp->beginPacket(remoteIp, remotePort);
+				udp->write(ack, UDP_COMMAND_HEADER_SIZE + ackBodyLength + SIPHASH_TAG_SIZE);
+				udp->endPacket();
+			}
+			else {
+				BeginAck(UdpCommandStatus::UdpAckDuplicate);
+				SendAck();
+			}
+			isUdpCommand = false;
+			return CommandType::NONE;
+		}
+
+		if (sequence < lastSequence
+			|| sequence == 0) {
+			statistics.packetsReplayed++;
+			isUdpCommand = false;
+			return CommandType::NONE;
+		}
+
+		lastSequences[clientId] = sequence;
+
+		CommandType commandType = (CommandType)header[5];
+		if (commandType <= CommandType::INVALID
+			|| commandType >= CommandType::COMMANDTYPE_COUNT) {
+			// INVALID is executed, and acknowledged, like an invalid HTTP request
+			commandType = CommandType::INVALID;
+		}
+
+		// only a command that is to be executed replaces what is in the loading buffer
+		char* loadingBody = webServer->GetLoadingBuffer(true);
+		for (uint16_t byteIndex = 0; byteIndex < bodyLength; byteIndex++) {
+			loadingBody[byteIndex] = (char)body[byteIndex];
+		}
+		loadingBody[bodyLength] = '\0';
+
+		statistics.commandsExecuted++;
+		isAckSent = false;
+		webServer->SetCommandType(commandType);
+
+		return commandType;
+	}
+
+	/*!
+		@brief		Starts the ack of the current command.
+		@param		status		The outcome of the command.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void UdpCommandChannel::BeginAck(UdpCommandStatus status) {
+		ack[0] = 'L';
+		ack[1] = 'S';
+		ack[2] = 'A';
+		ack[3] = UDP_COMMAND_VERSION;
+		ack[4] = clientId;
+		ack[5] = (uint8_t)status;
+		WriteLong(sessionId, &ack[6]);
+		WriteLong(sequence, &ack[10]);
+		ackBodyLength = 0;
+	}
+
+	/*!
+		@brief		Adds text to the body of the ack.  Text that does not fit is cut off.
+		@param		str		A pointer to the text.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void UdpCommandChannel::WriteAck(const char* str) {
+		if (str == nullptr) {
+			return;
+		}
+
+		while (*str != '\0'
+			&& ackBodyLength < UDP_COMMAND_MAX_ACK_BODY) {
+			ack[UDP_COMMAND_HEADER_SIZE + ackBodyLength++] = *str++;
+		}
+	}
+
+	/*!
+		@brief		Tags the ack and sends it to the client that sent the current command.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void UdpCommandChannel::SendAck() {
+		ack[14] = (uint8_t)ackBodyLength;
+		ack[15] = (uint8_t)(ackBodyLength >> 8);
+
+		sipHash.Begin(key);
+		sipHash.Update(ack, UDP_COMMAND_HEADER_SIZE + ackBodyLength);
+		SipHash::WriteTag(sipHash.End(), &ack[UDP_COMMAND_HEADER_SIZE + ackBodyLength]);
+
+		udp->beginPacket(remoteIp, remotePort);
+		udp->write(ack, UDP_COMMAND_HEADER_SIZE + ackBodyLength + SIPHASH_TAG_SIZE);
+		udp->endPacket();
+
+		isAckSent = true;
+		isUdpCommand = false;
+	}
+
+	/*!
+		@brief		Checks for a command packet and otherwise for a HTTP request.
+		@returns	The type of command that has been received (if any).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CommandType UdpCommandChannel::HandleNextCommand() {
+		CommandType commandType = HandleNextQuickCommand();
+		if (commandType != CommandType::NONE) {
+			return commandType;
+		}
+
+		return webServer->HandleNextCommand();
+	}
+
+	/*!
+		@brief		Checks for a command packet only, which is cheap enough to do between
+					rendering frames.
+		@returns	The type of command that has been received (if any).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CommandType UdpCommandChannel::HandleNextQuickCommand() {
+		isUdpCommand = false;
+		return ReceiveCommand();
+	}
+
+	void UdpCommandChannel::SetCommandType(CommandType commandType) {
+		webServer->SetCommandType(commandType);
+	}
+
+	char* UdpCommandChannel::GetLoadingBuffer(bool clearBuffer) {
+		return webServer->GetLoadingBuffer(clearBuffer);
+	}
+
+	FixedSizeCharBuffer* UdpCommandChannel::GetLoadingFixedSizeBuffer() {
+		return webServer->GetLoadingFixedSizeBuffer();
+	}
+
+	const char* UdpCommandChannel::GetAuthCredentials() {
+		return webServer->GetAuthCredentials();
+	}
+
+	void UdpCommandChannel::RespondError() {
+		if (!isUdpCommand) {
+			webServer->RespondError();
+			return;
+		}
+
+		BeginAck(UdpCommandStatus::UdpAckError);
+		SendAck();
+	}
+
+	void UdpCommandChannel::RespondNotAuthorised() {
+		if (!isUdpCommand) {
+			webServer->RespondNotAuthorised();
+			return;
+		}
+
+		BeginAck(UdpCommandStatus::UdpAckNotAuthorised);
+		SendAck();
+	}
+
+	void UdpCommandChannel::RespondNoContent() {
+		if (!isUdpCommand) {
+			webServer->RespondNoContent();
+			return;
+		}
+
+		BeginAck(UdpCommandStatus::UdpAckNoContent);
+		SendAck();
+	}
+
+	void UdpCommandChannel::RespondOK(const char* str) {
+		if (!isUdpCommand) {
+			webServer->RespondOK(str);
+			return;
+		}
+
+		BeginAck(UdpCommandStatus::UdpAckOK);
+		WriteAck(str);
+		SendAck();
+	}
+
+	void UdpCommandChannel::StartResponseOK() {
+		if (!isUdpCommand) {
+			webServer->StartResponseOK();
+			return;
+		}
+
+		BeginAck(UdpCommandStatus::UdpAckOK);
+	}
+
+	void UdpCommandChannel::WriteResponse(const char* str) {
+		if (!isUdpCommand) {
+			webServer->WriteResponse(str);
+			return;
+		}
+
+		WriteAck(str);
+	}
+
+	void UdpCommandChannel::EndResponse() {
+		if (!isUdpCommand) {
+			webServer->EndResponse();
+			return;
+		}
+
+		SendAck();
+	}
+}
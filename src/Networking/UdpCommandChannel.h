@@ -0,0 +1,148 @@
+/*!
+ * @file UdpCommandChannel.h
+ *
+ * Receives authenticated commands in compact UDP packets
+ * and acknowledges them, alongside the Restful interface.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _UdpCommandChannel_h
+#define _UdpCommandChannel_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "IUdpService.h"
+#include "SipHash.h"
+#include "../DomainInterfaces.h"
+#include "../FixedSizeCharBuffer.h"
+
+#define		UDP_COMMAND_VERSION				1		// version of the packet format
+#define		UDP_COMMAND_HEADER_SIZE			16		// bytes in the header of a command or an ack
+#define		UDP_COMMAND_MAX_CLIENTS			8		// clients (ids 0 - 7) whose sequence numbers are tracked
+#define		UDP_COMMAND_MAX_BODY			256		// most bytes of the body of a command (longer commands are rejected)
+#define		UDP_COMMAND_MAX_ACK_BODY		128		// most bytes of a response body carried by an ack (the rest is cut off)
+#define		UDP_COMMAND_ACK_SIZE			(UDP_COMMAND_HEADER_SIZE + UDP_COMMAND_MAX_ACK_BODY + SIPHASH_TAG_SIZE)
+
+namespace LS {
+	/*!
+		@brief	The outcome of a command carried by an ack.
+	*/
+	enum UdpCommandStatus {
+		UdpAckOK,					// executed, the body of the ack is the body of the response
+		UdpAckNoContent,			// executed, no body
+		UdpAckError,				// the command failed (e.g. an invalid body)
+		UdpAckNotAuthorised,
+		UdpAckInvalid,				// not a command or the client id is out of range
+		UdpAckSession,				// the session id is not current, the ack carries the current session id
+		UdpAckDuplicate				// the sequence number has already been executed
+	};
+
+	/*!
+		@brief	Counts of the command packets received.
+	*/
+	struct UdpCommandStatistics {
+		uint32_t packetsReceived = 0;
+		uint32_t packetsRejected = 0;		// malformed or the tag is not valid for the key
+		uint32_t packetsReplayed = 0;		// sequence number older than the last executed
+		uint32_t duplicates = 0;			// sequence number already executed, ack sent again
+		uint32_t commandsExecuted = 0;
+	};
+
+	/*!
+		@brief	Lets commands be sent to the server as single UDP packets, rather than
+				HTTP requests, so that control operations (e.g. POWEROFF) take a few
+				milliseconds rather than hundreds.  The channel wraps the Restful interface:
+				commands are dispatched through the same CommandFactory / ICommand classes
+				and it is the channel that is given to the commands and the orchastrator
+				so that a response goes back to wherever the command came from.  Over UDP
+				the response is an ack holding the outcome of the command and the start of
+				any response body.
+
+				A command packet is:
+				'L' 'S' 'C' version
+				client id (0 - UDP_COMMAND_MAX_CLIENTS - 1)
+				command type (CommandType value, e.g. 5 = POWEROFF)
+				session id (4 bytes, little endian)
+				sequence (4 bytes, little endian, starts from 1)
+				body length (2 bytes, little endian, at most UDP_COMMAND_MAX_BODY)
+				body (as the body of the HTTP request)
+				tag (8 bytes): SipHash-2-4 of all of the above with the pre-shared key
+
+				An ack has the same layout, starting 'L' 'S' 'A', with the status
+				(UdpCommandStatus) in place of the command type.  Acks are tagged with
+				the same key.  Packets with an invalid tag are not acknowledged.
+
+				Each client's sequence must increase with each new command so a command
+				is never executed twice: a command that is sent again (e.g. its ack was lost)
+				has its ack sent again and older commands are ignored.  The session id
+				changes each time the server starts so that commands captured before
+				then cannot be replayed; a client learns the current session id from the
+				UdpAckSession ack to its first command.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class UdpCommandChannel : public ILightWebServer {
+	private:
+		uint16_t port;
+		IUdpService* udp;
+		ILightWebServer* webServer;
+		const uint8_t* key;
+		uint32_t sessionId = 0;
+		uint32_t lastSequences[UDP_COMMAND_MAX_CLIENTS];
+
+		SipHash sipHash;
+		uint8_t header[UDP_COMMAND_HEADER_SIZE];
+		uint8_t body[UDP_COMMAND_MAX_BODY];			// the body is only copied to the loading buffer once its tag is checked
+		uint8_t tag[SIPHASH_TAG_SIZE];
+		uint8_t ack[UDP_COMMAND_ACK_SIZE];
+		uint16_t ackBodyLength = 0;
+		bool isAckSent = true;				// whether the ack of the last command has been sent
+
+		bool isUdpCommand = false;			// whether the current command was received over UDP
+		uint8_t clientId = 0;
+		uint32_t sequence = 0;
+		IP remoteIp;
+		uint16_t remotePort = 0;
+		UdpCommandStatistics statistics;
+
+	protected:
+		CommandType ReceiveCommand();
+		void BeginAck(UdpCommandStatus status);
+		void WriteAck(const char* str);
+		void SendAck();
+		static uint32_t ReadLong(const uint8_t* bytes);
+		static void WriteLong(uint32_t value, uint8_t* bytes);
+
+	public:
+		UdpCommandChannel(uint16_t port, IUdpService* udp, ILightWebServer* webServer, const uint8_t* key);
+
+		void Start(uint32_t sessionId);
+		UdpCommandStatistics* GetStatistics();
+
+		void SetCommandType(CommandType commandType);
+		char* GetLoadingBuffer(bool clearBuffer = true);
+		FixedSizeCharBuffer* GetLoadingFixedSizeBuffer();
+		const char* GetAuthCredentials();
+		void RespondError();
+		void RespondNotAuthorised();
+		void RespondNoContent();
+		void RespondOK(const char* str = nullptr);
+		void StartResponseOK();
+		void WriteResponse(const char* str);
+		void EndResponse();
+		CommandType HandleNextCommand();
+		CommandType HandleNextQuickCommand();
+	};
+}
+
+#endif
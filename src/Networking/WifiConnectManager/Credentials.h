@@ -106,5 +106,10 @@ WiFiNINA_Configuration defaultConfig;
 
 /////////// End Default Config Data /////////////
 
+// *** Enter the key of the UDP command channel here (16 bytes) ***
+// The key must be shared with the clients that send commands over UDP
+// and should be changed from this default.
+const uint8_t udpCommandKey[16] = { 0x4C, 0x53, 0x2D, 0x55, 0x44, 0x50, 0x2D, 0x43, 0x4F, 0x4D, 0x4D, 0x41, 0x4E, 0x44, 0x53, 0x21 };
+
 
 #endif    //Credentials_h
\ No newline at end of file
@@ -21,6 +21,18 @@ namespace LS {
 			return millis();
 		}
 	public:
+		/*!
+			@brief		Waits for the next interrupt (at least the 1ms system tick
+						that drives millis()) with the processor halted.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		virtual void Idle() {
+#if defined(ARDUINO_ARCH_SAMD)
+			__WFI();
+#endif
+		}
+
 		ArduinoTimer(uint8_t interval = 50) 
 			: Timer(interval) {
 			// we need to initialise the first interval or otherwise the timer
@@ -0,0 +1,170 @@
+#include "FrameGovernor.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor sets the interval that the governor will return
+					to when execution cycles are within budget.
+		@param		baseInterval	The normal rendering frame interval in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FrameGovernor::FrameGovernor(uint8_t baseInterval) {
+		this->baseInterval = baseInterval;
+		this->interval = baseInterval;
+	}
+
+	/*!
+		@brief		Sets the policy that determines how the governor reacts to
+					cycles that exceed the frame budget.  The effective interval
+					is returned to the base interval.
+		@param		policy		A pointer to the new policy which is copied.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameGovernor::SetPolicy(FrameGovernorPolicy* policy) {
+		if (policy == nullptr) {
+			return;
+		}
+
+		this->policy = *policy;
+		interval = baseInterval;
+		framesWithinBudget = 0;
+		consecutiveShedFrames = 0;
+		shedNetwork = false;
+	}
+
+	/*!
+		@brief		Gets the policy that the governor is currently applying.
+		@returns	A pointer to the policy.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FrameGovernorPolicy* FrameGovernor::GetPolicy() {
+		return &policy;
+	}
+
+	/*!
+		@brief		Records the time taken by an execution cycle and decides on the
+					interval and the network work for the next cycle.  A cycle is
+					measured against the allowance at the current interval, which is
+					the frame budget plus however far the interval has been stretched:
+						1. a cycle over the allowance stretches the interval by one step (up to the maximum)
+						   and sheds network work on the next cycle (up to the maximum number of
+						   consecutive cycles so that commands are never starved).
+						2. a run of consecutive cycles that would also fit the allowance one step
+						   shorter shrinks the interval by one step back towards the base interval.
+						   Cycles that fit the current allowance but not the shorter one hold the
+						   interval where it is.
+		@param		frameTime	The time, in milliseconds, taken by the cycle.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameGovernor::RecordFrame(uint32_t frameTime) {
+		lastFrameTime = frameTime > 0xFFFF ? 0xFFFF : (uint16_t)frameTime;
+		if (lastFrameTime > peakFrameTime) {
+			peakFrameTime = lastFrameTime;
+		}
+
+		if (!policy.enabled) {
+			interval = baseInterval;
+			shedNetwork = false;
+			return;
+		}
+
+		uint16_t allowance = GetFrameBudget() + (interval - baseInterval);
+		if (frameTime > allowance) {
+			overruns++;
+			framesWithinBudget = 0;
+
+			uint16_t stretchedInterval = interval + policy.intervalStep;
+			interval = stretchedInterval > policy.maxInterval ? policy.maxInterval : stretchedInterval;
+			if (interval < baseInterval) {
+				interval = baseInterval;
+			}
+
+			shedNetwork = policy.shedMode != GovernorShedMode::ShedNothing
+				&& consecutiveShedFrames < policy.maxShedFrames;
+		}
+		else {
+			shedNetwork = false;
+
+			if (interval <= baseInterval
+				|| frameTime + policy.intervalStep > allowance) {
+				framesWithinBudget = 0;
+			}
+			else if (++framesWithinBudget >= policy.recoveryFrames) {
+				framesWithinBudget = 0;
+				interval = interval - baseInterval > policy.intervalStep ? interval - policy.intervalStep : baseInterval;
+			}
+		}
+
+		if (shedNetwork) {
+			consecutiveShedFrames++;
+			shedFrames++;
+		}
+		else {
+			consecutiveShedFrames = 0;
+		}
+	}
+
+	/*!
+		@brief		Records that a received command has been held over to a
+					later cycle.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameGovernor::RecordDeferredCommand() {
+		deferredCommands++;
+	}
+
+	/*!
+		@brief		Resets the statistics that are reported via the status API.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FrameGovernor::ResetStatistics() {
+		lastFrameTime = peakFrameTime = 0;
+		overruns = shedFrames = deferredCommands = 0;
+	}
+
+	/*!
+		@brief		Gets the effective rendering frame interval.
+		@returns	The interval in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t FrameGovernor::GetInterval() {
+		return interval;
+	}
+
+	/*!
+		@brief		Gets the time an execution cycle may take before it is
+					treated as an overrun.
+		@returns	The frame budget in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t FrameGovernor::GetFrameBudget() {
+		return policy.frameBudget == 0 ? baseInterval : policy.frameBudget;
+	}
+
+	/*!
+		@brief		Gets whether network work should be shed on the next cycle.
+		@returns	True if network work should be shed, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FrameGovernor::IsSheddingNetwork() {
+		return shedNetwork;
+	}
+
+	/*!
+		@brief		Gets how network work is shed.
+		@returns	The shed mode of the current policy.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	GovernorShedMode FrameGovernor::GetShedMode() {
+		return policy.shedMode;
+	}
+}
@@ -0,0 +1,97 @@
+/*!
+ * @file FrameGovernor.h
+ *
+ * Adapts the rendering frame rate and the amount of
+ * network work carried out on each execution cycle
+ * according to how long previous cycles have taken.
+ *
+ *
+ * Written by Kevin White.
+ *
+ * This file is part of the LS library.
+ *
+ */
+
+#ifndef _FrameGovernor_h
+#define _FrameGovernor_h
+
+#include <stdint.h>
+
+#define		GOVERNOR_DEFAULT_MAX_INTERVAL		100		// longest frame interval (ms) the governor will stretch to
+#define		GOVERNOR_DEFAULT_INTERVAL_STEP		5		// ms added to / removed from the interval on each adjustment
+#define		GOVERNOR_DEFAULT_RECOVERY_FRAMES	40		// frames within budget before the interval is reduced again
+#define		GOVERNOR_DEFAULT_MAX_SHED_FRAMES	4		// most consecutive cycles that network work can be shed
+
+namespace LS {
+	/*!
+		@brief	The action taken with network work on a cycle that
+				follows a cycle that exceeded the frame budget.
+	*/
+	enum GovernorShedMode {
+		ShedNothing,			// always poll and execute commands
+		ShedDeferCommands,		// poll for commands but execute them on a later cycle
+		ShedSkipPolling			// do not poll for commands at all
+	};
+
+	/*!
+		@brief	Policy that determines how the governor reacts
+				to execution cycles that exceed the frame budget.
+	*/
+	struct FrameGovernorPolicy {
+		bool enabled = true;
+		uint8_t frameBudget = 0;									// ms a cycle may take (0 = the base interval)
+		uint8_t maxInterval = GOVERNOR_DEFAULT_MAX_INTERVAL;
+		uint8_t intervalStep = GOVERNOR_DEFAULT_INTERVAL_STEP;
+		uint8_t recoveryFrames = GOVERNOR_DEFAULT_RECOVERY_FRAMES;
+		uint8_t maxShedFrames = GOVERNOR_DEFAULT_MAX_SHED_FRAMES;
+		GovernorShedMode shedMode = GovernorShedMode::ShedDeferCommands;
+	};
+
+	/*!
+		@brief	Measures the time taken by each execution cycle and decides
+				on the effective frame interval and whether network work should
+				be shed on the next cycle.  The governor only makes decisions, it
+				is up to the orchastrator to act on them.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class FrameGovernor {
+	private:
+		FrameGovernorPolicy policy;
+		uint8_t baseInterval;
+		uint8_t interval;
+		uint8_t framesWithinBudget = 0;							// consecutive cycles that would fit a shorter interval
+		uint8_t consecutiveShedFrames = 0;
+		bool shedNetwork = false;
+
+		// statistics reported via the status API
+		uint16_t lastFrameTime = 0;
+		uint16_t peakFrameTime = 0;
+		uint32_t overruns = 0;
+		uint32_t shedFrames = 0;
+		uint32_t deferredCommands = 0;
+
+	public:
+		FrameGovernor(uint8_t baseInterval);
+
+		void SetPolicy(FrameGovernorPolicy* policy);
+		FrameGovernorPolicy* GetPolicy();
+
+		void RecordFrame(uint32_t frameTime);
+		void RecordDeferredCommand();
+		void ResetStatistics();
+
+		uint8_t GetInterval();
+		uint8_t GetFrameBudget();
+		bool IsSheddingNetwork();
+		GovernorShedMode GetShedMode();
+
+		uint16_t GetLastFrameTime() { return lastFrameTime; }
+		uint16_t GetPeakFrameTime() { return peakFrameTime; }
+		uint32_t GetOverruns() { return overruns; }
+		uint32_t GetShedFrames() { return shedFrames; }
+		uint32_t GetDeferredCommands() { return deferredCommands; }
+	};
+}
+
+#endif
@@ -1,6 +1,9 @@
 #ifndef _Orchastor_H
 #define _Orchastor_H
 
+#include <stdint.h>
+#include "../Renderer/LayerCompositor.h"
+
 namespace LS {
 	/*!
 	@brief  Interface that defines the contract for a class that acts as the
@@ -12,6 +15,14 @@ namespace LS {
 	{
 	public:
 		virtual void StopPrograms() = 0;
+		virtual bool SeekProgram(uint32_t frame) = 0;
+		virtual uint32_t GetProgramFrame() = 0;
+		virtual void PreemptPrograms() = 0;
+		virtual void ResumePrograms() = 0;
+		virtual bool SetLayerBlend(uint8_t layer, BlendMode blendMode, uint8_t alpha) = 0;
+		virtual bool StopLayer(uint8_t layer) = 0;
+		virtual bool StopSegment(uint8_t segment) = 0;
+		virtual void StopSegments() = 0;
 
 		virtual void Start() = 0;
 		virtual void Stop() = 0;
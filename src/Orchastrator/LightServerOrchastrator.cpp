@@ -38,6 +38,628 @@ namespace LS {
 		// resetting an LP state effectively 'stops' the program as there are no further
 		// instructions to be executed as the state is cleared.
 		primaryLpState->reset();
+
+		// the programs of the layers are stopped too
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			layers[layerIndex].lpState->reset();
+			layers[layerIndex].output->Reset();
+		}
+		if (layerCompositor != nullptr) {
+			layerCompositor->Clear();
+		}
+		layersChanged = false;
+
+		// as are the programs of the segments
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			segments[segmentIndex].lpState->reset();
+		}
+	}
+
+	/*!
+		@brief		Moves the executing program to a rendering frame, as if the program had
+					been executing for that many frames, and renders what is on display at that
+					frame straight away.  Frames that have been rendered ahead are discarded.
+					The program is positioned by LpExecutor::Seek in O(depth + siblings passed
+					over on each level walked), whatever the frame, and the frame is then
+					rendered once.
+		@param		frame		The rendering frame (0 = start of program).
+		@returns	True if the program was moved or false if there is no program or the
+					program is still being loaded.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::SeekProgram(uint32_t frame) {
+		if (activeCommand != nullptr
+			|| primaryLpState->getFirstInstruction() == nullptr) {
+			return false;
+		}
+
+		if (lookaheadBuffer != nullptr) {
+			lookaheadBuffer->Clear();
+		}
+		lookaheadPending = false;
+
+		if (IsIdle()) {
+			// the frames skipped whilst idle no longer apply to the program
+			idleFrames = 0;
+			idleHeldFrames = 0;
+			timer->Restart();
+		}
+
+		if (!lpExecutor->Seek(primaryLpState, frame, &lpiExecutorOutput)) {
+			return false;
+		}
+
+		if (!lpiExecutorOutput.RenderingInstructionsSet()) {
+			return true;
+		}
+
+		isBaseStale = false;
+		if (layerCompositor != nullptr) {
+			layerCompositor->SetBase(
+				lpiExecutorOutput.GetRenderingInstructions(),
+				lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+				lpiExecutorOutput.GetRepeatRenderingInstructions()
+			);
+		}
+
+		if (IsLayered()) {
+			ShowLayers();
+		}
+		else {
+			SetProgramPixels(&lpiExecutorOutput);
+		}
+		renderer->ShowPixels();
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets the position of the executing program as the number of rendering
+					frames that have been shown since the program started.  Frames that have
+					been rendered ahead but not yet shown are not counted whereas frames that
+					have passed whilst idle are.
+		@returns	The number of rendering frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t LightServerOrchastrator::GetProgramFrame() {
+		uint32_t frame = primaryLpState->GetFrame();
+		if (primaryLpState->getCurrentInstruction() == nullptr) {
+			// the program has come to an end so its position no longer moves
+			return frame;
+		}
+
+		CheckLookaheadIsCurrent();
+		uint32_t framesAhead = lookaheadPending ? 1 : 0;
+		if (lookaheadBuffer != nullptr) {
+			framesAhead += lookaheadBuffer->GetNumberOfFrames();
+		}
+
+		if (IsIdle()) {
+			uint32_t elapsedFrames = (timer->GetTime() - idleStart) / timer->GetInterval();
+			frame += elapsedFrames < idleFrames ? elapsedFrames : idleFrames;
+		}
+
+		return frame > framesAhead ? frame - framesAhead : 0;
+	}
+
+	/*!
+		@brief		Pauses the executing program, whilst something else (e.g. a pixel stream)
+					drives the LEDs, without stopping commands from being executed.  The
+					program does not move on until it is resumed.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::PreemptPrograms() {
+		if (programsPreempted) {
+			return;
+		}
+
+		if (IsIdle()) {
+			// catch the program up with the frames that have passed whilst idle
+			uint32_t idleTime = timer->GetTime() - idleStart;
+			EndIdle(idleTime / timer->GetInterval());
+			timer->Restart();
+		}
+
+		programsPreempted = true;
+	}
+
+	/*!
+		@brief		Resumes the program paused by PreemptPrograms().  What the program has
+					on display is rendered straight away as the LEDs no longer show it.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::ResumePrograms() {
+		if (!programsPreempted) {
+			return;
+		}
+
+		programsPreempted = false;
+		SeekProgram(GetProgramFrame());
+		SeekSegments();
+	}
+
+	/*!
+		@brief		Gets whether an LP state, executor or output is already used by the program,
+					a layer or a segment.  Each program must have its own as the state of one
+					program's execution must never be mixed with another's.
+		@param		lpState		A pointer to the LP state.
+		@param		lpExecutor	A pointer to the executor.
+		@param		output		A pointer to the output (nullptr = no output).
+		@returns	True if any of them is already used, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::IsInUse(LpState* lpState, LpExecutor* lpExecutor, LpiExecutorOutput* output) {
+		if (lpState == primaryLpState
+			|| lpExecutor == this->lpExecutor
+			|| output == &lpiExecutorOutput) {
+			return true;
+		}
+
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			if (lpState == layers[layerIndex].lpState
+				|| lpExecutor == layers[layerIndex].lpExecutor
+				|| (output != nullptr && output == layers[layerIndex].output)) {
+				return true;
+			}
+		}
+
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			if (lpState == segments[segmentIndex].lpState
+				|| lpExecutor == segments[segmentIndex].lpExecutor) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Adds a layer that is composited over the program (and any layers added
+					before it).  The layer has a program of its own, which is loaded into its
+					LP state in the same way as the program, and its own executor so that the
+					state of one program's execution is never mixed with another's (the LPI
+					executors themselves are shared as they keep nothing from one execution
+					to the next).  The layer is blended with an alpha of FF until changed.
+		@param		lpState			A pointer to the LP state of the program of the layer.
+		@param		lpExecutor		A pointer to the executor of the program of the layer.
+		@param		layerOutput		A pointer to the output that keeps the last frame of the layer.
+		@returns	True if the layer was added or false if there is no compositor, no room for the layer
+					or the LP state, executor or output is already used by another program.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::AddLayer(LpState* lpState, LpExecutor* lpExecutor, LpiExecutorOutput* layerOutput) {
+		if (layerCompositor == nullptr
+			|| lpState == nullptr
+			|| lpExecutor == nullptr
+			|| layerOutput == nullptr
+			|| numberOfLayers >= MAX_LAYERS
+			|| IsInUse(lpState, lpExecutor, layerOutput)) {
+			return false;
+		}
+
+		OrchastratorLayer* layer = &layers[numberOfLayers++];
+		layer->lpState = lpState;
+		layer->lpExecutor = lpExecutor;
+		layer->output = layerOutput;
+		layer->output->Reset();
+
+		return true;
+	}
+
+	/*!
+		@brief		Changes how a layer is blended with the layers below it.  The change
+					is shown on the next rendering frame.
+		@param		layer		The layer (1 = the layer above the program).
+		@param		blendMode	How the layer is blended.
+		@param		alpha		The alpha of the layer (BlendAlpha only).
+		@returns	True if the blend was changed or false if there is no such layer.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::SetLayerBlend(uint8_t layer, BlendMode blendMode, uint8_t alpha) {
+		if (layer == 0
+			|| layer > numberOfLayers) {
+			return false;
+		}
+
+		layers[layer - 1].blendMode = blendMode;
+		layers[layer - 1].alpha = alpha;
+		layersChanged = true;
+
+		return true;
+	}
+
+	/*!
+		@brief		Stops the program of a layer so that the layer is no longer shown.  The
+					change is shown on the next rendering frame.
+		@param		layer		The layer (1 = the layer above the program).
+		@returns	True if the layer was stopped or false if there is no such layer.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::StopLayer(uint8_t layer) {
+		if (layer == 0
+			|| layer > numberOfLayers) {
+			return false;
+		}
+
+		layers[layer - 1].lpState->reset();
+		layers[layer - 1].output->Reset();
+		layersChanged = true;
+
+		return true;
+	}
+
+	/*!
+		@brief		Gets whether a layer has a program (including one that has come to an
+					end, in which case the layer keeps showing its last frame).
+		@param		layer		The index of the layer.
+		@returns	True if the layer has a program, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::IsLayerLoaded(uint8_t layer) {
+		return layers[layer].lpState->getFirstInstruction() != nullptr;
+	}
+
+	/*!
+		@brief		Gets whether the frames of the program are composited with the layers,
+					i.e. a layer has a program or a layer has changed since it was last shown.
+		@returns	True if the frames are composited, false if the program is rendered alone.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::IsLayered() {
+		if (layerCompositor == nullptr) {
+			return false;
+		}
+
+		if (layersChanged) {
+			return true;
+		}
+
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			if (IsLayerLoaded(layerIndex)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Composites the last frame of the program with the last frame of each
+					layer, in order, and sets the pixels of the program to the result (the
+					pixels are not shown).  lpiExecutorOutput is used to hold the composited frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::ShowLayers() {
+		layerCompositor->Begin();
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			if (IsLayerLoaded(layerIndex)) {
+				layerCompositor->Blend(layers[layerIndex].output, layers[layerIndex].blendMode, layers[layerIndex].alpha);
+			}
+		}
+
+		layerCompositor->GetOutput(&lpiExecutorOutput);
+		SetProgramPixels(&lpiExecutorOutput);
+		layersChanged = false;
+	}
+
+	/*!
+		@brief		Takes the frame of the program, in lpiExecutorOutput, as the base that the
+					layers are composited over and, if there are no layers to composite, sets
+					the pixels of the program to it (the pixels are not shown).
+		@param		isLayered	True if the frame is composited with the layers.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::SetProgramFrame(bool isLayered) {
+		isBaseStale = false;
+		if (layerCompositor != nullptr) {
+			layerCompositor->SetBase(
+				lpiExecutorOutput.GetRenderingInstructions(),
+				lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+				lpiExecutorOutput.GetRepeatRenderingInstructions()
+			);
+		}
+
+		if (!isLayered) {
+			SetProgramPixels(&lpiExecutorOutput);
+		}
+	}
+
+	/*!
+		@brief		Renders the frame that is due when the program is composited with
+					layers or segments play programs of their own.  The program, and the
+					program of each layer and segment, are executed; the frames of the program
+					and layers are composited if any of them has changed and each segment that
+					has changed is rendered into its range of the LEDs.  lpiExecutorOutput is
+					needed to execute the programs so frames are not rendered ahead whilst
+					layered or segmented; any that were rendered ahead before then are discarded
+					and the program moved back to the frame that is on display.
+		@returns	True if pixels were rendered, false if nothing changed on this frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::RenderComposite() {
+		bool isLayered = IsLayered();
+		bool isChanged = layersChanged;
+
+		if (lookaheadPending
+			|| isBaseStale
+			|| (lookaheadBuffer != nullptr && !lookaheadBuffer->IsEmpty())) {
+			uint32_t frame = GetProgramFrame();
+			if (lookaheadBuffer != nullptr) {
+				lookaheadBuffer->Clear();
+			}
+			lookaheadPending = false;
+
+			if (lpExecutor->Seek(primaryLpState, frame, &lpiExecutorOutput)
+				&& lpiExecutorOutput.RenderingInstructionsSet()) {
+				SetProgramFrame(isLayered);
+				isChanged = true;
+			}
+		}
+
+		lpExecutor->Execute(primaryLpState, &lpiExecutorOutput);
+		if (lpiExecutorOutput.RenderingInstructionsSet()) {
+			SetProgramFrame(isLayered);
+			isChanged = true;
+		}
+
+		if (isLayered) {
+			bool isLayerChanged = isChanged;
+			for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+				OrchastratorLayer* layer = &layers[layerIndex];
+				if (!IsLayerLoaded(layerIndex)) {
+					continue;
+				}
+
+				// the layer keeps its last frame as it is composited again whenever another layer changes
+				layer->lpExecutor->Execute(layer->lpState, &lpiExecutorOutput);
+				if (lpiExecutorOutput.RenderingInstructionsSet()) {
+					layer->output->LoadRenderingInstructions(
+						lpiExecutorOutput.GetRenderingInstructions(),
+						lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+						lpiExecutorOutput.GetRepeatRenderingInstructions()
+					);
+					isLayerChanged = true;
+				}
+			}
+
+			if (isLayerChanged) {
+				ShowLayers();
+				isChanged = true;
+			}
+		}
+
+		if (RenderSegments()) {
+			isChanged = true;
+		}
+
+		if (!isChanged) {
+			return false;
+		}
+
+		renderer->ShowPixels();
+
+		return true;
+	}
+
+	/*!
+		@brief		Adds the program of the next segment of the LEDs: the first segment
+					added plays the first segment of the LED configuration, and so on.  As
+					with a layer, the segment has its own executor, and its LP state is told
+					the segment so that its LPIs see the length of the segment as the number
+					of LEDs.  The segment is not played until a program is loaded into its state.
+		@param		lpState			A pointer to the LP state of the program of the segment.
+		@param		lpExecutor		A pointer to the executor of the program of the segment.
+		@returns	True if the segment was added or false if there is no room for the segment or
+					the LP state or executor is already used by another program.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::AddSegment(LpState* lpState, LpExecutor* lpExecutor) {
+		if (lpState == nullptr
+			|| lpExecutor == nullptr
+			|| numberOfSegments >= MAX_SEGMENTS
+			|| IsInUse(lpState, lpExecutor, nullptr)) {
+			return false;
+		}
+
+		OrchastratorSegment* segment = &segments[numberOfSegments];
+		segment->lpState = lpState;
+		segment->lpExecutor = lpExecutor;
+		segment->lpState->SetSegment(&renderer->GetLedConfig()->segments[numberOfSegments]);
+		numberOfSegments++;
+
+		return true;
+	}
+
+	/*!
+		@brief		Stops the program of a segment so that the program plays on the range
+					of the segment again.  This is shown straight away.
+		@param		segment		The index of the segment.
+		@returns	True if the segment was stopped or false if there is no such segment.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::StopSegment(uint8_t segment) {
+		if (segment >= numberOfSegments) {
+			return false;
+		}
+
+		segments[segment].lpState->reset();
+		SeekProgram(GetProgramFrame());
+
+		return true;
+	}
+
+	/*!
+		@brief		Stops the programs of all of the segments, e.g. before the segments are
+					changed, so that the program plays on all of the LEDs again.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::StopSegments() {
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			segments[segmentIndex].lpState->reset();
+		}
+
+		SeekProgram(GetProgramFrame());
+	}
+
+	/*!
+		@brief		Gets whether a segment of the LED configuration has a program (including
+					one that has come to an end, in which case the segment keeps its last frame).
+		@param		segment		The index of the segment.
+		@returns	True if the segment has a program, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::IsSegmentLoaded(uint8_t segment) {
+		return segment < renderer->GetLedConfig()->numberOfSegments
+			&& segments[segment].lpState->getFirstInstruction() != nullptr;
+	}
+
+	/*!
+		@brief		Gets whether any segment plays a program of its own.
+		@returns	True if a segment has a program, false if the program plays on all of the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::IsSegmented() {
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			if (IsSegmentLoaded(segmentIndex)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/*!
+		@brief		Sets the pixels of a frame of the program (or of the program composited
+					with the layers).  The ranges of the segments that play programs of their
+					own are left as they are, the rest of the frame being set as if the frame
+					were rendered across all of the LEDs.
+		@param		output		A pointer to the frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::SetProgramPixels(LpiExecutorOutput* output) {
+		if (!IsSegmented()) {
+			renderer->SetPixels(output);
+			return;
+		}
+
+		LEDConfig* ledConfig = renderer->GetLedConfig();
+		uint16_t gapStart = 0;
+		for (uint8_t segmentIndex = 0; segmentIndex <= numberOfSegments; segmentIndex++) {
+			uint16_t gapEnd = ledConfig->numberOfLEDs;
+			if (segmentIndex < numberOfSegments) {
+				if (!IsSegmentLoaded(segmentIndex)) {
+					continue;
+				}
+				gapEnd = ledConfig->segments[segmentIndex].firstLed;
+			}
+
+			if (gapEnd > gapStart) {
+				renderer->SetPixelRange(
+					output->GetRenderingInstructions(),
+					output->GetNumberOfRenderingInstructions(),
+					output->GetRepeatRenderingInstructions(),
+					gapStart,
+					gapEnd,
+					gapStart
+				);
+			}
+
+			if (segmentIndex < numberOfSegments) {
+				gapStart = gapEnd + ledConfig->segments[segmentIndex].numberOfLEDs;
+			}
+		}
+	}
+
+	/*!
+		@brief		Executes the program of each segment and sets the pixels of the range of
+					each segment whose frame has changed (the pixels are not shown).  Segments
+					whose programs do not change on this frame are skipped.  lpiExecutorOutput
+					is used to execute the programs.
+		@returns	True if any pixels were set, false if no segment changed on this frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::RenderSegments() {
+		bool isChanged = false;
+		LEDConfig* ledConfig = renderer->GetLedConfig();
+
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			OrchastratorSegment* segment = &segments[segmentIndex];
+			if (!IsSegmentLoaded(segmentIndex)) {
+				continue;
+			}
+
+			segment->lpExecutor->Execute(segment->lpState, &lpiExecutorOutput);
+			if (!lpiExecutorOutput.RenderingInstructionsSet()) {
+				continue;
+			}
+
+			renderer->SetPixelRange(
+				lpiExecutorOutput.GetRenderingInstructions(),
+				lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+				lpiExecutorOutput.GetRepeatRenderingInstructions(),
+				ledConfig->segments[segmentIndex].firstLed,
+				ledConfig->segments[segmentIndex].firstLed + ledConfig->segments[segmentIndex].numberOfLEDs,
+				0
+			);
+			isChanged = true;
+		}
+
+		return isChanged;
+	}
+
+	/*!
+		@brief		Renders what the program of each segment has on display straight away,
+					e.g. once the LEDs have been driven by something else.  The frames are not
+					kept so each program is moved to the frame that it is already at.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::SeekSegments() {
+		LEDConfig* ledConfig = renderer->GetLedConfig();
+		bool isChanged = false;
+
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			OrchastratorSegment* segment = &segments[segmentIndex];
+			if (!IsSegmentLoaded(segmentIndex)
+				|| !segment->lpExecutor->Seek(segment->lpState, segment->lpState->GetFrame(), &lpiExecutorOutput)
+				|| !lpiExecutorOutput.RenderingInstructionsSet()) {
+				continue;
+			}
+
+			renderer->SetPixelRange(
+				lpiExecutorOutput.GetRenderingInstructions(),
+				lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+				lpiExecutorOutput.GetRepeatRenderingInstructions(),
+				ledConfig->segments[segmentIndex].firstLed,
+				ledConfig->segments[segmentIndex].firstLed + ledConfig->segments[segmentIndex].numberOfLEDs,
+				0
+			);
+			isChanged = true;
+		}
+
+		if (isChanged) {
+			renderer->ShowPixels();
+		}
 	}
 
 	/*!
@@ -59,6 +681,376 @@ namespace LS {
 		isRunning = true;
 	}
 
+	/*!
+		@brief		Gets the next command to be executed.  If the frame governor is
+					shedding network work then either no polling takes place or a
+					received command is held until a later cycle.  A held command
+					is returned before polling for a new command as the loading
+					buffer still contains its body.
+		@returns	The type of command to be executed or NONE.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	CommandType LightServerOrchastrator::GetNextCommand() {
+		if (frameGovernor != nullptr && frameGovernor->IsSheddingNetwork()) {
+			if (pendingCommand != CommandType::NONE
+				|| frameGovernor->GetShedMode() == GovernorShedMode::ShedSkipPolling) {
+				return CommandType::NONE;
+			}
+
+			CommandType receivedCommand = webServer->HandleNextCommand();
+			if (receivedCommand != CommandType::NONE) {
+				pendingCommand = receivedCommand;
+				frameGovernor->RecordDeferredCommand();
+			}
+
+			return CommandType::NONE;
+		}
+
+		if (pendingCommand != CommandType::NONE) {
+			CommandType heldCommand = pendingCommand;
+			pendingCommand = CommandType::NONE;
+			return heldCommand;
+		}
+
+		return webServer->HandleNextCommand();
+	}
+
+	/*!
+		@brief		Carries out the next part of the work of a command that spreads its
+					work across several execution cycles (e.g. loading a large program).
+					No new commands are polled for until the command is complete as the
+					command may still require the body of its request.
+		@returns	True if there is such a command, false otherwise.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::ContinueActiveCommand() {
+		if (activeCommand == nullptr) {
+			return false;
+		}
+
+		activeCommand->ContinueCommand();
+		if (!activeCommand->HasPendingWork()) {
+			activeCommand = nullptr;
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Completes an execution cycle by passing the time taken by the cycle
+					to the frame governor (if any) and applying the interval it decides upon.
+		@param		cycleStart		The time at which the cycle started.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::EndCycle(uint32_t cycleStart) {
+		if (frameGovernor == nullptr) {
+			return;
+		}
+
+		frameGovernor->RecordFrame(timer->GetTime() - cycleStart);
+		timer->SetInterval(frameGovernor->GetInterval());
+	}
+
+	/*!
+		@brief		Discards frames that have been rendered ahead if the program state
+					has since been reset, e.g. by a POWEROFF or a new program being loaded.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::CheckLookaheadIsCurrent() {
+		if (lookaheadBuffer == nullptr
+			|| lookaheadGeneration == primaryLpState->GetGeneration()) {
+			return;
+		}
+
+		lookaheadBuffer->Clear();
+		lookaheadPending = false;
+		lookaheadGeneration = primaryLpState->GetGeneration();
+	}
+
+	/*!
+		@brief		Renders a single frame ahead of the display clock whilst waiting
+					for the next rendering frame.  Nothing is rendered if the lookahead
+					buffer is full or the next rendering frame is due soon.  Frames are
+					executed into lpiExecutorOutput, which is not otherwise used between
+					rendering frames, and copied into the lookahead buffer.  If a frame does
+					not fit then it is held in lpiExecutorOutput until the buffer has drained or,
+					for a frame that is too big for the buffer, until it is rendered.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::ProduceLookaheadFrame() {
+		if (lookaheadBuffer == nullptr
+			|| programsPreempted
+			|| IsLayered()
+			|| IsSegmented()
+			|| timer->GetTimeUntilNext() < LOOKAHEAD_MIN_SLACK) {
+			return;
+		}
+
+		CheckLookaheadIsCurrent();
+
+		if (lookaheadPending) {
+			if (!lookaheadBuffer->Push(&lpiExecutorOutput, lpExecutor->GetRenderedInstruction())) {
+				return;
+			}
+			lookaheadPending = false;
+		}
+
+		if (lookaheadBuffer->IsFull()) {
+			return;
+		}
+
+		lpExecutor->Execute(primaryLpState, &lpiExecutorOutput);
+		if (!lookaheadBuffer->Push(&lpiExecutorOutput, lpExecutor->GetRenderedInstruction())) {
+			lookaheadPending = true;
+		}
+	}
+
+	/*!
+		@brief		Renders the frame that is due.  The frame is taken from the frames
+					rendered ahead of time (if any) or otherwise the LP is executed now.
+		@returns	True if pixels were rendered, false if nothing changed on this frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool LightServerOrchastrator::RenderNextFrame() {
+		CheckLookaheadIsCurrent();
+
+		if (IsLayered()
+			|| IsSegmented()) {
+			return RenderComposite();
+		}
+
+		// time spent setting the pixels is attributed to the LPI that rendered them when profiling
+		LpProfiler* profiler = lpExecutor->GetProfiler();
+		bool isProfiled = profiler != nullptr && profiler->IsEnabled();
+
+		if (lookaheadBuffer != nullptr
+			&& !lookaheadBuffer->IsEmpty()) {
+			LookaheadFrame* frame = lookaheadBuffer->Peek();
+			bool isRendered = frame->numberOfRis > 0;
+			if (isRendered) {
+				uint32_t startTime = isProfiled ? profiler->GetTime() : 0;
+				renderer->SetPixels(lookaheadBuffer->GetRenderingInstructions(frame), frame->numberOfRis, frame->repeat);
+				renderer->ShowPixels();
+				if (layerCompositor != nullptr) {
+					// kept so that layers can be composited over it once a layer is shown
+					layerCompositor->SetBase(lookaheadBuffer->GetRenderingInstructions(frame), frame->numberOfRis, frame->repeat);
+					isBaseStale = false;
+				}
+				if (isProfiled) {
+					profiler->RecordPixels(frame->lpInstruction, startTime);
+				}
+			}
+			lookaheadBuffer->Pop();
+
+			return isRendered;
+		}
+
+		if (lookaheadPending) {
+			// the frame is already in lpiExecutorOutput
+			lookaheadPending = false;
+		}
+		else {
+			lpExecutor->Execute(primaryLpState, &lpiExecutorOutput);
+		}
+
+		if (!lpiExecutorOutput.RenderingInstructionsSet()) {
+			return false;
+		}
+
+		// there's a RI to be rendered...so render it
+		uint32_t startTime = isProfiled ? profiler->GetTime() : 0;
+		renderer->SetPixels(&lpiExecutorOutput);
+		renderer->ShowPixels();
+		if (isProfiled) {
+			profiler->RecordPixels(lpExecutor->GetRenderedInstruction(), startTime);
+		}
+		if (layerCompositor != nullptr) {
+			if (lpiExecutorOutput.IsGenerated()) {
+				// rendering the frame just to keep it would undo the saving of generating the
+				// pixels, so the frame is rendered again if a layer is composited over it
+				isBaseStale = true;
+			}
+			else {
+				layerCompositor->SetBase(
+					lpiExecutorOutput.GetRenderingInstructions(),
+					lpiExecutorOutput.GetNumberOfRenderingInstructions(),
+					lpiExecutorOutput.GetRepeatRenderingInstructions()
+				);
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+		@brief		Goes idle, at the end of an execution cycle, if nothing will be rendered on
+					the next rendering frame.  The timer is delayed until the first rendering frame
+					on which something may change and, until then, the orchastrator only polls for
+					commands.  Frames that have already been rendered ahead are counted provided
+					that none of them render anything.
+		@param		cycleStart		The time at which the current cycle started.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::EnterIdle(uint32_t cycleStart) {
+		if (!idleEnabled
+			|| programsPreempted
+			|| idleFrames > 0
+			|| lookaheadPending
+			|| layersChanged
+			|| pendingCommand != CommandType::NONE
+			|| activeCommand != nullptr) {
+			return;
+		}
+
+		uint16_t heldFrames = 0;
+		if (lookaheadBuffer != nullptr) {
+			CheckLookaheadIsCurrent();
+			if (lookaheadBuffer->HasFramesToRender()) {
+				return;
+			}
+			heldFrames = lookaheadBuffer->GetNumberOfFrames();
+		}
+
+		uint32_t framesUntilNextChange = (uint32_t)heldFrames + lpExecutor->GetFramesUntilNextChange(primaryLpState);
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			if (!IsLayerLoaded(layerIndex)) {
+				continue;
+			}
+
+			// the layers are never rendered ahead so no frames are held for them
+			uint16_t layerFrames = layers[layerIndex].lpExecutor->GetFramesUntilNextChange(layers[layerIndex].lpState);
+			if (layerFrames < framesUntilNextChange) {
+				framesUntilNextChange = layerFrames;
+			}
+		}
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			if (!IsSegmentLoaded(segmentIndex)) {
+				continue;
+			}
+
+			uint16_t segmentFrames = segments[segmentIndex].lpExecutor->GetFramesUntilNextChange(segments[segmentIndex].lpState);
+			if (segmentFrames < framesUntilNextChange) {
+				framesUntilNextChange = segmentFrames;
+			}
+		}
+		if (framesUntilNextChange == 0) {
+			return;
+		}
+
+		idleFrames = framesUntilNextChange > FRAMES_UNTIL_CHANGE_NEVER ? FRAMES_UNTIL_CHANGE_NEVER : framesUntilNextChange;
+		idleHeldFrames = heldFrames;
+		idleStart = cycleStart;
+		timer->SkipIntervals(idleFrames);
+	}
+
+	/*!
+		@brief		Leaves idle by moving the LP forward by the rendering frames that have
+					elapsed whilst idle, so that the LP is at the same point that it would
+					have been at had each of the frames been executed.
+		@param		elapsedFrames	The number of rendering frames that have elapsed whilst idle.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::EndIdle(uint16_t elapsedFrames) {
+		if (idleFrames == 0) {
+			return;
+		}
+
+		if (elapsedFrames > idleFrames) {
+			elapsedFrames = idleFrames;
+		}
+
+		// the first frames were rendered ahead and are held in the lookahead buffer
+		uint16_t heldFrames = elapsedFrames < idleHeldFrames ? elapsedFrames : idleHeldFrames;
+		for (uint16_t frame = 0; frame < heldFrames; frame++) {
+			lookaheadBuffer->Pop();
+		}
+
+		if (elapsedFrames > heldFrames) {
+			lpExecutor->SkipFrames(primaryLpState, elapsedFrames - heldFrames);
+		}
+
+		for (uint8_t layerIndex = 0; layerIndex < numberOfLayers; layerIndex++) {
+			if (IsLayerLoaded(layerIndex)) {
+				layers[layerIndex].lpExecutor->SkipFrames(layers[layerIndex].lpState, elapsedFrames);
+			}
+		}
+		for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+			if (IsSegmentLoaded(segmentIndex)) {
+				segments[segmentIndex].lpExecutor->SkipFrames(segments[segmentIndex].lpState, elapsedFrames);
+			}
+		}
+
+		idleFrames = 0;
+		idleHeldFrames = 0;
+	}
+
+	/*!
+		@brief		Polls for a command whilst idle.  The orchastrator leaves idle as soon
+					as a command is received and starts an execution cycle immediately, which
+					executes the command, because the command may change what is rendered.
+					Otherwise the processor is left to wait until there is something to do.
+		@param		isInSetupMode	True if in set up mode, in which case commands are not polled.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::ExecuteWhileIdle(bool isInSetupMode) {
+		if (!isInSetupMode
+			&& pendingCommand == CommandType::NONE) {
+			pendingCommand = webServer->HandleNextCommand();
+		}
+
+		if (pendingCommand == CommandType::NONE) {
+			timer->Idle();
+			return;
+		}
+
+		uint32_t idleTime = timer->GetTime() - idleStart;
+		EndIdle(idleTime / timer->GetInterval());
+		timer->Restart();
+	}
+
+	/*!
+		@brief		Executes a command received on a channel that is cheap enough to check
+					between rendering frames (e.g. the UDP command channel) straight away rather
+					than waiting for the next rendering frame.  Nothing is checked whilst another
+					command is in progress or the next rendering frame is due soon.
+		@param		isInSetupMode	True if in set up mode, in which case commands are not polled.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LightServerOrchastrator::ExecuteQuickCommand(bool isInSetupMode) {
+		if (isInSetupMode
+			|| activeCommand != nullptr
+			|| pendingCommand != CommandType::NONE
+			|| timer->GetTimeUntilNext() < LOOKAHEAD_MIN_SLACK) {
+			return;
+		}
+
+		CommandType quickCommand = webServer->HandleNextQuickCommand();
+		if (quickCommand == CommandType::NONE) {
+			return;
+		}
+
+		ICommand* command = commandFactory->GetCommand(quickCommand);
+		if (command == nullptr) {
+			return;
+		}
+
+		command->ExecuteCommand();
+		if (command->HasPendingWork()) {
+			// continue the command on the following execution cycles
+			activeCommand = command;
+		}
+	}
+
 	// NOTE: There are two versions of the Execute method:
 	// (1) for when no debugging output is required.  This is a 'clean' method without any debugging output statements.
 	// (2) for when debugging output is required.  This contains additional code to cause debug messages to be sent via the serial connection.
@@ -76,26 +1068,41 @@ namespace LS {
 		bool timeToExecute = timer->IsTime();
 
 		if (!timeToExecute || !isRunning) {
+			if (isRunning && IsIdle()) {
+				// nothing can change until the timer next fires so just poll for commands
+				ExecuteWhileIdle(isInSetupMode);
+			}
+			else if (isRunning) {
+				// execute commands that can be received quickly straight away and use
+				// the rest of the time whilst waiting for the next frame to render frames ahead
+				ExecuteQuickCommand(isInSetupMode);
+				ProduceLookaheadFrame();
+			}
 			return false;
 		}
 
-		// see if there's a RI to be rendered
-		lpExecutor->Execute(primaryLpState, &lpiExecutorOutput);
-		if (lpiExecutorOutput.RenderingInstructionsSet()) {
-			// there's a RI to be rendered...so render it
-			renderer->SetPixels(&lpiExecutorOutput);
-			renderer->ShowPixels();
+		uint32_t cycleStart = timer->GetTime();
+
+		// if idle then this is the first frame on which something may change, so
+		// catch the LP up with the frames on which nothing changed
+		EndIdle(idleFrames);
+
+		// see if there's a RI to be rendered (and render it) unless the program has been preempted
+		if (!programsPreempted) {
+			RenderNextFrame();
 		}
 
 		if (isInSetupMode) {
 			// do not execute the web server if in set up mode because
 			// the LDL web server can conflict with the set up web portal
 			// and cause it to be become non-responsive, requiring multiple restarts
+			EndCycle(cycleStart);
 			return false;
 		}
 		
-		// see if a new command has been received
-		CommandType nextCommand = webServer->HandleNextCommand();
+		// continue a command that spreads its work across execution cycles or otherwise
+		// see if a new command has been received (or one held over from a previous cycle)
+		CommandType nextCommand = ContinueActiveCommand() ? CommandType::NONE : GetNextCommand();
 
 		// new command received...so execute it (could be a new LP, for example)
 		if (nextCommand != CommandType::NONE) {
@@ -105,9 +1112,18 @@ namespace LS {
 				if (!nextCommandToExecute->ExecuteCommand()) {
 					// TODO: what do we do here?
 				}
+
+				if (nextCommandToExecute->HasPendingWork()) {
+					// continue the command on the following execution cycles
+					activeCommand = nextCommandToExecute;
+				}
 			}
 		}
 
+		// go idle if nothing will change on the next frame(s)
+		EnterIdle(cycleStart);
+		EndCycle(cycleStart);
+
 		return true;
 	}
 #endif
@@ -124,9 +1140,25 @@ namespace LS {
 		bool timeToExecute = timer->IsTime();
 
 		if (!timeToExecute || !isRunning) {
+			if (isRunning && IsIdle()) {
+				// nothing can change until the timer next fires so just poll for commands
+				ExecuteWhileIdle(isInSetupMode);
+			}
+			else if (isRunning) {
+				// execute commands that can be received quickly straight away and use
+				// the rest of the time whilst waiting for the next frame to render frames ahead
+				ExecuteQuickCommand(isInSetupMode);
+				ProduceLookaheadFrame();
+			}
 			return false;
 		}
 
+		uint32_t cycleStart = timer->GetTime();
+
+		// if idle then this is the first frame on which something may change, so
+		// catch the LP up with the frames on which nothing changed
+		EndIdle(idleFrames);
+
 		/** START: DEBUG **/
 		uint32_t startExecuteCycle = millis();
 		appLogger->logEvent(startExecuteCycle, 1, "Cycle", "Execute", true, startExecuteCycle);
@@ -134,12 +1166,8 @@ namespace LS {
 		appLogger->logEvent(startRendering, 2, "Render", "Render", true, startRendering);
 		/** END: DEBUG **/
 
-		// see if there's a RI to be rendered
-		lpExecutor->Execute(primaryLpState, &lpiExecutorOutput);
-		if (lpiExecutorOutput.RenderingInstructionsSet()) {
-			// there's a RI to be rendered...so render it
-			renderer->SetPixels(&lpiExecutorOutput);
-			renderer->ShowPixels();
+		// see if there's a RI to be rendered (and render it) unless the program has been preempted
+		if (!programsPreempted && RenderNextFrame()) {
 			/** START: DEBUG **/
 			uint32_t startRendering = millis();
 			appLogger->logEvent(startExecuteCycle, 2, "Render", "Execute", false, millis());
@@ -156,12 +1184,14 @@ namespace LS {
 			// do not execute the web server if in set up mode because
 			// the LDL web server can conflict with the set up web portal
 			// and cause it to be become non-responsive, requiring multiple restarts
+			EndCycle(cycleStart);
 			return false;
 		}
 
 
-		// see if a new command has been received
-		CommandType nextCommand = webServer->HandleNextCommand();
+		// continue a command that spreads its work across execution cycles or otherwise
+		// see if a new command has been received (or one held over from a previous cycle)
+		CommandType nextCommand = ContinueActiveCommand() ? CommandType::NONE : GetNextCommand();
 
 		// new command received...so execute it (could be a new LP, for example)
 		if (nextCommand != CommandType::NONE) {
@@ -183,9 +1213,18 @@ namespace LS {
 				/** START: DEBUG **/
 				appLogger->logEvent(startExecuteCommand, 2, "Command", "Execute", false, millis());
 				/** END: DEBUG **/
+
+				if (nextCommandToExecute->HasPendingWork()) {
+					// continue the command on the following execution cycles
+					activeCommand = nextCommandToExecute;
+				}
 			}
 		}
 
+		// go idle if nothing will change on the next frame(s)
+		EnterIdle(cycleStart);
+		EndCycle(cycleStart);
+
 		/** START: DEBUG **/
 		appLogger->logEvent(startExecuteCycle, 1, "Cycle", "Execute", false, millis());
 		/** END: DEBUG **/
@@ -4,10 +4,13 @@
 #include "IOrchastor.h"
 
 #include "Timer.h"
+#include "FrameGovernor.h"
 #include "../LPE/Executor/LpExecutor.h"
+#include "../LPE/Executor/LookaheadFrameBuffer.h"
 #include "../LPE/StateBuilder/LpState.h"
 #include "../LPE/LpiExecutors/LpiExecutorOutput.h"
 #include "../Renderer/PixelRenderer.h"
+#include "../Renderer/LayerCompositor.h"
 #include "../DomainInterfaces.h"
 #include "../Commands/CommandFactory.h"
 
@@ -18,6 +21,29 @@ namespace LS {
 //#endif
 #define		ORCHASTRATOR_DEBUG_ALL		// define this to see orchastrator debugging output
 
+#define		LOOKAHEAD_MIN_SLACK			5		// ms that must remain before the next frame to render a frame ahead
+
+	/*!
+		@brief	A layer that is composited over the program: a program of its own,
+				executed by an executor of its own, and the last frame it rendered.
+	*/
+	struct OrchastratorLayer {
+		LpState* lpState = nullptr;
+		LpExecutor* lpExecutor = nullptr;
+		LpiExecutorOutput* output = nullptr;		// the last frame rendered by the layer
+		BlendMode blendMode = BlendMode::BlendAlpha;
+		uint8_t alpha = 255;
+	};
+
+	/*!
+		@brief	The program of a segment of the LEDs (the segment of the same index
+				in the LED configuration), executed by an executor of its own.
+	*/
+	struct OrchastratorSegment {
+		LpState* lpState = nullptr;
+		LpExecutor* lpExecutor = nullptr;
+	};
+
 	class LightServerOrchastrator : public IOrchastor {
 		private:
 			Timer* timer;
@@ -27,10 +53,50 @@ namespace LS {
 			ILightWebServer* webServer;
 			CommandFactory* commandFactory;
 			IAppLogger* appLogger;
+			FrameGovernor* frameGovernor = nullptr;
+			LookaheadFrameBuffer* lookaheadBuffer = nullptr;
+			LayerCompositor* layerCompositor = nullptr;
 
 		protected:
 			LpiExecutorOutput lpiExecutorOutput;
 			bool isRunning = true;
+			CommandType pendingCommand = CommandType::NONE;
+			ICommand* activeCommand = nullptr;		// command with work spread across execution cycles
+			bool lookaheadPending = false;			// lpiExecutorOutput holds a frame that did not fit in the lookahead buffer
+			uint16_t lookaheadGeneration = 0;
+			bool idleEnabled = false;
+			uint16_t idleFrames = 0;				// rendering frames on which nothing changes (0 = not idle)
+			uint16_t idleHeldFrames = 0;			// of which are held in the lookahead buffer
+			uint32_t idleStart = 0;
+			bool programsPreempted = false;			// the LEDs are driven by something other than the program
+			OrchastratorLayer layers[MAX_LAYERS];	// composited over the program, lowest first
+			uint8_t numberOfLayers = 0;
+			bool layersChanged = false;				// the layers must be composited again even if no frame is rendered
+			bool isBaseStale = false;				// the frame on display was generated straight into the pixels so is not the base of the layers
+			OrchastratorSegment segments[MAX_SEGMENTS];	// play programs of their own on ranges of the LEDs
+			uint8_t numberOfSegments = 0;
+
+			CommandType GetNextCommand();
+			bool ContinueActiveCommand();
+			void EndCycle(uint32_t cycleStart);
+			bool RenderNextFrame();
+			void ProduceLookaheadFrame();
+			void CheckLookaheadIsCurrent();
+			void EnterIdle(uint32_t cycleStart);
+			void EndIdle(uint16_t elapsedFrames);
+			void ExecuteWhileIdle(bool isInSetupMode);
+			void ExecuteQuickCommand(bool isInSetupMode);
+			bool IsLayered();
+			bool IsLayerLoaded(uint8_t layer);
+			bool RenderComposite();
+			void SetProgramFrame(bool isLayered);
+			void ShowLayers();
+			bool IsSegmented();
+			bool IsSegmentLoaded(uint8_t segment);
+			void SetProgramPixels(LpiExecutorOutput* output);
+			bool RenderSegments();
+			void SeekSegments();
+			bool IsInUse(LpState* lpState, LpExecutor* lpExecutor, LpiExecutorOutput* output);
 
 		public:
 			LightServerOrchastrator(
@@ -52,7 +118,89 @@ namespace LS {
 				this->appLogger = appLogger;
 			}
 
+			/*!
+				@brief		Sets the governor that adapts the frame rate and network work
+							to the time taken by each execution cycle.  Pass nullptr to
+							always render at the timer's interval.
+				@param		frameGovernor	The governor to apply.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			void SetFrameGovernor(FrameGovernor* frameGovernor) {
+				this->frameGovernor = frameGovernor;
+			}
+
+			/*!
+				@brief		Gets the governor that adapts the frame rate (if any).
+				@returns	A pointer to the governor or nullptr if none has been set.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			FrameGovernor* GetFrameGovernor() {
+				return frameGovernor;
+			}
+
+			/*!
+				@brief		Sets the buffer used to render frames ahead of the display clock
+							whilst waiting for the next rendering frame.  Pass nullptr to only
+							render frames as they are due.
+				@param		lookaheadBuffer		The buffer to store frames rendered ahead.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			void SetLookaheadBuffer(LookaheadFrameBuffer* lookaheadBuffer) {
+				this->lookaheadBuffer = lookaheadBuffer;
+				this->lookaheadPending = false;
+				if (lookaheadBuffer != nullptr) {
+					lookaheadBuffer->Clear();
+				}
+			}
+
+			/*!
+				@brief		Sets the compositor that combines the frames of the layers with the
+							frame of the program.  Pass nullptr to only render the program.
+				@param		layerCompositor		The compositor of the layers.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			void SetLayerCompositor(LayerCompositor* layerCompositor) {
+				this->layerCompositor = layerCompositor;
+			}
+
+			/*!
+				@brief		Sets whether the orchastrator stops executing rendering frames whilst
+							nothing can change (e.g. a static LPI with a long duration or the program
+							has come to an end).  Whilst idle, the orchastrator only polls for commands
+							and otherwise lets the processor wait.
+				@param		idleEnabled		True to go idle when nothing can change, false otherwise.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			void SetIdleEnabled(bool idleEnabled) {
+				this->idleEnabled = idleEnabled;
+			}
+
+			/*!
+				@brief		Gets whether the orchastrator is currently idle.
+				@returns	True if idle, false otherwise.
+				@author		Kevin White
+				@date		19 Oct 2026
+			*/
+			bool IsIdle() {
+				return idleFrames > 0;
+			}
+
 			void StopPrograms();
+			bool SeekProgram(uint32_t frame);
+			uint32_t GetProgramFrame();
+			void PreemptPrograms();
+			void ResumePrograms();
+			bool AddLayer(LpState* lpState, LpExecutor* lpExecutor, LpiExecutorOutput* layerOutput);
+			bool SetLayerBlend(uint8_t layer, BlendMode blendMode, uint8_t alpha);
+			bool StopLayer(uint8_t layer);
+			bool AddSegment(LpState* lpState, LpExecutor* lpExecutor);
+			bool StopSegment(uint8_t segment);
+			void StopSegments();
 			void Stop();
 			void Start();
 			bool Execute(bool isInSetupMode);
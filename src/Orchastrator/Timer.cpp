@@ -7,11 +7,7 @@ namespace LS {
 		@date		2 Feb 2021
 	*/
 	Timer::Timer(uint8_t interval) {
-		if (interval < 25) {
-			interval = 25;
-		}
-
-		this->interval = interval;
+		SetInterval(interval);
 		// SetNext();
 		// nextTime = this->GetCurrent() + interval;
 		// nextTime = 0;
@@ -39,11 +35,106 @@ namespace LS {
 	}
 
 	/*!
-		@brief		Sets the next interval value.
+		@brief		Sets the next interval value.  The next interval follows on from the
+					one that has just been reached, rather than from the current time, so that
+					the time taken to notice that the interval was reached does not build up
+					and the timer keeps time with its clock.  If the timer has fallen more than
+					an interval behind then it starts again from the current time.
 		@author		Kevin White
 		@date		2 Feb 2021
 	*/
 	void Timer::SetNext() {
-		nextTime = GetCurrent() + interval;
+		uint32_t current = GetCurrent();
+		nextTime += interval;
+		if (current >= nextTime) {
+			nextTime = current + interval;
+		}
+	}
+
+	/*!
+		@brief		Waits briefly, whilst there is nothing to do, in a way that reduces
+					power consumption.  The base timer does not wait at all.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void Timer::Idle() {
+	}
+
+	/*!
+		@brief		Delays the next time the timer fires by a number of intervals.
+		@param		numberOfIntervals	The number of intervals to skip.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void Timer::SkipIntervals(uint16_t numberOfIntervals) {
+		nextTime += (uint32_t)numberOfIntervals * interval;
+	}
+
+	/*!
+		@brief		Moves the next time the timer fires earlier or later, e.g. to keep
+					the timer in step with the timer of another server.
+		@param		milliseconds	The number of milliseconds to move the timer by, which
+									is negative to fire earlier or positive to fire later.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void Timer::Shift(int16_t milliseconds) {
+		nextTime += milliseconds;
+	}
+
+	/*!
+		@brief		Causes the timer to fire the next time it is checked.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void Timer::Restart() {
+		nextTime = GetCurrent();
+	}
+
+	/*!
+		@brief		Gets the current time of the timer's clock.
+		@returns	The current time in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t Timer::GetTime() {
+		return GetCurrent();
+	}
+
+	/*!
+		@brief		Gets the time remaining until the timer next fires.
+		@returns	The remaining time in milliseconds or 0 if the timer is due to fire.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint32_t Timer::GetTimeUntilNext() {
+		uint32_t current = GetCurrent();
+		return current >= nextTime ? 0 : nextTime - current;
+	}
+
+	/*!
+		@brief		Gets the interval between each time the timer fires.
+		@returns	The interval in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint8_t Timer::GetInterval() {
+		return interval;
+	}
+
+	/*!
+		@brief		Sets the interval between each time the timer fires.  The
+					interval is never less than 25ms.  The new interval takes
+					effect from the next time the timer fires.
+		@param		interval	The interval in milliseconds.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void Timer::SetInterval(uint8_t interval) {
+		if (interval < 25) {
+			interval = 25;
+		}
+
+		this->interval = interval;
 	}
 }
\ No newline at end of file
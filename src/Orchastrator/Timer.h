@@ -23,6 +23,14 @@ namespace LS {
 	public:
 		Timer(uint8_t interval);
 		virtual bool IsTime();
+		virtual void Idle();
+		uint32_t GetTime();
+		uint32_t GetTimeUntilNext();
+		void SkipIntervals(uint16_t numberOfIntervals);
+		void Shift(int16_t milliseconds);
+		void Restart();
+		uint8_t GetInterval();
+		void SetInterval(uint8_t interval);
 	};
 }
 
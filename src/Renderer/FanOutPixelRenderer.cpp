@@ -0,0 +1,257 @@
+#include "FanOutPixelRenderer.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects dependencies.
+		@param		pixelController		A pointer to the class that interacts with the LED hardware.
+		@param		ledConfig			A pointer to the configuration of the LEDs of the whole logical strip.
+		@param		numberOfLocalLeds	The number of LEDs attached to this server (the start of the logical strip).
+		@param		udp					A pointer to the UDP service used to send frames to the followers.
+		@param		port				The port that the followers receive frames on.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	FanOutPixelRenderer::FanOutPixelRenderer(IPixelController* pixelController, LEDConfig* ledConfig, uint16_t numberOfLocalLeds, IUdpService* udp, uint16_t port)
+		: PixelRenderer(pixelController, ledConfig) {
+		this->numberOfLocalLeds = numberOfLocalLeds;
+		this->udp = udp;
+		this->port = port;
+	}
+
+	/*!
+		@brief		Gets the number of LEDs attached to this server, i.e. rendered locally.
+		@return		The number of local LEDs, limited to the length of the logical strip.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPixelRenderer::GetNumberOfLeds() {
+		return numberOfLocalLeds < ledConfig->numberOfLEDs
+			? numberOfLocalLeds
+			: ledConfig->numberOfLEDs;
+	}
+
+	/*!
+		@brief		Starts the UDP service used to send frames.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPixelRenderer::Start() {
+		udp->begin(port);
+	}
+
+	/*!
+		@brief		Adds a follower that renders a segment of the logical strip.
+		@param		ip				The IP address of the follower.
+		@param		firstLed		The first LED of the logical strip rendered by the follower.
+		@param		numberOfLeds	The number of LEDs rendered by the follower.
+		@returns	True if the follower was added or false if there is no space or the segment is empty.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPixelRenderer::AddFollower(IP ip, uint16_t firstLed, uint16_t numberOfLeds) {
+		if (numberOfFollowers >= FAN_OUT_MAX_FOLLOWERS
+			|| numberOfLeds == 0) {
+			return false;
+		}
+
+		FanOutFollower* follower = &followers[numberOfFollowers++];
+		follower->ip = ip;
+		follower->firstLed = firstLed;
+		follower->numberOfLeds = numberOfLeds;
+
+		return true;
+	}
+
+	/*!
+		@brief		Sets the pixel rendering buffer of the local LEDs with the values that have been
+					output from executing a rendering instruction and sends the followers their
+					segments.  The followers are sent rendering instructions so the pixels of an
+					output that generates them are rendered to rendering instructions first.
+		@param		lpiExecutorOutput	A pointer to the instance that contains the rendering instruction output.
+		@return		True if the pixel rendering buffer was set or false if the lpiExecutorOutput is null
+					or contains no rendering instructions.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPixelRenderer::SetPixels(LpiExecutorOutput* lpiExecutorOutput) {
+		if (lpiExecutorOutput == nullptr) {
+			lastSetRiValid = false;
+			return false;
+		}
+
+		return SetPixels(
+			lpiExecutorOutput->GetRenderingInstructions(),
+			lpiExecutorOutput->GetNumberOfRenderingInstructions(),
+			lpiExecutorOutput->GetRepeatRenderingInstructions()
+		);
+	}
+
+	/*!
+		@brief		Sets the pixel rendering buffer of the local LEDs with a set of rendering
+					instructions for the logical strip and sends the followers their segments.
+		@param		renderingInstructions	A pointer to the rendering instructions.
+		@param		numberOfInstructions	The number of rendering instructions.
+		@param		repeat					True if the rendering instructions are repeated until all LEDs have been set.
+		@param		firstLed				The LED that the first rendering instruction starts from.  Frames
+											are only sent to the followers when this is the start of the strip.
+		@return		True if the pixel rendering buffer was set or false if there are no rendering instructions.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	bool FanOutPixelRenderer::SetPixels(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed) {
+		if (!PixelRenderer::SetPixels(renderingInstructions, numberOfInstructions, repeat, firstLed)) {
+			return false;
+		}
+
+		if (firstLed != 0
+			|| numberOfFollowers == 0) {
+			return true;
+		}
+
+		// keep the frame so it can be sent again if it turns out to be the last
+		lastFrameRis = 0;
+		if (numberOfInstructions <= FAN_OUT_REFRESH_RIS) {
+			for (uint16_t riIndex = 0; riIndex < numberOfInstructions; riIndex++) {
+				lastFrame[riIndex] = renderingInstructions[riIndex];
+			}
+			lastFrameRis = numberOfInstructions;
+			lastFrameRepeat = repeat;
+		}
+
+		sequence++;
+		SendFrame(renderingInstructions, numberOfInstructions, repeat);
+		frameSentSinceRefresh = true;
+
+		return true;
+	}
+
+	/*!
+		@brief		Sends the last frame again, with the same sequence number, when no new
+					frame has been sent for FAN_OUT_REFRESH_INTERVAL ms.  Followers that already
+					showed the frame ignore it.  This should be called on every loop.
+		@param		now		The current time (ms).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPixelRenderer::Refresh(uint32_t now) {
+		if (now - lastRefreshTime < FAN_OUT_REFRESH_INTERVAL) {
+			return;
+		}
+
+		lastRefreshTime = now;
+		if (!frameSentSinceRefresh
+			&& lastFrameRis > 0) {
+			SendFrame(lastFrame, lastFrameRis, lastFrameRepeat);
+		}
+		frameSentSinceRefresh = false;
+	}
+
+	/*!
+		@brief		Gets the sequence number of the last frame that was sent.
+		@returns	The sequence number.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t FanOutPixelRenderer::GetSequence() {
+		return sequence;
+	}
+
+	/*!
+		@brief		Sends each of the followers its segment of a frame.
+		@param		renderingInstructions	A pointer to the rendering instructions of the logical strip.
+		@param		numberOfInstructions	The number of rendering instructions.
+		@param		repeat					True if the rendering instructions are repeated along the strip.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPixelRenderer::SendFrame(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat) {
+		for (uint8_t followerIndex = 0; followerIndex < numberOfFollowers; followerIndex++) {
+			SendSegment(&followers[followerIndex], renderingInstructions, numberOfInstructions, repeat);
+		}
+	}
+
+	/*!
+		@brief		Sends a follower its segment of a frame.  The rendering instructions are
+					walked along the logical strip (repeated if necessary) and the parts that
+					fall within the segment are added to packets as runs.  A packet is sent each
+					time it fills and the last packet of the frame is flagged as such.
+		@param		follower				A pointer to the follower.
+		@param		renderingInstructions	A pointer to the rendering instructions of the logical strip.
+		@param		numberOfInstructions	The number of rendering instructions.
+		@param		repeat					True if the rendering instructions are repeated along the strip.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPixelRenderer::SendSegment(FanOutFollower* follower, RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat) {
+		uint32_t segmentStart = follower->firstLed;
+		uint32_t segmentEnd = segmentStart + follower->numberOfLeds;
+		if (segmentEnd > ledConfig->numberOfLEDs) {
+			segmentEnd = ledConfig->numberOfLEDs;
+		}
+
+		uint32_t patternLength = 0;
+		for (uint16_t riIndex = 0; riIndex < numberOfInstructions; riIndex++) {
+			patternLength += renderingInstructions[riIndex].number;
+		}
+
+		uint8_t packetIndex = 0;
+		packet.Begin(sequence, packetIndex, 0);
+
+		// skip the whole repeats of the pattern that end before the segment
+		uint32_t ledIndex = 0;
+		if (repeat
+			&& patternLength > 0) {
+			ledIndex = (segmentStart / patternLength) * patternLength;
+		}
+
+		while (patternLength > 0
+			&& ledIndex < segmentEnd) {
+			for (uint16_t riIndex = 0; riIndex < numberOfInstructions && ledIndex < segmentEnd; riIndex++) {
+				RI* renderingInstruction = &renderingInstructions[riIndex];
+				uint32_t runStart = ledIndex;
+				uint32_t runEnd = ledIndex + renderingInstruction->number;
+				ledIndex = runEnd;
+
+				if (runStart < segmentStart) {
+					runStart = segmentStart;
+				}
+				if (runEnd > segmentEnd) {
+					runEnd = segmentEnd;
+				}
+
+				while (runStart < runEnd) {
+					uint8_t count = runEnd - runStart > FAN_OUT_MAX_RUN_LENGTH
+						? FAN_OUT_MAX_RUN_LENGTH
+						: (uint8_t)(runEnd - runStart);
+
+					if (!packet.AddRun(renderingInstruction->colour, count)) {
+						SendPacket(follower);
+						packet.Begin(sequence, ++packetIndex, (uint16_t)(runStart - segmentStart));
+						packet.AddRun(renderingInstruction->colour, count);
+					}
+
+					runStart += count;
+				}
+			}
+
+			if (!repeat) {
+				break;
+			}
+		}
+
+		packet.SetLast();
+		SendPacket(follower);
+	}
+
+	/*!
+		@brief		Sends the current packet to a follower.
+		@param		follower		A pointer to the follower.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void FanOutPixelRenderer::SendPacket(FanOutFollower* follower) {
+		udp->beginPacket(follower->ip, port);
+		udp->write(packet.GetBuffer(), packet.GetSize());
+		udp->endPacket();
+	}
+}
@@ -0,0 +1,83 @@
+/*!
+	@brief		Provides a pixel renderer that renders the start of a
+				logical strip of LEDs on the attached LEDs and sends the
+				rest of the strip to follower Light Servers over UDP.
+	@author		Kevin White
+	@date		19 Oct 2026
+*/
+#ifndef _FanOutPixelRenderer_h
+#define _FanOutPixelRenderer_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include <stdint.h>
+#include "PixelRenderer.h"
+#include "../Networking/IUdpService.h"
+#include "../Networking/FanOutPacket.h"
+
+#define		FAN_OUT_MAX_FOLLOWERS			4		// most followers a master sends frames to
+#define		FAN_OUT_REFRESH_RIS				48		// most RIs of the last frame kept so it can be sent again
+#define		FAN_OUT_REFRESH_INTERVAL		1000	// ms without a new frame before the last frame is sent again
+
+namespace LS {
+	/*!
+		@brief	A follower and the segment of the logical strip that it renders.
+	*/
+	struct FanOutFollower {
+		IP ip;
+		uint16_t firstLed = 0;			// first LED of the logical strip rendered by the follower
+		uint16_t numberOfLeds = 0;		// number of LEDs rendered by the follower
+	};
+
+	/*!
+		@brief	Renders a logical strip of LEDs that is spread over several Light
+				Servers.  The master runs the program for the whole logical strip
+				(ledConfig->numberOfLEDs), renders the first LEDs of the strip on its own
+				LEDs and, each time a frame is rendered, sends each follower its segment
+				of the frame as run-length encoded packets (see FanOutPacket).  Each frame
+				has a sequence number so followers can discard incomplete frames and hold
+				the last frame they showed.  The last frame is sent again when no new frame
+				has been rendered for FAN_OUT_REFRESH_INTERVAL ms so that a follower that
+				lost a frame of a program that has stopped changing still catches up.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class FanOutPixelRenderer : public PixelRenderer {
+	private:
+		uint16_t numberOfLocalLeds;
+		IUdpService* udp;
+		uint16_t port;
+
+		FanOutFollower followers[FAN_OUT_MAX_FOLLOWERS];
+		uint8_t numberOfFollowers = 0;
+		FanOutPacket packet;
+		uint16_t sequence = 0;
+
+		RI lastFrame[FAN_OUT_REFRESH_RIS];
+		uint16_t lastFrameRis = 0;				// 0 = the last frame could not be kept
+		bool lastFrameRepeat = false;
+		bool frameSentSinceRefresh = false;
+		uint32_t lastRefreshTime = 0;
+
+	protected:
+		virtual uint16_t GetNumberOfLeds();
+		void SendFrame(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat);
+		void SendSegment(FanOutFollower* follower, RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat);
+		void SendPacket(FanOutFollower* follower);
+
+	public:
+		FanOutPixelRenderer(IPixelController* pixelController, LEDConfig* ledConfig, uint16_t numberOfLocalLeds, IUdpService* udp, uint16_t port);
+
+		void Start();
+		bool AddFollower(IP ip, uint16_t firstLed, uint16_t numberOfLeds);
+		virtual bool SetPixels(LpiExecutorOutput* lpiExecutorOutput);
+		virtual bool SetPixels(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed = 0);
+		void Refresh(uint32_t now);
+		uint16_t GetSequence();
+	};
+}
+#endif
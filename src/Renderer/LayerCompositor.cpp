@@ -0,0 +1,150 @@
+#include "LayerCompositor.h"
+
+namespace LS {
+	/*!
+		@brief		Constructor injects dependencies.
+		@param		ledConfig		A pointer to the class that contains configuration information about the LEDs.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	LayerCompositor::LayerCompositor(LEDConfig* ledConfig) {
+		this->ledConfig = ledConfig;
+	}
+
+	/*!
+		@brief		Gets the number of pixels that are composited.
+		@returns	The number of pixels.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	uint16_t LayerCompositor::GetNumberOfPixels() {
+		return ledConfig->numberOfLEDs < COMPOSITOR_MAX_PIXELS ? ledConfig->numberOfLEDs : COMPOSITOR_MAX_PIXELS;
+	}
+
+	/*!
+		@brief		Blends a set of rendering instructions into a frame.  The pixel of
+					each rendering instruction is packed once and the blend is chosen
+					once so that the inner loop only blends the pixels.  Pixels that the
+					rendering instructions do not reach are left as they are.
+		@param		destination				A pointer to the frame.
+		@param		renderingInstructions	A pointer to the rendering instructions.
+		@param		numberOfInstructions	The number of rendering instructions.
+		@param		repeat					True if the rendering instructions are repeated until all pixels have been set.
+		@param		blendMode				How each pixel is blended with the pixel of the frame.
+		@param		alpha					The alpha of the rendering instructions (BlendAlpha only).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::Expand(uint32_t* destination, RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, BlendMode blendMode, uint8_t alpha) {
+		if (renderingInstructions == nullptr
+			|| numberOfInstructions == 0) {
+			return;
+		}
+
+		uint16_t numberOfPixels = GetNumberOfPixels();
+		uint16_t weight = alpha + (alpha >> 7);		// 0 - 256 so that an alpha of FF is the layer alone
+		uint16_t pixelIndex = 0;
+		uint16_t passStart;
+		do {
+			passStart = pixelIndex;
+			for (uint16_t riIndex = 0; riIndex < numberOfInstructions && pixelIndex < numberOfPixels; riIndex++) {
+				uint32_t pixel = Pack(&renderingInstructions[riIndex].colour);
+				uint16_t endIndex = renderingInstructions[riIndex].number < numberOfPixels - pixelIndex
+					? pixelIndex + renderingInstructions[riIndex].number
+					: numberOfPixels;
+
+				switch (blendMode) {
+					case BlendMode::BlendAdd:
+						for (; pixelIndex < endIndex; pixelIndex++) destination[pixelIndex] = Add(destination[pixelIndex], pixel);
+						break;
+					case BlendMode::BlendAlpha:
+						for (; pixelIndex < endIndex; pixelIndex++) destination[pixelIndex] = Mix(destination[pixelIndex], pixel, weight);
+						break;
+					case BlendMode::BlendMax:
+						for (; pixelIndex < endIndex; pixelIndex++) destination[pixelIndex] = Max(destination[pixelIndex], pixel);
+						break;
+					default:
+						for (; pixelIndex < endIndex; pixelIndex++) destination[pixelIndex] = pixel;
+						break;
+				}
+			}
+		} while (repeat && pixelIndex < numberOfPixels && pixelIndex > passStart);
+	}
+
+	/*!
+		@brief		Clears the base, e.g. once the program of the base has been stopped.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::Clear() {
+		memset(basePixels, 0, sizeof(basePixels));
+	}
+
+	/*!
+		@brief		Sets the frame of the bottom layer.  As with the LEDs, the pixels that
+					the rendering instructions do not reach keep the previous frame.
+		@param		renderingInstructions	A pointer to the rendering instructions of the frame.
+		@param		numberOfInstructions	The number of rendering instructions.
+		@param		repeat					True if the rendering instructions are repeated until all pixels have been set.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::SetBase(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat) {
+		Expand(basePixels, renderingInstructions, numberOfInstructions, repeat, BlendMode::BlendReplace, 0);
+	}
+
+	/*!
+		@brief		Begins compositing a frame, starting with the base.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::Begin() {
+		memcpy(pixels, basePixels, GetNumberOfPixels() * sizeof(uint32_t));
+	}
+
+	/*!
+		@brief		Blends the frame of a layer over the layers composited so far.
+		@param		layerOutput		A pointer to the frame of the layer.
+		@param		blendMode		How the layer is blended.
+		@param		alpha			The alpha of the layer (BlendAlpha only).
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::Blend(LpiExecutorOutput* layerOutput, BlendMode blendMode, uint8_t alpha) {
+		if (layerOutput == nullptr) {
+			return;
+		}
+
+		Expand(
+			pixels,
+			layerOutput->GetRenderingInstructions(),
+			layerOutput->GetNumberOfRenderingInstructions(),
+			layerOutput->GetRepeatRenderingInstructions(),
+			blendMode,
+			alpha
+		);
+	}
+
+	/*!
+		@brief		Gets the composited frame as rendering instructions.
+		@param		output		A pointer to the output that is set to the frame.
+		@author		Kevin White
+		@date		19 Oct 2026
+	*/
+	void LayerCompositor::GetOutput(LpiExecutorOutput* output) {
+		output->Reset();
+
+		uint16_t numberOfPixels = GetNumberOfPixels();
+		uint16_t runStart = 0;
+		for (uint16_t pixelIndex = 1; pixelIndex <= numberOfPixels; pixelIndex++) {
+			if (pixelIndex < numberOfPixels
+				&& pixels[pixelIndex] == pixels[runStart]) {
+				continue;
+			}
+
+			Colour colour(pixels[runStart] >> 16, pixels[runStart] >> 8, pixels[runStart]);
+			output->SetNextRenderingInstruction(&colour, pixelIndex - runStart);
+			runStart = pixelIndex;
+		}
+	}
+}
\ No newline at end of file
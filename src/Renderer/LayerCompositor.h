@@ -0,0 +1,148 @@
+/*!
+	@brief		Provides a class that composites the frames of several layers
+				into the frame that is rendered.
+	@author		Kevin White
+	@date		19 Oct 2026
+*/
+#ifndef _LayerCompositor_h
+#define _LayerCompositor_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "arduino.h"
+#else
+#include "../WProgram.h"
+#endif
+
+#include "../ValueDomainTypes.h"
+#include "../LPE/LpiExecutors/LpiExecutorOutput.h"
+#include <string.h>
+
+// Each layer has its own LP state, executor and output (about 4.4 KB with a 1000 byte JSON document) on top of
+// the 2.8 KB of the compositor, so the 32 KB of the MKR1010 has room for one layer, and only with other features left out
+#define		MAX_LAYERS					1		// most layers that are composited over the program
+#define		COMPOSITOR_MAX_PIXELS		MAX_RENDERING_INSTRUCTIONS		// most pixels that are composited
+#define		COMPOSITOR_RED_BLUE			0x00FF00FF		// the red and blue channels of a packed pixel
+#define		COMPOSITOR_GREEN			0x0000FF00		// the green channel of a packed pixel
+#define		COMPOSITOR_RED_BLUE_CARRY	0x01000100		// the bits above the red and blue channels
+#define		COMPOSITOR_GREEN_CARRY		0x00010000		// the bit above the green channel
+
+namespace LS {
+	/*!
+		@brief	How the frame of a layer is combined with the layers below it.
+	*/
+	enum BlendMode {
+		BlendReplace,		// the layer replaces the layers below it
+		BlendAdd,			// the colours are added (up to full intensity)
+		BlendAlpha,			// the layer is mixed with the layers below it by its alpha (0 - 255)
+		BlendMax			// the brighter of each channel is kept
+	};
+
+	/*!
+		@brief	Composites the frames of layers, bottom first, into a single frame.  The
+				frame of the bottom layer (the base) is kept so that the layers above it can
+				be composited over it again without the base being rendered again.  Pixels
+				are packed as 0x00RRGGBB so that each blend works on two channels at
+				once (red and blue, each with 8 spare bits above it) and then green, rather
+				than on each channel in turn.  The composited frame is given as rendering
+				instructions, adjacent pixels of the same colour sharing an instruction,
+				so that it is rendered in the same way as the frame of a single program.
+		@author	Kevin White
+		@date	19 Oct 2026
+	*/
+	class LayerCompositor {
+	protected:
+		LEDConfig* ledConfig = nullptr;
+		uint32_t basePixels[COMPOSITOR_MAX_PIXELS] = {};
+		uint32_t pixels[COMPOSITOR_MAX_PIXELS] = {};
+
+		uint16_t GetNumberOfPixels();
+		void Expand(uint32_t* destination, RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, BlendMode blendMode, uint8_t alpha);
+
+		/*!
+			@brief		Packs a colour into a pixel (0x00RRGGBB).
+			@param		colour		The colour.
+			@returns	The pixel.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t Pack(Colour* colour) {
+			return ((uint32_t)colour->red << 16) | ((uint32_t)colour->green << 8) | colour->blue;
+		}
+
+		/*!
+			@brief		Adds two pixels, each channel saturating at FF.  The carry out of
+						each channel (into its spare bits) is spread back over the channel.
+			@param		below		The pixel of the layers below.
+			@param		above		The pixel of the layer.
+			@returns	The blended pixel.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t Add(uint32_t below, uint32_t above) {
+			uint32_t redBlue = (below & COMPOSITOR_RED_BLUE) + (above & COMPOSITOR_RED_BLUE);
+			uint32_t green = (below & COMPOSITOR_GREEN) + (above & COMPOSITOR_GREEN);
+			uint32_t redBlueCarry = redBlue & COMPOSITOR_RED_BLUE_CARRY;
+			uint32_t greenCarry = green & COMPOSITOR_GREEN_CARRY;
+
+			return ((redBlue | (redBlueCarry - (redBlueCarry >> 8))) & COMPOSITOR_RED_BLUE)
+				| ((green | (greenCarry - (greenCarry >> 8))) & COMPOSITOR_GREEN);
+		}
+
+		/*!
+			@brief		Mixes two pixels: below x (256 - weight) + above x weight, / 256.
+			@param		below		The pixel of the layers below.
+			@param		above		The pixel of the layer.
+			@param		weight		The weight of the layer (0 - 256).
+			@returns	The blended pixel.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t Mix(uint32_t below, uint32_t above, uint16_t weight) {
+			uint16_t belowWeight = 256 - weight;
+			uint32_t redBlue = ((below & COMPOSITOR_RED_BLUE) * belowWeight + (above & COMPOSITOR_RED_BLUE) * weight) >> 8;
+			uint32_t green = ((below & COMPOSITOR_GREEN) * belowWeight + (above & COMPOSITOR_GREEN) * weight) >> 8;
+
+			return (redBlue & COMPOSITOR_RED_BLUE) | (green & COMPOSITOR_GREEN);
+		}
+
+		/*!
+			@brief		Keeps the larger of each of the two channels (at bits 0 and 16).
+						The channels of below, with the bit above each set, are subtracted
+						from those of above: the bit is only still set if below is the larger.
+			@param		below		The channels of the layers below.
+			@param		above		The channels of the layer.
+			@returns	The larger channels.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t MaxChannels(uint32_t below, uint32_t above) {
+			uint32_t belowIsLarger = ((below | COMPOSITOR_RED_BLUE_CARRY) - above) & COMPOSITOR_RED_BLUE_CARRY;
+			uint32_t belowMask = belowIsLarger - (belowIsLarger >> 8);
+
+			return (below & belowMask) | (above & ~belowMask & COMPOSITOR_RED_BLUE);
+		}
+
+		/*!
+			@brief		Keeps the brighter of each channel of two pixels.
+			@param		below		The pixel of the layers below.
+			@param		above		The pixel of the layer.
+			@returns	The blended pixel.
+			@author		Kevin White
+			@date		19 Oct 2026
+		*/
+		static uint32_t Max(uint32_t below, uint32_t above) {
+			return MaxChannels(below & COMPOSITOR_RED_BLUE, above & COMPOSITOR_RED_BLUE)
+				| MaxChannels(below >> 8 & COMPOSITOR_RED_BLUE, above >> 8 & COMPOSITOR_RED_BLUE) << 8;
+		}
+
+	public:
+		LayerCompositor(LEDConfig* ledConfig);
+
+		void Clear();
+		void SetBase(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat);
+		void Begin();
+		void Blend(LpiExecutorOutput* layerOutput, BlendMode blendMode, uint8_t alpha);
+		void GetOutput(LpiExecutorOutput* output);
+	};
+}
+#endif
@@ -13,6 +13,16 @@ namespace LS {
 		this->ledConfig = ledConfig;
 	}
 
+	/*!
+	  @brief	Gets the number of LEDs that are connected to this renderer.
+	  @return	The number of LEDs.
+	  @author	Kevin White
+	  @date		19 Oct 2026
+	*/
+	uint16_t PixelRenderer::GetNumberOfLeds() {
+		return ledConfig->numberOfLEDs;
+	}
+
 	/*!
 	  @brief	Sets the pixel rendering buffer with the values that have been output
 				from executing a rendering instruction.
@@ -23,25 +33,109 @@ namespace LS {
 	  @date		16 Jan 21
 	*/
 	bool PixelRenderer::SetPixels(LpiExecutorOutput* lpiExecutorOutput) {
-		lastSetRiValid = false;
+		if (lpiExecutorOutput == nullptr) {
+			lastSetRiValid = false;
+			return false;
+		}
+
+		if (lpiExecutorOutput->IsGenerated()) {
+			return SetGeneratedPixels(lpiExecutorOutput);
+		}
 
-		if (lpiExecutorOutput == nullptr
-			|| lpiExecutorOutput->GetNumberOfRenderingInstructions() <= 0) {
+		return SetPixels(
+			lpiExecutorOutput->GetRenderingInstructions(),
+			lpiExecutorOutput->GetNumberOfRenderingInstructions(),
+			lpiExecutorOutput->GetRepeatRenderingInstructions()
+		);
+	}
+
+	/*!
+	  @brief	Sets the pixel rendering buffer with the pixels of an output whose pixels are
+				generated as they are set, one run of pixels of the same colour at a time,
+				rather than copied from rendering instructions.
+	  @param	lpiExecutorOutput	A pointer to the output that generates the pixels.
+	  @return	True if the pixel rendering buffer was set or false if the pixels could not be generated.
+	  @author	Kevin White
+	  @date		19 Oct 2026
+	*/
+	bool PixelRenderer::SetGeneratedPixels(LpiExecutorOutput* lpiExecutorOutput) {
+		lastSetRiValid = lpiExecutorOutput->BeginRuns();
+		if (!lastSetRiValid) {
 			return false;
 		}
 
-		RI* renderingInstructions = lpiExecutorOutput->GetRenderingInstructions();
 		uint16_t ledIndex = 0;
-		uint16_t numberOfLeds = ledConfig->numberOfLEDs;
+		uint16_t numberOfLeds = GetNumberOfLeds();
+		Colour colour;
+		uint16_t numberOfPixels;
+		while (ledIndex < numberOfLeds
+			&& (numberOfPixels = lpiExecutorOutput->GetNextRun(ledIndex, &colour)) > 0) {
+			for (uint16_t i = 0; i < numberOfPixels && ledIndex < numberOfLeds; i++) {
+				pixelController->setPixelColor(ledIndex++, colour.red, colour.green, colour.blue);
+			}
+		}
+
+		return true;
+	}
+
+	/*!
+	  @brief	Sets the pixel rendering buffer with a set of rendering instructions.
+	  @param	renderingInstructions	A pointer to the rendering instructions.
+	  @param	numberOfInstructions	The number of rendering instructions.
+	  @param	repeat					True if the rendering instructions are repeated until all LEDs have been set.
+	  @param	firstLed				The LED that the first rendering instruction starts from.
+	  @return	True if the pixel rendering buffer was set or false if there are no rendering instructions.
+	  @author	Kevin White
+	  @date		19 Oct 2026
+	*/
+	bool PixelRenderer::SetPixels(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed) {
+		return SetPixelRange(renderingInstructions, numberOfInstructions, repeat, firstLed, GetNumberOfLeds(), 0);
+	}
+
+	/*!
+	  @brief	Sets a range of the pixel rendering buffer with a set of rendering instructions,
+				e.g. a segment of the LEDs that plays a program of its own.  The LEDs outside
+				of the range are left as they are.
+	  @param	renderingInstructions	A pointer to the rendering instructions.
+	  @param	numberOfInstructions	The number of rendering instructions.
+	  @param	repeat					True if the rendering instructions are repeated until all LEDs of the range have been set.
+	  @param	firstLed				The first LED of the range.
+	  @param	endLed					The LED after the last LED of the range.
+	  @param	skipLeds				The number of pixels of the rendering instructions that are skipped before
+										the first LED is set, e.g. so that a range continues a frame of the whole strip.
+	  @return	True if the pixel rendering buffer was set or false if there are no rendering instructions.
+	  @author	Kevin White
+	  @date		19 Oct 2026
+	*/
+	bool PixelRenderer::SetPixelRange(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed, uint16_t endLed, uint16_t skipLeds) {
+		lastSetRiValid = false;
+
+		if (renderingInstructions == nullptr
+			|| numberOfInstructions <= 0) {
+			return false;
+		}
+
+		uint16_t ledIndex = firstLed;
+		uint16_t numberOfLeds = GetNumberOfLeds();
+		if (endLed > numberOfLeds) {
+			endLed = numberOfLeds;
+		}
 		lastSetRiValid = true;
 
-		while (ledIndex < numberOfLeds) {
+		while (ledIndex < endLed) {
 			// iterate over each RI and render the specified number of LEDs
 			// for that RI
-			for (uint16_t riIndex = 0; riIndex < lpiExecutorOutput->GetNumberOfRenderingInstructions(); riIndex++) {
+			for (uint16_t riIndex = 0; riIndex < numberOfInstructions; riIndex++) {
 				RI renderingInstruction = renderingInstructions[riIndex];
 
-				for (uint16_t i = 0; i < renderingInstruction.number; i++) {
+				uint16_t numberOfPixels = renderingInstruction.number;
+				if (skipLeds > 0) {
+					uint16_t skippedPixels = skipLeds < numberOfPixels ? skipLeds : numberOfPixels;
+					skipLeds -= skippedPixels;
+					numberOfPixels -= skippedPixels;
+				}
+
+				for (uint16_t i = 0; i < numberOfPixels; i++) {
 					pixelController->setPixelColor(
 						ledIndex++,
 						renderingInstruction.colour.red,
@@ -49,13 +143,13 @@ namespace LS {
 						renderingInstruction.colour.blue
 					);
 
-					if (ledIndex >= numberOfLeds) {
+					if (ledIndex >= endLed) {
 						return true;
 					}
 				}
 			}
 
-			if (!lpiExecutorOutput->GetRepeatRenderingInstructions()) {
+			if (!repeat) {
 				// RIs do not repeat, so they have been rendered once
 				// and now we just need to return
 				return true;
@@ -84,7 +178,7 @@ namespace LS {
 		@date		16 Jan 21
 	*/
 	bool PixelRenderer::AreAnyPixelsOn() {
-		for (uint16_t i = 0; i < ledConfig->numberOfLEDs; i++) {
+		for (uint16_t i = 0; i < GetNumberOfLeds(); i++) {
 			if (pixelController->getPixelColor(i) != 0) {
 				return true;
 			}
@@ -26,10 +26,15 @@ namespace LS {
 		IPixelController* pixelController = nullptr;
 		bool lastSetRiValid = false;
 
+		virtual uint16_t GetNumberOfLeds();
+		bool SetGeneratedPixels(LpiExecutorOutput* lpiExecutorOutput);
+
 	public:
 		PixelRenderer(IPixelController* pixelController, LEDConfig* ledConfig);
 
 		virtual bool SetPixels(LpiExecutorOutput* lpiExecutorOutput);
+		virtual bool SetPixels(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed = 0);
+		bool SetPixelRange(RI* renderingInstructions, uint16_t numberOfInstructions, bool repeat, uint16_t firstLed, uint16_t endLed, uint16_t skipLeds);
 		virtual void ShowPixels();
 		virtual bool AreAnyPixelsOn();
 
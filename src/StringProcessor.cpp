@@ -150,7 +150,7 @@ namespace LS {
 
 	/*!
 	  @brief   Extracts a LPI instruction value from a string.  A valid LPI instruction
-			   consists of four hex encoded parts: xx (op code), yy (duration), rr (reserved), zz (reserved).
+			   consists of four hex encoded parts: xx (op code), yy (duration), tt (transition), zz (reserved).
 	  @param   instructionString	 The pointer to the string that contains the hexidecimally encoded LPI instruction.
 	  @param   isValid				 A reference to the boolean type that will be set to true if the string contains
 									 a valid LPI instruction.  If it is not valid then the value is set to false.
@@ -172,10 +172,13 @@ namespace LS {
 		if (isValid == false) return lpi;
 		lpi.duration = duration;
 
-		// Extract the two reserved values (to ensure that they have bene defined)
+		// Extract the transition (00-FF are valid)
 		pInstructionString += 2;
-		ExtractNumberFromHexEncoded(pInstructionString, 0, 0, isValid);
+		uint8_t transition = ExtractNumberFromHexEncoded(pInstructionString, 0, 255, isValid);
 		if (isValid == false) return lpi;
+		lpi.transition = transition;
+
+		// Extract the reserved value (to ensure that it has been defined)
 		pInstructionString += 2;
 		ExtractNumberFromHexEncoded(pInstructionString, 0, 0, isValid);
 
@@ -184,7 +187,7 @@ namespace LS {
 
 	/*!
 		  @brief   Extracts a LPI instruction value from a string.  A valid LPI instruction
-				   consists of four hex encoded parts: xx (op code), yy (duration), rr (reserved), zz (reserved).
+				   consists of four hex encoded parts: xx (op code), yy (duration), tt (transition), zz (reserved).
 		  @param   instructionString	 The pointer to the string that contains the hexidecimally encoded LPI instruction.
 		  @param   isValid				 A reference to the boolean type that will be set to true if the string contains
 										 a valid LPI instruction.  If it is not valid then the value is set to false.
@@ -205,10 +208,13 @@ namespace LS {
 		if (isValid == false) return false;
 		lpiInstruction->duration = duration;
 
-		// Extract the two reserved values (to ensure that they have bene defined)
+		// Extract the transition (00-FF are valid)
 		pInstructionString += 2;
-		ExtractNumberFromHexEncoded(pInstructionString, 0, 0, isValid);
+		uint8_t transition = ExtractNumberFromHexEncoded(pInstructionString, 0, 255, isValid);
 		if (isValid == false) return false;
+		lpiInstruction->transition = transition;
+
+		// Extract the reserved value (to ensure that it has been defined)
 		pInstructionString += 2;
 		ExtractNumberFromHexEncoded(pInstructionString, 0, 0, isValid);
 
@@ -232,6 +238,29 @@ namespace LS {
 		return boolValue;
 	}
 
+	/*!
+	  @brief   Extracts a number from a single hex encoded digit, e.g. the index of a colour.
+	  @param   digitString			 The pointer to the string that contains the hexidecimally encoded digit.
+	  @param   maxExpectedValue		 The maximum value that the digit is expected to have (at most 15).
+	  @param   isValid				 A reference to the boolean type that will be set to true if the string contains
+									 a valid digit no greater than maxExpectedValue.  If it is not valid then the value is set to false.
+	  @return  The number (0 - 15).
+	*/
+	const uint8_t StringProcessor::ExtractDigitFromHexEncoded(const char* digitString, uint8_t maxExpectedValue, bool& isValid) {
+		isValid = false;
+		if (digitString == nullptr) return 0;
+
+		uint8_t digit = 0;
+		char currentChar = *digitString;
+		if (currentChar > 47 && currentChar < 58) digit = currentChar - 48;			// 0 - 9
+		else if (currentChar > 64 && currentChar < 71) digit = currentChar - 55;	// A - F
+		else return 0;
+
+		isValid = digit <= maxExpectedValue;
+
+		return digit;
+	}
+
 	/*!
 	  @brief   Converts a uint8_t number to a hex-encoded string and adds the values
 			   to the put buffer.  Caller is reasonable for ensuring that the buffer
@@ -251,4 +280,61 @@ namespace LS {
 		nibble = (number & 15);
 		*pPutBuffer = (nibble < 10 ? 48 + nibble : 55 + nibble);
 	}
+
+	/*!
+	  @brief   Loads an LPI in to a buffer with each of its colour references, a '*'
+			   followed by a single hex digit (e.g. *2), replaced by the hex-encoded colour
+			   at that index of a palette.  A reference to a colour that the palette does
+			   not have is replaced by black.
+	  @param   lpi				The pointer to the LPI string.
+	  @param   buffer			The pointer to the buffer that the LPI is loaded in to.
+	  @param   palette			The pointer to the colours of the palette (may be nullptr).
+	  @param   numberOfColours	The number of colours of the palette.
+	  @return  True if the LPI was loaded or false if a colour reference is not valid or
+			   the LPI does not fit in the buffer.
+	*/
+	bool StringProcessor::ExpandColourReferences(const char* lpi, FixedSizeCharBuffer* buffer, const Colour* palette, uint8_t numberOfColours) {
+		if (lpi == nullptr || buffer == nullptr) return false;
+
+		char* pBuffer = buffer->GetBuffer();
+		uint16_t remaining = buffer->GetBufferSize() - 1;	// space for the terminator
+		bool isValid = true;
+
+		char currentChar;
+		while (isValid && (currentChar = *lpi++) != '\0') {
+			if (currentChar != COLOUR_REFERENCE) {
+				if (remaining == 0) {
+					isValid = false;
+					break;
+				}
+
+				*pBuffer++ = currentChar;
+				remaining--;
+				continue;
+			}
+
+			// the index of the colour is a single hex digit
+			char indexChar = *lpi++;
+			uint8_t index = 0;
+			if (indexChar > 47 && indexChar < 58) index = indexChar - 48;		// 0 - 9
+			else if (indexChar > 64 && indexChar < 71) index = indexChar - 55;	// A - F
+			else isValid = false;
+
+			if (!isValid || remaining < 6) {
+				isValid = false;
+				break;
+			}
+
+			Colour colour = palette != nullptr && index < numberOfColours ? palette[index] : Colour();
+			ConvertNumberToHexEncoded(pBuffer, colour.red);
+			ConvertNumberToHexEncoded(pBuffer + 2, colour.green);
+			ConvertNumberToHexEncoded(pBuffer + 4, colour.blue);
+			pBuffer += 6;
+			remaining -= 6;
+		}
+
+		*pBuffer = '\0';
+
+		return isValid;
+	}
 }
\ No newline at end of file
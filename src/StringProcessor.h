@@ -35,7 +35,11 @@ namespace LS {
 
 			virtual const bool ExtractBoolFromHexEncoded(const char* instructionString, bool& isValid);
 
+			virtual const uint8_t ExtractDigitFromHexEncoded(const char* digitString, uint8_t maxExpectedValue, bool& isValid);
+
 			virtual const void ConvertNumberToHexEncoded(char* putBuffer, uint8_t number);
+
+			virtual bool ExpandColourReferences(const char* lpi, FixedSizeCharBuffer* buffer, const Colour* palette, uint8_t numberOfColours);
 		};
 
 }
@@ -18,6 +18,12 @@ namespace LS {
 
 	#define	BUFFER_JSON_RESPONSE_SIZE	150	 // 200
 
+	#define MAX_NESTED_LOOPS			5			// most repeats that can be nested within each other in a LP
+	#define COLOUR_REFERENCE			'*'			// followed by a hex digit, refers to a colour of a palette in an LPI
+	#define MAX_PALETTE_SIZE			16			// most colours of a palette (that a single hex digit can refer to)
+	#define MAX_SEGMENTS				4			// most named ranges of LEDs that can play programs of their own
+	#define SEGMENT_NAME_SIZE			12			// longest segment name (including the terminator)
+
 	//#define BUFFER_LPI_LOADING			1000		// buffer size for loading an individual LPI
 	//#define	BUFFER_LPI_VALIDATION		1000		// buffer size for validating an individual LPI
 	//#define BUFFER_LP_VALIDATION		5000		// buffer size for validating an entire LP
@@ -109,6 +115,16 @@ namespace LS {
 		}
 	};
 
+	/*!
+	@brief  Struct that represents a segment: a named range of the LEDs that plays
+			a program of its own (e.g. the roofline and the tree of one strip).
+	*/
+	struct LEDSegment {
+		char name[SEGMENT_NAME_SIZE];
+		uint16_t firstLed;
+		uint16_t numberOfLEDs;
+	};
+
 	/*!
 	@brief  Struct that represents the configuration of the LEDs.  This includes: the number
 			of pixels available (LEDs).
@@ -121,6 +137,12 @@ namespace LS {
 		// the last program that was stored which will be re-loaded when the LEDs are next started
 		char storedProgram[2000];
 
+		// the segments of the LEDs, in order along the strip and not overlapping
+		// (kept after the stored program so that configurations stored before
+		// there were segments are still read correctly)
+		LEDSegment segments[MAX_SEGMENTS];
+		uint8_t numberOfSegments = 0;
+
 		//LEDConfig(uint8_t numberOfLEDs) {
 		//	this->numberOfLEDs = numberOfLEDs;
 		//}
@@ -131,6 +153,51 @@ namespace LS {
 		bool AreSettingsValid() {
 			return controlValue == 99;
 		}
+
+		/*!
+		  @brief	Checks that the segments are in order along the strip, do not
+					overlap and are within the LEDs.
+		  @returns	True if the segments are valid, false otherwise.
+		*/
+		bool AreSegmentsValid() {
+			if (numberOfSegments > MAX_SEGMENTS) {
+				return false;
+			}
+
+			uint16_t nextLed = 0;
+			for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+				LEDSegment* segment = &segments[segmentIndex];
+				if (segment->numberOfLEDs == 0
+					|| segment->firstLed < nextLed
+					|| segment->firstLed + segment->numberOfLEDs > numberOfLEDs
+					|| strnlen(segment->name, SEGMENT_NAME_SIZE) == 0
+					|| strnlen(segment->name, SEGMENT_NAME_SIZE) == SEGMENT_NAME_SIZE) {
+					return false;
+				}
+				nextLed = segment->firstLed + segment->numberOfLEDs;
+			}
+
+			return true;
+		}
+
+		/*!
+		  @brief	Finds a segment by its name.
+		  @param	name	The name of the segment.
+		  @returns	The index of the segment or -1 if there is no such segment.
+		*/
+		int8_t FindSegment(const char* name) {
+			if (name == nullptr) {
+				return -1;
+			}
+
+			for (uint8_t segmentIndex = 0; segmentIndex < numberOfSegments; segmentIndex++) {
+				if (strncmp(segments[segmentIndex].name, name, SEGMENT_NAME_SIZE) == 0) {
+					return segmentIndex;
+				}
+			}
+
+			return -1;
+		}
 	};
 
 	/*!
@@ -139,6 +206,7 @@ namespace LS {
 	struct LPIInstruction {
 		uint8_t opcode;
 		uint8_t duration;
+		uint8_t transition;			// frames over which the LPI fades in from the frame before it (0 = none)
 		FixedSizeCharBuffer* lpi;
 
 		/*!
@@ -147,6 +215,7 @@ namespace LS {
 		LPIInstruction() {
 			opcode = 0;
 			duration = 0;
+			transition = 0;
 			lpi = nullptr;
 		}
 
@@ -159,13 +228,14 @@ namespace LS {
 		LPIInstruction(uint8_t opcode, uint8_t duration, FixedSizeCharBuffer* lpi) {
 			this->opcode = opcode;
 			this->duration = duration;
+			this->transition = 0;
 			this->lpi = lpi;
 		}
 
 		/*!
 		  @brief	Gets a pointer to the remainder of the LPI buffer once
 			        it has been advanced over the 8-bytes of the LPI instruction
-					(that is, advanced over the op-code, duration, xx reserved, and yy reserved).
+					(that is, advanced over the op-code, duration, tt transition, and yy reserved).
 					Using this method means that changes to the instruction format will
 					mean only having to change it once here.
 		  @returns	A poiunt to the advanced LPI buffer.
@@ -192,7 +262,10 @@ namespace LS {
 		NoIntructions = 7,
 		InvalidProperty = 8,
 		Maximum5NestedLoopsAllowed = 9,
-		LoopHasInvalidTimesValue = 10
+		LoopHasInvalidTimesValue = 10,
+		ExceedsFrameBudget = 11,
+		UnknownSubroutine = 12,
+		RecursiveSubroutine = 13
 	};
 
 	/*!